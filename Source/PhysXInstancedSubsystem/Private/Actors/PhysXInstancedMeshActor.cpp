@@ -9,7 +9,9 @@
 #include "IImageWrapper.h"
 #include "IImageWrapperModule.h"
 #include "Components/PhysXInstancedStaticMeshComponent.h"
+#include "Components/PhysXInstancedHierarchicalStaticMeshComponent.h"
 #include "Subsystems/PhysXInstancedWorldSubsystem.h"
+#include "Types/PhysXInstanceArchetype.h"
 
 #include "Engine/CollisionProfile.h"
 #include "Engine/StaticMesh.h"            // FStaticMaterial, GetStaticMaterials
@@ -179,6 +181,7 @@ APhysXInstancedMeshActor::APhysXInstancedMeshActor()
 	// --- Physics defaults ----------------------------------------------------
 
 	bSimulateInstances     = true;
+	bCreateBodiesAsync     = false;
 	bInstancesUseGravity   = true;
 	bOverrideInstanceMass  = false;
 	InstanceMassInKg       = 10.0f;
@@ -243,6 +246,19 @@ void APhysXInstancedMeshActor::ApplyCollisionSettings()
 
 		InstancedMesh->SetInstancesAffectNavigation(bInstancesAffectNavigation);
 	}
+
+	// Hierarchical storage mirrors the storage collision configured above.
+	SyncRenderTierComponent(StorageHierarchicalMesh);
+}
+
+EPhysXInstanceShapeType APhysXInstancedMeshActor::GetEffectiveShapeType() const
+{
+	return InstanceArchetype ? InstanceArchetype->ShapeType : InstanceShapeType;
+}
+
+UStaticMesh* APhysXInstancedMeshActor::GetEffectiveCollisionMesh() const
+{
+	return InstanceArchetype ? InstanceArchetype->CollisionMesh : OverrideCollisionMesh;
 }
 
 /** Apply editor/runtime property state to the InstancedMesh component. */
@@ -356,6 +372,16 @@ void APhysXInstancedMeshActor::PostEditChangeProperty(FPropertyChangedEvent& Pro
 			InstancedMesh->bCastDynamicShadow = bInstancesCastShadow;
 			InstancedMesh->bCastStaticShadow  = bInstancesCastShadow;
 		}
+
+		TArray<UPhysXInstancedStaticMeshComponent*> RenderComponents;
+		GetRenderComponents(RenderComponents);
+
+		for (UPhysXInstancedStaticMeshComponent* Component : RenderComponents)
+		{
+			SyncRenderTierComponent(Component);
+		}
+
+		SyncRenderTierComponent(StorageHierarchicalMesh);
 	}
 }
 
@@ -539,6 +565,562 @@ void APhysXInstancedMeshActor::ApplyInstanceMaterials()
 	{
 		InstancedMesh->SetMaterial(SlotIndex, nullptr);
 	}
+
+	// Keep chunk, sleeping-tier and storage components visually identical to the primary component.
+	TArray<UPhysXInstancedStaticMeshComponent*> RenderComponents;
+	GetRenderComponents(RenderComponents);
+
+	for (UPhysXInstancedStaticMeshComponent* Component : RenderComponents)
+	{
+		SyncRenderTierComponent(Component);
+	}
+
+	SyncRenderTierComponent(StorageHierarchicalMesh);
+}
+
+// ============================================================================
+// Render tiers
+// ============================================================================
+
+/** Return the sleeping-tier component, creating it lazily so actors without tiers pay nothing. */
+UPhysXInstancedStaticMeshComponent* APhysXInstancedMeshActor::GetOrCreateSleepingInstancedMesh()
+{
+	if (!SleepingInstancedMesh)
+	{
+		SleepingInstancedMesh = CreateRenderTierComponent(TEXT("SleepingInstancedMesh"));
+
+		if (SleepingInstancedMesh)
+		{
+			SleepingInstancedMesh->bIsSleepingTier = true;
+		}
+	}
+
+	return SleepingInstancedMesh;
+}
+
+/** Lazily create the non-casting component used for far awake instances. */
+UPhysXInstancedStaticMeshComponent* APhysXInstancedMeshActor::GetOrCreateNoShadowInstancedMesh()
+{
+	if (!NoShadowInstancedMesh)
+	{
+		NoShadowInstancedMesh = CreateRenderTierComponent(TEXT("NoShadowInstancedMesh"));
+	}
+
+	return NoShadowInstancedMesh;
+}
+
+/** Create and register a runtime instanced component attached next to InstancedMesh. */
+UPhysXInstancedStaticMeshComponent* APhysXInstancedMeshActor::CreateRenderTierComponent(FName ComponentName)
+{
+	if (!InstancedMesh)
+	{
+		return nullptr;
+	}
+
+	UPhysXInstancedStaticMeshComponent* TierComponent =
+		NewObject<UPhysXInstancedStaticMeshComponent>(this, ComponentName, RF_Transient);
+
+	if (!TierComponent)
+	{
+		return nullptr;
+	}
+
+	TierComponent->OwningPhysXActor = this;
+	TierComponent->SetMobility(EComponentMobility::Movable);
+	TierComponent->SetupAttachment(SceneRoot);
+	TierComponent->SetRelativeTransform(InstancedMesh->GetRelativeTransform());
+
+	SyncRenderTierComponent(TierComponent);
+
+	AddInstanceComponent(TierComponent);
+	TierComponent->RegisterComponent();
+
+	return TierComponent;
+}
+
+/** Collect the primary component followed by chunk and sleeping-tier components. */
+void APhysXInstancedMeshActor::GetRenderComponents(TArray<UPhysXInstancedStaticMeshComponent*>& OutComponents) const
+{
+	OutComponents.Reset();
+
+	if (InstancedMesh)
+	{
+		OutComponents.Add(InstancedMesh);
+	}
+
+	for (UPhysXInstancedStaticMeshComponent* Chunk : ChunkComponents)
+	{
+		if (Chunk)
+		{
+			OutComponents.Add(Chunk);
+		}
+	}
+
+	if (SleepingInstancedMesh)
+	{
+		OutComponents.Add(SleepingInstancedMesh);
+	}
+
+	if (NoShadowInstancedMesh)
+	{
+		OutComponents.Add(NoShadowInstancedMesh);
+	}
+}
+
+/** Route a new awake instance to the chunk that should own it. */
+UPhysXInstancedStaticMeshComponent* APhysXInstancedMeshActor::GetRenderComponentForLocation(const FVector& WorldLocation)
+{
+	// Storage actors always keep a single component.
+	if (bStorageOnly || bIsStorageActor)
+	{
+		return InstancedMesh;
+	}
+
+	switch (ChunkMode)
+	{
+	case EPhysXInstanceChunkMode::SpatialCell:
+		if (UPhysXInstancedStaticMeshComponent* Chunk = GetOrCreateChunkForCell(GetChunkCellForLocation(WorldLocation)))
+		{
+			return Chunk;
+		}
+		break;
+
+	case EPhysXInstanceChunkMode::MaxInstancesPerComponent:
+	{
+		const int32 Cap = FMath::Max(1, MaxInstancesPerChunk);
+
+		if (InstancedMesh && InstancedMesh->GetInstanceCount() < Cap)
+		{
+			return InstancedMesh;
+		}
+
+		for (UPhysXInstancedStaticMeshComponent* Chunk : ChunkComponents)
+		{
+			if (Chunk && !Chunk->bIsSpatialChunk && Chunk->GetInstanceCount() < Cap)
+			{
+				return Chunk;
+			}
+		}
+
+		const FName ChunkName = *FString::Printf(TEXT("InstancedMeshChunk_%d"), ChunkComponents.Num());
+		if (UPhysXInstancedStaticMeshComponent* NewChunk = CreateRenderTierComponent(ChunkName))
+		{
+			ChunkComponents.Add(NewChunk);
+			return NewChunk;
+		}
+		break;
+	}
+
+	case EPhysXInstanceChunkMode::None:
+	default:
+		break;
+	}
+
+	return InstancedMesh;
+}
+
+/** Decide where an already registered instance should render given its sleep state and position. */
+UPhysXInstancedStaticMeshComponent* APhysXInstancedMeshActor::ResolveRenderComponent(
+	const UInstancedStaticMeshComponent* CurrentComponent,
+	bool bSleeping,
+	const FVector& WorldLocation,
+	bool bBeyondShadowDistance)
+{
+	if (bStorageOnly || bIsStorageActor)
+	{
+		return InstancedMesh;
+	}
+
+	if (bSleeping && bUseSleepingRenderTier)
+	{
+		// A single sleeping component would span every cell and undo per-chunk culling for resting instances.
+		if (ChunkMode == EPhysXInstanceChunkMode::SpatialCell)
+		{
+			if (UPhysXInstancedStaticMeshComponent* SleepingChunk = GetOrCreateSleepingChunkForCell(GetChunkCellForLocation(WorldLocation)))
+			{
+				return SleepingChunk;
+			}
+		}
+
+		return GetOrCreateSleepingInstancedMesh();
+	}
+
+	// Far instances stop casting; the sleeping tier above still wins so resting debris keeps its shadows.
+	if (bBeyondShadowDistance && bUseShadowDistanceLOD)
+	{
+		return GetOrCreateNoShadowInstancedMesh();
+	}
+
+	const UPhysXInstancedStaticMeshComponent* Current = Cast<UPhysXInstancedStaticMeshComponent>(CurrentComponent);
+	const bool bCurrentIsActive =
+		Current &&
+		!Current->bIsSleepingTier &&
+		Current != NoShadowInstancedMesh &&
+		Current->OwningPhysXActor == this;
+
+	if (bCurrentIsActive)
+	{
+		switch (ChunkMode)
+		{
+		case EPhysXInstanceChunkMode::SpatialCell:
+			if (Current->bIsSpatialChunk && !HasLeftChunkCell(Current, WorldLocation))
+			{
+				return const_cast<UPhysXInstancedStaticMeshComponent*>(Current);
+			}
+			break;
+
+		case EPhysXInstanceChunkMode::MaxInstancesPerComponent:
+			if (!Current->bIsSpatialChunk)
+			{
+				return const_cast<UPhysXInstancedStaticMeshComponent*>(Current);
+			}
+			break;
+
+		case EPhysXInstanceChunkMode::None:
+		default:
+			if (Current == InstancedMesh)
+			{
+				return InstancedMesh;
+			}
+			break;
+		}
+	}
+
+	return GetRenderComponentForLocation(WorldLocation);
+}
+
+/** Cell test with a border margin so instances resting on a cell edge do not ping-pong. */
+bool APhysXInstancedMeshActor::HasLeftChunkCell(
+	const UPhysXInstancedStaticMeshComponent* ChunkComponent,
+	const FVector& WorldLocation) const
+{
+	if (!ChunkComponent || !ChunkComponent->bIsSpatialChunk || ChunkMode != EPhysXInstanceChunkMode::SpatialCell)
+	{
+		return true;
+	}
+
+	const float CellSize = FMath::Max(ChunkCellSize, 100.0f);
+	const float Margin   = FMath::Max(ChunkCellHysteresis, 0.0f);
+
+	const float MinX = ChunkComponent->ChunkCell.X * CellSize - Margin;
+	const float MinY = ChunkComponent->ChunkCell.Y * CellSize - Margin;
+	const float MaxX = (ChunkComponent->ChunkCell.X + 1) * CellSize + Margin;
+	const float MaxY = (ChunkComponent->ChunkCell.Y + 1) * CellSize + Margin;
+
+	return WorldLocation.X < MinX || WorldLocation.X > MaxX ||
+		   WorldLocation.Y < MinY || WorldLocation.Y > MaxY;
+}
+
+/** Map a world location to its XY chunk cell. */
+FIntVector APhysXInstancedMeshActor::GetChunkCellForLocation(const FVector& WorldLocation) const
+{
+	const float CellSize = FMath::Max(ChunkCellSize, 100.0f);
+
+	return FIntVector(
+		FMath::FloorToInt(WorldLocation.X / CellSize),
+		FMath::FloorToInt(WorldLocation.Y / CellSize),
+		0);
+}
+
+/** Find or lazily create the chunk component for a spatial cell. */
+UPhysXInstancedStaticMeshComponent* APhysXInstancedMeshActor::GetOrCreateChunkForCell(const FIntVector& Cell)
+{
+	if (UPhysXInstancedStaticMeshComponent* const* Found = ChunkComponentsByCell.Find(Cell))
+	{
+		if (*Found)
+		{
+			return *Found;
+		}
+	}
+
+	const FName ChunkName = *FString::Printf(TEXT("InstancedMeshChunk_%d_%d"), Cell.X, Cell.Y);
+
+	UPhysXInstancedStaticMeshComponent* NewChunk = CreateRenderTierComponent(ChunkName);
+	if (!NewChunk)
+	{
+		return nullptr;
+	}
+
+	NewChunk->bIsSpatialChunk = true;
+	NewChunk->ChunkCell       = Cell;
+
+	ChunkComponents.Add(NewChunk);
+	ChunkComponentsByCell.Add(Cell, NewChunk);
+
+	return NewChunk;
+}
+
+/** Find or lazily create the sleeping-tier chunk for a spatial cell. */
+UPhysXInstancedStaticMeshComponent* APhysXInstancedMeshActor::GetOrCreateSleepingChunkForCell(const FIntVector& Cell)
+{
+	if (UPhysXInstancedStaticMeshComponent* const* Found = SleepingChunkComponentsByCell.Find(Cell))
+	{
+		if (*Found)
+		{
+			return *Found;
+		}
+	}
+
+	const FName ChunkName = *FString::Printf(TEXT("SleepingInstancedMeshChunk_%d_%d"), Cell.X, Cell.Y);
+
+	UPhysXInstancedStaticMeshComponent* NewChunk = CreateRenderTierComponent(ChunkName);
+	if (!NewChunk)
+	{
+		return nullptr;
+	}
+
+	NewChunk->bIsSpatialChunk = true;
+	NewChunk->bIsSleepingTier = true;
+	NewChunk->ChunkCell       = Cell;
+
+	// Listed with the other chunks so counts, material and shadow syncs cover it.
+	ChunkComponents.Add(NewChunk);
+	SleepingChunkComponentsByCell.Add(Cell, NewChunk);
+
+	return NewChunk;
+}
+
+/** Mirror the render state of InstancedMesh so tier switches are not visible; only storage mirrors collision. */
+void APhysXInstancedMeshActor::SyncRenderTierComponent(UInstancedStaticMeshComponent* TierComponent) const
+{
+	if (!TierComponent || !InstancedMesh || TierComponent == InstancedMesh)
+	{
+		return;
+	}
+
+	if (TierComponent->GetStaticMesh() != InstancedMesh->GetStaticMesh())
+	{
+		TierComponent->SetStaticMesh(InstancedMesh->GetStaticMesh());
+	}
+
+	const int32 NumSlots = InstancedMesh->GetNumMaterials();
+	for (int32 SlotIndex = 0; SlotIndex < NumSlots; ++SlotIndex)
+	{
+		TierComponent->SetMaterial(SlotIndex, InstancedMesh->GetMaterial(SlotIndex));
+	}
+
+	TierComponent->NumCustomDataFloats = InstancedMesh->NumCustomDataFloats;
+
+	// The no-shadow tier exists only to drop shadow casting; everything else mirrors InstancedMesh.
+	const bool bAllowShadow = (TierComponent != NoShadowInstancedMesh);
+
+	TierComponent->SetCastShadow(bAllowShadow && InstancedMesh->CastShadow);
+	TierComponent->bCastDynamicShadow = bAllowShadow && InstancedMesh->bCastDynamicShadow;
+	TierComponent->bCastStaticShadow  = bAllowShadow && InstancedMesh->bCastStaticShadow;
+
+	TierComponent->SetSimulatePhysics(false);
+	TierComponent->SetCollisionProfileName(InstancedMesh->GetCollisionProfileName());
+
+	// Storage instances have no PhysX body, so hierarchical storage collides through the component like InstancedMesh.
+	// Sleeping, no-shadow and chunk components hold instances whose PhysX bodies collide; engine bodies there would
+	// only double the collision and be rebuilt on every tier migration.
+	TierComponent->SetCollisionEnabled(TierComponent == StorageHierarchicalMesh
+		? InstancedMesh->GetCollisionEnabled()
+		: ECollisionEnabled::NoCollision);
+
+	if (UPhysXInstancedStaticMeshComponent* PhysXTier = Cast<UPhysXInstancedStaticMeshComponent>(TierComponent))
+	{
+		PhysXTier->SetInstancesAffectNavigation(InstancedMesh->GetInstancesAffectNavigation());
+	}
+	else if (UPhysXInstancedHierarchicalStaticMeshComponent* HierarchicalTier = Cast<UPhysXInstancedHierarchicalStaticMeshComponent>(TierComponent))
+	{
+		HierarchicalTier->SetInstancesAffectNavigation(InstancedMesh->GetInstancesAffectNavigation());
+	}
+}
+
+// ============================================================================
+// Material variants
+// ============================================================================
+
+/** Resolve override materials against the mesh materials, one entry per mesh slot. */
+void APhysXInstancedMeshActor::GetResolvedMaterials(TArray<UMaterialInterface*>& OutMaterials) const
+{
+	OutMaterials.Reset();
+
+	if (!InstanceStaticMesh)
+	{
+		return;
+	}
+
+	const int32 NumSlots = InstanceStaticMesh->GetStaticMaterials().Num();
+	OutMaterials.Reserve(NumSlots);
+
+	for (int32 SlotIndex = 0; SlotIndex < NumSlots; ++SlotIndex)
+	{
+		UMaterialInterface* Material = nullptr;
+
+		if (bOverrideInstanceMaterials && InstanceOverrideMaterials.IsValidIndex(SlotIndex))
+		{
+			Material = InstanceOverrideMaterials[SlotIndex];
+		}
+
+		if (!Material)
+		{
+			Material = InstanceStaticMesh->GetMaterial(SlotIndex);
+		}
+
+		OutMaterials.Add(Material);
+	}
+}
+
+/** Resolve a variant's materials against the mesh materials, one entry per mesh slot. */
+bool APhysXInstancedMeshActor::GetResolvedVariantMaterials(int32 Variant, TArray<UMaterialInterface*>& OutMaterials) const
+{
+	OutMaterials.Reset();
+
+	if (!InstanceStaticMesh || !MaterialVariants.IsValidIndex(Variant))
+	{
+		return false;
+	}
+
+	const TArray<UMaterialInterface*>& VariantMaterials = MaterialVariants[Variant].Materials;
+
+	const int32 NumSlots = InstanceStaticMesh->GetStaticMaterials().Num();
+	OutMaterials.Reserve(NumSlots);
+
+	for (int32 SlotIndex = 0; SlotIndex < NumSlots; ++SlotIndex)
+	{
+		UMaterialInterface* Material = VariantMaterials.IsValidIndex(SlotIndex) ? VariantMaterials[SlotIndex] : nullptr;
+
+		if (!Material)
+		{
+			Material = InstanceStaticMesh->GetMaterial(SlotIndex);
+		}
+
+		OutMaterials.Add(Material);
+	}
+
+	return true;
+}
+
+/** Linear search over the variant table (tables are small). */
+int32 APhysXInstancedMeshActor::FindMaterialVariant(const TArray<UMaterialInterface*>& Materials) const
+{
+	if (!UsesMaterialVariants())
+	{
+		return INDEX_NONE;
+	}
+
+	TArray<UMaterialInterface*> VariantMaterials;
+
+	for (int32 Variant = 0; Variant < MaterialVariants.Num(); ++Variant)
+	{
+		if (GetResolvedVariantMaterials(Variant, VariantMaterials) && VariantMaterials == Materials)
+		{
+			return Variant;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+/** Read the variant index back from PerInstanceCustomData. */
+int32 APhysXInstancedMeshActor::GetInstanceMaterialVariant(const UInstancedStaticMeshComponent* Component, int32 InstanceIndex) const
+{
+	if (!UsesMaterialVariants() || !Component || InstanceIndex < 0)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 NumFloats = Component->NumCustomDataFloats;
+	if (MaterialVariantCustomDataIndex < 0 || MaterialVariantCustomDataIndex >= NumFloats)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 DataIndex = InstanceIndex * NumFloats + MaterialVariantCustomDataIndex;
+	if (!Component->PerInstanceSMCustomData.IsValidIndex(DataIndex))
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 Variant = FMath::RoundToInt(Component->PerInstanceSMCustomData[DataIndex]);
+	return MaterialVariants.IsValidIndex(Variant) ? Variant : INDEX_NONE;
+}
+
+/** Resolve the materials an instance stands for (variant first, actor materials as fallback). */
+void APhysXInstancedMeshActor::GetInstanceResolvedMaterials(
+	const UInstancedStaticMeshComponent* Component,
+	int32 InstanceIndex,
+	TArray<UMaterialInterface*>& OutMaterials) const
+{
+	const int32 Variant = GetInstanceMaterialVariant(Component, InstanceIndex);
+
+	if (Variant == INDEX_NONE || !GetResolvedVariantMaterials(Variant, OutMaterials))
+	{
+		GetResolvedMaterials(OutMaterials);
+	}
+}
+
+/** Store the variant index as a float in PerInstanceCustomData. */
+bool APhysXInstancedMeshActor::SetInstanceMaterialVariant(UInstancedStaticMeshComponent* Component, int32 InstanceIndex, int32 Variant) const
+{
+	if (!Component || !MaterialVariants.IsValidIndex(Variant))
+	{
+		return false;
+	}
+
+	if (MaterialVariantCustomDataIndex < 0 || MaterialVariantCustomDataIndex >= Component->NumCustomDataFloats)
+	{
+		return false;
+	}
+
+	return Component->SetCustomDataValue(
+		InstanceIndex,
+		MaterialVariantCustomDataIndex,
+		static_cast<float>(Variant),
+		/*bMarkRenderStateDirty=*/true);
+}
+
+// ============================================================================
+// Hierarchical storage
+// ============================================================================
+
+/** Storage instances go to the hierarchical component when enabled, otherwise to InstancedMesh. */
+UInstancedStaticMeshComponent* APhysXInstancedMeshActor::GetStorageComponent()
+{
+	if (bUseHierarchicalStorage)
+	{
+		if (UPhysXInstancedHierarchicalStaticMeshComponent* Hierarchical = GetOrCreateStorageHierarchicalMesh())
+		{
+			return Hierarchical;
+		}
+	}
+
+	return InstancedMesh;
+}
+
+/** Create the hierarchical storage component next to InstancedMesh on first use. */
+UPhysXInstancedHierarchicalStaticMeshComponent* APhysXInstancedMeshActor::GetOrCreateStorageHierarchicalMesh()
+{
+	if (StorageHierarchicalMesh || !InstancedMesh)
+	{
+		return StorageHierarchicalMesh;
+	}
+
+	UPhysXInstancedHierarchicalStaticMeshComponent* Hierarchical =
+		NewObject<UPhysXInstancedHierarchicalStaticMeshComponent>(this, TEXT("StorageHierarchicalMesh"), RF_Transient);
+
+	if (!Hierarchical)
+	{
+		return nullptr;
+	}
+
+	Hierarchical->OwningPhysXActor = this;
+	Hierarchical->SetMobility(EComponentMobility::Movable);
+	Hierarchical->SetupAttachment(SceneRoot);
+	Hierarchical->SetRelativeTransform(InstancedMesh->GetRelativeTransform());
+
+	// Storage collision and navigation are configured on InstancedMesh; mirror them.
+	SyncRenderTierComponent(Hierarchical);
+
+	AddInstanceComponent(Hierarchical);
+	Hierarchical->RegisterComponent();
+
+	Hierarchical->SetInstancesAffectNavigation(bStorageInstancesAffectNavigation);
+
+	StorageHierarchicalMesh = Hierarchical;
+	return StorageHierarchicalMesh;
 }
 
 // ============================================================================
@@ -659,7 +1241,18 @@ void APhysXInstancedMeshActor::BuildAndRegisterInstances()
 	}
 	RegisteredInstanceIDs.Reset();
 
-	InstancedMesh->ClearInstances();
+	TArray<UPhysXInstancedStaticMeshComponent*> RenderComponents;
+	GetRenderComponents(RenderComponents);
+
+	for (UPhysXInstancedStaticMeshComponent* Component : RenderComponents)
+	{
+		Component->ClearInstances();
+	}
+
+	if (StorageHierarchicalMesh)
+	{
+		StorageHierarchicalMesh->ClearInstances();
+	}
 
 	// --------------------------------------------------------------------
 	// 2) Storage-only: create ISM instances only, no PhysX bodies.
@@ -667,48 +1260,102 @@ void APhysXInstancedMeshActor::BuildAndRegisterInstances()
 
 	if (bStorageOnly)
 	{
+		UInstancedStaticMeshComponent* StorageComponent = GetStorageComponent();
+
 		for (const FTransform& LocalTM : InstanceRelativeTransforms)
 		{
 			const FTransform WorldTM = LocalTM * GetActorTransform();
-			InstancedMesh->AddInstanceWorldSpace(WorldTM);
+			StorageComponent->AddInstanceWorldSpace(WorldTM);
+		}
+
+		// Initial fill: build the cluster tree once for the whole batch.
+		if (StorageHierarchicalMesh)
+		{
+			StorageHierarchicalMesh->FlushTreeRebuild(/*bAsync=*/true);
 		}
 
 		return;
 	}
 
 	// --------------------------------------------------------------------
-	// 3) Dynamic actor: create ISM instances and register them as a batch.
+	// 3) Dynamic actor: create ISM instances and register them as a batch
+	//    per render component (a single one unless chunking is enabled).
 	// --------------------------------------------------------------------
 
-	TArray<int32> IndicesToRegister;
-	IndicesToRegister.Reserve(InstanceRelativeTransforms.Num());
+	struct FComponentRegisterBatch
+	{
+		TArray<int32> InstanceIndices;
+		TArray<int32> GenerationOrder;
+	};
+
+	TMap<UPhysXInstancedStaticMeshComponent*, FComponentRegisterBatch> Batches;
+	int32 NumAdded = 0;
 
 	for (const FTransform& LocalTM : InstanceRelativeTransforms)
 	{
 		const FTransform WorldTM = LocalTM * GetActorTransform();
 
-		const int32 NewIndex = InstancedMesh->AddInstanceWorldSpace(WorldTM);
+		UPhysXInstancedStaticMeshComponent* TargetComponent = GetRenderComponentForLocation(WorldTM.GetLocation());
+		if (!TargetComponent)
+		{
+			continue;
+		}
+
+		const int32 NewIndex = TargetComponent->AddInstanceWorldSpace(WorldTM);
 		if (NewIndex == INDEX_NONE)
 		{
 			continue;
 		}
 
-		IndicesToRegister.Add(NewIndex);
+		FComponentRegisterBatch& Batch = Batches.FindOrAdd(TargetComponent);
+		Batch.InstanceIndices.Add(NewIndex);
+		Batch.GenerationOrder.Add(NumAdded++);
 	}
 
-	if (IndicesToRegister.Num() == 0)
+	if (NumAdded == 0)
 	{
 		return;
 	}
 
 	const bool bSimulate = bSimulateInstances;
 
-	// Batch registration fills RegisteredInstanceIDs in the same order as IndicesToRegister.
-	CachedSubsystem->RegisterInstancesBatch(
-		InstancedMesh,
-		IndicesToRegister,
-		bSimulate,
-		/*out*/ RegisteredInstanceIDs);
+	// Keep RegisteredInstanceIDs in generation order regardless of which chunk received the instance.
+	RegisteredInstanceIDs.SetNum(NumAdded);
+
+	TArray<FPhysXInstanceID> BatchIDs;
+
+	for (TPair<UPhysXInstancedStaticMeshComponent*, FComponentRegisterBatch>& Pair : Batches)
+	{
+		const FComponentRegisterBatch& Batch = Pair.Value;
+
+		// Batch registration fills BatchIDs in the same order as InstanceIndices.
+		if (bCreateBodiesAsync)
+		{
+			CachedSubsystem->RegisterInstancesBatchAsync(
+				Pair.Key,
+				Batch.InstanceIndices,
+				bSimulate,
+				/*out*/ BatchIDs,
+				FPhysXInstanceBodiesCreatedDelegate::CreateWeakLambda(this, [this](const TArray<FPhysXInstanceID>& CreatedIDs)
+				{
+					OnInstanceBodiesReady.Broadcast(CreatedIDs);
+				}));
+		}
+		else
+		{
+			CachedSubsystem->RegisterInstancesBatch(
+				Pair.Key,
+				Batch.InstanceIndices,
+				bSimulate,
+				/*out*/ BatchIDs);
+		}
+
+		for (int32 Index = 0; Index < Batch.GenerationOrder.Num(); ++Index)
+		{
+			RegisteredInstanceIDs[Batch.GenerationOrder[Index]] =
+				BatchIDs.IsValidIndex(Index) ? BatchIDs[Index] : FPhysXInstanceID();
+		}
+	}
 }
 
 // ============================================================================
@@ -1171,10 +1818,23 @@ void APhysXInstancedMeshActor::SpawnPhysicsInstancesFromActorBatch(
 // ID / count helpers
 // ============================================================================
 
-/** Return the number of visual ISM instances owned by this actor. */
+/**
+ * Return the number of visual ISM instances owned by this actor (all render components).
+ * Sums the per-component counts in place; this is polled per frame so it must not allocate.
+ */
 int32 APhysXInstancedMeshActor::GetInstanceCount() const
 {
-	return InstancedMesh ? InstancedMesh->GetInstanceCount() : 0;
+	int32 Count = StorageHierarchicalMesh ? StorageHierarchicalMesh->GetInstanceCount() : 0;
+	Count += InstancedMesh ? InstancedMesh->GetInstanceCount() : 0;
+	Count += SleepingInstancedMesh ? SleepingInstancedMesh->GetInstanceCount() : 0;
+	Count += NoShadowInstancedMesh ? NoShadowInstancedMesh->GetInstanceCount() : 0;
+
+	for (const UPhysXInstancedStaticMeshComponent* Chunk : ChunkComponents)
+	{
+		Count += Chunk ? Chunk->GetInstanceCount() : 0;
+	}
+
+	return Count;
 }
 
 /** Map ISM instance index to the corresponding subsystem instance handle. */
@@ -0,0 +1,206 @@
+﻿/**
+* Copyright (C) 2025 | Created by NordVader Inc.
+* All rights reserved!
+* My Discord Server: https://discord.gg/B8prpf3vzD
+*/
+
+#include "Async/PhysXInstancedAsyncQueryActions.h"
+
+#include "Subsystems/PhysXInstancedWorldSubsystem.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+// ============================================================================
+// Base
+// ============================================================================
+
+UPhysXInstancedWorldSubsystem* UPhysXInstanceAsyncQueryAction::GetQuerySubsystem() const
+{
+	UWorld* World = QueryWorld.Get();
+	return World ? World->GetSubsystem<UPhysXInstancedWorldSubsystem>() : nullptr;
+}
+
+void UPhysXInstanceAsyncQueryAction::InitQueryAction(UObject* WorldContextObject)
+{
+	QueryWorld = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : nullptr;
+	RegisterWithGameInstance(WorldContextObject);
+}
+
+// ============================================================================
+// Raycast
+// ============================================================================
+
+UPhysXInstanceAsyncRaycastAction* UPhysXInstanceAsyncRaycastAction::RaycastInstanceIDAsync(
+	UObject* WorldContextObject,
+	FVector Start,
+	FVector End,
+	bool bIncludeStorage,
+	ECollisionChannel TraceChannel)
+{
+	UPhysXInstanceAsyncRaycastAction* Action = NewObject<UPhysXInstanceAsyncRaycastAction>();
+	Action->Ray.Start     = Start;
+	Action->Ray.End       = End;
+	Action->bQueryStorage = bIncludeStorage;
+	Action->QueryChannel  = TraceChannel;
+	Action->InitQueryAction(WorldContextObject);
+	return Action;
+}
+
+void UPhysXInstanceAsyncRaycastAction::Activate()
+{
+	UPhysXInstancedWorldSubsystem* Subsystem = GetQuerySubsystem();
+	if (!Subsystem)
+	{
+		HandleCompleted(FPhysXInstanceQueryHit());
+		return;
+	}
+
+	TWeakObjectPtr<UPhysXInstanceAsyncRaycastAction> WeakThis(this);
+	Subsystem->RaycastInstanceIDAsync(Ray.Start, Ray.End, bQueryStorage, QueryChannel).Next([WeakThis](const FPhysXInstanceQueryHit& Hit)
+	{
+		if (UPhysXInstanceAsyncRaycastAction* Action = WeakThis.Get())
+		{
+			Action->HandleCompleted(Hit);
+		}
+	});
+}
+
+void UPhysXInstanceAsyncRaycastAction::HandleCompleted(const FPhysXInstanceQueryHit& Hit)
+{
+	Completed.Broadcast(Hit);
+	SetReadyToDestroy();
+}
+
+// ============================================================================
+// Sweep
+// ============================================================================
+
+UPhysXInstanceAsyncSweepAction* UPhysXInstanceAsyncSweepAction::SweepInstanceIDAsync(
+	UObject* WorldContextObject,
+	const FPhysXInstanceShapeQuery& Query,
+	bool bIncludeStorage,
+	ECollisionChannel TraceChannel)
+{
+	UPhysXInstanceAsyncSweepAction* Action = NewObject<UPhysXInstanceAsyncSweepAction>();
+	Action->ShapeQuery    = Query;
+	Action->bQueryStorage = bIncludeStorage;
+	Action->QueryChannel  = TraceChannel;
+	Action->InitQueryAction(WorldContextObject);
+	return Action;
+}
+
+void UPhysXInstanceAsyncSweepAction::Activate()
+{
+	UPhysXInstancedWorldSubsystem* Subsystem = GetQuerySubsystem();
+	if (!Subsystem)
+	{
+		HandleCompleted(FPhysXInstanceQueryHit());
+		return;
+	}
+
+	TWeakObjectPtr<UPhysXInstanceAsyncSweepAction> WeakThis(this);
+	Subsystem->SweepInstanceIDAsync(ShapeQuery, bQueryStorage, QueryChannel).Next([WeakThis](const FPhysXInstanceQueryHit& Hit)
+	{
+		if (UPhysXInstanceAsyncSweepAction* Action = WeakThis.Get())
+		{
+			Action->HandleCompleted(Hit);
+		}
+	});
+}
+
+void UPhysXInstanceAsyncSweepAction::HandleCompleted(const FPhysXInstanceQueryHit& Hit)
+{
+	Completed.Broadcast(Hit);
+	SetReadyToDestroy();
+}
+
+// ============================================================================
+// Overlap
+// ============================================================================
+
+UPhysXInstanceAsyncOverlapAction* UPhysXInstanceAsyncOverlapAction::OverlapInstanceIDsAsync(
+	UObject* WorldContextObject,
+	const FPhysXInstanceShapeQuery& Query,
+	bool bIncludeStorage,
+	ECollisionChannel TraceChannel)
+{
+	UPhysXInstanceAsyncOverlapAction* Action = NewObject<UPhysXInstanceAsyncOverlapAction>();
+	Action->ShapeQuery    = Query;
+	Action->bQueryStorage = bIncludeStorage;
+	Action->QueryChannel  = TraceChannel;
+	Action->InitQueryAction(WorldContextObject);
+	return Action;
+}
+
+void UPhysXInstanceAsyncOverlapAction::Activate()
+{
+	UPhysXInstancedWorldSubsystem* Subsystem = GetQuerySubsystem();
+	if (!Subsystem)
+	{
+		HandleCompleted(TArray<FPhysXInstanceID>());
+		return;
+	}
+
+	TWeakObjectPtr<UPhysXInstanceAsyncOverlapAction> WeakThis(this);
+	Subsystem->OverlapInstanceIDsAsync(ShapeQuery, bQueryStorage, QueryChannel).Next([WeakThis](const TArray<FPhysXInstanceID>& InstanceIDs)
+	{
+		if (UPhysXInstanceAsyncOverlapAction* Action = WeakThis.Get())
+		{
+			Action->HandleCompleted(InstanceIDs);
+		}
+	});
+}
+
+void UPhysXInstanceAsyncOverlapAction::HandleCompleted(const TArray<FPhysXInstanceID>& InstanceIDs)
+{
+	Completed.Broadcast(InstanceIDs);
+	SetReadyToDestroy();
+}
+
+// ============================================================================
+// K nearest
+// ============================================================================
+
+UPhysXInstanceAsyncNearestAction* UPhysXInstanceAsyncNearestAction::FindKNearestInstancesAsync(
+	UObject* WorldContextObject,
+	FVector WorldLocation,
+	int32 K,
+	FPhysXInstanceID IgnoreInstanceID,
+	bool bIncludeStorage,
+	float MaxDistance)
+{
+	UPhysXInstanceAsyncNearestAction* Action = NewObject<UPhysXInstanceAsyncNearestAction>();
+	Action->QueryLocation    = WorldLocation;
+	Action->QueryK           = K;
+	Action->QueryIgnoreID    = IgnoreInstanceID;
+	Action->bQueryStorage    = bIncludeStorage;
+	Action->QueryMaxDistance = MaxDistance;
+	Action->InitQueryAction(WorldContextObject);
+	return Action;
+}
+
+void UPhysXInstanceAsyncNearestAction::Activate()
+{
+	UPhysXInstancedWorldSubsystem* Subsystem = GetQuerySubsystem();
+	if (!Subsystem)
+	{
+		HandleCompleted(TArray<FPhysXInstanceNearestHit>());
+		return;
+	}
+
+	TWeakObjectPtr<UPhysXInstanceAsyncNearestAction> WeakThis(this);
+	Subsystem->FindKNearestInstancesAsync(QueryLocation, QueryK, QueryIgnoreID, bQueryStorage, QueryMaxDistance).Next([WeakThis](const TArray<FPhysXInstanceNearestHit>& Hits)
+	{
+		if (UPhysXInstanceAsyncNearestAction* Action = WeakThis.Get())
+		{
+			Action->HandleCompleted(Hits);
+		}
+	});
+}
+
+void UPhysXInstanceAsyncNearestAction::HandleCompleted(const TArray<FPhysXInstanceNearestHit>& Hits)
+{
+	Completed.Broadcast(Hits);
+	SetReadyToDestroy();
+}
@@ -0,0 +1,122 @@
+﻿/**
+* Copyright (C) 2025 | Created by NordVader Inc.
+* All rights reserved!
+* My Discord Server: https://discord.gg/B8prpf3vzD
+*/
+
+#include "Components/PhysXInstancedHierarchicalStaticMeshComponent.h"
+#include "Actors/PhysXInstancedMeshActor.h"
+
+#include "Engine/World.h"
+#include "NavigationSystem.h"
+
+// ============================================================================
+// UPhysXInstancedHierarchicalStaticMeshComponent
+// ============================================================================
+
+UPhysXInstancedHierarchicalStaticMeshComponent::UPhysXInstancedHierarchicalStaticMeshComponent(
+	const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	// Storage instances never simulate; collision is configured by the owning actor.
+	BodyInstance.bSimulatePhysics = false;
+
+	// Keep custom data layout identical to the dynamic component.
+	NumCustomDataFloats = 4;
+
+	// Tree rebuilds are batched by the world subsystem instead of running on every add/remove.
+	bAutoRebuildTreeOnInstanceChanges = false;
+
+	// Navigation updates are disabled by default for performance.
+	bInstancesAffectNavigation = false;
+	SetCanEverAffectNavigation(false);
+}
+
+// ============================================================================
+// Navigation
+// ============================================================================
+
+void UPhysXInstancedHierarchicalStaticMeshComponent::SetInstancesAffectNavigation(bool bNewValue)
+{
+	if (bInstancesAffectNavigation == bNewValue)
+	{
+		return;
+	}
+
+	bInstancesAffectNavigation = bNewValue;
+
+	// Enable/disable nav-relevance for this component.
+	SetCanEverAffectNavigation(bInstancesAffectNavigation);
+
+	// Request a nav-octree update for this component when the navigation system is available.
+	if (GetWorld() && FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		UNavigationSystemV1::UpdateComponentInNavOctree(*this);
+	}
+}
+
+void UPhysXInstancedHierarchicalStaticMeshComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	// Cache owning actor pointer if it was not provided explicitly.
+	if (!OwningPhysXActor)
+	{
+		OwningPhysXActor = Cast<APhysXInstancedMeshActor>(GetOwner());
+	}
+
+	// Storage components follow the storage navigation setting of the owning actor.
+	if (OwningPhysXActor)
+	{
+		SetInstancesAffectNavigation(OwningPhysXActor->bStorageInstancesAffectNavigation);
+	}
+}
+
+void UPhysXInstancedHierarchicalStaticMeshComponent::OnUnregister()
+{
+	Super::OnUnregister();
+
+	// Clear cached owner pointer when it matches the current owner.
+	if (OwningPhysXActor == GetOwner())
+	{
+		OwningPhysXActor = nullptr;
+	}
+}
+
+void UPhysXInstancedHierarchicalStaticMeshComponent::PartialNavigationUpdate(int32 InstanceIndex)
+{
+	if (!bInstancesAffectNavigation)
+	{
+		return;
+	}
+
+	Super::PartialNavigationUpdate(InstanceIndex);
+}
+
+// ============================================================================
+// Deferred cluster tree
+// ============================================================================
+
+void UPhysXInstancedHierarchicalStaticMeshComponent::NotifyInstancesChanged(int32 NumChanges, double CurrentTime)
+{
+	if (NumChanges <= 0)
+	{
+		return;
+	}
+
+	if (PendingTreeChanges == 0)
+	{
+		FirstPendingChangeTime = CurrentTime;
+	}
+
+	PendingTreeChanges += NumChanges;
+}
+
+void UPhysXInstancedHierarchicalStaticMeshComponent::FlushTreeRebuild(bool bAsync)
+{
+	PendingTreeChanges     = 0;
+	FirstPendingChangeTime = 0.0;
+
+	// Unbuilt instances are still rendered until the new tree lands.
+	BuildTreeIfOutdated(bAsync, /*bForceUpdate=*/false);
+}
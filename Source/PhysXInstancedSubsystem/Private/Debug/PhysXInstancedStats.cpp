@@ -42,6 +42,56 @@ DEFINE_STAT(STAT_PhysXInstanced_AsyncParallel);
 DEFINE_STAT(STAT_PhysXInstanced_AsyncApply);
 DEFINE_STAT(STAT_PhysXInstanced_JobsPerFrame);
 
+// --- Render tiers -----------------------------------------------------------
+
+DEFINE_STAT(STAT_PhysXInstanced_RenderTierMigrate);
+DEFINE_STAT(STAT_PhysXInstanced_RenderTierMigrations);
+DEFINE_STAT(STAT_PhysXInstanced_RenderTierPending);
+
+// --- Storage trees ----------------------------------------------------------
+
+DEFINE_STAT(STAT_PhysXInstanced_StorageTreeRebuild);
+DEFINE_STAT(STAT_PhysXInstanced_StorageTreeRebuilds);
+DEFINE_STAT(STAT_PhysXInstanced_StorageTreePending);
+DEFINE_STAT(STAT_PhysXInstanced_StorageBVHQuery);
+DEFINE_STAT(STAT_PhysXInstanced_StorageBVHRebuild);
+DEFINE_STAT(STAT_PhysXInstanced_StorageBVHLeaves);
+
+// --- Shared shapes ----------------------------------------------------------
+
+DEFINE_STAT(STAT_PhysXInstanced_SharedShapes);
+DEFINE_STAT(STAT_PhysXInstanced_PooledBodies);
+
+// --- Scene insertion --------------------------------------------------------
+
+DEFINE_STAT(STAT_PhysXInstanced_SceneAddBatch);
+DEFINE_STAT(STAT_PhysXInstanced_SceneAddedActors);
+DEFINE_STAT(STAT_PhysXInstanced_SceneRemoveBatch);
+DEFINE_STAT(STAT_PhysXInstanced_SceneRemovedActors);
+
+// --- Async body creation ---------------------------------------------------
+
+DEFINE_STAT(STAT_PhysXInstanced_AsyncCreateFinalize);
+DEFINE_STAT(STAT_PhysXInstanced_AsyncCreateBacklog);
+
+// --- Runtime collision cooking ---------------------------------------------
+
+DEFINE_STAT(STAT_PhysXInstanced_CookedShapeSwap);
+DEFINE_STAT(STAT_PhysXInstanced_CookedShapesPending);
+
+// --- Spatial hash -----------------------------------------------------------
+
+DEFINE_STAT(STAT_PhysXInstanced_SpatialHashQuery);
+DEFINE_STAT(STAT_PhysXInstanced_SelectionQuery);
+DEFINE_STAT(STAT_PhysXInstanced_SpatialHashCells);
+
+// --- Batched queries --------------------------------------------------------
+
+DEFINE_STAT(STAT_PhysXInstanced_BatchQuery);
+DEFINE_STAT(STAT_PhysXInstanced_BatchQueryCount);
+DEFINE_STAT(STAT_PhysXInstanced_AsyncQueries);
+DEFINE_STAT(STAT_PhysXInstanced_AsyncQueryCount);
+
 // --- World-level counters ---------------------------------------------------
 
 DEFINE_STAT(STAT_PhysXInstanced_InstancesTotal);
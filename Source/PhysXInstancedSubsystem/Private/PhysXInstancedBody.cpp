@@ -5,8 +5,11 @@
 */
 
 #include "PhysXInstancedBody.h"
+#include "PhysXInstancedShapeCache.h"
+#include "PhysXInstancedCookedMeshCache.h"
 #include "Debug/PhysXInstancedStats.h"
 #include "Actors/PhysXInstancedMeshActor.h"
+#include "Types/PhysXInstanceArchetype.h"
 
 #if PHYSICS_INTERFACE_PHYSX
 
@@ -16,9 +19,12 @@
 #include "Engine/StaticMesh.h"
 #include "Engine/World.h"
 #include "GameFramework/Actor.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/ObjectKey.h"
 
 #include "PhysicsEngine/BodyInstance.h"
 #include "PhysicsEngine/BodySetup.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
 #include "PhysicsEngine/BoxElem.h"
 #include "PhysicsEngine/SphereElem.h"
 #include "PhysicsEngine/SphylElem.h"
@@ -44,9 +50,38 @@ DEFINE_LOG_CATEGORY_STATIC(LogPhysXInstanced, Log, All);
 // FPhysXInstanceBody lifetime
 // -----------------------------------------------------------------------------
 
+namespace
+{
+	/** Park an out-of-scene actor in its shape pool or release it, then clear the body's pointers. */
+	void ReleaseDetachedBody(FPhysXInstanceBody& Body)
+	{
+		// A parked actor keeps its shared shape reference until it is reused or trimmed.
+		const bool bRecycled = Body.SharedShape && Body.OwningShapeCache
+			&& Body.OwningShapeCache->RecycleActor(*Body.PxBody, Body.SharedShape);
+
+		if (!bRecycled)
+		{
+			Body.PxBody->release();
+
+			// Drop the shared shape reference after the actor detached from it.
+			if (Body.SharedShape && Body.OwningShapeCache)
+			{
+				Body.OwningShapeCache->Release(Body.SharedShape);
+			}
+		}
+
+		Body.PxBody = nullptr;
+
+		Body.SharedShape      = nullptr;
+		Body.OwningShapeCache = nullptr;
+		Body.bUsesProxyShape    = false;
+		Body.ProxyCookBodySetup = nullptr;
+	}
+}
+
 void FPhysXInstanceBody::Destroy()
 {
-	// Removes the actor from its scene (if any) and releases the PhysX object.
+	// Removes the actor from its scene (if any), then parks it in the shape pool or releases it.
 	if (!PxBody)
 	{
 		return;
@@ -58,8 +93,59 @@ void FPhysXInstanceBody::Destroy()
 		Scene->removeActor(*PxBody);
 	}
 
-	PxBody->release();
-	PxBody = nullptr;
+	ReleaseDetachedBody(*this);
+}
+
+void FPhysXInstanceBody::DestroyBatch(const TArray<FPhysXInstanceBody*>& Bodies, bool bWakeOnLostTouch)
+{
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_SceneRemoveBatch);
+
+	// Group actors by scene. Instances of one world share a scene, so this is almost always one group.
+	struct FSceneGroup
+	{
+		PxScene* Scene = nullptr;
+		TArray<PxActor*> Actors;
+	};
+	TArray<FSceneGroup, TInlineAllocator<1>> Groups;
+
+	for (FPhysXInstanceBody* Body : Bodies)
+	{
+		if (!Body || !Body->PxBody)
+		{
+			continue;
+		}
+
+		PxScene* Scene = Body->PxBody->getScene();
+		if (!Scene)
+		{
+			continue;
+		}
+
+		FSceneGroup* Group = Groups.FindByPredicate([Scene](const FSceneGroup& G) { return G.Scene == Scene; });
+		if (!Group)
+		{
+			Group = &Groups.AddDefaulted_GetRef();
+			Group->Scene = Scene;
+			Group->Actors.Reserve(Bodies.Num());
+		}
+
+		Group->Actors.Add(Body->PxBody);
+	}
+
+	for (FSceneGroup& Group : Groups)
+	{
+		Group.Scene->removeActors(Group.Actors.GetData(), (PxU32)Group.Actors.Num(), bWakeOnLostTouch);
+		INC_DWORD_STAT_BY(STAT_PhysXInstanced_SceneRemovedActors, Group.Actors.Num());
+	}
+
+	// Every actor is out of its scene now; release or recycle without further scene locking.
+	for (FPhysXInstanceBody* Body : Bodies)
+	{
+		if (Body && Body->PxBody)
+		{
+			ReleaseDetachedBody(*Body);
+		}
+	}
 }
 
 void FPhysXInstanceBody::AddActorToScene(UWorld* World)
@@ -90,16 +176,11 @@ void FPhysXInstanceBody::AddActorToScene(UWorld* World)
 
 namespace
 {
-	PxTransform MakePxTransformForInstance(UInstancedStaticMeshComponent* InstancedMesh, int32 InstanceIndex)
+	FTransform GetInstanceLocalTransform(UInstancedStaticMeshComponent* InstancedMesh, int32 InstanceIndex)
 	{
-		const FTransform ComponentTM = InstancedMesh->GetComponentTransform();
-
-		const FTransform InstanceLocalTM = InstancedMesh->PerInstanceSMData.IsValidIndex(InstanceIndex)
+		return InstancedMesh->PerInstanceSMData.IsValidIndex(InstanceIndex)
 			? FTransform(InstancedMesh->PerInstanceSMData[InstanceIndex].Transform)
 			: FTransform::Identity;
-
-		const FTransform WorldTM = InstanceLocalTM * ComponentTM;
-		return U2PTransform(WorldTM);
 	}
 
 	UBodySetup* GetCollisionBodySetup(UInstancedStaticMeshComponent* InstancedMesh, UStaticMesh* OverrideMesh)
@@ -117,86 +198,172 @@ namespace
 		return nullptr;
 	}
 
-	// Builds a box geometry from the static mesh bounds and instance/component scale.
-	PxBoxGeometry MakeBoxGeometryForInstance(
-		UInstancedStaticMeshComponent* InstancedMesh,
-		int32 InstanceIndex,
-		PxVec3& OutLocalCenter)
+	// -------------------------------------------------------------------------
+	// Fitted primitive cache
+	// -------------------------------------------------------------------------
+
+	// Object keys carry the GC serial number, so a recycled address never aliases a destroyed mesh.
+	struct FPrimitiveFitKey
 	{
-		OutLocalCenter = PxVec3(0.f);
+		FObjectKey StaticMesh;
+		FObjectKey CollisionBodySetup;
 
-		if (!InstancedMesh)
+		bool operator==(const FPrimitiveFitKey& Other) const
 		{
-			return PxBoxGeometry(PxVec3(1.f));
+			return StaticMesh == Other.StaticMesh && CollisionBodySetup == Other.CollisionBodySetup;
+		}
+
+		friend uint32 GetTypeHash(const FPrimitiveFitKey& Key)
+		{
+			return HashCombine(::GetTypeHash(Key.StaticMesh), ::GetTypeHash(Key.CollisionBodySetup));
+		}
+	};
+
+	// Shared by every world; bodies may be created from ParallelFor workers. Pruned by PrunePrimitiveFits().
+	TMap<FPrimitiveFitKey, FPhysXInstancePrimitiveFit> GPrimitiveFits;
+	FRWLock GPrimitiveFitsLock;
+
+	FGuid GetBodySetupGuid(const UBodySetup* BodySetup)
+	{
+		return BodySetup ? BodySetup->BodySetupGuid : FGuid();
+	}
+
+	// Index of the largest component (ties resolve to the lower axis, matching the original fit).
+	int32 PickMajorAxis(const FVector& AbsExtents)
+	{
+		int32 MajorAxis  = 0;
+		float MajorValue = AbsExtents.X;
+
+		if (AbsExtents.Y > MajorValue)
+		{
+			MajorAxis  = 1;
+			MajorValue = AbsExtents.Y;
+		}
+		if (AbsExtents.Z > MajorValue)
+		{
+			MajorAxis = 2;
 		}
 
-		const UStaticMesh* StaticMesh = InstancedMesh->GetStaticMesh();
+		return MajorAxis;
+	}
+
+	FPhysXInstancePrimitiveFit BuildPrimitiveFit(const UStaticMesh* StaticMesh, const UBodySetup* CollisionBodySetup)
+	{
+		FPhysXInstancePrimitiveFit Fit;
+
+		const UBodySetup* MeshBodySetup = StaticMesh ? StaticMesh->GetBodySetup() : nullptr;
+
+		Fit.MeshBodySetupGuid      = GetBodySetupGuid(MeshBodySetup);
+		Fit.CollisionBodySetupGuid = GetBodySetupGuid(CollisionBodySetup);
+
 		if (!StaticMesh)
 		{
-			return PxBoxGeometry(PxVec3(1.f));
+			return Fit;
 		}
 
 		const FBoxSphereBounds MeshBounds = StaticMesh->GetBounds();
 
-		FVector TotalScale = InstancedMesh->GetComponentTransform().GetScale3D();
-		if (InstancedMesh->PerInstanceSMData.IsValidIndex(InstanceIndex))
+		Fit.bHasMesh           = true;
+		Fit.BoundsOrigin       = MeshBounds.Origin;
+		Fit.BoundsExtent       = MeshBounds.BoxExtent;
+		Fit.BoundsSphereRadius = MeshBounds.SphereRadius;
+		Fit.BoundsMajorAxis    = PickMajorAxis(MeshBounds.BoxExtent.GetAbs());
+
+		if (CollisionBodySetup && CollisionBodySetup->AggGeom.SphereElems.Num() > 0)
 		{
-			const FTransform InstanceLocalTM(InstancedMesh->PerInstanceSMData[InstanceIndex].Transform);
-			TotalScale *= InstanceLocalTM.GetScale3D();
+			const FKSphereElem& Sphere = CollisionBodySetup->AggGeom.SphereElems[0];
+
+			Fit.bHasSphere   = true;
+			Fit.SphereCenter = Sphere.Center;
+			Fit.SphereRadius = Sphere.Radius;
 		}
 
-		const FVector HalfSizeUU = MeshBounds.BoxExtent * TotalScale;
-		const FVector CenterUU   = MeshBounds.Origin   * TotalScale;
+		if (MeshBodySetup && MeshBodySetup->AggGeom.SphylElems.Num() > 0)
+		{
+			const FKSphylElem& Sphyl = MeshBodySetup->AggGeom.SphylElems[0];
 
-		OutLocalCenter = U2PVector(CenterUU);
-		return PxBoxGeometry(U2PVector(HalfSizeUU));
+			Fit.bHasSphyl     = true;
+			Fit.SphylCenter   = Sphyl.Center;
+			Fit.SphylRotation = Sphyl.Rotation.Quaternion();
+			Fit.SphylRadius   = Sphyl.Radius;
+			Fit.SphylLength   = Sphyl.Length;
+		}
+
+		return Fit;
 	}
 
-	// Builds a sphere geometry from either BodySetup sphere data or the static mesh bounds.
-	PxSphereGeometry MakeSphereGeometryForInstance(
-		UBodySetup* BodySetup,
-		UInstancedStaticMeshComponent* InstancedMesh,
-		int32 InstanceIndex,
+	// Returns the cached fit for a mesh, rebuilding it when either body setup changed since it was computed.
+	FPhysXInstancePrimitiveFit FindOrBuildPrimitiveFit(const UStaticMesh* StaticMesh, const UBodySetup* CollisionBodySetup)
+	{
+		const FPrimitiveFitKey Key{ FObjectKey(StaticMesh), FObjectKey(CollisionBodySetup) };
+
+		const FGuid MeshGuid      = GetBodySetupGuid(StaticMesh ? StaticMesh->GetBodySetup() : nullptr);
+		const FGuid CollisionGuid = GetBodySetupGuid(CollisionBodySetup);
+
+		{
+			FReadScopeLock ReadLock(GPrimitiveFitsLock);
+
+			const FPhysXInstancePrimitiveFit* Cached = GPrimitiveFits.Find(Key);
+			if (Cached && Cached->MeshBodySetupGuid == MeshGuid && Cached->CollisionBodySetupGuid == CollisionGuid)
+			{
+				return *Cached;
+			}
+		}
+
+		const FPhysXInstancePrimitiveFit Fit = BuildPrimitiveFit(StaticMesh, CollisionBodySetup);
+
+		FWriteScopeLock WriteLock(GPrimitiveFitsLock);
+		GPrimitiveFits.Add(Key, Fit);
+		return Fit;
+	}
+
+	// Builds a box geometry from the cached mesh bounds and the given total scale.
+	PxBoxGeometry MakeBoxGeometryForInstance(
+		const FPhysXInstancePrimitiveFit& Fit,
+		const FVector& TotalScale,
 		PxVec3& OutLocalCenter)
 	{
 		OutLocalCenter = PxVec3(0.f);
 
-		if (!InstancedMesh)
+		if (!Fit.bHasMesh)
 		{
-			return PxSphereGeometry(U2PScalar(50.f));
+			return PxBoxGeometry(PxVec3(1.f));
 		}
 
-		const UStaticMesh* StaticMesh = InstancedMesh->GetStaticMesh();
-		if (!StaticMesh)
+		const FVector HalfSizeUU = Fit.BoundsExtent * TotalScale;
+		const FVector CenterUU   = Fit.BoundsOrigin * TotalScale;
+
+		OutLocalCenter = U2PVector(CenterUU);
+		return PxBoxGeometry(U2PVector(HalfSizeUU));
+	}
+
+	// Builds a sphere geometry from either the cached BodySetup sphere or the mesh bounds.
+	PxSphereGeometry MakeSphereGeometryForInstance(
+		const FPhysXInstancePrimitiveFit& Fit,
+		const FVector& TotalScale,
+		PxVec3& OutLocalCenter)
+	{
+		OutLocalCenter = PxVec3(0.f);
+
+		if (!Fit.bHasMesh)
 		{
 			return PxSphereGeometry(U2PScalar(50.f));
 		}
 
-		FVector TotalScale = InstancedMesh->GetComponentTransform().GetScale3D();
-		if (InstancedMesh->PerInstanceSMData.IsValidIndex(InstanceIndex))
-		{
-			const FTransform InstanceLocalTM(InstancedMesh->PerInstanceSMData[InstanceIndex].Transform);
-			TotalScale *= InstanceLocalTM.GetScale3D();
-		}
+		const float MaxScale = TotalScale.GetAbsMax();
 
 		float   RadiusUU = 0.f;
 		FVector CenterUU = FVector::ZeroVector;
 
-		if (BodySetup && BodySetup->AggGeom.SphereElems.Num() > 0)
+		if (Fit.bHasSphere)
 		{
-			const FKSphereElem& Sphere = BodySetup->AggGeom.SphereElems[0];
-			const float MaxScale = TotalScale.GetAbsMax();
-
-			RadiusUU = Sphere.Radius * MaxScale;
-			CenterUU = Sphere.Center * TotalScale;
+			RadiusUU = Fit.SphereRadius * MaxScale;
+			CenterUU = Fit.SphereCenter * TotalScale;
 		}
 		else
 		{
-			const FBoxSphereBounds MeshBounds = StaticMesh->GetBounds();
-			const float MaxScale = TotalScale.GetAbsMax();
-
-			RadiusUU = MeshBounds.SphereRadius * MaxScale;
-			CenterUU = MeshBounds.Origin * TotalScale;
+			RadiusUU = Fit.BoundsSphereRadius * MaxScale;
+			CenterUU = Fit.BoundsOrigin * TotalScale;
 		}
 
 		if (RadiusUU <= KINDA_SMALL_NUMBER)
@@ -208,110 +375,68 @@ namespace
 		return PxSphereGeometry(U2PScalar(RadiusUU));
 	}
 
-	// Builds a capsule geometry fitted to the mesh bounds or BodySetup sphyl data.
-	// Outputs the local center and the selected major axis index (0=X, 1=Y, 2=Z).
+	// Builds a capsule geometry from the cached BodySetup sphyl, or fits one to the mesh bounds.
+	// Outputs the local center and the local rotation that maps the PhysX capsule axis (X) onto the fitted axis.
 	PxCapsuleGeometry MakeCapsuleGeometryForInstance(
-		UInstancedStaticMeshComponent* InstancedMesh,
-		int32 InstanceIndex,
+		const FPhysXInstancePrimitiveFit& Fit,
+		const FVector& TotalScale,
 		PxVec3& OutLocalCenter,
-		int32& OutMajorAxisIndex)
+		FQuat& OutLocalRotation)
 	{
-		OutLocalCenter    = PxVec3(0.f);
-		OutMajorAxisIndex = 2;
-
-		if (!InstancedMesh)
-		{
-			return PxCapsuleGeometry(PxReal(1.f), PxReal(1.f));
-		}
-
-		const UStaticMesh* StaticMesh = InstancedMesh->GetStaticMesh();
-		if (!StaticMesh)
-		{
-			return PxCapsuleGeometry(PxReal(1.f), PxReal(1.f));
-		}
-
-		UBodySetup* BodySetup = StaticMesh->GetBodySetup();
-
-		FVector TotalScale = InstancedMesh->GetComponentTransform().GetScale3D();
-		if (InstancedMesh->PerInstanceSMData.IsValidIndex(InstanceIndex))
-		{
-			const FTransform InstanceLocalTM(InstancedMesh->PerInstanceSMData[InstanceIndex].Transform);
-			TotalScale *= InstanceLocalTM.GetScale3D();
-		}
+		OutLocalCenter   = PxVec3(0.f);
+		OutLocalRotation = FQuat::Identity;
 
 		// 1) Prefer a simple capsule (sphyl) from the mesh BodySetup.
-		if (BodySetup && BodySetup->AggGeom.SphylElems.Num() > 0)
+		if (Fit.bHasSphyl)
 		{
-			const FKSphylElem& Sphyl = BodySetup->AggGeom.SphylElems[0];
 			const float MaxScale = TotalScale.GetAbsMax();
 
-			float RadiusUU     = FMath::Max(Sphyl.Radius * MaxScale, KINDA_SMALL_NUMBER);
-			float HalfHeightUU = 0.5f * Sphyl.Length * MaxScale;
-
-			if (HalfHeightUU <= KINDA_SMALL_NUMBER)
-			{
-				HalfHeightUU = RadiusUU * 0.5f;
-			}
-
-			const FVector CenterUU = Sphyl.Center * TotalScale;
-			OutLocalCenter = U2PVector(CenterUU);
+			const float RadiusUU     = FMath::Max(Fit.SphylRadius * MaxScale, KINDA_SMALL_NUMBER);
+			const float HalfHeightUU = FMath::Max(0.5f * Fit.SphylLength * MaxScale, RadiusUU * 0.5f);
 
-			const FVector AxisLocal = Sphyl.Rotation.RotateVector(FVector::XAxisVector).GetSafeNormal();
-			const FVector AbsAxis   = AxisLocal.GetAbs();
+			OutLocalCenter = U2PVector(Fit.SphylCenter * TotalScale);
 
-			if (AbsAxis.X >= AbsAxis.Y && AbsAxis.X >= AbsAxis.Z)
-			{
-				OutMajorAxisIndex = 0;
-			}
-			else if (AbsAxis.Y >= AbsAxis.Z)
-			{
-				OutMajorAxisIndex = 1;
-			}
-			else
-			{
-				OutMajorAxisIndex = 2;
-			}
+			// Sphyl rotation already describes the capsule axis in mesh local space.
+			OutLocalRotation = Fit.SphylRotation;
 
-			return PxCapsuleGeometry(
-				U2PScalar(RadiusUU),
-				U2PScalar(HalfHeightUU));
+			return PxCapsuleGeometry(U2PScalar(RadiusUU), U2PScalar(HalfHeightUU));
 		}
 
 		// 2) Fallback: fit a capsule to the mesh bounds and align along the major axis.
-		const FBoxSphereBounds MeshBounds = StaticMesh->GetBounds();
+		if (!Fit.bHasMesh)
+		{
+			// Invalid geometry; the caller falls back to its default box.
+			return PxCapsuleGeometry(PxReal(0.f), PxReal(0.f));
+		}
 
-		const FVector ExtentsUU = MeshBounds.BoxExtent * TotalScale;
-		const FVector AbsExt    = ExtentsUU.GetAbs();
+		const FVector AbsExt = (Fit.BoundsExtent * TotalScale).GetAbs();
 
-		float MajorExtent = AbsExt.X;
-		OutMajorAxisIndex = 0;
+		const bool bUniformScale =
+			FMath::IsNearlyEqual(FMath::Abs(TotalScale.X), FMath::Abs(TotalScale.Y)) &&
+			FMath::IsNearlyEqual(FMath::Abs(TotalScale.X), FMath::Abs(TotalScale.Z));
 
-		if (AbsExt.Y > MajorExtent)
-		{
-			MajorExtent       = AbsExt.Y;
-			OutMajorAxisIndex = 1;
-		}
-		if (AbsExt.Z > MajorExtent)
-		{
-			MajorExtent       = AbsExt.Z;
-			OutMajorAxisIndex = 2;
-		}
+		const int32 MajorAxis = bUniformScale ? Fit.BoundsMajorAxis : PickMajorAxis(AbsExt);
 
-		float RadExtent = 0.f;
-		if (OutMajorAxisIndex == 0)
+		float MajorExtent = 0.f;
+		float RadExtent   = 0.f;
+
+		if (MajorAxis == 0)
 		{
-			RadExtent = FMath::Max(AbsExt.Y, AbsExt.Z);
+			MajorExtent = AbsExt.X;
+			RadExtent   = FMath::Max(AbsExt.Y, AbsExt.Z);
 		}
-		else if (OutMajorAxisIndex == 1)
+		else if (MajorAxis == 1)
 		{
-			RadExtent = FMath::Max(AbsExt.X, AbsExt.Z);
+			MajorExtent = AbsExt.Y;
+			RadExtent   = FMath::Max(AbsExt.X, AbsExt.Z);
 		}
 		else
 		{
-			RadExtent = FMath::Max(AbsExt.X, AbsExt.Y);
+			MajorExtent = AbsExt.Z;
+			RadExtent   = FMath::Max(AbsExt.X, AbsExt.Y);
 		}
 
-		float RadiusUU = FMath::Max(RadExtent, KINDA_SMALL_NUMBER);
+		const float RadiusUU = FMath::Max(RadExtent, KINDA_SMALL_NUMBER);
 
 		// Ensures that (HalfHeight + Radius) approximately matches the major extent.
 		float HalfHeightUU = MajorExtent - RadiusUU;
@@ -320,56 +445,109 @@ namespace
 			HalfHeightUU = RadiusUU * 0.5f;
 		}
 
-		const FVector CenterUU = MeshBounds.Origin * TotalScale;
-		OutLocalCenter = U2PVector(CenterUU);
+		OutLocalCenter = U2PVector(Fit.BoundsOrigin * TotalScale);
+
+		const FVector DesiredAxis =
+			(MajorAxis == 0) ? FVector::XAxisVector :
+			(MajorAxis == 1) ? FVector::YAxisVector :
+							   FVector::ZAxisVector;
+
+		OutLocalRotation = FQuat::FindBetweenNormals(FVector::XAxisVector, DesiredAxis);
 
 		return PxCapsuleGeometry(
 			U2PScalar(RadiusUU),
 			U2PScalar(HalfHeightUU));
 	}
 
-	PxConvexMeshGeometry MakeConvexGeometry(UBodySetup* BodySetup, UInstancedStaticMeshComponent* InstancedMesh)
+	PxConvexMeshGeometry MakeConvexGeometry(PxConvexMesh* ConvexMesh, const FVector& ComponentScale)
 	{
-		if (!BodySetup || BodySetup->AggGeom.ConvexElems.Num() == 0)
+		if (!ConvexMesh)
 		{
 			return PxConvexMeshGeometry();
 		}
 
-		const FKConvexElem& Convex = BodySetup->AggGeom.ConvexElems[0];
+		const PxVec3 PxScale = U2PVector(ComponentScale);
+		const PxMeshScale MeshScale(PxScale, PxQuat(PxIdentity));
+
+		return PxConvexMeshGeometry(ConvexMesh, MeshScale);
+	}
 
-		if (!Convex.GetConvexMesh())
+	PxTriangleMeshGeometry MakeTriangleMeshGeometry(PxTriangleMesh* TriMesh, const FVector& ComponentScale)
+	{
+		if (!TriMesh)
 		{
-			return PxConvexMeshGeometry();
+			return PxTriangleMeshGeometry();
 		}
 
-		const FVector ComponentScale = InstancedMesh->GetComponentScale();
 		const PxVec3 PxScale = U2PVector(ComponentScale);
 		const PxMeshScale MeshScale(PxScale, PxQuat(PxIdentity));
 
-		return PxConvexMeshGeometry(Convex.GetConvexMesh(), MeshScale);
+		return PxTriangleMeshGeometry(TriMesh, MeshScale);
 	}
 
-	PxTriangleMeshGeometry MakeTriangleMeshGeometry(UBodySetup* BodySetup, UInstancedStaticMeshComponent* InstancedMesh)
+	/** Cooked convex from the body setup, else from the runtime cook cache (bOutPending while it cooks). */
+	PxConvexMesh* ResolveConvexMesh(UBodySetup* BodySetup, bool& bOutPending)
 	{
-		if (!BodySetup || BodySetup->TriMeshes.Num() == 0)
+		bOutPending = false;
+
+		if (!BodySetup)
 		{
-			return PxTriangleMeshGeometry();
+			return nullptr;
 		}
 
-		PxTriangleMesh* TriMesh = BodySetup->TriMeshes[0];
-		if (!TriMesh)
+		if (BodySetup->AggGeom.ConvexElems.Num() > 0 && BodySetup->AggGeom.ConvexElems[0].GetConvexMesh())
 		{
-			return PxTriangleMeshGeometry();
+			return BodySetup->AggGeom.ConvexElems[0].GetConvexMesh();
 		}
 
-		const FVector ComponentScale = InstancedMesh->GetComponentScale();
-		const PxVec3 PxScale = U2PVector(ComponentScale);
-		const PxMeshScale MeshScale(PxScale, PxQuat(PxIdentity));
+		return FPhysXInstancedCookedMeshCache::Get().FindOrRequestConvex(BodySetup, bOutPending);
+	}
 
-		return PxTriangleMeshGeometry(TriMesh, MeshScale);
+	/** Triangle-mesh counterpart of ResolveConvexMesh(). */
+	PxTriangleMesh* ResolveTriangleMesh(UBodySetup* BodySetup, bool& bOutPending)
+	{
+		bOutPending = false;
+
+		if (!BodySetup)
+		{
+			return nullptr;
+		}
+
+		if (BodySetup->TriMeshes.Num() > 0 && BodySetup->TriMeshes[0])
+		{
+			return BodySetup->TriMeshes[0];
+		}
+
+		return FPhysXInstancedCookedMeshCache::Get().FindOrRequestTriangleMesh(BodySetup, bOutPending);
 	}
 } // anonymous namespace
 
+void FPhysXInstanceBody::PrunePrimitiveFits(bool bReleaseAll)
+{
+	check(IsInGameThread());
+
+	FWriteScopeLock WriteLock(GPrimitiveFitsLock);
+
+	if (bReleaseAll)
+	{
+		GPrimitiveFits.Empty();
+		return;
+	}
+
+	auto IsStale = [](const FObjectKey& Key)
+	{
+		return Key != FObjectKey() && !Key.ResolveObjectPtr();
+	};
+
+	for (auto It = GPrimitiveFits.CreateIterator(); It; ++It)
+	{
+		if (IsStale(It.Key().StaticMesh) || IsStale(It.Key().CollisionBodySetup))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
 // -----------------------------------------------------------------------------
 // Body creation
 // -----------------------------------------------------------------------------
@@ -380,456 +558,695 @@ bool FPhysXInstanceBody::CreateFromInstancedStaticMesh(
 	bool bSimulate,
 	PxMaterial* DefaultMaterial,
 	EPhysXInstanceShapeType ShapeType,
-	UStaticMesh* OverrideCollisionMesh)
+	UStaticMesh* OverrideCollisionMesh,
+	FPhysXInstancedShapeCache* ShapeCache,
+	const FTransform* InstanceLocalTransform)
 {
-	// Measure CPU time spent creating a PhysX body for an instance.
-	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_CreateBody);
-
 	if (PxBody)
 	{
 		Destroy();
 	}
 
-	if (!InstancedMesh || !DefaultMaterial)
+	FPhysXInstanceBodyCreateParams Params;
+	if (!ResolveCreateParams(InstancedMesh, bSimulate, ShapeType, OverrideCollisionMesh, Params))
 	{
 		return false;
 	}
 
-	// We only need the SDK here, not the scene. Actor will be added later.
-	if (!GPhysXSDK)
+	const FTransform InstanceLocalTM = InstanceLocalTransform
+		? *InstanceLocalTransform
+		: GetInstanceLocalTransform(InstancedMesh, InstanceIndex);
+
+	return CreateFromParams(Params, InstanceIndex, InstanceLocalTM, DefaultMaterial, ShapeCache);
+}
+
+bool FPhysXInstanceBody::ResolveCreateParams(
+	UInstancedStaticMeshComponent* InstancedMesh,
+	bool bSimulate,
+	EPhysXInstanceShapeType ShapeType,
+	UStaticMesh* OverrideCollisionMesh,
+	FPhysXInstanceBodyCreateParams& OutParams)
+{
+	OutParams = FPhysXInstanceBodyCreateParams();
+
+	if (!InstancedMesh)
 	{
 		return false;
 	}
 
-	FBodyInstance* TemplateBodyInstance = InstancedMesh->GetBodyInstance();
+	const FBodyInstance* TemplateBodyInstance = InstancedMesh->GetBodyInstance();
 	if (!TemplateBodyInstance)
 	{
 		return false;
 	}
 
+	const AActor* Owner = InstancedMesh->GetOwner();
+	const APhysXInstancedMeshActor* PhysXActor = Cast<APhysXInstancedMeshActor>(Owner);
+
 	UBodySetup* CollisionBodySetup = GetCollisionBodySetup(InstancedMesh, OverrideCollisionMesh);
 
+	OutParams.ComponentTransform = InstancedMesh->GetComponentTransform();
+	OutParams.StaticMesh         = InstancedMesh->GetStaticMesh();
+	OutParams.CollisionBodySetup = CollisionBodySetup;
+
 	const bool bPhysicsStatic =
 		!InstancedMesh->IsSimulatingPhysics() && !bSimulate && InstancedMesh->Mobility != EComponentMobility::Movable;
 
 	const bool bUseTriangleMesh = (ShapeType == EPhysXInstanceShapeType::TriangleMeshStatic);
-	bool bSkipMassUpdate = false;
 
 	if (bUseTriangleMesh && bSimulate)
 	{
 		UE_LOG(LogPhysXInstanced, Warning,
 			TEXT("TriangleMesh selected for a simulating instance – forcing kinematic and skipping mass update."));
 		bSimulate = false;
-		bSkipMassUpdate = true;
+		OutParams.bSkipMassUpdate = true;
 	}
 
-	const PxTransform PxTM = MakePxTransformForInstance(InstancedMesh, InstanceIndex);
-
-	// Use global PhysX SDK instead of accessing PxScene here.
-	PxPhysics& Physics = *GPhysXSDK;
-	PxRigidDynamic* RigidDynamic = Physics.createRigidDynamic(PxTM);
-	if (!RigidDynamic)
-	{
-		return false;
-	}
+	OutParams.bSimulate      = bSimulate;
+	OutParams.bPhysicsStatic = bPhysicsStatic;
 
 	// ---------------------------------------------------------------------
-	// Shape creation
+	// CCD configuration
 	// ---------------------------------------------------------------------
 
-	PxShape* Shape = nullptr;
+	// CCD filter flag used by CreateShapeFilterData to route CCD interactions.
+	bool bCCDFilter = false;
 
-	switch (ShapeType)
-	{
-	case EPhysXInstanceShapeType::Box:
+	// CCD rigid body flag (PxRigidBodyFlag::eENABLE_CCD) applied on the actor.
+	bool bCCDFlag = false;
+
+	if (PhysXActor)
 	{
-		PxVec3 LocalCenter(0.f);
-		PxBoxGeometry Geom = MakeBoxGeometryForInstance(InstancedMesh, InstanceIndex, LocalCenter);
-		if (Geom.isValid())
+		switch (PhysXActor->CCDConfig.Mode)
 		{
-			Shape = RigidDynamic->createShape(Geom, *DefaultMaterial);
-			if (Shape)
+		case EPhysXInstanceCCDMode::Off:
+			// Leaves CCD disabled.
+			break;
+
+		case EPhysXInstanceCCDMode::Simulating:
+			if (!bPhysicsStatic && !bUseTriangleMesh && bSimulate)
+			{
+				bCCDFilter = true;
+				bCCDFlag   = true;
+			}
+			break;
+
+		case EPhysXInstanceCCDMode::All:
+			if (!bPhysicsStatic && !bUseTriangleMesh)
+			{
+				bCCDFilter = true;
+				bCCDFlag   = true;
+			}
+			break;
+
+		case EPhysXInstanceCCDMode::AutoByVelocity:
+			// Enables CCD filtering but leaves the rigid body flag disabled initially.
+			// The subsystem toggles PxRigidBodyFlag::eENABLE_CCD based on velocity thresholds.
+			if (!bPhysicsStatic && !bUseTriangleMesh && bSimulate)
 			{
-				// Offsets the shape so the geometry matches the static mesh bounds center.
-				Shape->setLocalPose(PxTransform(LocalCenter));
+				bCCDFilter = true;
+				bCCDFlag   = false;
 			}
+			break;
+
+		default:
+			break;
 		}
-		break;
 	}
-
-	case EPhysXInstanceShapeType::Sphere:
+	else
 	{
-		PxVec3 LocalCenter(0.f);
-		PxSphereGeometry Geom = MakeSphereGeometryForInstance(CollisionBodySetup, InstancedMesh, InstanceIndex, LocalCenter);
-		if (Geom.isValid())
+		// Falls back to the legacy BodyInstance CCD flag when no actor-level config is present.
+		if (TemplateBodyInstance->bUseCCD && !bPhysicsStatic && !bUseTriangleMesh && bSimulate)
 		{
-			Shape = RigidDynamic->createShape(Geom, *DefaultMaterial);
-			if (Shape)
-			{
-				// Offsets the sphere so it matches the same bounds center logic as the box.
-				Shape->setLocalPose(PxTransform(LocalCenter));
-			}
+			bCCDFilter = true;
+			bCCDFlag   = true;
 		}
-		break;
 	}
 
-	case EPhysXInstanceShapeType::Capsule:
-	{
-		PxVec3  LocalCenter(0.f);
-		float   RadiusUU      = 50.f;
-		float   HalfHeightUU  = 25.f;
-		FQuat   LocalRotation = FQuat::Identity;
+	OutParams.bCCDFilter = bCCDFilter;
+	OutParams.bCCDFlag   = bCCDFlag;
 
-		const UStaticMesh* StaticMesh = InstancedMesh ? InstancedMesh->GetStaticMesh() : nullptr;
-		UBodySetup* BodySetup = StaticMesh ? StaticMesh->GetBodySetup() : nullptr;
+	// ---------------------------------------------------------------------
+	// Collision filtering inputs
+	// ---------------------------------------------------------------------
 
-		// 1) If there is a simple capsule collision in BodySetup – use its size and rotation
-		if (BodySetup && BodySetup->AggGeom.SphylElems.Num() > 0)
-		{
-			const FKSphylElem& Sphyl = BodySetup->AggGeom.SphylElems[0];
+	OutParams.ObjectType           = TemplateBodyInstance->GetObjectType();
+	OutParams.MaskFilter           = TemplateBodyInstance->GetMaskFilter();
+	OutParams.Responses            = TemplateBodyInstance->GetResponseToChannels();
+	OutParams.ActorID              = Owner ? Owner->GetUniqueID() : 0;
+	OutParams.ComponentID          = InstancedMesh->GetUniqueID();
+	OutParams.bNotifyRigidBodyCollision = TemplateBodyInstance->bNotifyRigidBodyCollision;
+	OutParams.bContactModification = TemplateBodyInstance->bContactModification;
 
-			FVector TotalScale = InstancedMesh->GetComponentTransform().GetScale3D();
-			if (InstancedMesh->PerInstanceSMData.IsValidIndex(InstanceIndex))
-			{
-				const FTransform InstanceLocalTM(InstancedMesh->PerInstanceSMData[InstanceIndex].Transform);
-				TotalScale *= InstanceLocalTM.GetScale3D();
-			}
+	// ---------------------------------------------------------------------
+	// Geometry source
+	// ---------------------------------------------------------------------
 
-			const float MaxScale = TotalScale.GetAbsMax();
+	// Missing cooked data falls back to a bounds box; resolved up front so the cache key matches the geometry.
+	// Meshes without cooked data are cooked at runtime: until then the box is a proxy swapped by the subsystem.
+	EPhysXInstanceShapeType EffectiveShapeType = ShapeType;
+	bool bCookPending = false;
 
-			RadiusUU     = FMath::Max(Sphyl.Radius * MaxScale, KINDA_SMALL_NUMBER);
-			HalfHeightUU = FMath::Max(0.5f * Sphyl.Length * MaxScale, RadiusUU * 0.5f);
+	if (ShapeType == EPhysXInstanceShapeType::Convex)
+	{
+		OutParams.ConvexMesh = ResolveConvexMesh(CollisionBodySetup, bCookPending);
+	}
+	else if (bUseTriangleMesh)
+	{
+		OutParams.TriMesh = ResolveTriangleMesh(CollisionBodySetup, bCookPending);
+	}
 
-			const FVector CenterUU = Sphyl.Center * TotalScale;
-			LocalCenter = U2PVector(CenterUU);
+	if (ShapeType == EPhysXInstanceShapeType::Convex && !OutParams.ConvexMesh)
+	{
+		UE_CLOG(!bCookPending, LogPhysXInstanced, Warning, TEXT("Convex недоступен, откат к Box."));
+		EffectiveShapeType = EPhysXInstanceShapeType::Box;
+	}
+	else if (bUseTriangleMesh && !OutParams.TriMesh)
+	{
+		UE_CLOG(!bCookPending, LogPhysXInstanced, Warning, TEXT("TriangleMesh недоступен, откат к Box."));
+		EffectiveShapeType = EPhysXInstanceShapeType::Box;
+	}
 
-			// Sphyl.Rotation already describes capsule axis in mesh local space
-			LocalRotation = Sphyl.Rotation.Quaternion();
-		}
-		else
-		{
-			// 2) Fallback: fit capsule into mesh bounds and align along the major axis
-			if (!StaticMesh)
-			{
-				break;
-			}
+	OutParams.ShapeType          = EffectiveShapeType;
+	OutParams.ProxyCookBodySetup = bCookPending ? CollisionBodySetup : nullptr;
 
-			const FBoxSphereBounds MeshBounds = StaticMesh->GetBounds();
+	if (EffectiveShapeType == EPhysXInstanceShapeType::Capsule && PhysXActor)
+	{
+		OutParams.ShapeOffset = PhysXActor->ShapeCollisionOffset;
+	}
 
-			FVector TotalScale = InstancedMesh->GetComponentTransform().GetScale3D();
-			if (InstancedMesh->PerInstanceSMData.IsValidIndex(InstanceIndex))
-			{
-				const FTransform InstanceLocalTM(InstancedMesh->PerInstanceSMData[InstanceIndex].Transform);
-				TotalScale *= InstanceLocalTM.GetScale3D();
-			}
+	// Primitive shapes read bounds and simple elements from the per-mesh fit instead of the mesh itself.
+	if (!OutParams.UsesMeshScale())
+	{
+		OutParams.Fit = FindOrBuildPrimitiveFit(OutParams.StaticMesh, CollisionBodySetup);
+	}
 
-			const FVector ExtentsUU = MeshBounds.BoxExtent * TotalScale;
-			const FVector AbsExt    = ExtentsUU.GetAbs();
+	// ---------------------------------------------------------------------
+	// Rigid body settings
+	// ---------------------------------------------------------------------
 
-			// choose major axis X/Y/Z
-			EAxis::Type MajorAxis = EAxis::X;
-			float MajorExtent = AbsExt.X;
-			if (AbsExt.Y > MajorExtent) { MajorAxis = EAxis::Y; MajorExtent = AbsExt.Y; }
-			if (AbsExt.Z > MajorExtent) { MajorAxis = EAxis::Z; MajorExtent = AbsExt.Z; }
+	OutParams.bEnableGravity = PhysXActor ? PhysXActor->bInstancesUseGravity : TemplateBodyInstance->bEnableGravity;
 
-			float RadExtent = 0.f;
-			if (MajorAxis == EAxis::X)       RadExtent = FMath::Max(AbsExt.Y, AbsExt.Z);
-			else if (MajorAxis == EAxis::Y)  RadExtent = FMath::Max(AbsExt.X, AbsExt.Z);
-			else                             RadExtent = FMath::Max(AbsExt.X, AbsExt.Y);
+	OutParams.LinearDamping                = TemplateBodyInstance->LinearDamping;
+	OutParams.AngularDamping               = TemplateBodyInstance->AngularDamping;
+	OutParams.PositionSolverIterationCount = TemplateBodyInstance->PositionSolverIterationCount;
+	OutParams.VelocitySolverIterationCount = TemplateBodyInstance->VelocitySolverIterationCount;
 
-			RadiusUU     = FMath::Max(RadExtent, KINDA_SMALL_NUMBER);
-			HalfHeightUU = MajorExtent - RadiusUU;
-			if (HalfHeightUU <= KINDA_SMALL_NUMBER)
-			{
-				HalfHeightUU = RadiusUU * 0.5f;
-			}
+	OutParams.Mass = (TemplateBodyInstance->GetBodyMass() > 0.f) ? TemplateBodyInstance->GetBodyMass() : 10.0f;
 
-			const FVector CenterUU = MeshBounds.Origin * TotalScale;
-			LocalCenter = U2PVector(CenterUU);
+	return true;
+}
 
-			const FVector DesiredAxis =
-				(MajorAxis == EAxis::X) ? FVector::XAxisVector :
-				(MajorAxis == EAxis::Y) ? FVector::YAxisVector :
-										  FVector::ZAxisVector;
+bool FPhysXInstanceBody::CreateFromParams(
+	const FPhysXInstanceBodyCreateParams& Params,
+	int32 InstanceIndex,
+	const FTransform& InstanceLocalTransform,
+	PxMaterial* DefaultMaterial,
+	FPhysXInstancedShapeCache* ShapeCache)
+{
+	// Measure CPU time spent creating a PhysX body for an instance.
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_CreateBody);
 
-			LocalRotation = FQuat::FindBetweenNormals(FVector::XAxisVector, DesiredAxis);
-		}
+	if (PxBody)
+	{
+		Destroy();
+	}
 
-		PxCapsuleGeometry Geom(U2PScalar(RadiusUU), U2PScalar(HalfHeightUU));
-		if (Geom.isValid())
-		{
-			Shape = RigidDynamic->createShape(Geom, *DefaultMaterial);
-			if (Shape)
-			{
-				// Applies an optional per-actor local offset for the collision shape.
-				FTransform ShapeOffset = FTransform::Identity;
-				if (InstancedMesh)
-				{
-					if (const APhysXInstancedMeshActor* PhysXActor = Cast<APhysXInstancedMeshActor>(InstancedMesh->GetOwner()))
-					{
-						ShapeOffset = PhysXActor->ShapeCollisionOffset;
-					}
-				}
+	// We only need the SDK here, not the scene. Actor will be added later.
+	if (!DefaultMaterial || !GPhysXSDK)
+	{
+		return false;
+	}
 
-				const FQuat   FinalRot   = LocalRotation * ShapeOffset.GetRotation();
-				const FVector FinalPosUU = P2UVector(LocalCenter) + ShapeOffset.GetLocation();
+	const PxTransform PxTM = U2PTransform(InstanceLocalTransform * Params.ComponentTransform);
 
-				Shape->setLocalPose(PxTransform(
-					U2PVector(FinalPosUU),
-					U2PQuat(FinalRot)
-				));
-			}
-		}
+	// Use global PhysX SDK instead of accessing PxScene here.
+	PxPhysics& Physics = *GPhysXSDK;
+
+	bool bSkipMassUpdate = Params.bSkipMassUpdate;
+
+	// ---------------------------------------------------------------------
+	// Collision filtering
+	// ---------------------------------------------------------------------
+
+	// Resolved before the shape exists: shared shapes are looked up by their filter data.
+	PxFilterData PxQuery;
+	PxFilterData PxSim;
+
+	{
+		// A shared shape carries one filter data for all of its bodies, so the per-body index and the
+		// render component are dropped: chunk components of one actor must resolve to the same cache key.
+		// ISM bodies have no per-body collision disable table, so both are informational only.
+		const uint32 ComponentID = ShapeCache ? 0u : Params.ComponentID;
+		const uint16 BodyIndex   = ShapeCache ? 0 : (uint16)InstanceIndex;
+
+		FCollisionFilterData QueryData;
+		FCollisionFilterData SimData;
+
+		CreateShapeFilterData(
+			(uint8)Params.ObjectType,
+			Params.MaskFilter,
+			Params.ActorID,
+			Params.Responses,
+			ComponentID,
+			BodyIndex,
+			QueryData,
+			SimData,
+			Params.bCCDFilter,
+			Params.bNotifyRigidBodyCollision,
+			Params.bPhysicsStatic,
+			Params.bContactModification
+		);
+
+		// Instance bit: lets scene queries reject non-instance shapes from the filter data alone.
+		PxQuery = PxFilterData(
+			QueryData.Word0, QueryData.Word1, QueryData.Word2, QueryData.Word3 | PhysXIS::QueryFlag_Instance);
 
-		break;
+		PxSim = PxFilterData(
+			SimData.Word0, SimData.Word1, SimData.Word2, SimData.Word3);
 	}
 
-	case EPhysXInstanceShapeType::Convex:
+	// ---------------------------------------------------------------------
+	// Shape creation
+	// ---------------------------------------------------------------------
+
+	const EPhysXInstanceShapeType EffectiveShapeType = Params.ShapeType;
+	const FTransform& ShapeOffset = Params.ShapeOffset;
+
+	bUsesProxyShape    = Params.ProxyCookBodySetup != nullptr;
+	ProxyCookBodySetup = Params.ProxyCookBodySetup;
+
+	// Cooked meshes only follow the component scale; fitted primitives also follow the instance scale.
+	const bool bUsesMeshScale = Params.UsesMeshScale();
+
+	FVector GeometryScale = bUsesMeshScale
+		? Params.ComponentTransform.GetScale3D()
+		: Params.ComponentTransform.GetScale3D() * InstanceLocalTransform.GetScale3D();
+
+	// Shared shapes are built from the snapped scale so every body using an entry gets the same geometry.
+	if (ShapeCache)
+	{
+		GeometryScale = ShapeCache->QuantizeScale(GeometryScale);
+	}
+
+	auto BuildShape = [&](bool bExclusive) -> PxShape*
 	{
-		PxConvexMeshGeometry Geom = MakeConvexGeometry(CollisionBodySetup, InstancedMesh);
-		if (Geom.isValid())
+		PxShape* NewShape = nullptr;
+
+		const FPhysXInstancePrimitiveFit& Fit = Params.Fit;
+
+		switch (EffectiveShapeType)
 		{
-			Shape = RigidDynamic->createShape(Geom, *DefaultMaterial);
-		}
-		else
+		case EPhysXInstanceShapeType::Box:
 		{
-			UE_LOG(LogPhysXInstanced, Warning, TEXT("Convex недоступен, откат к Box."));
 			PxVec3 LocalCenter(0.f);
-			PxBoxGeometry BoxGeom = MakeBoxGeometryForInstance(InstancedMesh, InstanceIndex, LocalCenter);
-			if (BoxGeom.isValid())
+			PxBoxGeometry Geom = MakeBoxGeometryForInstance(Fit, GeometryScale, LocalCenter);
+			if (Geom.isValid())
 			{
-				Shape = RigidDynamic->createShape(BoxGeom, *DefaultMaterial);
-				if (Shape)
+				NewShape = Physics.createShape(Geom, *DefaultMaterial, bExclusive);
+				if (NewShape)
 				{
-					Shape->setLocalPose(PxTransform(LocalCenter));
+					// Offsets the shape so the geometry matches the static mesh bounds center.
+					NewShape->setLocalPose(PxTransform(LocalCenter));
 				}
 			}
+			break;
 		}
-		break;
-	}
 
-	case EPhysXInstanceShapeType::TriangleMeshStatic:
-	{
-		PxTriangleMeshGeometry Geom = MakeTriangleMeshGeometry(CollisionBodySetup, InstancedMesh);
-		if (Geom.isValid())
+		case EPhysXInstanceShapeType::Sphere:
 		{
-			Shape = RigidDynamic->createShape(Geom, *DefaultMaterial);
-			bSkipMassUpdate = true;
+			PxVec3 LocalCenter(0.f);
+			PxSphereGeometry Geom = MakeSphereGeometryForInstance(Fit, GeometryScale, LocalCenter);
+			if (Geom.isValid())
+			{
+				NewShape = Physics.createShape(Geom, *DefaultMaterial, bExclusive);
+				if (NewShape)
+				{
+					// Offsets the sphere so it matches the same bounds center logic as the box.
+					NewShape->setLocalPose(PxTransform(LocalCenter));
+				}
+			}
+			break;
 		}
-		else
+
+		case EPhysXInstanceShapeType::Capsule:
 		{
-			UE_LOG(LogPhysXInstanced, Warning, TEXT("TriangleMesh недоступен, откат к Box."));
 			PxVec3 LocalCenter(0.f);
-			PxBoxGeometry BoxGeom = MakeBoxGeometryForInstance(InstancedMesh, InstanceIndex, LocalCenter);
-			if (BoxGeom.isValid())
+			FQuat  LocalRotation = FQuat::Identity;
+
+			PxCapsuleGeometry Geom = MakeCapsuleGeometryForInstance(Fit, GeometryScale, LocalCenter, LocalRotation);
+			if (Geom.isValid())
 			{
-				Shape = RigidDynamic->createShape(BoxGeom, *DefaultMaterial);
-				if (Shape)
+				NewShape = Physics.createShape(Geom, *DefaultMaterial, bExclusive);
+				if (NewShape)
 				{
-					Shape->setLocalPose(PxTransform(LocalCenter));
+					// Applies the optional per-actor local offset for the collision shape.
+					const FQuat   FinalRot   = LocalRotation * ShapeOffset.GetRotation();
+					const FVector FinalPosUU = P2UVector(LocalCenter) + ShapeOffset.GetLocation();
+
+					NewShape->setLocalPose(PxTransform(
+						U2PVector(FinalPosUU),
+						U2PQuat(FinalRot)
+					));
 				}
 			}
+			break;
+		}
+
+		case EPhysXInstanceShapeType::Convex:
+		{
+			PxConvexMeshGeometry Geom = MakeConvexGeometry(Params.ConvexMesh, GeometryScale);
+			if (Geom.isValid())
+			{
+				NewShape = Physics.createShape(Geom, *DefaultMaterial, bExclusive);
+			}
+			break;
 		}
-		break;
-	}
 
-	default:
-		break;
+		case EPhysXInstanceShapeType::TriangleMeshStatic:
+		{
+			PxTriangleMeshGeometry Geom = MakeTriangleMeshGeometry(Params.TriMesh, GeometryScale);
+			if (Geom.isValid())
+			{
+				NewShape = Physics.createShape(Geom, *DefaultMaterial, bExclusive);
+			}
+			break;
+		}
+
+		default:
+			break;
+		}
+
+		if (!NewShape)
+		{
+			// Final fallback: create a small box shape to keep the actor valid.
+			PxBoxGeometry BoxGeom(PxVec3(10.f));
+			if (!BoxGeom.isValid())
+			{
+				return nullptr;
+			}
+
+			NewShape = Physics.createShape(BoxGeom, *DefaultMaterial, bExclusive);
+			if (!NewShape)
+			{
+				return nullptr;
+			}
+		}
+
+		NewShape->setFlag(PxShapeFlag::eSIMULATION_SHAPE,  true);
+		NewShape->setFlag(PxShapeFlag::eSCENE_QUERY_SHAPE, true);
+		NewShape->setFlag(PxShapeFlag::eTRIGGER_SHAPE,     false);
+
+		NewShape->setQueryFilterData(PxQuery);
+		NewShape->setSimulationFilterData(PxSim);
+		return NewShape;
+	};
+
+	PxShape* Shape = nullptr;
+
+	if (ShapeCache)
+	{
+		FPhysXShapeCacheKey Key;
+		Key.StaticMesh  = Params.StaticMesh;
+		Key.BodySetup   = Params.CollisionBodySetup;
+		Key.ShapeType   = EffectiveShapeType;
+		Key.Scale       = GeometryScale;
+		Key.LocalOffset = ShapeOffset;
+		Key.Material    = DefaultMaterial;
+
+		Key.QueryWords[0] = PxQuery.word0; Key.QueryWords[1] = PxQuery.word1;
+		Key.QueryWords[2] = PxQuery.word2; Key.QueryWords[3] = PxQuery.word3;
+		Key.SimWords[0]   = PxSim.word0;   Key.SimWords[1]   = PxSim.word1;
+		Key.SimWords[2]   = PxSim.word2;   Key.SimWords[3]   = PxSim.word3;
+
+		Shape = ShapeCache->Acquire(Key, [&BuildShape]() { return BuildShape(/*bExclusive=*/false); });
+	}
+	else
+	{
+		Shape = BuildShape(/*bExclusive=*/true);
 	}
 
 	if (!Shape)
 	{
-		// Final fallback: create a small box shape to keep the actor valid.
-		PxBoxGeometry BoxGeom(PxVec3(10.f));
-		if (!BoxGeom.isValid())
+		return false;
+	}
+
+	// Shared shapes may have a parked actor of the same archetype: re-pose it instead of allocating.
+	PxRigidDynamic* RigidDynamic = ShapeCache ? ShapeCache->TakePooledActor(Shape) : nullptr;
+
+	if (RigidDynamic)
+	{
+		RigidDynamic->setGlobalPose(PxTM);
+	}
+	else
+	{
+		RigidDynamic = Physics.createRigidDynamic(PxTM);
+		if (!RigidDynamic)
 		{
-			RigidDynamic->release();
+			if (ShapeCache)
+			{
+				ShapeCache->Release(Shape);
+			}
+			else
+			{
+				Shape->release();
+			}
 			return false;
 		}
 
-		Shape = RigidDynamic->createShape(BoxGeom, *DefaultMaterial);
+		RigidDynamic->attachShape(*Shape);
 	}
 
-	Shape->setFlag(PxShapeFlag::eSIMULATION_SHAPE,  true);
-	Shape->setFlag(PxShapeFlag::eSCENE_QUERY_SHAPE, true);
-	Shape->setFlag(PxShapeFlag::eTRIGGER_SHAPE,     false);
+	if (Shape->getGeometryType() == PxGeometryType::eTRIANGLEMESH)
+	{
+		bSkipMassUpdate = true;
+	}
+
+	if (ShapeCache)
+	{
+		// The cache reference is handed back in Destroy(), after the actor let go of the shape.
+		SharedShape      = Shape;
+		OwningShapeCache = ShapeCache;
+	}
+	else
+	{
+		// The actor holds its own reference to the exclusive shape.
+		Shape->release();
+	}
 
 	// ---------------------------------------------------------------------
-	// CCD configuration
+	// Rigid body settings
 	// ---------------------------------------------------------------------
 
-	// CCD filter flag used by CreateShapeFilterData to route CCD interactions.
-	bool bCCDFilter = false;
+	{
+		RigidDynamic->setActorFlag(PxActorFlag::eDISABLE_GRAVITY, !Params.bEnableGravity);
 
-	// CCD rigid body flag (PxRigidBodyFlag::eENABLE_CCD) applied on the actor.
-	bool bCCDFlag = false;
+		const bool bKinematic = !Params.bSimulate;
+		RigidDynamic->setRigidBodyFlag(PxRigidBodyFlag::eKINEMATIC, bKinematic);
 
-	bool bHasActorCCDConfig = false;
-	EPhysXInstanceCCDMode CCDMode = EPhysXInstanceCCDMode::Off;
+		// Applies the initial CCD rigid body flag derived from CCDMode / legacy settings.
+		// Written unconditionally so pooled actors do not keep a previous owner's flag.
+		RigidDynamic->setRigidBodyFlag(PxRigidBodyFlag::eENABLE_CCD, Params.bCCDFlag);
 
-	if (InstancedMesh)
-	{
-		if (AActor* Owner = InstancedMesh->GetOwner())
-		{
-			if (const APhysXInstancedMeshActor* PhysXActor = Cast<APhysXInstancedMeshActor>(Owner))
-			{
-				CCDMode = PhysXActor->CCDConfig.Mode;
-				bHasActorCCDConfig = true;
-			}
-		}
+		RigidDynamic->setLinearDamping(Params.LinearDamping);
+		RigidDynamic->setAngularDamping(Params.AngularDamping);
+
+		RigidDynamic->setSolverIterationCounts(
+			Params.PositionSolverIterationCount,
+			Params.VelocitySolverIterationCount);
 	}
 
-	if (bHasActorCCDConfig)
+	if (!bSkipMassUpdate)
 	{
-		switch (CCDMode)
+		// Shared shapes reuse mass properties computed once for their collision archetype.
+		if (!OwningShapeCache || !OwningShapeCache->ApplyMassProperties(*RigidDynamic, SharedShape, Params.Mass, /*MassScale=*/1.f))
 		{
-		case EPhysXInstanceCCDMode::Off:
-			// Leaves CCD disabled.
-			break;
+			PxRigidBodyExt::updateMassAndInertia(*RigidDynamic, Params.Mass);
+		}
+	}
 
-		case EPhysXInstanceCCDMode::Simulating:
-			if (!bPhysicsStatic && !bUseTriangleMesh && bSimulate)
-			{
-				bCCDFilter = true;
-				bCCDFlag   = true;
-			}
-			break;
+	//Scene->addActor(*RigidDynamic);
+	PxBody = RigidDynamic;
+	return true;
+}
 
-		case EPhysXInstanceCCDMode::All:
-			if (!bPhysicsStatic && !bUseTriangleMesh)
-			{
-				bCCDFilter = true;
-				bCCDFlag   = true;
-			}
-			break;
+// -----------------------------------------------------------------------------
+// Archetype templates
+// -----------------------------------------------------------------------------
 
-		case EPhysXInstanceCCDMode::AutoByVelocity:
-			// Enables CCD filtering but leaves the rigid body flag disabled initially.
-			// The subsystem toggles PxRigidBodyFlag::eENABLE_CCD based on velocity thresholds.
-			if (!bPhysicsStatic && !bUseTriangleMesh && bSimulate)
-			{
-				bCCDFilter = true;
-				bCCDFlag   = false;
-			}
-			break;
+PxRigidDynamic* FPhysXInstanceBody::BakeArchetypeTemplate(
+	const UPhysXInstanceArchetype& Archetype,
+	UInstancedStaticMeshComponent* InstancedMesh,
+	int32 InstanceIndex,
+	PxMaterial* DefaultMaterial,
+	const FTransform* InstanceLocalTransform)
+{
+	// Geometry comes from the regular path with an exclusive shape; everything else is overwritten below.
+	FPhysXInstanceBody Source;
+	if (!Source.CreateFromInstancedStaticMesh(
+		InstancedMesh,
+		InstanceIndex,
+		/*bSimulate=*/true,
+		DefaultMaterial,
+		Archetype.ShapeType,
+		Archetype.CollisionMesh,
+		/*ShapeCache=*/nullptr,
+		InstanceLocalTransform))
+	{
+		return nullptr;
+	}
 
-		default:
-			break;
-		}
+	// A proxy box would stay baked forever; wait for the cooked mesh instead.
+	PxShape* ExclusiveShape = nullptr;
+	if (Source.bUsesProxyShape || Source.PxBody->getShapes(&ExclusiveShape, 1) != 1)
+	{
+		Source.Destroy();
+		return nullptr;
 	}
-	else
+
+	PxRigidDynamic* Template = Source.PxBody;
+	PxPhysics& Physics = *GPhysXSDK;
+
+	// Clones attach this shape instead of copying it.
+	PxShape* Shape = PxCloneShape(Physics, *ExclusiveShape, /*isExclusive=*/false);
+	if (!Shape)
 	{
-		// Falls back to the legacy BodyInstance CCD flag when no actor-level config is present.
-		if (TemplateBodyInstance->bUseCCD && !bPhysicsStatic && !bUseTriangleMesh && bSimulate)
-		{
-			bCCDFilter = true;
-			bCCDFlag   = true;
-		}
+		Source.Destroy();
+		return nullptr;
 	}
 
+	Template->detachShape(*ExclusiveShape);
+	Template->attachShape(*Shape);
+	Shape->release();
+
+	const bool bTriangleMesh = Shape->getGeometryType() == PxGeometryType::eTRIANGLEMESH;
+	const bool bKinematic    = Template->getRigidBodyFlags().isSet(PxRigidBodyFlag::eKINEMATIC);
+	const bool bUseCCD       = Archetype.bUseCCD && !bTriangleMesh && !bKinematic;
+
 	// ---------------------------------------------------------------------
 	// Collision filtering
 	// ---------------------------------------------------------------------
 
 	{
-		AActor* Owner = InstancedMesh->GetOwner();
-		const int32  ActorID     = Owner ? Owner->GetUniqueID() : 0;
-		const uint32 ComponentID = InstancedMesh->GetUniqueID();
-		const uint16 BodyIndex   = (uint16)InstanceIndex;
+		const FBodyInstance* TemplateBodyInstance = InstancedMesh->GetBodyInstance();
+
+		ECollisionChannel           ObjectType = TemplateBodyInstance->GetObjectType();
+		FCollisionResponseContainer Responses  = TemplateBodyInstance->GetResponseToChannels();
 
-		const uint8 MyChannel = (uint8)TemplateBodyInstance->GetObjectType();
-		const FMaskFilter MaskFilter = TemplateBodyInstance->GetMaskFilter();
-		const FCollisionResponseContainer& Responses =
-			TemplateBodyInstance->GetResponseToChannels();
+		// Unknown profiles keep the component's settings.
+		Archetype.GetCollisionResponses(ObjectType, Responses);
 
 		FCollisionFilterData QueryData;
 		FCollisionFilterData SimData;
 
-		const bool bEnableCCD = bCCDFilter;
-
-		const bool bEnableContactNotify = TemplateBodyInstance->bNotifyRigidBodyCollision;
-		const bool bModifyContacts      = TemplateBodyInstance->bContactModification;
-
+		// The shape is shared by every actor using the archetype, so the archetype stands in for the actor ID.
 		CreateShapeFilterData(
-			MyChannel,
-			MaskFilter,
-			ActorID,
+			(uint8)ObjectType,
+			TemplateBodyInstance->GetMaskFilter(),
+			/*ActorID=*/(int32)Archetype.GetUniqueID(),
 			Responses,
-			ComponentID,
-			BodyIndex,
+			/*ComponentID=*/0,
+			/*BodyIndex=*/0,
 			QueryData,
 			SimData,
-			bEnableCCD,
-			bEnableContactNotify,
-			bPhysicsStatic,
-			bModifyContacts
+			bUseCCD,
+			Archetype.bNotifyRigidBodyCollision,
+			/*bStaticShape=*/false,
+			/*bModifyContacts=*/false
 		);
 
-		const PxFilterData PxQuery(
-			QueryData.Word0, QueryData.Word1, QueryData.Word2, QueryData.Word3);
-
-		const PxFilterData PxSim(
-			SimData.Word0, SimData.Word1, SimData.Word2, SimData.Word3);
-
-		Shape->setQueryFilterData(PxQuery);
-		Shape->setSimulationFilterData(PxSim);
+		Shape->setQueryFilterData(PxFilterData(QueryData.Word0, QueryData.Word1, QueryData.Word2, QueryData.Word3 | PhysXIS::QueryFlag_Instance));
+		Shape->setSimulationFilterData(PxFilterData(SimData.Word0, SimData.Word1, SimData.Word2, SimData.Word3));
 	}
 
 	// ---------------------------------------------------------------------
-	// Rigid body settings
+	// Material, flags and mass
 	// ---------------------------------------------------------------------
 
-	{
-		bool bEnableGravity = true;
-		bool bGotGravityFromActor = false;
+	UPhysicalMaterial* PhysMat = Archetype.PhysicalMaterial;
 
-		if (InstancedMesh)
+	if (PhysMat)
+	{
+		// The engine material already carries static friction and the combine modes; the shape holds a reference.
+		if (PxMaterial* Material = PhysMat->GetPhysicsMaterial().Material)
 		{
-			if (AActor* Owner = InstancedMesh->GetOwner())
-			{
-				if (const APhysXInstancedMeshActor* PhysXActor = Cast<APhysXInstancedMeshActor>(Owner))
-				{
-					bEnableGravity = PhysXActor->bInstancesUseGravity;
-					bGotGravityFromActor = true;
-				}
-			}
+			Shape->setMaterials(&Material, 1);
 		}
+	}
+
+	Template->setActorFlag(PxActorFlag::eDISABLE_GRAVITY, !Archetype.bEnableGravity);
+	Template->setRigidBodyFlag(PxRigidBodyFlag::eENABLE_CCD, bUseCCD);
 
-		if (!bGotGravityFromActor && TemplateBodyInstance)
+	Template->setLinearDamping(FMath::Max(0.0f, Archetype.LinearDamping));
+	Template->setAngularDamping(FMath::Max(0.0f, Archetype.AngularDamping));
+
+	if (!bTriangleMesh)
+	{
+		if (Archetype.bOverrideMass)
 		{
-			bEnableGravity = TemplateBodyInstance->bEnableGravity;
+			PxRigidBodyExt::setMassAndUpdateInertia(*Template, FMath::Max(Archetype.MassInKg, 0.001f));
 		}
+		else
+		{
+			// Same density conversion as the actor overrides: g/cm^3 to kg/m^3.
+			const float Density_g_per_cm3 = PhysMat ? PhysMat->Density : 1.0f;
+			PxRigidBodyExt::updateMassAndInertia(*Template, FMath::Max(Density_g_per_cm3 * 1000.0f, 0.001f));
+		}
+	}
 
-		RigidDynamic->setActorFlag(PxActorFlag::eDISABLE_GRAVITY, !bEnableGravity);
+	return Template;
+}
 
-		const bool bKinematic = !bSimulate;
-		RigidDynamic->setRigidBodyFlag(PxRigidBodyFlag::eKINEMATIC, bKinematic);
+bool FPhysXInstanceBody::CreateFromArchetypeTemplate(
+	const PxRigidDynamic& Template,
+	UInstancedStaticMeshComponent* InstancedMesh,
+	int32 InstanceIndex,
+	bool bSimulate,
+	const FTransform* InstanceLocalTransform)
+{
+	if (!InstancedMesh)
+	{
+		return false;
+	}
 
-		// Applies the initial CCD rigid body flag derived from CCDMode / legacy settings.
-		if (bCCDFlag)
-		{
-			RigidDynamic->setRigidBodyFlag(PxRigidBodyFlag::eENABLE_CCD, true);
-		}
+	const FTransform InstanceLocalTM = InstanceLocalTransform
+		? *InstanceLocalTransform
+		: GetInstanceLocalTransform(InstancedMesh, InstanceIndex);
 
-		RigidDynamic->setLinearDamping(TemplateBodyInstance->LinearDamping);
-		RigidDynamic->setAngularDamping(TemplateBodyInstance->AngularDamping);
+	return CreateFromArchetypeTemplate(Template, InstanceLocalTM * InstancedMesh->GetComponentTransform(), bSimulate);
+}
 
-		RigidDynamic->setSolverIterationCounts(
-			TemplateBodyInstance->PositionSolverIterationCount,
-			TemplateBodyInstance->VelocitySolverIterationCount);
+bool FPhysXInstanceBody::CreateFromArchetypeTemplate(
+	const PxRigidDynamic& Template,
+	const FTransform& InstanceWorldTransform,
+	bool bSimulate)
+{
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_CreateBody);
+
+	if (PxBody)
+	{
+		Destroy();
 	}
 
-	if (!bSkipMassUpdate)
+	if (!GPhysXSDK)
 	{
-		const float Mass =
-			(TemplateBodyInstance->GetBodyMass() > 0.f)
-				? TemplateBodyInstance->GetBodyMass()
-				: 10.0f;
+		return false;
+	}
+
+	// Copies flags, damping, mass properties and solver counts; the shared shape is attached, not copied.
+	PxRigidDynamic* RigidDynamic = PxCloneDynamic(*GPhysXSDK, U2PTransform(InstanceWorldTransform), Template);
+	if (!RigidDynamic)
+	{
+		return false;
+	}
 
-		PxRigidBodyExt::updateMassAndInertia(*RigidDynamic, Mass);
+	// Templates are baked dynamic (triangle meshes kinematic); CCD is not allowed on kinematic bodies.
+	if (!bSimulate)
+	{
+		RigidDynamic->setRigidBodyFlag(PxRigidBodyFlag::eENABLE_CCD, false);
+		RigidDynamic->setRigidBodyFlag(PxRigidBodyFlag::eKINEMATIC, true);
 	}
 
-	//Scene->addActor(*RigidDynamic);
 	PxBody = RigidDynamic;
 	return true;
 }
@@ -0,0 +1,388 @@
+﻿/**
+* Copyright (C) 2025 | Created by NordVader Inc.
+* All rights reserved!
+* My Discord Server: https://discord.gg/B8prpf3vzD
+*/
+
+#include "PhysXInstancedCookedMeshCache.h"
+
+#if PHYSICS_INTERFACE_PHYSX
+
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "IPhysXCooking.h"
+#include "IPhysXCookingModule.h"
+#include "Interfaces/Interface_CollisionDataProvider.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/SecureHash.h"
+#include "Modules/ModuleManager.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "PxPhysicsAPI.h"
+
+using namespace physx;
+
+DEFINE_LOG_CATEGORY_STATIC(LogPhysXInstancedCooking, Log, All);
+
+// -----------------------------------------------------------------------------
+// Local helpers
+// -----------------------------------------------------------------------------
+
+namespace
+{
+	struct FCookSource
+	{
+		TArray<FVector>     Vertices;
+		TArray<FTriIndices> Indices;
+		TArray<uint16>      MaterialIndices;
+		bool                bFlipNormals = false;
+	};
+
+	/** Game thread: convex hull points or triangle data for BodySetup. */
+	bool GatherCookSource(UBodySetup& BodySetup, EPhysXCookedMeshKind Kind, FCookSource& Out)
+	{
+		// Convex elements usually keep their hull points even when the cooked mesh is missing.
+		if (Kind == EPhysXCookedMeshKind::Convex &&
+			BodySetup.AggGeom.ConvexElems.Num() > 0 &&
+			BodySetup.AggGeom.ConvexElems[0].VertexData.Num() >= 4)
+		{
+			Out.Vertices = BodySetup.AggGeom.ConvexElems[0].VertexData;
+			return true;
+		}
+
+		// Otherwise read the render triangles (a convex is then the hull of all vertices).
+		IInterface_CollisionDataProvider* Provider = Cast<IInterface_CollisionDataProvider>(BodySetup.GetOuter());
+
+		FTriMeshCollisionData TriData;
+		if (!Provider ||
+			!Provider->ContainsPhysicsTriMeshData(/*InUseAllTriData=*/true) ||
+			!Provider->GetPhysicsTriMeshData(&TriData, /*InUseAllTriData=*/true))
+		{
+			return false;
+		}
+
+		Out.Vertices = MoveTemp(TriData.Vertices);
+
+		if (Kind == EPhysXCookedMeshKind::TriangleMesh)
+		{
+			Out.Indices         = MoveTemp(TriData.Indices);
+			Out.MaterialIndices = MoveTemp(TriData.MaterialIndices);
+			Out.bFlipNormals    = TriData.bFlipNormals;
+			return Out.Indices.Num() > 0;
+		}
+
+		return Out.Vertices.Num() >= 4;
+	}
+
+	/** Cache file named after the source geometry, the cooking format and the PhysX version. */
+	FString MakeCachePath(EPhysXCookedMeshKind Kind, const FCookSource& Source, FName Format)
+	{
+		FSHA1 Sha;
+
+		const uint8  KindByte = (uint8)Kind;
+		const uint8  FlipByte = Source.bFlipNormals ? 1 : 0;
+		const uint32 Version  = PX_PHYSICS_VERSION;
+		const FString FormatString = Format.ToString();
+
+		Sha.Update(&KindByte, sizeof(KindByte));
+		Sha.Update(&FlipByte, sizeof(FlipByte));
+		Sha.Update((const uint8*)&Version, sizeof(Version));
+		Sha.UpdateWithString(*FormatString, FormatString.Len());
+		Sha.Update((const uint8*)Source.Vertices.GetData(), Source.Vertices.Num() * sizeof(FVector));
+		Sha.Update((const uint8*)Source.Indices.GetData(), Source.Indices.Num() * sizeof(FTriIndices));
+		Sha.Update((const uint8*)Source.MaterialIndices.GetData(), Source.MaterialIndices.Num() * sizeof(uint16));
+		Sha.Final();
+
+		FSHAHash Hash;
+		Sha.GetHash(Hash.Hash);
+
+		return FPaths::ProjectSavedDir() / TEXT("PhysXInstanced") / TEXT("CookedCollision") /
+			FString::Printf(TEXT("%s_%s.bin"),
+				Kind == EPhysXCookedMeshKind::Convex ? TEXT("Convex") : TEXT("TriMesh"),
+				*Hash.ToString());
+	}
+}
+
+// -----------------------------------------------------------------------------
+// FPhysXInstancedCookedMeshCache
+// -----------------------------------------------------------------------------
+
+FPhysXInstancedCookedMeshCache& FPhysXInstancedCookedMeshCache::Get()
+{
+	static FPhysXInstancedCookedMeshCache Instance;
+	return Instance;
+}
+
+FPhysXInstancedCookedMeshCache::~FPhysXInstancedCookedMeshCache()
+{
+	// PhysX may already be gone at static destruction; only wait for tasks and drop pointers.
+	FScopeLock ScopeLock(&Lock);
+
+	for (TPair<FEntryKey, TUniquePtr<FEntry>>& Pair : Entries)
+	{
+		if (Pair.Value->Task.IsValid())
+		{
+			Pair.Value->Task.Wait();
+		}
+	}
+	Entries.Reset();
+}
+
+PxConvexMesh* FPhysXInstancedCookedMeshCache::FindOrRequestConvex(UBodySetup* BodySetup, bool& bOutPending)
+{
+	PxBase* Mesh = FindOrRequest(BodySetup, EPhysXCookedMeshKind::Convex, bOutPending);
+	return Mesh ? Mesh->is<PxConvexMesh>() : nullptr;
+}
+
+PxTriangleMesh* FPhysXInstancedCookedMeshCache::FindOrRequestTriangleMesh(UBodySetup* BodySetup, bool& bOutPending)
+{
+	PxBase* Mesh = FindOrRequest(BodySetup, EPhysXCookedMeshKind::TriangleMesh, bOutPending);
+	return Mesh ? Mesh->is<PxTriangleMesh>() : nullptr;
+}
+
+PxBase* FPhysXInstancedCookedMeshCache::FindOrRequest(UBodySetup* BodySetup, EPhysXCookedMeshKind Kind, bool& bOutPending)
+{
+	// Entries are validated against the live body setup, which only the game thread may resolve.
+	check(IsInGameThread());
+
+	bOutPending = false;
+
+	if (!BodySetup || !bEnabled)
+	{
+		return nullptr;
+	}
+
+	// Nothing could produce a mesh: skip the proxy round trip and let the body fall back to a box right away.
+	if (!bDiskCacheEnabled && !GetCooker())
+	{
+		return nullptr;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+
+	TUniquePtr<FEntry>& Entry = Entries.FindOrAdd(FEntryKey(BodySetup, Kind));
+
+	// A body setup reallocated at the same address gets a fresh entry.
+	if (Entry && Entry->State != EState::Cooking && Entry->BodySetup.Get() != BodySetup)
+	{
+		if (Entry->Mesh)
+		{
+			Entry->Mesh->release();
+		}
+		Entry.Reset();
+	}
+
+	if (!Entry)
+	{
+		Entry = MakeUnique<FEntry>();
+		Entry->BodySetup = BodySetup;
+		Entry->Kind      = Kind;
+	}
+
+	bOutPending = (Entry->State == EState::Requested || Entry->State == EState::Cooking);
+	return Entry->Mesh;
+}
+
+bool FPhysXInstancedCookedMeshCache::IsPending(const UBodySetup* BodySetup, EPhysXCookedMeshKind Kind) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const TUniquePtr<FEntry>* Entry = Entries.Find(FEntryKey(BodySetup, Kind));
+	return Entry && (*Entry)->State != EState::Ready && (*Entry)->State != EState::Failed;
+}
+
+bool FPhysXInstancedCookedMeshCache::IsReady(const UBodySetup* BodySetup, EPhysXCookedMeshKind Kind) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const TUniquePtr<FEntry>* Entry = Entries.Find(FEntryKey(BodySetup, Kind));
+	return Entry && (*Entry)->State == EState::Ready;
+}
+
+int32 FPhysXInstancedCookedMeshCache::NumPending() const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	int32 Count = 0;
+	for (const TPair<FEntryKey, TUniquePtr<FEntry>>& Pair : Entries)
+	{
+		if (Pair.Value->State == EState::Requested || Pair.Value->State == EState::Cooking)
+		{
+			++Count;
+		}
+	}
+	return Count;
+}
+
+int32 FPhysXInstancedCookedMeshCache::Tick()
+{
+	check(IsInGameThread());
+
+	FScopeLock ScopeLock(&Lock);
+
+	int32 NumReady = 0;
+
+	for (TPair<FEntryKey, TUniquePtr<FEntry>>& Pair : Entries)
+	{
+		FEntry& Entry = *Pair.Value;
+
+		if (Entry.State == EState::Requested)
+		{
+			StartCook_Locked(Entry);
+		}
+		else if (Entry.State == EState::Cooking && Entry.Task.IsReady())
+		{
+			FinishCook_Locked(Entry);
+			NumReady += (Entry.State == EState::Ready) ? 1 : 0;
+		}
+	}
+
+	return NumReady;
+}
+
+void FPhysXInstancedCookedMeshCache::StartCook_Locked(FEntry& Entry)
+{
+	UBodySetup* BodySetup = Entry.BodySetup.Get();
+
+	FCookSource Source;
+	if (!BodySetup || !GatherCookSource(*BodySetup, Entry.Kind, Source))
+	{
+		Entry.State = EState::Failed;
+		return;
+	}
+
+	IPhysXCooking* TaskCooker = GetCooker();
+
+	const FName Format(FPlatformProperties::GetPhysicsFormat());
+
+	Entry.CachePath = MakeCachePath(Entry.Kind, Source, Format);
+	Entry.State     = EState::Cooking;
+	Entry.Result    = MakeShared<FCookResult, ESPMode::ThreadSafe>();
+
+	// The task sees copies only: the entry and the body setup stay on the game thread.
+	const bool                 bUseDisk  = bDiskCacheEnabled;
+	const EPhysXCookedMeshKind Kind      = Entry.Kind;
+	const FString              CachePath = Entry.CachePath;
+
+	Entry.Task = Async(EAsyncExecution::ThreadPool,
+		[Result = Entry.Result, TaskCooker, Format, bUseDisk, Kind, CachePath, Source = MoveTemp(Source)]()
+	{
+		TArray<uint8>& Data = Result->CookedData;
+
+		// Disk hit: nothing to cook. Also the only source of meshes in builds without the cooker.
+		if (bUseDisk && FFileHelper::LoadFileToArray(Data, *CachePath, FILEREAD_Silent) && Data.Num() > 0)
+		{
+			Result->bLoadedFromDisk = true;
+			return;
+		}
+
+		Data.Reset();
+
+		if (!TaskCooker)
+		{
+			return;
+		}
+
+		bool bCooked = false;
+
+		if (Kind == EPhysXCookedMeshKind::Convex)
+		{
+			bCooked = TaskCooker->CookConvex(Format, EPhysXMeshCookFlags::Default, Source.Vertices, Data) != EPhysXCookingResult::Failed;
+		}
+		else
+		{
+			bCooked = TaskCooker->CookTriMesh(Format, EPhysXMeshCookFlags::Default,
+				Source.Vertices, Source.Indices, Source.MaterialIndices, Source.bFlipNormals, Data);
+		}
+
+		if (!bCooked)
+		{
+			Data.Reset();
+			return;
+		}
+
+		if (bUseDisk)
+		{
+			FFileHelper::SaveArrayToFile(Data, *CachePath);
+		}
+	});
+}
+
+IPhysXCooking* FPhysXInstancedCookedMeshCache::GetCooker()
+{
+	check(IsInGameThread());
+
+	if (!bCookerResolved)
+	{
+		bCookerResolved = true;
+
+		// Module lookup must happen on the game thread; the cooker itself is safe to use from workers.
+		// Cooked builds usually do not ship the module, so its absence is expected, not an error.
+		IPhysXCookingModule* CookingModule = FModuleManager::Get().ModuleExists(TEXT("PhysXCooking"))
+			? FModuleManager::LoadModulePtr<IPhysXCookingModule>(TEXT("PhysXCooking"))
+			: nullptr;
+
+		Cooker = CookingModule ? CookingModule->GetPhysXCooking() : nullptr;
+
+		UE_CLOG(!Cooker, LogPhysXInstancedCooking, Log,
+			TEXT("PhysXCooking is not available in this build; runtime cooking is off, only disk-cached meshes are loaded."));
+	}
+
+	return Cooker;
+}
+
+void FPhysXInstancedCookedMeshCache::FinishCook_Locked(FEntry& Entry)
+{
+	Entry.Task.Reset();
+
+	const TSharedPtr<FCookResult, ESPMode::ThreadSafe> Result = MoveTemp(Entry.Result);
+
+	if (Result && Result->CookedData.Num() > 0 && GPhysXSDK)
+	{
+		PxDefaultMemoryInputData Input(Result->CookedData.GetData(), (PxU32)Result->CookedData.Num());
+
+		Entry.Mesh = (Entry.Kind == EPhysXCookedMeshKind::Convex)
+			? static_cast<PxBase*>(GPhysXSDK->createConvexMesh(Input))
+			: static_cast<PxBase*>(GPhysXSDK->createTriangleMesh(Input));
+	}
+
+	// A stale or corrupt cache file would fail every session; drop it so the next run cooks again.
+	if (!Entry.Mesh && Result && Result->bLoadedFromDisk)
+	{
+		IFileManager::Get().Delete(*Entry.CachePath, /*RequireExists=*/false, /*EvenReadOnly=*/true, /*Quiet=*/true);
+	}
+
+	if (!Entry.Mesh)
+	{
+		UE_CLOG(Cooker, LogPhysXInstancedCooking, Warning, TEXT("Runtime cooking failed for %s, instances keep the box proxy."),
+			*GetNameSafe(Entry.BodySetup.Get()));
+	}
+
+	Entry.State = Entry.Mesh ? EState::Ready : EState::Failed;
+}
+
+void FPhysXInstancedCookedMeshCache::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+
+	for (TPair<FEntryKey, TUniquePtr<FEntry>>& Pair : Entries)
+	{
+		FEntry& Entry = *Pair.Value;
+
+		if (Entry.Task.IsValid())
+		{
+			Entry.Task.Wait();
+		}
+
+		// Shapes built from the mesh hold their own references.
+		if (Entry.Mesh)
+		{
+			Entry.Mesh->release();
+		}
+	}
+
+	Entries.Reset();
+}
+
+#endif // PHYSICS_INTERFACE_PHYSX
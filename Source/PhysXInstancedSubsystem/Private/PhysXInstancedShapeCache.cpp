@@ -0,0 +1,331 @@
+﻿/**
+* Copyright (C) 2025 | Created by NordVader Inc.
+* All rights reserved!
+* My Discord Server: https://discord.gg/B8prpf3vzD
+*/
+
+#include "PhysXInstancedShapeCache.h"
+
+#if PHYSICS_INTERFACE_PHYSX
+
+#include "Misc/ScopeLock.h"
+#include "PxPhysicsAPI.h"
+
+using namespace physx;
+
+// -----------------------------------------------------------------------------
+// FPhysXShapeCacheKey
+// -----------------------------------------------------------------------------
+
+bool FPhysXShapeCacheKey::operator==(const FPhysXShapeCacheKey& Other) const
+{
+	return StaticMesh == Other.StaticMesh
+		&& BodySetup == Other.BodySetup
+		&& ShapeType == Other.ShapeType
+		&& Scale     == Other.Scale
+		&& Material  == Other.Material
+		&& FMemory::Memcmp(QueryWords, Other.QueryWords, sizeof(QueryWords)) == 0
+		&& FMemory::Memcmp(SimWords,   Other.SimWords,   sizeof(SimWords))   == 0
+		&& LocalOffset.Equals(Other.LocalOffset, 0.f);
+}
+
+uint32 GetTypeHash(const FPhysXShapeCacheKey& Key)
+{
+	uint32 Hash = HashCombine(::GetTypeHash(Key.StaticMesh), ::GetTypeHash(Key.BodySetup));
+	Hash = HashCombine(Hash, ::GetTypeHash((uint8)Key.ShapeType));
+	Hash = HashCombine(Hash, ::GetTypeHash(Key.Scale));
+	Hash = HashCombine(Hash, ::GetTypeHash(Key.Material));
+	Hash = FCrc::MemCrc32(Key.QueryWords, sizeof(Key.QueryWords), Hash);
+	Hash = FCrc::MemCrc32(Key.SimWords,   sizeof(Key.SimWords),   Hash);
+	return Hash;
+}
+
+// -----------------------------------------------------------------------------
+// FPhysXInstancedShapeCache
+// -----------------------------------------------------------------------------
+
+FPhysXInstancedShapeCache::~FPhysXInstancedShapeCache()
+{
+	Reset();
+}
+
+PxShape* FPhysXInstancedShapeCache::Acquire(const FPhysXShapeCacheKey& Key, TFunctionRef<PxShape*()> CreateShape)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	if (FEntry* Existing = Entries.Find(Key))
+	{
+		++Existing->RefCount;
+		return Existing->Shape;
+	}
+
+	PxShape* NewShape = CreateShape();
+	if (!NewShape)
+	{
+		return nullptr;
+	}
+
+	// The creation reference is owned by the cache; attached actors hold their own PhysX references.
+	FEntry& Entry = Entries.Add(Key);
+	Entry.Shape    = NewShape;
+	Entry.RefCount = 1;
+
+	KeyByShape.Add(NewShape, Key);
+	return NewShape;
+}
+
+void FPhysXInstancedShapeCache::Release(PxShape* Shape)
+{
+	if (!Shape)
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+
+	const FPhysXShapeCacheKey* Key = KeyByShape.Find(Shape);
+	if (!Key)
+	{
+		return;
+	}
+
+	FEntry* Entry = Entries.Find(*Key);
+	if (!Entry)
+	{
+		KeyByShape.Remove(Shape);
+		return;
+	}
+
+	if (--Entry->RefCount > 0)
+	{
+		return;
+	}
+
+	Entries.Remove(*Key);
+	KeyByShape.Remove(Shape);
+
+	Shape->release();
+}
+
+void FPhysXInstancedShapeCache::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+
+	for (TPair<FPhysXShapeCacheKey, FEntry>& Pair : Entries)
+	{
+		for (PxRigidDynamic* Pooled : Pair.Value.PooledActors)
+		{
+			Pooled->release();
+		}
+		Pair.Value.PooledActors.Reset();
+
+		if (Pair.Value.Shape)
+		{
+			Pair.Value.Shape->release();
+		}
+	}
+
+	Entries.Reset();
+	KeyByShape.Reset();
+	NumPooled = 0;
+}
+
+int32 FPhysXInstancedShapeCache::Num() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Entries.Num();
+}
+
+int32 FPhysXInstancedShapeCache::NumPooledActors() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return NumPooled;
+}
+
+void FPhysXInstancedShapeCache::SetMaxPooledActorsPerShape(int32 InMaxPooled)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const int32 NewMax = FMath::Max(0, InMaxPooled);
+	if (NewMax == MaxPooledActorsPerShape)
+	{
+		return;
+	}
+
+	MaxPooledActorsPerShape = NewMax;
+
+	// Trimming may drop the last reference of an entry, so walk a snapshot of the shapes.
+	TArray<PxShape*> Shapes;
+	KeyByShape.GetKeys(Shapes);
+
+	for (PxShape* Shape : Shapes)
+	{
+		if (FEntry* Entry = Entries.Find(KeyByShape.FindChecked(Shape)))
+		{
+			TrimPool_Locked(*Entry, NewMax);
+		}
+	}
+}
+
+PxRigidDynamic* FPhysXInstancedShapeCache::TakePooledActor(PxShape* Shape)
+{
+	if (!Shape)
+	{
+		return nullptr;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+
+	const FPhysXShapeCacheKey* Key = KeyByShape.Find(Shape);
+	FEntry* Entry = Key ? Entries.Find(*Key) : nullptr;
+	if (!Entry || Entry->PooledActors.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	PxRigidDynamic* Actor = Entry->PooledActors.Pop(/*bAllowShrinking=*/false);
+	--NumPooled;
+
+	// The pooled actor's reference moves to the new body; the one from Acquire() is redundant.
+	check(Entry->RefCount > 1);
+	--Entry->RefCount;
+
+	return Actor;
+}
+
+bool FPhysXInstancedShapeCache::RecycleActor(PxRigidDynamic& Actor, PxShape* Shape)
+{
+	if (!Shape || Actor.getScene())
+	{
+		return false;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+
+	const FPhysXShapeCacheKey* Key = KeyByShape.Find(Shape);
+	FEntry* Entry = Key ? Entries.Find(*Key) : nullptr;
+	if (!Entry || Entry->PooledActors.Num() >= MaxPooledActorsPerShape)
+	{
+		return false;
+	}
+
+	// Reset state the subsystem toggles at runtime; the spawn path re-applies everything else.
+	Actor.userData = nullptr;
+	Actor.setActorFlag(PxActorFlag::eDISABLE_SIMULATION, false);
+	Actor.setRigidBodyFlag(PxRigidBodyFlag::eKINEMATIC, false);
+	Actor.setRigidBodyFlag(PxRigidBodyFlag::eENABLE_CCD, false);
+	Actor.setRigidDynamicLockFlags(PxRigidDynamicLockFlags(0));
+	Actor.setLinearVelocity(PxVec3(0.f), /*autowake=*/false);
+	Actor.setAngularVelocity(PxVec3(0.f), /*autowake=*/false);
+
+	Entry->PooledActors.Add(&Actor);
+	++NumPooled;
+	return true;
+}
+
+void FPhysXInstancedShapeCache::TrimPool_Locked(FEntry& Entry, int32 MaxPooled)
+{
+	PxShape* Shape = Entry.Shape;
+
+	while (Entry.PooledActors.Num() > MaxPooled)
+	{
+		Entry.PooledActors.Pop(/*bAllowShrinking=*/false)->release();
+		--NumPooled;
+		--Entry.RefCount;
+	}
+
+	if (Entry.RefCount > 0)
+	{
+		return;
+	}
+
+	// Only parked actors were keeping the shape alive.
+	const FPhysXShapeCacheKey Key = KeyByShape.FindChecked(Shape);
+	Entries.Remove(Key);
+	KeyByShape.Remove(Shape);
+
+	Shape->release();
+}
+
+bool FPhysXInstancedShapeCache::ApplyMassProperties(PxRigidDynamic& Body, PxShape* Shape, float Density, float MassScale)
+{
+	if (!Shape || Shape->getGeometryType() == PxGeometryType::eTRIANGLEMESH)
+	{
+		return false;
+	}
+
+	FMassProperties Props;
+
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		const FPhysXShapeCacheKey* Key = KeyByShape.Find(Shape);
+		FEntry* Entry = Key ? Entries.Find(*Key) : nullptr;
+		if (!Entry)
+		{
+			return false;
+		}
+
+		const FMassProperties* Cached = Entry->MassProperties.FindByPredicate([Density, MassScale](const FMassProperties& Candidate)
+		{
+			return Candidate.Density == Density && Candidate.MassScale == MassScale;
+		});
+
+		if (Cached)
+		{
+			Props = *Cached;
+		}
+		else
+		{
+			// Same math as PxRigidBodyExt::updateMassAndInertia for a single shape with uniform density.
+			const PxShape* const ShapeList[1] = { Shape };
+			const PxMassProperties MassProps =
+				PxRigidBodyExt::computeMassPropertiesFromShapes(ShapeList, 1) * (PxReal)(Density * MassScale);
+
+			if (!(MassProps.mass > 0.f))
+			{
+				return false;
+			}
+
+			PxQuat MassFrame;
+			const PxVec3 Diagonal = PxMassProperties::getMassSpaceInertia(MassProps.inertiaTensor, MassFrame);
+
+			Props.Density         = Density;
+			Props.MassScale       = MassScale;
+			Props.Mass            = MassProps.mass;
+			Props.InertiaDiagonal = Diagonal;
+			Props.CMassLocalPose  = PxTransform(MassProps.centerOfMass, MassFrame);
+
+			Entry->MassProperties.Add(Props);
+		}
+	}
+
+	Body.setMass(Props.Mass);
+	Body.setMassSpaceInertiaTensor(Props.InertiaDiagonal);
+	Body.setCMassLocalPose(Props.CMassLocalPose);
+	return true;
+}
+
+FVector FPhysXInstancedShapeCache::QuantizeScale(const FVector& Scale, float Quantum)
+{
+	if (Quantum <= 0.f)
+	{
+		return Scale;
+	}
+
+	auto SnapAxis = [Quantum](float Value) -> float
+	{
+		const float Snapped = FMath::RoundToFloat(Value / Quantum) * Quantum;
+		if (FMath::Abs(Snapped) >= Quantum)
+		{
+			return Snapped;
+		}
+
+		// Keep tiny scales non-degenerate; the sign is preserved for mirrored instances.
+		return (Value < 0.f) ? -Quantum : Quantum;
+	};
+
+	return FVector(SnapAxis(Scale.X), SnapAxis(Scale.Y), SnapAxis(Scale.Z));
+}
+
+#endif // PHYSICS_INTERFACE_PHYSX
@@ -0,0 +1,570 @@
+﻿/**
+* Copyright (C) 2025 | Created by NordVader Inc.
+* All rights reserved!
+* My Discord Server: https://discord.gg/B8prpf3vzD
+*/
+
+#include "PhysXInstancedSpatialHash.h"
+
+// -----------------------------------------------------------------------------
+// Bookkeeping
+// -----------------------------------------------------------------------------
+
+FIntVector FPhysXInstancedSpatialHash::GetCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt(Location.X * InvCellSize),
+		FMath::FloorToInt(Location.Y * InvCellSize),
+		FMath::FloorToInt(Location.Z * InvCellSize));
+}
+
+void FPhysXInstancedSpatialHash::AddToCell(FPhysXInstanceID ID, const FVector& Location, FEntry& Entry)
+{
+	Entry.Cell = GetCell(Location);
+
+	TArray<FCellItem>& Items = Cells.FindOrAdd(Entry.Cell);
+	Entry.SlotInCell = Items.Num();
+
+	FCellItem& Item = Items.AddDefaulted_GetRef();
+	Item.ID       = ID;
+	Item.Location = Location;
+
+	if (!bHasOccupiedBounds)
+	{
+		OccupiedMin = Entry.Cell;
+		OccupiedMax = Entry.Cell;
+		bHasOccupiedBounds = true;
+	}
+	else
+	{
+		OccupiedMin = FIntVector(FMath::Min(OccupiedMin.X, Entry.Cell.X), FMath::Min(OccupiedMin.Y, Entry.Cell.Y), FMath::Min(OccupiedMin.Z, Entry.Cell.Z));
+		OccupiedMax = FIntVector(FMath::Max(OccupiedMax.X, Entry.Cell.X), FMath::Max(OccupiedMax.Y, Entry.Cell.Y), FMath::Max(OccupiedMax.Z, Entry.Cell.Z));
+	}
+}
+
+void FPhysXInstancedSpatialHash::RemoveFromCell(const FEntry& Entry)
+{
+	TArray<FCellItem>* Items = Cells.Find(Entry.Cell);
+	if (!Items || !Items->IsValidIndex(Entry.SlotInCell))
+	{
+		return;
+	}
+
+	Items->RemoveAtSwap(Entry.SlotInCell, 1, /*bAllowShrinking=*/false);
+
+	// The former last item now lives in the freed slot.
+	if (Items->IsValidIndex(Entry.SlotInCell))
+	{
+		if (FEntry* Moved = Entries.Find((*Items)[Entry.SlotInCell].ID))
+		{
+			Moved->SlotInCell = Entry.SlotInCell;
+		}
+	}
+
+	if (Items->Num() == 0)
+	{
+		Cells.Remove(Entry.Cell);
+	}
+}
+
+void FPhysXInstancedSpatialHash::Update(FPhysXInstanceID ID, const FVector& Location)
+{
+	if (!ID.IsValid())
+	{
+		return;
+	}
+
+	FEntry* Existing = Entries.Find(ID);
+	if (!Existing)
+	{
+		FEntry& NewEntry = Entries.Add(ID);
+		AddToCell(ID, Location, NewEntry);
+		return;
+	}
+
+	const FIntVector NewCell = GetCell(Location);
+	if (NewCell == Existing->Cell)
+	{
+		Cells.FindChecked(NewCell)[Existing->SlotInCell].Location = Location;
+		return;
+	}
+
+	RemoveFromCell(*Existing);
+	AddToCell(ID, Location, *Existing);
+}
+
+bool FPhysXInstancedSpatialHash::Remove(FPhysXInstanceID ID)
+{
+	FEntry Entry;
+	if (!Entries.RemoveAndCopyValue(ID, Entry))
+	{
+		return false;
+	}
+
+	RemoveFromCell(Entry);
+	return true;
+}
+
+bool FPhysXInstancedSpatialHash::GetLocation(FPhysXInstanceID ID, FVector& OutLocation) const
+{
+	const FEntry* Entry = Entries.Find(ID);
+	if (!Entry)
+	{
+		return false;
+	}
+
+	OutLocation = Cells.FindChecked(Entry->Cell)[Entry->SlotInCell].Location;
+	return true;
+}
+
+void FPhysXInstancedSpatialHash::Reset()
+{
+	Cells.Reset();
+	Entries.Reset();
+
+	OccupiedMin = FIntVector::ZeroValue;
+	OccupiedMax = FIntVector::ZeroValue;
+	bHasOccupiedBounds = false;
+}
+
+void FPhysXInstancedSpatialHash::SetCellSize(float InCellSize)
+{
+	InCellSize = FMath::Max(InCellSize, 1.f);
+	if (InCellSize == CellSize)
+	{
+		return;
+	}
+
+	TArray<FCellItem> All;
+	All.Reserve(Entries.Num());
+	for (const TPair<FIntVector, TArray<FCellItem>>& Pair : Cells)
+	{
+		All.Append(Pair.Value);
+	}
+
+	Reset();
+
+	CellSize    = InCellSize;
+	InvCellSize = 1.f / InCellSize;
+
+	for (const FCellItem& Item : All)
+	{
+		Update(Item.ID, Item.Location);
+	}
+}
+
+// -----------------------------------------------------------------------------
+// Queries
+// -----------------------------------------------------------------------------
+
+bool FPhysXInstancedSpatialHash::ForEachCellInRange(
+	const FIntVector& MinCell,
+	const FIntVector& MaxCell,
+	TFunctionRef<bool(const FCellItem&)> Visitor) const
+{
+	return ForEachOccupiedCellInRange(MinCell, MaxCell,
+		[&](const FIntVector& /*Cell*/, const TArray<FCellItem>& Items)
+		{
+			for (const FCellItem& Item : Items)
+			{
+				if (!Visitor(Item))
+				{
+					return false;
+				}
+			}
+			return true;
+		});
+}
+
+bool FPhysXInstancedSpatialHash::ForEachOccupiedCellInRange(
+	const FIntVector& MinCell,
+	const FIntVector& MaxCell,
+	TFunctionRef<bool(const FIntVector&, const TArray<FCellItem>&)> Visitor) const
+{
+	const int64 NumInRange =
+		(int64)(MaxCell.X - MinCell.X + 1) *
+		(int64)(MaxCell.Y - MinCell.Y + 1) *
+		(int64)(MaxCell.Z - MinCell.Z + 1);
+
+	// Huge ranges over a sparse grid: walking the occupied cells is cheaper than probing empty ones.
+	if (NumInRange > Cells.Num())
+	{
+		for (const TPair<FIntVector, TArray<FCellItem>>& Pair : Cells)
+		{
+			const FIntVector& C = Pair.Key;
+			if (C.X < MinCell.X || C.X > MaxCell.X ||
+				C.Y < MinCell.Y || C.Y > MaxCell.Y ||
+				C.Z < MinCell.Z || C.Z > MaxCell.Z)
+			{
+				continue;
+			}
+
+			if (!Visitor(C, Pair.Value))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				const FIntVector Cell(X, Y, Z);
+
+				const TArray<FCellItem>* Items = Cells.Find(Cell);
+				if (Items && !Visitor(Cell, *Items))
+				{
+					return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+int32 FPhysXInstancedSpatialHash::ForEachInSphere(
+	const FVector& Center,
+	float Radius,
+	TFunctionRef<bool(FPhysXInstanceID, const FVector&)> Visitor) const
+{
+	if (Radius < 0.f || Entries.Num() == 0)
+	{
+		return 0;
+	}
+
+	const float RadiusSq = Radius * Radius;
+	int32 NumVisited = 0;
+
+	ForEachCellInRange(GetCell(Center - FVector(Radius)), GetCell(Center + FVector(Radius)),
+		[&](const FCellItem& Item)
+		{
+			if (FVector::DistSquared(Center, Item.Location) > RadiusSq)
+			{
+				return true;
+			}
+
+			++NumVisited;
+			return Visitor(Item.ID, Item.Location);
+		});
+
+	return NumVisited;
+}
+
+int32 FPhysXInstancedSpatialHash::ForEachInBox(
+	const FBox& Box,
+	TFunctionRef<bool(FPhysXInstanceID, const FVector&)> Visitor) const
+{
+	if (!Box.IsValid || Entries.Num() == 0)
+	{
+		return 0;
+	}
+
+	int32 NumVisited = 0;
+
+	ForEachCellInRange(GetCell(Box.Min), GetCell(Box.Max),
+		[&](const FCellItem& Item)
+		{
+			if (!Box.IsInsideOrOn(Item.Location))
+			{
+				return true;
+			}
+
+			++NumVisited;
+			return Visitor(Item.ID, Item.Location);
+		});
+
+	return NumVisited;
+}
+
+int32 FPhysXInstancedSpatialHash::ForEachInConvexVolume(
+	const FConvexVolume& Volume,
+	const FBox& Bounds,
+	float ItemRadius,
+	TFunctionRef<bool(FPhysXInstanceID, const FVector&)> Visitor) const
+{
+	if (!Bounds.IsValid || Entries.Num() == 0)
+	{
+		return 0;
+	}
+
+	ItemRadius = FMath::Max(ItemRadius, 0.f);
+
+	const FVector CellExtent = FVector(0.5f * CellSize + ItemRadius);
+	int32 NumVisited = 0;
+
+	ForEachOccupiedCellInRange(GetCell(Bounds.Min - FVector(ItemRadius)), GetCell(Bounds.Max + FVector(ItemRadius)),
+		[&](const FIntVector& Cell, const TArray<FCellItem>& Items)
+		{
+			// FConvexVolume tests four planes per SIMD step, for the cell box and for each entry.
+			bool bFullyContained = false;
+			if (!Volume.IntersectBox((FVector(Cell) + FVector(0.5f)) * CellSize, CellExtent, bFullyContained))
+			{
+				return true;
+			}
+
+			for (const FCellItem& Item : Items)
+			{
+				if (!bFullyContained && !Volume.IntersectSphere(Item.Location, ItemRadius))
+				{
+					continue;
+				}
+
+				++NumVisited;
+				if (!Visitor(Item.ID, Item.Location))
+				{
+					return false;
+				}
+			}
+			return true;
+		});
+
+	return NumVisited;
+}
+
+int32 FPhysXInstancedSpatialHash::ForEachInCone(
+	const FVector& Origin,
+	const FVector& Direction,
+	float HalfAngleRadians,
+	float Length,
+	TFunctionRef<bool(FPhysXInstanceID, const FVector&)> Visitor) const
+{
+	if (Length <= 0.f || Entries.Num() == 0)
+	{
+		return 0;
+	}
+
+	const FVector Axis = Direction.GetSafeNormal();
+	if (Axis.IsNearlyZero())
+	{
+		return 0;
+	}
+
+	HalfAngleRadians = FMath::Clamp(HalfAngleRadians, 0.f, PI);
+
+	float SinHalf, CosHalf;
+	FMath::SinCos(&SinHalf, &CosHalf, HalfAngleRadians);
+
+	const float LengthSq = Length * Length;
+	const float CosSq    = CosHalf * CosHalf;
+
+	// Bounds: apex, rim disk and tip; wide cones fall back to the bounding sphere of the apex.
+	FBox Bounds(Origin - FVector(Length), Origin + FVector(Length));
+	if (HalfAngleRadians < HALF_PI)
+	{
+		const FVector CapCenter = Origin + Axis * (Length * CosHalf);
+		const float   CapRadius = Length * SinHalf;
+		const FVector CapExtent(
+			CapRadius * FMath::Sqrt(FMath::Max(0.f, 1.f - Axis.X * Axis.X)),
+			CapRadius * FMath::Sqrt(FMath::Max(0.f, 1.f - Axis.Y * Axis.Y)),
+			CapRadius * FMath::Sqrt(FMath::Max(0.f, 1.f - Axis.Z * Axis.Z)));
+
+		Bounds = FBox(CapCenter - CapExtent, CapCenter + CapExtent);
+		Bounds += Origin;
+		Bounds += Origin + Axis * Length;
+
+		// A world axis inside the cone: the spherical cap reaches the full length along it.
+		for (int32 i = 0; i < 3; ++i)
+		{
+			if (Axis[i] > CosHalf)
+			{
+				Bounds.Max[i] = Origin[i] + Length;
+			}
+			else if (-Axis[i] > CosHalf)
+			{
+				Bounds.Min[i] = Origin[i] - Length;
+			}
+		}
+	}
+
+	// Half the cell diagonal.
+	const float CellRadius = 0.5f * CellSize * 1.7320508f;
+	int32 NumVisited = 0;
+
+	ForEachOccupiedCellInRange(GetCell(Bounds.Min), GetCell(Bounds.Max),
+		[&](const FIntVector& Cell, const TArray<FCellItem>& Items)
+		{
+			// Conservative sphere-vs-cone cull of the whole cell.
+			const FVector ToCell = (FVector(Cell) + FVector(0.5f)) * CellSize - Origin;
+			const float   DistSq = ToCell.SizeSquared();
+			if (DistSq > FMath::Square(Length + CellRadius))
+			{
+				return true;
+			}
+
+			const float Along = FVector::DotProduct(ToCell, Axis);
+			const float Perp  = FMath::Sqrt(FMath::Max(0.f, DistSq - Along * Along));
+			if (Perp * CosHalf - Along * SinHalf > CellRadius)
+			{
+				return true;
+			}
+
+			for (const FCellItem& Item : Items)
+			{
+				const FVector V   = Item.Location - Origin;
+				const float   VSq = V.SizeSquared();
+				const float   A   = FVector::DotProduct(V, Axis);
+
+				// A >= |V| * cos(half angle), squared without the square root.
+				const bool bInside = (CosHalf >= 0.f)
+					? (A >= 0.f && A * A >= VSq * CosSq)
+					: (A >= 0.f || A * A <= VSq * CosSq);
+
+				if (VSq > LengthSq || !bInside)
+				{
+					continue;
+				}
+
+				++NumVisited;
+				if (!Visitor(Item.ID, Item.Location))
+				{
+					return false;
+				}
+			}
+			return true;
+		});
+
+	return NumVisited;
+}
+
+FPhysXInstanceID FPhysXInstancedSpatialHash::FindNearest(
+	const FVector& Location,
+	float MaxDistance,
+	TFunctionRef<bool(FPhysXInstanceID, const FVector&)> Filter,
+	float* OutDistSq) const
+{
+	FNeighbor Best;
+	if (FindKNearest(Location, MaxDistance, Filter, MakeArrayView(&Best, 1)) == 0)
+	{
+		return FPhysXInstanceID();
+	}
+
+	if (OutDistSq)
+	{
+		*OutDistSq = Best.DistSq;
+	}
+
+	return Best.ID;
+}
+
+int32 FPhysXInstancedSpatialHash::FindKNearest(
+	const FVector& Location,
+	float MaxDistance,
+	TFunctionRef<bool(FPhysXInstanceID, const FVector&)> Filter,
+	TArrayView<FNeighbor> OutNeighbors) const
+{
+	const int32 K = OutNeighbors.Num();
+	if (K == 0 || Entries.Num() == 0)
+	{
+		return 0;
+	}
+
+	const float MaxDistSq = (MaxDistance > 0.f) ? FMath::Square(MaxDistance) : TNumericLimits<float>::Max();
+	int32 Count = 0;
+
+	// OutNeighbors stays sorted; K is small, so insertion beats a heap.
+	auto TestItem = [&](const FCellItem& Item)
+	{
+		const float DistSq = FVector::DistSquared(Location, Item.Location);
+		const bool bEnters = (Count < K) ? (DistSq <= MaxDistSq) : (DistSq < OutNeighbors[K - 1].DistSq);
+		if (!bEnters || !Filter(Item.ID, Item.Location))
+		{
+			return;
+		}
+
+		int32 Slot = (Count < K) ? Count++ : K - 1;
+		while (Slot > 0 && OutNeighbors[Slot - 1].DistSq > DistSq)
+		{
+			OutNeighbors[Slot] = OutNeighbors[Slot - 1];
+			--Slot;
+		}
+
+		OutNeighbors[Slot].ID     = Item.ID;
+		OutNeighbors[Slot].DistSq = DistSq;
+	};
+
+	const FIntVector Origin = GetCell(Location);
+
+	// Rings beyond the occupied bounds (or MaxDistance) cannot hold anything.
+	int32 MaxRing = FMath::Max3(
+		FMath::Max(FMath::Abs(Origin.X - OccupiedMin.X), FMath::Abs(OccupiedMax.X - Origin.X)),
+		FMath::Max(FMath::Abs(Origin.Y - OccupiedMin.Y), FMath::Abs(OccupiedMax.Y - Origin.Y)),
+		FMath::Max(FMath::Abs(Origin.Z - OccupiedMin.Z), FMath::Abs(OccupiedMax.Z - Origin.Z)));
+
+	if (MaxDistance > 0.f)
+	{
+		MaxRing = FMath::Min(MaxRing, FMath::CeilToInt(MaxDistance * InvCellSize) + 1);
+	}
+
+	// Distance from Location to the nearest face of its own cell; ring R starts (R - 1) cells past it.
+	const FVector CellMin = FVector(Origin) * CellSize;
+	const FVector InCell  = Location - CellMin;
+	const float FaceDist  = FMath::Min3(
+		FMath::Min(InCell.X, CellSize - InCell.X),
+		FMath::Min(InCell.Y, CellSize - InCell.Y),
+		FMath::Min(InCell.Z, CellSize - InCell.Z));
+
+	int64 NumProbed = 0;
+
+	for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+	{
+		if (Ring > 0 && Count == K)
+		{
+			const float RingDist = FMath::Max(0.f, FaceDist + (Ring - 1) * CellSize);
+			if (FMath::Square(RingDist) > OutNeighbors[K - 1].DistSq)
+			{
+				break;
+			}
+		}
+
+		const int64 Side      = 2 * (int64)Ring + 1;
+		const int64 InnerSide = FMath::Max<int64>(Side - 2, 0);
+		const int64 NumShell  = Side * Side * Side - InnerSide * InnerSide * InnerSide;
+
+		// Probing the remaining rings would cost more than one pass over the occupied cells.
+		// The pass revisits the rings already probed, so it starts from an empty result.
+		if (NumProbed + NumShell > Cells.Num())
+		{
+			Count = 0;
+			for (const TPair<FIntVector, TArray<FCellItem>>& Pair : Cells)
+			{
+				for (const FCellItem& Item : Pair.Value)
+				{
+					TestItem(Item);
+				}
+			}
+			break;
+		}
+
+		NumProbed += NumShell;
+
+		for (int32 DX = -Ring; DX <= Ring; ++DX)
+		{
+			for (int32 DY = -Ring; DY <= Ring; ++DY)
+			{
+				const bool bOnShellXY = (FMath::Abs(DX) == Ring || FMath::Abs(DY) == Ring);
+				const int32 StepZ = bOnShellXY ? 1 : FMath::Max(2 * Ring, 1);
+
+				for (int32 DZ = -Ring; DZ <= Ring; DZ += StepZ)
+				{
+					const TArray<FCellItem>* Items = Cells.Find(Origin + FIntVector(DX, DY, DZ));
+					if (!Items)
+					{
+						continue;
+					}
+
+					for (const FCellItem& Item : *Items)
+					{
+						TestItem(Item);
+					}
+				}
+			}
+		}
+	}
+
+	return Count;
+}
@@ -0,0 +1,539 @@
+﻿/**
+* Copyright (C) 2025 | Created by NordVader Inc.
+* All rights reserved!
+* My Discord Server: https://discord.gg/B8prpf3vzD
+*/
+
+#include "PhysXInstancedStorageBVH.h"
+
+namespace
+{
+	/** Half the surface area of a box; only ever compared, so the factor does not matter. */
+	FORCEINLINE float GetBoxArea(const FBox& Box)
+	{
+		const FVector E = Box.Max - Box.Min;
+		return E.X * E.Y + E.Y * E.Z + E.Z * E.X;
+	}
+}
+
+// -----------------------------------------------------------------------------
+// Node management
+// -----------------------------------------------------------------------------
+
+int32 FPhysXInstancedStorageBVH::AllocateNode()
+{
+	if (FreeNodes.Num() > 0)
+	{
+		const int32 NodeIndex = FreeNodes.Pop(/*bAllowShrinking=*/false);
+		Nodes[NodeIndex] = FNode();
+		return NodeIndex;
+	}
+
+	return Nodes.AddDefaulted();
+}
+
+void FPhysXInstancedStorageBVH::FreeNode(int32 NodeIndex)
+{
+	Nodes[NodeIndex] = FNode();
+	FreeNodes.Add(NodeIndex);
+}
+
+void FPhysXInstancedStorageBVH::RefitFrom(int32 NodeIndex)
+{
+	while (NodeIndex != INDEX_NONE)
+	{
+		FNode& Node = Nodes[NodeIndex];
+		Node.Bounds = Nodes[Node.Left].Bounds + Nodes[Node.Right].Bounds;
+		NodeIndex = Node.Parent;
+	}
+}
+
+void FPhysXInstancedStorageBVH::InsertLeaf(int32 Leaf)
+{
+	if (Root == INDEX_NONE)
+	{
+		Root = Leaf;
+		Nodes[Leaf].Parent = INDEX_NONE;
+		return;
+	}
+
+	const FBox LeafBox = Nodes[Leaf].Bounds;
+
+	// Walk down towards the sibling whose enlargement costs the least surface area.
+	int32 Index = Root;
+	while (!Nodes[Index].IsLeaf())
+	{
+		const FNode& Node = Nodes[Index];
+
+		const float Area         = GetBoxArea(Node.Bounds);
+		const float CombinedArea = GetBoxArea(Node.Bounds + LeafBox);
+
+		// Cost of pairing with this node, and the enlargement every node below it inherits.
+		const float Cost        = 2.0f * CombinedArea;
+		const float InheritCost = 2.0f * (CombinedArea - Area);
+
+		auto GetChildCost = [&](int32 Child)
+		{
+			const FNode& ChildNode = Nodes[Child];
+			const float  NewArea   = GetBoxArea(ChildNode.Bounds + LeafBox);
+			return ChildNode.IsLeaf()
+				? NewArea + InheritCost
+				: (NewArea - GetBoxArea(ChildNode.Bounds)) + InheritCost;
+		};
+
+		const float CostLeft  = GetChildCost(Node.Left);
+		const float CostRight = GetChildCost(Node.Right);
+
+		if (Cost < CostLeft && Cost < CostRight)
+		{
+			break;
+		}
+
+		Index = (CostLeft < CostRight) ? Node.Left : Node.Right;
+	}
+
+	const int32 Sibling   = Index;
+	const int32 OldParent = Nodes[Sibling].Parent;
+	const int32 NewParent = AllocateNode();
+
+	FNode& Parent = Nodes[NewParent];
+	Parent.Parent = OldParent;
+	Parent.Left   = Sibling;
+	Parent.Right  = Leaf;
+	Parent.Bounds = Nodes[Sibling].Bounds + LeafBox;
+
+	Nodes[Sibling].Parent = NewParent;
+	Nodes[Leaf].Parent    = NewParent;
+
+	if (OldParent == INDEX_NONE)
+	{
+		Root = NewParent;
+	}
+	else
+	{
+		FNode& Grand = Nodes[OldParent];
+		(Grand.Left == Sibling ? Grand.Left : Grand.Right) = NewParent;
+		RefitFrom(OldParent);
+	}
+}
+
+void FPhysXInstancedStorageBVH::RemoveLeaf(int32 Leaf)
+{
+	if (Leaf == Root)
+	{
+		Root = INDEX_NONE;
+		return;
+	}
+
+	const int32 Parent  = Nodes[Leaf].Parent;
+	const int32 Grand   = Nodes[Parent].Parent;
+	const int32 Sibling = (Nodes[Parent].Left == Leaf) ? Nodes[Parent].Right : Nodes[Parent].Left;
+
+	// The sibling takes the parent's place.
+	if (Grand != INDEX_NONE)
+	{
+		FNode& GrandNode = Nodes[Grand];
+		(GrandNode.Left == Parent ? GrandNode.Left : GrandNode.Right) = Sibling;
+		Nodes[Sibling].Parent = Grand;
+		FreeNode(Parent);
+		RefitFrom(Grand);
+	}
+	else
+	{
+		Root = Sibling;
+		Nodes[Sibling].Parent = INDEX_NONE;
+		FreeNode(Parent);
+	}
+
+	Nodes[Leaf].Parent = INDEX_NONE;
+}
+
+// -----------------------------------------------------------------------------
+// Leaves
+// -----------------------------------------------------------------------------
+
+void FPhysXInstancedStorageBVH::Insert(FPhysXInstanceID ID, const FBox& Box)
+{
+	if (!ID.IsValid() || !Box.IsValid)
+	{
+		return;
+	}
+
+	++NumChangesSinceRebuild;
+
+	if (const int32* Existing = LeafByID.Find(ID))
+	{
+		const int32 Leaf = *Existing;
+		RemoveLeaf(Leaf);
+		Nodes[Leaf].Bounds = Box;
+		InsertLeaf(Leaf);
+		return;
+	}
+
+	const int32 Leaf = AllocateNode();
+	Nodes[Leaf].Bounds = Box;
+	Nodes[Leaf].ID     = ID;
+
+	LeafByID.Add(ID, Leaf);
+	InsertLeaf(Leaf);
+}
+
+bool FPhysXInstancedStorageBVH::Remove(FPhysXInstanceID ID)
+{
+	int32 Leaf = INDEX_NONE;
+	if (!LeafByID.RemoveAndCopyValue(ID, Leaf))
+	{
+		return false;
+	}
+
+	RemoveLeaf(Leaf);
+	FreeNode(Leaf);
+
+	++NumChangesSinceRebuild;
+	return true;
+}
+
+void FPhysXInstancedStorageBVH::Reset()
+{
+	Nodes.Reset();
+	FreeNodes.Reset();
+	LeafByID.Reset();
+
+	Root = INDEX_NONE;
+	NumChangesSinceRebuild = 0;
+}
+
+// -----------------------------------------------------------------------------
+// Rebuild
+// -----------------------------------------------------------------------------
+
+bool FPhysXInstancedStorageBVH::NeedsRebuild(int32 MinChanges) const
+{
+	return MinChanges > 0 && NumChangesSinceRebuild >= FMath::Max(MinChanges, LeafByID.Num() / 4);
+}
+
+void FPhysXInstancedStorageBVH::Rebuild()
+{
+	struct FItem
+	{
+		FPhysXInstanceID ID;
+		FBox             Bounds;
+		FVector          Center;
+	};
+
+	TArray<FItem> Items;
+	Items.Reserve(LeafByID.Num());
+
+	for (const TPair<FPhysXInstanceID, int32>& Pair : LeafByID)
+	{
+		const FBox& Bounds = Nodes[Pair.Value].Bounds;
+		Items.Add({ Pair.Key, Bounds, Bounds.GetCenter() });
+	}
+
+	Reset();
+
+	if (Items.Num() == 0)
+	{
+		return;
+	}
+
+	Nodes.Reserve(Items.Num() * 2 - 1);
+	LeafByID.Reserve(Items.Num());
+
+	struct FBuildTask
+	{
+		int32 Begin;
+		int32 End;
+		int32 Parent;
+		bool  bLeft;
+	};
+
+	TArray<FBuildTask, TInlineAllocator<64>> Stack;
+	Stack.Add({ 0, Items.Num(), INDEX_NONE, false });
+
+	while (Stack.Num() > 0)
+	{
+		const FBuildTask Task = Stack.Pop(/*bAllowShrinking=*/false);
+
+		const int32 NodeIndex = AllocateNode();
+		Nodes[NodeIndex].Parent = Task.Parent;
+
+		if (Task.Parent == INDEX_NONE)
+		{
+			Root = NodeIndex;
+		}
+		else
+		{
+			FNode& Parent = Nodes[Task.Parent];
+			(Task.bLeft ? Parent.Left : Parent.Right) = NodeIndex;
+		}
+
+		const int32 Count = Task.End - Task.Begin;
+		if (Count == 1)
+		{
+			const FItem& Item = Items[Task.Begin];
+			Nodes[NodeIndex].Bounds = Item.Bounds;
+			Nodes[NodeIndex].ID     = Item.ID;
+			LeafByID.Add(Item.ID, NodeIndex);
+			continue;
+		}
+
+		// Split at the middle of the longest axis of the leaf centers.
+		FBox CenterBounds(ForceInit);
+		for (int32 i = Task.Begin; i < Task.End; ++i)
+		{
+			CenterBounds += Items[i].Center;
+		}
+
+		const FVector Size = CenterBounds.GetSize();
+		const int32 Axis = (Size.X >= Size.Y && Size.X >= Size.Z) ? 0 : (Size.Y >= Size.Z ? 1 : 2);
+		const float Split = CenterBounds.GetCenter()[Axis];
+
+		int32 Mid = Task.Begin;
+		for (int32 i = Task.Begin; i < Task.End; ++i)
+		{
+			if (Items[i].Center[Axis] < Split)
+			{
+				Swap(Items[i], Items[Mid]);
+				++Mid;
+			}
+		}
+
+		// Coincident centers: fall back to an even split.
+		if (Mid == Task.Begin || Mid == Task.End)
+		{
+			Mid = Task.Begin + Count / 2;
+		}
+
+		Stack.Add({ Mid, Task.End, NodeIndex, false });
+		Stack.Add({ Task.Begin, Mid, NodeIndex, true });
+	}
+
+	// Children are always allocated after their parent: one reverse pass fits every internal node.
+	for (int32 NodeIndex = Nodes.Num() - 1; NodeIndex >= 0; --NodeIndex)
+	{
+		FNode& Node = Nodes[NodeIndex];
+		if (!Node.IsLeaf())
+		{
+			Node.Bounds = Nodes[Node.Left].Bounds + Nodes[Node.Right].Bounds;
+		}
+	}
+
+	NumChangesSinceRebuild = 0;
+}
+
+// -----------------------------------------------------------------------------
+// Queries
+// -----------------------------------------------------------------------------
+
+int32 FPhysXInstancedStorageBVH::ForEachOverlappingSphere(
+	const FVector& Center,
+	float Radius,
+	TFunctionRef<bool(FPhysXInstanceID, const FBox&)> Visitor) const
+{
+	if (Root == INDEX_NONE || Radius < 0.0f)
+	{
+		return 0;
+	}
+
+	const float RadiusSq = Radius * Radius;
+	int32 NumVisited = 0;
+
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Add(Root);
+
+	while (Stack.Num() > 0)
+	{
+		const FNode& Node = Nodes[Stack.Pop(/*bAllowShrinking=*/false)];
+		if (!FMath::SphereAABBIntersection(Center, RadiusSq, Node.Bounds))
+		{
+			continue;
+		}
+
+		if (Node.IsLeaf())
+		{
+			++NumVisited;
+			if (!Visitor(Node.ID, Node.Bounds))
+			{
+				break;
+			}
+			continue;
+		}
+
+		Stack.Add(Node.Left);
+		Stack.Add(Node.Right);
+	}
+
+	return NumVisited;
+}
+
+int32 FPhysXInstancedStorageBVH::ForEachOverlappingBox(
+	const FBox& Box,
+	TFunctionRef<bool(FPhysXInstanceID, const FBox&)> Visitor) const
+{
+	if (Root == INDEX_NONE || !Box.IsValid)
+	{
+		return 0;
+	}
+
+	int32 NumVisited = 0;
+
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Add(Root);
+
+	while (Stack.Num() > 0)
+	{
+		const FNode& Node = Nodes[Stack.Pop(/*bAllowShrinking=*/false)];
+		if (!Node.Bounds.Intersect(Box))
+		{
+			continue;
+		}
+
+		if (Node.IsLeaf())
+		{
+			++NumVisited;
+			if (!Visitor(Node.ID, Node.Bounds))
+			{
+				break;
+			}
+			continue;
+		}
+
+		Stack.Add(Node.Left);
+		Stack.Add(Node.Right);
+	}
+
+	return NumVisited;
+}
+
+float FPhysXInstancedStorageBVH::RayCast(
+	const FVector& Start,
+	const FVector& End,
+	const FVector& Extent,
+	TFunctionRef<float(FPhysXInstanceID, float)> HitTest,
+	FPhysXInstanceID& OutID) const
+{
+	OutID = FPhysXInstanceID();
+
+	if (Root == INDEX_NONE)
+	{
+		return -1.0f;
+	}
+
+	const FVector Delta = End - Start;
+
+	bool  bParallel[3];
+	float InvDelta[3];
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		bParallel[Axis] = FMath::Abs(Delta[Axis]) < SMALL_NUMBER;
+		InvDelta[Axis]  = bParallel[Axis] ? 0.0f : 1.0f / Delta[Axis];
+	}
+
+	// Slab test against the inflated box; returns the entry fraction in [0, 1].
+	auto GetEntryFraction = [&](const FBox& Box, float& OutEntry)
+	{
+		float TMin = 0.0f;
+		float TMax = 1.0f;
+
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			const float Min = Box.Min[Axis] - Extent[Axis];
+			const float Max = Box.Max[Axis] + Extent[Axis];
+
+			if (bParallel[Axis])
+			{
+				if (Start[Axis] < Min || Start[Axis] > Max)
+				{
+					return false;
+				}
+				continue;
+			}
+
+			float T0 = (Min - Start[Axis]) * InvDelta[Axis];
+			float T1 = (Max - Start[Axis]) * InvDelta[Axis];
+			if (T0 > T1)
+			{
+				Swap(T0, T1);
+			}
+
+			TMin = FMath::Max(TMin, T0);
+			TMax = FMath::Min(TMax, T1);
+			if (TMin > TMax)
+			{
+				return false;
+			}
+		}
+
+		OutEntry = TMin;
+		return true;
+	};
+
+	struct FStackEntry
+	{
+		int32 NodeIndex;
+		float Entry;
+	};
+
+	float BestFraction = TNumericLimits<float>::Max();
+
+	TArray<FStackEntry, TInlineAllocator<64>> Stack;
+
+	float RootEntry = 0.0f;
+	if (GetEntryFraction(Nodes[Root].Bounds, RootEntry))
+	{
+		Stack.Add({ Root, RootEntry });
+	}
+
+	while (Stack.Num() > 0)
+	{
+		const FStackEntry Top = Stack.Pop(/*bAllowShrinking=*/false);
+		if (Top.Entry > BestFraction)
+		{
+			continue;
+		}
+
+		const FNode& Node = Nodes[Top.NodeIndex];
+
+		if (Node.IsLeaf())
+		{
+			const float HitFraction = HitTest(Node.ID, Top.Entry);
+			if (HitFraction >= 0.0f && HitFraction < BestFraction)
+			{
+				BestFraction = HitFraction;
+				OutID        = Node.ID;
+			}
+			continue;
+		}
+
+		float EntryLeft  = 0.0f;
+		float EntryRight = 0.0f;
+		const bool bHitLeft  = GetEntryFraction(Nodes[Node.Left].Bounds,  EntryLeft);
+		const bool bHitRight = GetEntryFraction(Nodes[Node.Right].Bounds, EntryRight);
+
+		// Push the farther child first so the nearer one is visited next.
+		if (bHitLeft && bHitRight)
+		{
+			if (EntryLeft < EntryRight)
+			{
+				Stack.Add({ Node.Right, EntryRight });
+				Stack.Add({ Node.Left,  EntryLeft });
+			}
+			else
+			{
+				Stack.Add({ Node.Left,  EntryLeft });
+				Stack.Add({ Node.Right, EntryRight });
+			}
+		}
+		else if (bHitLeft)
+		{
+			Stack.Add({ Node.Left, EntryLeft });
+		}
+		else if (bHitRight)
+		{
+			Stack.Add({ Node.Right, EntryRight });
+		}
+	}
+
+	return OutID.IsValid() ? BestFraction : -1.0f;
+}
@@ -10,16 +10,53 @@
 
 namespace PhysXIS
 {
+	static constexpr int32 Order_AsyncBodyCreation  = 5;
+	static constexpr int32 Order_CookedShapes       = 6;
 	static constexpr int32 Order_AddActors          = 10;
 	static constexpr int32 Order_InstanceTasks      = 20;
 	static constexpr int32 Order_PhysicsStepCompute = 30;
 	static constexpr int32 Order_PhysicsStepStop    = 31;
 	static constexpr int32 Order_PhysicsStepSync    = 32;
 	static constexpr int32 Order_PhysicsStepFinalize= 33;
+	static constexpr int32 Order_AsyncQueries       = 34;
+	static constexpr int32 Order_RenderTiers        = 35;
+	static constexpr int32 Order_StorageTrees       = 36;
 	static constexpr int32 Order_Lifetime           = 40;
 
 #if PHYSICS_INTERFACE_PHYSX
 
+	class FAsyncBodyCreationProcess final : public IPhysXISProcess
+	{
+	public:
+		virtual const TCHAR* GetName() const override { return TEXT("PhysXIS.AsyncBodyCreation"); }
+		virtual int32 GetOrder() const override { return Order_AsyncBodyCreation; }
+		virtual EPhysXISProcessCategory GetCategory() const override { return EPhysXISProcessCategory::SceneInsertion; }
+
+		virtual void Tick(FPhysXISProcessContext& Context) override
+		{
+			if (Context.Subsystem)
+			{
+				Context.Subsystem->ProcessAsyncBodyCreation();
+			}
+		}
+	};
+
+	class FCookedShapesProcess final : public IPhysXISProcess
+	{
+	public:
+		virtual const TCHAR* GetName() const override { return TEXT("PhysXIS.CookedShapes"); }
+		virtual int32 GetOrder() const override { return Order_CookedShapes; }
+		virtual EPhysXISProcessCategory GetCategory() const override { return EPhysXISProcessCategory::SceneInsertion; }
+
+		virtual void Tick(FPhysXISProcessContext& Context) override
+		{
+			if (Context.Subsystem)
+			{
+				Context.Subsystem->ProcessCookedShapeSwaps();
+			}
+		}
+	};
+
 	class FAddActorsProcess final : public IPhysXISProcess
 	{
 	public:
@@ -116,8 +153,57 @@ namespace PhysXIS
 		}
 	};
 
+	class FRenderTiersProcess final : public IPhysXISProcess
+	{
+	public:
+		virtual const TCHAR* GetName() const override { return TEXT("PhysXIS.RenderTiers"); }
+		virtual int32 GetOrder() const override { return Order_RenderTiers; }
+		virtual EPhysXISProcessCategory GetCategory() const override { return EPhysXISProcessCategory::Rendering; }
+
+		virtual void Tick(FPhysXISProcessContext& Context) override
+		{
+			if (Context.Subsystem)
+			{
+				Context.Subsystem->ProcessRenderTierMigrations();
+			}
+		}
+	};
+
 #endif // PHYSICS_INTERFACE_PHYSX
 
+	/** Runs after the physics step so queued queries see this frame's body poses. */
+	class FAsyncQueriesProcess final : public IPhysXISProcess
+	{
+	public:
+		virtual const TCHAR* GetName() const override { return TEXT("PhysXIS.AsyncQueries"); }
+		virtual int32 GetOrder() const override { return Order_AsyncQueries; }
+		virtual EPhysXISProcessCategory GetCategory() const override { return EPhysXISProcessCategory::Other; }
+
+		virtual void Tick(FPhysXISProcessContext& Context) override
+		{
+			if (Context.Subsystem)
+			{
+				Context.Subsystem->ProcessAsyncQueries();
+			}
+		}
+	};
+
+	class FStorageTreesProcess final : public IPhysXISProcess
+	{
+	public:
+		virtual const TCHAR* GetName() const override { return TEXT("PhysXIS.StorageTrees"); }
+		virtual int32 GetOrder() const override { return Order_StorageTrees; }
+		virtual EPhysXISProcessCategory GetCategory() const override { return EPhysXISProcessCategory::Rendering; }
+
+		virtual void Tick(FPhysXISProcessContext& Context) override
+		{
+			if (Context.Subsystem)
+			{
+				Context.Subsystem->ProcessStorageTreeRebuilds();
+			}
+		}
+	};
+
 	class FLifetimeProcess final : public IPhysXISProcess
 	{
 	public:
@@ -137,6 +223,8 @@ namespace PhysXIS
 	void RegisterDefaultProcesses(FPhysXISProcessManager& Manager)
 	{
 #if PHYSICS_INTERFACE_PHYSX
+		Manager.AddProcess<FAsyncBodyCreationProcess>();
+		Manager.AddProcess<FCookedShapesProcess>();
 		Manager.AddProcess<FAddActorsProcess>();
 		Manager.AddProcess<FInstanceTasksProcess>();
 
@@ -144,7 +232,11 @@ namespace PhysXIS
 		Manager.AddProcess<FPhysicsStepStopActionsProcess>();
 		Manager.AddProcess<FPhysicsStepTransformSyncProcess>();
 		Manager.AddProcess<FPhysicsStepFinalizeProcess>();
+
+		Manager.AddProcess<FRenderTiersProcess>();
 #endif
+		Manager.AddProcess<FAsyncQueriesProcess>();
+		Manager.AddProcess<FStorageTreesProcess>();
 		Manager.AddProcess<FLifetimeProcess>();
 	}
 }
\ No newline at end of file
@@ -8,20 +8,27 @@
 
 // Plugin
 #include "Actors/PhysXInstancedMeshActor.h"
+#include "Components/PhysXInstancedHierarchicalStaticMeshComponent.h"
 #include "Components/PhysXInstancedStaticMeshComponent.h"
 #include "Debug/PhysXInstancedStats.h"
 #include "PhysXInstancedBody.h"
+#include "PhysXInstancedCookedMeshCache.h"
 #include "Processes/PhysXInstancedDefaultProcesses.h"
 #include "Processes/PhysXInstancedProcessPipeline.h"
+#include "Types/PhysXInstanceArchetype.h"
 #include "Types/PhysXInstanceEvents.h"
 #include "Types/PhysXInstancedTypes.h"
 
 // UE
+#include "Algo/BinarySearch.h"
+#include "Async/Async.h"
 #include "Async/ParallelFor.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
 #include "Components/InstancedStaticMeshComponent.h"
 #include "DrawDebugHelpers.h"
 #include "Engine/StaticMesh.h"
 #include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
 #include "PhysicsEngine/PhysicsSettings.h"
 
 // PhysX support glue
@@ -53,6 +60,19 @@ struct UPhysXInstancedWorldSubsystem::FPhysXInstanceUserData
 	FPhysXInstanceID InstanceID;
 };
 
+FPhysXInstancedShapeCache* UPhysXInstancedWorldSubsystem::GetShapeCacheForNewBodies()
+{
+	if (!bShareInstanceShapes)
+	{
+		return nullptr;
+	}
+
+	// Config may change in the editor; apply it before workers read the quantum.
+	ShapeCache.SetScaleQuantum(SharedShapeScaleQuantum);
+	ShapeCache.SetMaxPooledActorsPerShape(MaxPooledBodiesPerArchetype);
+	return &ShapeCache;
+}
+
 void UPhysXInstancedWorldSubsystem::EnsureInstanceUserData(FPhysXInstanceID ID)
 {
 	FPhysXInstanceData* Data = Instances.Find(ID);
@@ -158,6 +178,27 @@ static TAutoConsoleVariable<int32> CVarPhysXInstancedUseParallelRegister(
 
 #endif // PHYSICS_INTERFACE_PHYSX
 
+// Toggle for running batched queries across worker threads.
+static TAutoConsoleVariable<int32> CVarPhysXInstancedUseParallelQueries(
+	TEXT("physxinstanced.Query.Parallel"),
+	1,
+	TEXT("Use ParallelFor for batched instance queries.\n")
+	TEXT("0 = run every query of a batch on the calling thread.\n")
+	TEXT("1 = split batches into chunks of 16 queries and run them in parallel."),
+	ECVF_Default);
+
+// Toggle for the process pipeline; the fixed fallback sequence in Tick runs the same phases in the same order.
+static TAutoConsoleVariable<int32> CVarPhysXInstancedUseProcessPipeline(
+	TEXT("physxinstanced.Process.Pipeline"),
+	1,
+	TEXT("Tick the subsystem through its process pipeline.\n")
+	TEXT("0 = run the built-in phases in a fixed order (custom processes are skipped).\n")
+	TEXT("1 = tick the registered processes."),
+	ECVF_Default);
+
+// Queries per ParallelFor task; small enough to balance, large enough to amortize the scene lock.
+static constexpr int32 BatchQueryChunkSize = 16;
+
 namespace
 {
 #if ENABLE_DRAW_DEBUG
@@ -231,6 +272,21 @@ static void DrawSphereSafe(UWorld* World, const FVector& C, float R, const FColo
 	DrawDebugSphere(World, C, R, 16, Color, bPersistent, LifeTime, 0, Thickness);
 }
 
+static void DrawBoxSafe(UWorld* World, const FVector& C, const FVector& Extent, const FColor& Color, float Duration, float Thickness = 1.0f)
+{
+	if (!World)
+	{
+		return;
+	}
+
+	bool  bPersistent = false;
+	float LifeTime = 0.0f;
+	float StringDuration = 0.0f;
+	MakeDebugDrawParams(Duration, bPersistent, LifeTime, StringDuration);
+
+	DrawDebugBox(World, C, Extent, Color, bPersistent, LifeTime, 0, Thickness);
+}
+
 static void DrawArrowSafe(UWorld* World, const FVector& From, const FVector& To, const FColor& Color, float Duration, float Thickness = 1.5f)
 {
 	if (!World)
@@ -295,6 +351,56 @@ static bool HasInterfaceEvents(const APhysXInstancedMeshActor* Owner)
 	return Owner
 		&& Owner->GetClass()->ImplementsInterface(UPhysXInstanceEvents::StaticClass());
 }
+
+/**
+ * Material match used when collapsing instances into an existing actor.
+ * Variant actors accept any material set from their variant table (OutVariant is set);
+ * other actors require identical resolved materials.
+ */
+static bool DoesActorAcceptMaterials(
+	const APhysXInstancedMeshActor* Candidate,
+	const TArray<UMaterialInterface*>& Materials,
+	int32& OutVariant)
+{
+	OutVariant = INDEX_NONE;
+
+	if (!Candidate)
+	{
+		return false;
+	}
+
+	if (Candidate->UsesMaterialVariants())
+	{
+		OutVariant = Candidate->FindMaterialVariant(Materials);
+		return OutVariant != INDEX_NONE;
+	}
+
+	TArray<UMaterialInterface*> CandidateMaterials;
+	Candidate->GetResolvedMaterials(CandidateMaterials);
+
+	return CandidateMaterials == Materials;
+}
+
+/** True if RemoveInstance() on this component moves the last instance into the removed slot. */
+static bool UsesRemoveAtSwap(const UInstancedStaticMeshComponent* ISMC)
+{
+	if (!ISMC)
+	{
+		return false;
+	}
+
+	// HISM keeps its cluster tree stable by swap-removing in every engine version.
+	if (ISMC->IsA<UHierarchicalInstancedStaticMeshComponent>())
+	{
+		return true;
+	}
+
+#if ENGINE_MAJOR_VERSION >= 5
+	return ISMC->bSupportRemoveAtSwap != 0;
+#else
+	return false;
+#endif
+}
 	
 static bool GetInstanceWorldTransform_Safe(const FPhysXInstanceData& Data, FTransform& OutWorldTM)
 {
@@ -318,6 +424,31 @@ static bool GetInstanceWorldTransform_Safe(const FPhysXInstanceData& Data, FTran
 	return ISMC->GetInstanceTransform(Data.InstanceIndex, OutWorldTM, /*bWorldSpace=*/true);
 }
 
+static bool GetInstanceWorldBounds_Safe(const FPhysXInstanceData& Data, FBox& OutBounds)
+{
+	UInstancedStaticMeshComponent* ISMC = Data.InstancedComponent.Get();
+	const UStaticMesh* Mesh = ISMC ? ISMC->GetStaticMesh() : nullptr;
+	if (!Mesh)
+	{
+		return false;
+	}
+
+	FTransform WorldTM;
+	if (!GetInstanceWorldTransform_Safe(Data, WorldTM))
+	{
+		return false;
+	}
+
+	OutBounds = Mesh->GetBounds().GetBox().TransformBy(WorldTM);
+	return true;
+}
+
+static bool DoesComponentRespondToChannel(const UInstancedStaticMeshComponent* ISMC, ECollisionChannel Channel)
+{
+	return ISMC->GetCollisionEnabled() != ECollisionEnabled::NoCollision
+		&& ISMC->GetCollisionResponseToChannel(Channel) != ECR_Ignore;
+}
+
 static bool GetInstanceWorldLocation_Safe(const FPhysXInstanceData& Data, FVector& OutLocation)
 {
 	OutLocation = FVector::ZeroVector;
@@ -404,6 +535,137 @@ static bool GetInstanceWorldLocation_Safe(const FPhysXInstanceData& Data, FVecto
 	}
 }
 
+/**
+ * Outward-facing planes of the view volume behind a screen rectangle: four side planes through the
+ * deprojected corner rays plus near and far caps. Works for perspective and orthographic cameras.
+ */
+static bool BuildScreenRectVolume(
+	const APlayerController* PC,
+	const FVector2D& ScreenA,
+	const FVector2D& ScreenB,
+	float MaxDistance,
+	FConvexVolume& OutVolume,
+	FBox& OutBounds)
+{
+	if (!PC || MaxDistance <= 0.0f)
+	{
+		return false;
+	}
+
+	const FVector2D Min(FMath::Min(ScreenA.X, ScreenB.X), FMath::Min(ScreenA.Y, ScreenB.Y));
+	const FVector2D Max(FMath::Max(ScreenA.X, ScreenB.X), FMath::Max(ScreenA.Y, ScreenB.Y));
+	if (Max.X - Min.X < 1.0f || Max.Y - Min.Y < 1.0f)
+	{
+		return false;
+	}
+
+	// Corners in winding order, then the centre.
+	const FVector2D Screen[5] = { Min, FVector2D(Max.X, Min.Y), Max, FVector2D(Min.X, Max.Y), (Min + Max) * 0.5f };
+
+	FVector Origins[5];
+	FVector Dirs[5];
+	for (int32 i = 0; i < 5; ++i)
+	{
+		if (!PC->DeprojectScreenPositionToWorld(Screen[i].X, Screen[i].Y, Origins[i], Dirs[i]))
+		{
+			return false;
+		}
+	}
+
+	const FVector Inside = Origins[4] + Dirs[4] * (0.5f * MaxDistance);
+
+	auto AddPlane = [&OutVolume, &Inside](const FVector& Point, FVector Normal)
+	{
+		Normal = Normal.GetSafeNormal();
+		FPlane Plane(Point, Normal);
+		if (Plane.PlaneDot(Inside) > 0.0f)
+		{
+			Plane = Plane.Flip();
+		}
+		OutVolume.Planes.Add(Plane);
+	};
+
+	OutVolume.Planes.Reset();
+
+	for (int32 i = 0; i < 4; ++i)
+	{
+		const int32 j = (i + 1) % 4;
+
+		// Contains ray i and origin j; for perspective both rays meet at the eye, for ortho they are parallel.
+		FVector Normal = FVector::CrossProduct(Dirs[i], Origins[j] - Origins[i]);
+		if (Normal.IsNearlyZero())
+		{
+			Normal = FVector::CrossProduct(Dirs[i], Dirs[j]);
+		}
+		AddPlane(Origins[i], Normal);
+	}
+
+	AddPlane(Origins[4], -Dirs[4]);
+	AddPlane(Origins[4] + Dirs[4] * MaxDistance, Dirs[4]);
+
+	OutVolume.Init();
+
+	OutBounds.Init();
+	for (int32 i = 0; i < 4; ++i)
+	{
+		OutBounds += Origins[i];
+		OutBounds += Origins[i] + Dirs[i] * (MaxDistance / FMath::Max(FVector::DotProduct(Dirs[i], Dirs[4]), KINDA_SMALL_NUMBER));
+	}
+
+	return true;
+}
+
+/** Moves up to Budget requests from the front of Pending into Out (FIFO) and charges them to Budget. */
+template <typename QueryType>
+void TakeAsyncQueries(TArray<QueryType>& Pending, TArray<QueryType>& Out, int32& Budget)
+{
+	const int32 NumTaken = FMath::Min(Pending.Num(), Budget);
+	if (NumTaken == Pending.Num())
+	{
+		Out = MoveTemp(Pending);
+		Pending.Reset();
+	}
+	else if (NumTaken > 0)
+	{
+		Out.Reserve(NumTaken);
+		for (int32 Index = 0; Index < NumTaken; ++Index)
+		{
+			Out.Add(MoveTemp(Pending[Index]));
+		}
+		Pending.RemoveAt(0, NumTaken, /*bAllowShrinking=*/false);
+	}
+
+	Budget -= NumTaken;
+}
+
+/** Calls RunGroup once per run of requests sharing GetKey; request order is kept inside a run. */
+template <typename QueryType, typename KeyFuncType, typename GroupFuncType>
+void ForEachAsyncQueryGroup(TArray<QueryType>& Queries, KeyFuncType GetKey, GroupFuncType RunGroup)
+{
+	Queries.StableSort([&GetKey](const QueryType& A, const QueryType& B) { return GetKey(A) < GetKey(B); });
+
+	for (int32 Begin = 0; Begin < Queries.Num();)
+	{
+		const uint64 Key = GetKey(Queries[Begin]);
+
+		int32 End = Begin + 1;
+		while (End < Queries.Num() && GetKey(Queries[End]) == Key)
+		{
+			++End;
+		}
+
+		RunGroup(TArrayView<QueryType>(Queries.GetData() + Begin, End - Begin));
+		Begin = End;
+	}
+}
+
+/** Group key of raycast, sweep and overlap requests: one batch per storage flag and trace channel. */
+template <typename QueryType>
+uint64 GetTraceQueryGroupKey(const QueryType& Query)
+{
+	return (uint64(Query.TraceChannel) << 1) | (Query.bIncludeStorage ? 1u : 0u);
+}
+
 } // namespace
 
 
@@ -501,8 +763,7 @@ bool UPhysXInstancedWorldSubsystem::HandleStopAction_DestroyBody(
 	// AddActorToScene() on a destroyed/rebound body -> crash or undefined behavior.
 	InvalidatePendingAddEntries(ID);
 
-	ClearInstanceUserData(ID);
-	Data.Body.Destroy();
+	DestroyInstanceBody(ID, Data);
 #endif
 
 	Data.bSimulating = false;
@@ -547,8 +808,7 @@ bool UPhysXInstancedWorldSubsystem::HandleStopAction_ConvertToStorage(
 			// IMPORTANT(PXIS_DEFERRED_ADD): see comment in HandleStopAction_DestroyBody().
 			InvalidatePendingAddEntries(ID);
 			
-			ClearInstanceUserData(ID);
-			Data.Body.Destroy();
+			DestroyInstanceBody(ID, Data);
 #endif
 			Data.bSimulating = false;
 		}
@@ -632,9 +892,13 @@ void UPhysXInstancedWorldSubsystem::Initialize(FSubsystemCollectionBase& Collect
 	PendingInstanceTasks.Reset();
 	InstanceIDBySlot.Reset();
 
+	SpatialHash.Reset();
+	SpatialHash.SetCellSize(SpatialHashCellSize);
+	StorageBVH.Reset();
+
 #if PHYSICS_INTERFACE_PHYSX
-	PendingAddActorsHead = 0;
 	PendingAddActors.Reset();
+	PendingAddRefreshCursor = 0;
 #endif
 
 	Instances.Reset();
@@ -643,6 +907,11 @@ void UPhysXInstancedWorldSubsystem::Initialize(FSubsystemCollectionBase& Collect
 	Actors.Reset();
 	NextActorID = 1;
 
+	{
+		FScopeLock Lock(&AsyncQueryLock);
+		bAcceptAsyncQueries = true;
+	}
+
 	NumBodiesLifetimeCreated = 0;
 	NumBodiesTotal           = 0;
 	NumBodiesSimulating      = 0;
@@ -669,6 +938,12 @@ void UPhysXInstancedWorldSubsystem::Initialize(FSubsystemCollectionBase& Collect
 			++GInstancedDefaultMaterialRefCount;
 		}
 	}
+
+	// Fits are keyed by mesh; drop the ones whose mesh went away once GC has run.
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddLambda([]()
+	{
+		FPhysXInstanceBody::PrunePrimitiveFits();
+	});
 #endif // PHYSICS_INTERFACE_PHYSX
 	BuildProcessPipeline();
 }
@@ -678,19 +953,51 @@ void UPhysXInstancedWorldSubsystem::Deinitialize()
 	// Stop any deferred work first.
 	PendingInstanceTasks.Reset();
 	LifetimeHeap.Reset();
+	CancelAsyncQueries();
 
 #if PHYSICS_INTERFACE_PHYSX
-	PendingAddActorsHead = 0;
 	PendingAddActors.Reset();
+	PendingAddRefreshCursor = 0;
+	ProxyShapeInstances.Reset();
 
-	for (TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
+	// Nothing will be spawned anymore: release bodies instead of parking them.
+	ShapeCache.SetMaxPooledActorsPerShape(0);
+
+	// Background tasks still read components and the shape cache; let them finish first.
+	CancelAsyncBodyCreation();
+
+	// Bulk teardown: one removeActors call per scene, no per-ID user data lookups.
 	{
-		ClearInstanceUserData(Pair.Key);
-		Pair.Value.Body.Destroy();
+		TArray<FPhysXInstanceBody*> Bodies;
+		Bodies.Reserve(Instances.Num() + DeferredBodyDestroys.Num());
+
+		for (TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
+		{
+			Bodies.Add(&Pair.Value.Body);
+		}
+		for (FPhysXInstanceBody& Body : DeferredBodyDestroys)
+		{
+			Bodies.Add(&Body);
+		}
+
+		FPhysXInstanceBody::DestroyBatch(Bodies, /*bWakeOnLostTouch=*/false);
+		DeferredBodyDestroys.Reset();
 	}
 
+	// Actors are released, so nothing points at the user data anymore.
+	for (TPair<FPhysXInstanceID, FPhysXInstanceUserData*>& Pair : UserDataByID)
+	{
+		delete Pair.Value;
+	}
 	UserDataByID.Reset();
 
+	// Every body has returned its shape references by now; drop whatever the cache still holds.
+	ShapeCache.Reset();
+	ReleaseArchetypeTemplates();
+
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+	PostGarbageCollectHandle.Reset();
+
 	// Release shared material only when the last world subsystem goes away.
 	if (GInstancedDefaultMaterial)
 	{
@@ -699,6 +1006,14 @@ void UPhysXInstancedWorldSubsystem::Deinitialize()
 		{
 			GInstancedDefaultMaterial->release();
 			GInstancedDefaultMaterial = nullptr;
+
+			// Last world gone: cooked meshes are only referenced by the cache now.
+			FPhysXInstancedCookedMeshCache::Get().Reset();
+			FPhysXInstanceBody::PrunePrimitiveFits(/*bReleaseAll=*/true);
+		}
+		else
+		{
+			FPhysXInstanceBody::PrunePrimitiveFits();
 		}
 	}
 #endif // PHYSICS_INTERFACE_PHYSX
@@ -706,6 +1021,8 @@ void UPhysXInstancedWorldSubsystem::Deinitialize()
 	Instances.Reset();
 	Actors.Reset();
 	InstanceIDBySlot.Reset();
+	SpatialHash.Reset();
+	StorageBVH.Reset();
 	CachedWorld.Reset();
 
 	if (ProcessManager.IsValid())
@@ -742,12 +1059,14 @@ void UPhysXInstancedWorldSubsystem::Tick(float DeltaTime)
 	}
 	SimTime = FMath::Max(0.0f, SimTime);
 
-	if (!ProcessManager.IsValid())
+	const bool bUseProcessPipeline = CVarPhysXInstancedUseProcessPipeline.GetValueOnGameThread() != 0;
+
+	if (bUseProcessPipeline && !ProcessManager.IsValid())
 	{
 		BuildProcessPipeline();
 	}
 
-	if (ProcessManager.IsValid())
+	if (bUseProcessPipeline && ProcessManager.IsValid())
 	{
 		FPhysXISProcessContext Ctx;
 		Ctx.Subsystem = this;
@@ -759,12 +1078,23 @@ void UPhysXInstancedWorldSubsystem::Tick(float DeltaTime)
 		return;
 	}
 
+	// Same phases and order as the default processes.
 #if PHYSICS_INTERFACE_PHYSX
+	ProcessAsyncBodyCreation();
+	ProcessCookedShapeSwaps();
 	ProcessPendingAddActors();
 	ProcessInstanceTasks();
 #endif
 
 	AsyncPhysicsStep(DeltaTime, SimTime);
+
+	ProcessAsyncQueries();
+
+#if PHYSICS_INTERFACE_PHYSX
+	ProcessRenderTierMigrations();
+#endif
+
+	ProcessStorageTreeRebuilds();
 	ProcessLifetimeExpirations();
 }
 
@@ -1002,6 +1332,11 @@ void UPhysXInstancedWorldSubsystem::ProcessLifetimeExpirations()
 		++Processed;
 	}
 
+#if PHYSICS_INTERFACE_PHYSX
+	// Expiry waves remove many bodies at once: remove them from the scene in one call.
+	FScopedBodyDestroyBatch BodyDestroyScope(*this);
+#endif
+
 	for (const FExpiredLifetime& Item : Expired)
 	{
 		ApplyLifetimeAction(Item.ID, Item.Action);
@@ -1042,6 +1377,9 @@ FPhysXSpawnInstanceResult UPhysXInstancedWorldSubsystem::SpawnPhysicsInstance(
 
 	APhysXInstancedMeshActor* TargetActor = nullptr;
 
+	// Material variant written into the new instance's custom data (INDEX_NONE = none).
+	int32 TargetVariant = Request.MaterialVariantIndex;
+
 	// Local buffer of resolved materials used for actor matching.
 	TArray<UMaterialInterface*> DesiredMaterials;
 
@@ -1125,11 +1463,25 @@ FPhysXSpawnInstanceResult UPhysXInstancedWorldSubsystem::SpawnPhysicsInstance(
 					continue;
 				}
 
-				if (ISMC->GetStaticMesh() != Request.StaticMesh)
+				if (ISMC->GetStaticMesh() != Request.StaticMesh || Actor->InstanceArchetype != Request.Archetype)
 				{
 					continue;
 				}
 
+				// Variant actors collapse every material set from their table into one component.
+				if (Actor->UsesMaterialVariants())
+				{
+					const int32 Variant = Actor->FindMaterialVariant(DesiredMaterials);
+					if (Variant == INDEX_NONE)
+					{
+						continue;
+					}
+
+					TargetActor   = Actor;
+					TargetVariant = Variant;
+					break;
+				}
+
 				const int32 NumSlots = DesiredMaterials.Num();
 				bool bMaterialsMatch = true;
 
@@ -1177,6 +1529,7 @@ FPhysXSpawnInstanceResult UPhysXInstancedWorldSubsystem::SpawnPhysicsInstance(
 			TargetActor->InstanceStaticMesh         = Request.StaticMesh;
 			TargetActor->bOverrideInstanceMaterials = Request.bUseOverrideMaterials;
 			TargetActor->InstanceOverrideMaterials  = Request.OverrideMaterials;
+			TargetActor->InstanceArchetype          = Request.Archetype;
 
 			TargetActor->ApplyInstanceMaterials();
 		}
@@ -1203,24 +1556,38 @@ FPhysXSpawnInstanceResult UPhysXInstancedWorldSubsystem::SpawnPhysicsInstance(
 
 	const FTransform& WorldTransform = Request.InstanceWorldTransform;
 
+	// Chunked actors route the instance to the component that covers its location.
+	UPhysXInstancedStaticMeshComponent* TargetISMC =
+		TargetActor->GetRenderComponentForLocation(WorldTransform.GetLocation());
+
+	if (!TargetISMC)
+	{
+		return Result;
+	}
+
 	const int32 NewInstanceIndex =
-		TargetActor->InstancedMesh->AddInstanceWorldSpace(WorldTransform);
+		TargetISMC->AddInstanceWorldSpace(WorldTransform);
 
 	if (NewInstanceIndex == INDEX_NONE)
 	{
 		return Result;
 	}
 
+	if (TargetVariant != INDEX_NONE && TargetActor->UsesMaterialVariants())
+	{
+		TargetActor->SetInstanceMaterialVariant(TargetISMC, NewInstanceIndex, TargetVariant);
+	}
+
 	const bool bSimulate =
 		Request.bStartSimulating && TargetActor->bSimulateInstances;
 
 	const FPhysXInstanceID NewInstanceID =
-		RegisterInstance(TargetActor->InstancedMesh, NewInstanceIndex, bSimulate);
+		RegisterInstance(TargetISMC, NewInstanceIndex, bSimulate, Request.InsertionPriority);
 
 	if (!NewInstanceID.IsValid())
 	{
 		// Roll back the ISM instance if PhysX registration failed.
-		TargetActor->InstancedMesh->RemoveInstance(NewInstanceIndex);
+		TargetISMC->RemoveInstance(NewInstanceIndex);
 		return Result;
 	}
 
@@ -1263,7 +1630,8 @@ FPhysXSpawnInstanceResult UPhysXInstancedWorldSubsystem::SpawnPhysicsInstance(
 FPhysXInstanceID UPhysXInstancedWorldSubsystem::RegisterInstance(
 	UInstancedStaticMeshComponent* InstancedMesh,
 	int32 InstanceIndex,
-	bool bSimulate)
+	bool bSimulate,
+	int32 InsertionPriority)
 {
 	// Measure CPU time spent registering a new instance in the subsystem.
 	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_RegisterInstance);
@@ -1307,7 +1675,7 @@ FPhysXInstanceID UPhysXInstancedWorldSubsystem::RegisterInstance(
 		AddSlotMapping(NewID);
 		ApplyDefaultLifetimeForNewInstance(NewID, InstancedMesh);
 		// No PxActor exists in this path, so EnsureInstanceUserData() is a no-op.
-		EnqueueAddActorToScene(NewID, InstancedMesh);
+		EnqueueAddActorToScene(NewID, InstancedMesh, InsertionPriority);
 		
 		++NumBodiesTotal;
 		if (NewData.bSimulating)
@@ -1318,44 +1686,13 @@ FPhysXInstanceID UPhysXInstancedWorldSubsystem::RegisterInstance(
 		return NewID;
 	}
 
-	// Read shape settings from the owning PhysX instanced mesh actor.
-	EPhysXInstanceShapeType ShapeType = EPhysXInstanceShapeType::Box;
-	UStaticMesh* OverrideMesh         = nullptr;
-
-	if (AActor* Owner = InstancedMesh->GetOwner())
-	{
-		if (const APhysXInstancedMeshActor* PhysXActor = Cast<APhysXInstancedMeshActor>(Owner))
-		{
-			ShapeType    = PhysXActor->InstanceShapeType;
-			OverrideMesh = PhysXActor->OverrideCollisionMesh;
-		}
-	}
-
-	// Create a PhysX body via FPhysXInstanceBody helper.
-	if (!NewData.Body.CreateFromInstancedStaticMesh(
-		InstancedMesh,
-		InstanceIndex,
-		bSimulate,
-		GInstancedDefaultMaterial,
-		ShapeType,
-		OverrideMesh))
+	// Create a PhysX body from the owner's archetype or shape settings (overrides applied).
+	if (!CreateInstanceBody(NewData.Body, InstancedMesh, InstanceIndex, bSimulate))
 	{
 		// Creation failed: do not add to the map, return an invalid ID.
 		return FPhysXInstanceID();
 	}
 	
-	// Apply actor-level overrides (mass/damping) before storing/enqueueing.
-	if (const APhysXInstancedMeshActor* OwnerActor = Cast<APhysXInstancedMeshActor>(InstancedMesh->GetOwner()))
-	{
-		if (physx::PxRigidActor* RA = NewData.Body.GetPxActor())
-		{
-			if (physx::PxRigidDynamic* RD = RA->is<physx::PxRigidDynamic>())
-			{
-				ApplyOwnerPhysicsOverrides(OwnerActor, InstancedMesh, OverrideMesh, RD);
-			}
-		}
-	}
-	
 	// IMPORTANT:
 	// userData setup requires the instance record to exist in Instances.
 	Instances.Add(NewID, NewData);
@@ -1371,7 +1708,7 @@ FPhysXInstanceID UPhysXInstancedWorldSubsystem::RegisterInstance(
 	}
 
 	// Defer adding the PhysX actor to the scene to a separate budgeted phase.
-	EnqueueAddActorToScene(NewID, InstancedMesh);
+	EnqueueAddActorToScene(NewID, InstancedMesh, InsertionPriority);
 
 	return NewID;
 #endif // PHYSICS_INTERFACE_PHYSX
@@ -1428,14 +1765,16 @@ void UPhysXInstancedWorldSubsystem::RegisterInstancesBatch(
 
 	EPhysXInstanceShapeType ShapeType = EPhysXInstanceShapeType::Box;
 	UStaticMesh* OverrideMesh         = nullptr;
+	const UPhysXInstanceArchetype* Archetype = nullptr;
 
 	if (AActor* Owner = InstancedMesh->GetOwner())
 	{
 		if (const APhysXInstancedMeshActor* PhysXActor =
 			Cast<APhysXInstancedMeshActor>(Owner))
 		{
-			ShapeType    = PhysXActor->InstanceShapeType;
-			OverrideMesh = PhysXActor->OverrideCollisionMesh;
+			ShapeType    = PhysXActor->GetEffectiveShapeType();
+			OverrideMesh = PhysXActor->GetEffectiveCollisionMesh();
+			Archetype    = PhysXActor->InstanceArchetype;
 		}
 	}
 
@@ -1451,6 +1790,12 @@ void UPhysXInstancedWorldSubsystem::RegisterInstancesBatch(
 		int32                          InstanceIndex = INDEX_NONE;
 		bool                           bSimulate = false;
 
+		/** Instance transform captured on the game thread; workers never read the component. */
+		FTransform                     InstanceLocalTM;
+
+		/** Archetype template to clone (baked on the game thread); null builds the body from the mesh. */
+		physx::PxRigidDynamic*         Template = nullptr;
+
 		bool                           bSuccess = false;
 	};
 
@@ -1497,6 +1842,10 @@ void UPhysXInstancedWorldSubsystem::RegisterInstancesBatch(
 			Job.InstanceIndex = InstanceIndex;
 			Job.bSimulate     = bSimulate;
 
+			Job.InstanceLocalTM = InstancedMesh->PerInstanceSMData.IsValidIndex(InstanceIndex)
+				? FTransform(InstancedMesh->PerInstanceSMData[InstanceIndex].Transform)
+				: FTransform::Identity;
+
 			OutInstanceIDs.Add(NewID);
 		}
 	}
@@ -1510,22 +1859,53 @@ void UPhysXInstancedWorldSubsystem::RegisterInstancesBatch(
 	// 2) Create PhysX bodies (optionally parallel)
 	// ---------------------------------------------------------
 
-	auto DoCreateBodyForJob = [ShapeType, OverrideMesh](FPhysXInstanceCreateJob& Job)
+	FPhysXInstancedShapeCache* JobShapeCache = GetShapeCacheForNewBodies();
+
+	// Templates are baked here: baking reads the component and mutates the template map.
+	if (Archetype)
+	{
+		for (FPhysXInstanceCreateJob& Job : Jobs)
+		{
+			Job.Template = FindOrBakeArchetypeTemplate(*Archetype, Job.ISMC, Job.InstanceIndex);
+		}
+	}
+
+	// Component, owner and collision state is snapshotted here; bodies are built from it on workers.
+	FPhysXInstanceBodyCreateParams CreateParams;
+	const bool bHasCreateParams =
+		FPhysXInstanceBody::ResolveCreateParams(InstancedMesh, bSimulate, ShapeType, OverrideMesh, CreateParams);
+
+	const FTransform ComponentTM = InstancedMesh->GetComponentTransform();
+
+	auto DoCreateBodyForJob = [&CreateParams, bHasCreateParams, &ComponentTM, JobShapeCache](FPhysXInstanceCreateJob& Job)
 	{
 		SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_RegisterCreateBodyWorker);
 
-		if (!Job.ISMC || !Job.Data)
+		if (!Job.Data)
+		{
+			return;
+		}
+
+		if (Job.Template)
 		{
+			Job.bSuccess = Job.Data->Body.CreateFromArchetypeTemplate(
+				*Job.Template,
+				Job.InstanceLocalTM * ComponentTM,
+				Job.bSimulate);
 			return;
 		}
 
-		Job.bSuccess = Job.Data->Body.CreateFromInstancedStaticMesh(
-			Job.ISMC,
+		if (!bHasCreateParams)
+		{
+			return;
+		}
+
+		Job.bSuccess = Job.Data->Body.CreateFromParams(
+			CreateParams,
 			Job.InstanceIndex,
-			Job.bSimulate,
+			Job.InstanceLocalTM,
 			GInstancedDefaultMaterial,
-			ShapeType,
-			OverrideMesh);
+			JobShapeCache);
 	};
 
 	const bool bUseParallelRegister =
@@ -1571,8 +1951,9 @@ void UPhysXInstancedWorldSubsystem::RegisterInstancesBatch(
 				continue;
 			}
 
-			// After success, apply overrides on the game thread.
-			if (const APhysXInstancedMeshActor* OwnerActor = Cast<APhysXInstancedMeshActor>(Job.ISMC ? Job.ISMC->GetOwner() : nullptr))
+			// After success, apply overrides on the game thread (archetype bodies carry their own).
+			const APhysXInstancedMeshActor* OwnerActor = Cast<APhysXInstancedMeshActor>(Job.ISMC ? Job.ISMC->GetOwner() : nullptr);
+			if (OwnerActor && !Archetype)
 			{
 				if (physx::PxRigidActor* RA = Job.Data ? Job.Data->Body.GetPxActor() : nullptr)
 				{
@@ -1600,911 +1981,3187 @@ void UPhysXInstancedWorldSubsystem::RegisterInstancesBatch(
 #endif // PHYSICS_INTERFACE_PHYSX
 }
 
-void UPhysXInstancedWorldSubsystem::UnregisterInstance(FPhysXInstanceID ID)
+void UPhysXInstancedWorldSubsystem::RegisterInstancesBatchAsync(
+	UInstancedStaticMeshComponent* InstancedMesh,
+	const TArray<int32>& InstanceIndices,
+	bool bSimulate,
+	TArray<FPhysXInstanceID>& OutInstanceIDs,
+	FPhysXInstanceBodiesCreatedDelegate OnCompleted)
 {
-	if (FPhysXInstanceData* Data = Instances.Find(ID))
-	{
+	OutInstanceIDs.Reset();
+
 #if PHYSICS_INTERFACE_PHYSX
-		ClearInstanceUserData(ID);
-		Data->Body.Destroy();
-#endif
+	const APhysXInstancedMeshActor* OwnerActor = InstancedMesh ? Cast<APhysXInstancedMeshActor>(InstancedMesh->GetOwner()) : nullptr;
 
-		if (NumBodiesTotal > 0)
-		{
-			--NumBodiesTotal;
-		}
+	// Archetype bodies are template clones, cheap enough to create synchronously.
+	const bool bUsesArchetype = OwnerActor && OwnerActor->InstanceArchetype;
 
-		if (Data->bSimulating && NumBodiesSimulating > 0)
-		{
-			--NumBodiesSimulating;
-		}
+	const EPhysXInstanceShapeType ShapeType = OwnerActor ? OwnerActor->InstanceShapeType : EPhysXInstanceShapeType::Box;
+	UStaticMesh* OverrideMesh = OwnerActor ? OwnerActor->OverrideCollisionMesh : nullptr;
 
-		RemoveSlotMapping(ID);
-		InvalidatePendingAddEntries(ID);
-		Instances.Remove(ID);
-	}
-#if PHYSICS_INTERFACE_PHYSX
-	else
+	// Everything workers need from the component, owner and collision assets, read here once.
+	FPhysXInstanceBodyCreateParams CreateParams;
+
+	if (InstancedMesh && InstanceIndices.Num() > 0 && GInstancedDefaultMaterial && !bUsesArchetype &&
+		FPhysXInstanceBody::ResolveCreateParams(InstancedMesh, bSimulate, ShapeType, OverrideMesh, CreateParams))
 	{
-		// If the instance record is already gone, still ensure we don't leak user-data.
-		ClearInstanceUserData(ID);
-	}
-#endif
-}
+		SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_RegisterPrepareJobs);
 
-#if PHYSICS_INTERFACE_PHYSX
+		TUniquePtr<FAsyncBodyCreateBatch> Batch = MakeUnique<FAsyncBodyCreateBatch>();
+		Batch->InstancedMesh = InstancedMesh;
+		Batch->OverrideMesh  = OverrideMesh;
+		Batch->CreateParams  = MoveTemp(CreateParams);
+		Batch->ShapeCache    = GetShapeCacheForNewBodies();
+		Batch->OnCompleted   = MoveTemp(OnCompleted);
 
-namespace
-{
-	struct FPhysXInstanceAsyncStepJob
-	{
-		// Input data populated on the game thread.
-		FPhysXInstanceID               ID;
-		FPhysXInstanceData*            Data = nullptr;
-		UInstancedStaticMeshComponent* ISMC = nullptr;
-		physx::PxRigidDynamic*         RigidDynamic = nullptr;
+		Instances.Reserve(Instances.Num() + InstanceIndices.Num());
+		Batch->Jobs.Reserve(InstanceIndices.Num());
+		OutInstanceIDs.Reserve(InstanceIndices.Num());
 
-		// Per-frame config snapshots copied from the owning actor.
-		FPhysXInstanceStopConfig       StopConfig;
-		FPhysXInstanceCCDConfig        CCDConfig;
-		bool                           bUseCustomKillZ = false;
-		float                          CustomKillZ = 0.0f;
-		EPhysXInstanceStopAction       LostInstanceAction = EPhysXInstanceStopAction::None;
+		for (int32 InstanceIndex : InstanceIndices)
+		{
+			if (!ensureMsgf(InstanceIndex >= 0,
+				TEXT("RegisterInstancesBatchAsync: got negative InstanceIndex=%d"), InstanceIndex))
+			{
+				// Keep OutInstanceIDs aligned with InstanceIndices.
+				OutInstanceIDs.Add(FPhysXInstanceID());
+				continue;
+			}
 
-		// Owner actor location used for max-distance checks.
-		bool                           bHasOwnerLocation = false;
-		FVector                        OwnerLocation = FVector::ZeroVector;
+			const FPhysXInstanceID NewID(NextID++);
 
-		// Results computed in the worker.
-		FTransform                     NewWorldTransform;
-		FVector                        NewLocation = FVector::ZeroVector;
-		bool                           bSleeping = false;
+			FPhysXInstanceData NewData{};
+			NewData.InstancedComponent = InstancedMesh;
+			NewData.InstanceIndex      = InstanceIndex;
+			NewData.bSimulating        = bSimulate;
+			NewData.bBodyPending       = true;
 
-		// Copy of InstanceData->bWasSleeping from the start of the frame.
-		bool                           bWasSleepingInitial = false;
+			Instances.Add(NewID, NewData);
+			AddSlotMapping(NewID);
+			ApplyDefaultLifetimeForNewInstance(NewID, InstancedMesh);
 
-		// Auto-stop decisions.
-		bool                           bApplyStopAction = false;
-		EPhysXInstanceRemoveReason      RemoveReason = EPhysXInstanceRemoveReason::AutoStop;
-		EPhysXInstanceStopAction       ActionToApply = EPhysXInstanceStopAction::None;
+			FAsyncBodyCreateJob& Job = Batch->Jobs.AddDefaulted_GetRef();
+			Job.ID              = NewID;
+			Job.InstanceIndex   = InstanceIndex;
+			Job.InstanceLocalTM = InstancedMesh->PerInstanceSMData.IsValidIndex(InstanceIndex)
+				? FTransform(InstancedMesh->PerInstanceSMData[InstanceIndex].Transform)
+				: FTransform::Identity;
 
-		// CCD decisions.
-		bool                           bEnableCCD  = false;
-		bool                           bDisableCCD = false;
+			OutInstanceIDs.Add(NewID);
+		}
 
-		// Velocity caches (computed only when required by rules).
-		FVector                        CachedLinearVelocityU = FVector::ZeroVector;
-		float                          CachedLinearSpeed = 0.0f;
-		float                          CachedAngularSpeedDeg = 0.0f;
-		
-		// Updated timers.
-		float                          NewSleepTime = 0.0f;
-		float                          NewFallTime  = 0.0f;
-	};
+		if (Batch->Jobs.Num() > 0)
+		{
+			NumPendingAsyncBodies += Batch->Jobs.Num();
+			AsyncBodyCreateComponents.Add(InstancedMesh);
 
-	// Reused every frame to avoid per-tick allocations in AsyncPhysicsStep.
-	static TArray<FPhysXInstanceAsyncStepJob> GAsyncStepJobs;
-	
-	using FPhysXISAsyncPreComputeRuleFn  = bool (*)(float /*TimerDelta*/, FPhysXInstanceAsyncStepJob& /*Job*/);
-using FPhysXISAsyncPostComputeRuleFn = void (*)(float /*TimerDelta*/, FPhysXInstanceAsyncStepJob& /*Job*/);
-using FPhysXISAsyncPostApplyRuleFn   = void (*)(UPhysXInstancedWorldSubsystem& /*Subsystem*/, float /*TimerDelta*/, TArray<FPhysXInstanceAsyncStepJob>& /*Jobs*/);
+			// The first chunk starts right away; the pipeline dispatches the rest.
+			DispatchAsyncBodyChunk(*Batch);
+			AsyncBodyCreateBatches.Add(MoveTemp(Batch));
+			return;
+		}
 
-static const FPhysXISAsyncPreComputeRuleFn  GPhysXISAsyncPreComputeRules[]  = { nullptr };
-static const FPhysXISAsyncPostComputeRuleFn GPhysXISAsyncPostComputeRules[] = { nullptr };
-static const FPhysXISAsyncPostApplyRuleFn   GPhysXISAsyncPostApplyRules[]   = { nullptr };
+		Batch->OnCompleted.ExecuteIfBound(Batch->CreatedIDs);
+		return;
+	}
+#endif // PHYSICS_INTERFACE_PHYSX
 
-static FORCEINLINE bool RunAsyncPreComputeRules(float TimerDelta, FPhysXInstanceAsyncStepJob& Job)
-{
-	for (int32 Index = 0; GPhysXISAsyncPreComputeRules[Index] != nullptr; ++Index)
+	// No body can be created asynchronously here: register synchronously and report right away.
+	RegisterInstancesBatch(InstancedMesh, InstanceIndices, bSimulate, OutInstanceIDs);
+
+	TArray<FPhysXInstanceID> CreatedIDs;
+	CreatedIDs.Reserve(OutInstanceIDs.Num());
+
+	for (const FPhysXInstanceID& ID : OutInstanceIDs)
 	{
-		if (!GPhysXISAsyncPreComputeRules[Index](TimerDelta, Job))
+		if (ID.IsValid())
 		{
-			return false;
+			CreatedIDs.Add(ID);
 		}
 	}
-	return true;
+
+	OnCompleted.ExecuteIfBound(CreatedIDs);
 }
 
-static FORCEINLINE void RunAsyncPostComputeRules(float TimerDelta, FPhysXInstanceAsyncStepJob& Job)
+bool UPhysXInstancedWorldSubsystem::IsInstanceBodyPending(FPhysXInstanceID ID) const
 {
-	for (int32 Index = 0; GPhysXISAsyncPostComputeRules[Index] != nullptr; ++Index)
-	{
-		GPhysXISAsyncPostComputeRules[Index](TimerDelta, Job);
-	}
+	const FPhysXInstanceData* Data = Instances.Find(ID);
+	return Data && Data->bBodyPending;
 }
 
-static FORCEINLINE void RunAsyncPostApplyRules(UPhysXInstancedWorldSubsystem& Subsystem, float TimerDelta, TArray<FPhysXInstanceAsyncStepJob>& Jobs)
+int32 UPhysXInstancedWorldSubsystem::GetNumPendingAsyncBodies() const
 {
-	for (int32 Index = 0; GPhysXISAsyncPostApplyRules[Index] != nullptr; ++Index)
-	{
-		GPhysXISAsyncPostApplyRules[Index](Subsystem, TimerDelta, Jobs);
-	}
+#if PHYSICS_INTERFACE_PHYSX
+	return NumPendingAsyncBodies;
+#else
+	return 0;
+#endif
 }
 
-using FPhysXISAsyncComputeRuleFn = bool (*)(float /*TimerDelta*/, FPhysXInstanceAsyncStepJob& /*Job*/);
+#if PHYSICS_INTERFACE_PHYSX
 
-static bool ComputeRule_InitAndFastPath(float TimerDelta, FPhysXInstanceAsyncStepJob& Job)
+void UPhysXInstancedWorldSubsystem::DispatchAsyncBodyChunk(FAsyncBodyCreateBatch& Batch)
 {
-	if (!Job.Data || !Job.RigidDynamic)
+	const int32 Begin = Batch.NumDispatched;
+	const int32 End   = FMath::Min(Batch.Jobs.Num(), Begin + FMath::Max(1, AsyncBodyCreateChunkSize));
+
+	if (Begin >= End)
 	{
-		return false;
+		return;
 	}
 
-	FPhysXInstanceData* InstanceData = Job.Data;
+	Batch.NumDispatched = End;
 
-	const bool bSleepingNow = Job.RigidDynamic->isSleeping();
-	Job.bSleeping = bSleepingNow;
+	// Jobs is never resized while a chunk is in flight, and the batch lives on the heap.
+	FAsyncBodyCreateBatch* BatchPtr = &Batch;
 
-	Job.bApplyStopAction = false;
-	Job.ActionToApply    = EPhysXInstanceStopAction::None;
-	Job.bEnableCCD       = false;
-	Job.bDisableCCD      = false;
+	Batch.InFlight = Async(EAsyncExecution::ThreadPool, [BatchPtr, Begin, End]()
+	{
+		ParallelFor(End - Begin, [BatchPtr, Begin](int32 Offset)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_RegisterCreateBodyWorker);
 
-	Job.CachedLinearVelocityU = FVector::ZeroVector;
-	Job.CachedLinearSpeed     = 0.0f;
-	Job.CachedAngularSpeedDeg = 0.0f;
+			FAsyncBodyCreateJob& Job = BatchPtr->Jobs[Begin + Offset];
 
-	const bool bHasAutoStop =
-		(Job.StopConfig.bEnableAutoStop &&
-		 Job.StopConfig.Action != EPhysXInstanceStopAction::None);
+			// Snapshots only: the component may be ticking on the game thread meanwhile.
+			Job.bSuccess = Job.Body.CreateFromParams(
+				BatchPtr->CreateParams,
+				Job.InstanceIndex,
+				Job.InstanceLocalTM,
+				GInstancedDefaultMaterial,
+				BatchPtr->ShapeCache);
+		});
+	});
+}
 
-	const bool bHasSafetyRule =
-		Job.StopConfig.bUseMaxFallTime ||
-		Job.StopConfig.bUseMaxDistanceFromActor ||
-		Job.bUseCustomKillZ;
+void UPhysXInstancedWorldSubsystem::ProcessCookedShapeSwaps()
+{
+	FPhysXInstancedCookedMeshCache& CookedMeshes = FPhysXInstancedCookedMeshCache::Get();
 
-	const bool bUsesAutoCCD =
-		(Job.CCDConfig.Mode == EPhysXInstanceCCDMode::AutoByVelocity);
+	// Config may change in the editor; the cache is shared by all worlds.
+	CookedMeshes.SetEnabled(bCookMissingCollisionAtRuntime);
+	CookedMeshes.SetDiskCacheEnabled(bCacheCookedCollisionOnDisk);
+	CookedMeshes.Tick();
 
-	const bool bCanUseSleepingFastPath =
-		InstanceData->bWasSleeping &&
-		bSleepingNow &&
-		!bHasAutoStop &&
-		!bHasSafetyRule &&
-		!bUsesAutoCCD;
+	SET_DWORD_STAT(STAT_PhysXInstanced_CookedShapesPending, CookedMeshes.NumPending());
 
-	if (bCanUseSleepingFastPath)
+	if (ProxyShapeInstances.Num() == 0 || !GInstancedDefaultMaterial)
 	{
-		Job.NewSleepTime = InstanceData->SleepTime;
-		Job.NewFallTime  = InstanceData->FallTime;
-		return false;
+		return;
 	}
 
-	return true;
-}
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_CookedShapeSwap);
 
-static bool ComputeRule_ReadPose(float /*TimerDelta*/, FPhysXInstanceAsyncStepJob& Job)
-{
-	const PxTransform PxPose = Job.RigidDynamic->getGlobalPose();
+	int32 Budget = (MaxCookedShapeSwapsPerFrame > 0) ? MaxCookedShapeSwapsPerFrame : MAX_int32;
 
-	const FVector ULocation = P2UVector(PxPose.p);
-	const FQuat   URotation = P2UQuat(PxPose.q);
+	for (int32 Index = ProxyShapeInstances.Num() - 1; Index >= 0 && Budget > 0; --Index)
+	{
+		const FPhysXInstanceID ID = ProxyShapeInstances[Index];
 
-	Job.NewWorldTransform = FTransform(URotation, ULocation, FVector::OneVector);
-	Job.NewLocation       = ULocation;
+		FPhysXInstanceData* Data = Instances.Find(ID);
+		if (!Data || !Data->Body.PxBody || !Data->Body.bUsesProxyShape)
+		{
+			// Removed, rebuilt or already swapped.
+			ProxyShapeInstances.RemoveAtSwap(Index, 1, /*bAllowShrinking=*/false);
+			continue;
+		}
 
-	return true;
-}
+		const APhysXInstancedMeshActor* OwnerActor = Data->InstancedComponent.IsValid()
+			? Cast<APhysXInstancedMeshActor>(Data->InstancedComponent->GetOwner())
+			: nullptr;
 
-static bool ComputeRule_CustomKillZ(float /*TimerDelta*/, FPhysXInstanceAsyncStepJob& Job)
-{
-	if (Job.bUseCustomKillZ && Job.NewLocation.Z < Job.CustomKillZ)
-	{
-		if (Job.LostInstanceAction != EPhysXInstanceStopAction::None)
+		const EPhysXCookedMeshKind Kind =
+			(OwnerActor && OwnerActor->GetEffectiveShapeType() == EPhysXInstanceShapeType::TriangleMeshStatic)
+				? EPhysXCookedMeshKind::TriangleMesh
+				: EPhysXCookedMeshKind::Convex;
+
+		if (CookedMeshes.IsPending(Data->Body.ProxyCookBodySetup, Kind))
 		{
-			Job.bApplyStopAction = true;
-			Job.ActionToApply    = Job.LostInstanceAction;
+			continue;
 		}
 
-		Job.NewSleepTime = 0.0f;
-		Job.NewFallTime  = 0.0f;
-		Job.RemoveReason = EPhysXInstanceRemoveReason::KillZ;
-		return false;
-	}
+		// Failed cooks keep the box for good; ready ones get the real shape.
+		if (CookedMeshes.IsReady(Data->Body.ProxyCookBodySetup, Kind))
+		{
+			--Budget;
+			if (!SwapProxyShapeBody(ID, *Data))
+			{
+				continue;
+			}
+		}
+		else
+		{
+			Data->Body.bUsesProxyShape    = false;
+			Data->Body.ProxyCookBodySetup = nullptr;
+		}
 
-	return true;
+		ProxyShapeInstances.RemoveAtSwap(Index, 1, /*bAllowShrinking=*/false);
+	}
 }
 
-static bool ComputeRule_AutoStopDisabled(float TimerDelta, FPhysXInstanceAsyncStepJob& Job)
+bool UPhysXInstancedWorldSubsystem::SwapProxyShapeBody(FPhysXInstanceID ID, FPhysXInstanceData& Data)
 {
-	if (!Job.StopConfig.bEnableAutoStop ||
-		Job.StopConfig.Action == EPhysXInstanceStopAction::None)
-	{
-		const bool bSleepingNow = Job.bSleeping;
+	UInstancedStaticMeshComponent* ISMC  = Data.InstancedComponent.Get();
+	PxRigidDynamic*                OldRD = Data.Body.PxBody;
 
-		FPhysXInstanceData* InstanceData = Job.Data;
+	if (!ISMC || !OldRD)
+	{
+		return false;
+	}
 
-		Job.NewSleepTime = bSleepingNow
-			? (InstanceData->SleepTime + TimerDelta)
-			: 0.0f;
+	const bool bKinematic = OldRD->getRigidBodyFlags().isSet(PxRigidBodyFlag::eKINEMATIC);
 
-		Job.NewFallTime = 0.0f;
+	FPhysXInstanceBody NewBody;
+	if (!CreateInstanceBody(NewBody, ISMC, Data.InstanceIndex, /*bSimulate=*/!bKinematic))
+	{
 		return false;
 	}
 
-	return true;
-}
-
-static bool ComputeRule_ReadVelocitiesAndCCD(float /*TimerDelta*/, FPhysXInstanceAsyncStepJob& Job)
-{
-	const bool bNeedVelForStopCondition =
-		(Job.StopConfig.Condition == EPhysXInstanceStopCondition::VelocityThreshold ||
-		 Job.StopConfig.Condition == EPhysXInstanceStopCondition::SleepOrVelocity ||
-		 Job.StopConfig.Condition == EPhysXInstanceStopCondition::SleepAndVelocity);
+	PxRigidDynamic* NewRD = NewBody.PxBody;
 
-	const bool bNeedVelForFallTime = Job.StopConfig.bUseMaxFallTime;
-	const bool bNeedVelForCCD      = (Job.CCDConfig.Mode == EPhysXInstanceCCDMode::AutoByVelocity);
+	// Carry over the simulated state of the proxy.
+	PxScene*     Scene           = OldRD->getScene();
+	const bool   bWasSleeping    = Scene && OldRD->isSleeping();
+	const PxVec3 LinearVelocity  = OldRD->getLinearVelocity();
+	const PxVec3 AngularVelocity = OldRD->getAngularVelocity();
 
-	const bool bNeedAngularSpeed =
-		bNeedVelForStopCondition && (Job.StopConfig.AngularSpeedThreshold > 0.0f);
+	NewRD->setGlobalPose(OldRD->getGlobalPose());
+	NewRD->setActorFlag(PxActorFlag::eDISABLE_SIMULATION, OldRD->getActorFlags().isSet(PxActorFlag::eDISABLE_SIMULATION));
 
-	const bool bNeedLinearSpeed =
-		bNeedVelForStopCondition || bNeedVelForFallTime || bNeedVelForCCD;
+	DestroyInstanceBody(ID, Data);
+	Data.Body = NewBody;
+	EnsureInstanceUserData(ID);
 
-	if (bNeedLinearSpeed || bNeedAngularSpeed)
+	// Bodies still queued for insertion are picked up by the pending entry; inserted ones are replaced in place.
+	if (Scene)
 	{
-		const PxVec3 LinVelPx = Job.RigidDynamic->getLinearVelocity();
-		Job.CachedLinearVelocityU = P2UVector(LinVelPx);
-		Job.CachedLinearSpeed     = Job.CachedLinearVelocityU.Size();
+		Scene->addActor(*NewRD);
 
-		if (bNeedAngularSpeed)
+		if (!bKinematic && !NewRD->getActorFlags().isSet(PxActorFlag::eDISABLE_SIMULATION))
 		{
-			const PxVec3 AngVelPx    = Job.RigidDynamic->getAngularVelocity();
-			const float  AngSpeedRad = AngVelPx.magnitude();
-			Job.CachedAngularSpeedDeg = FMath::RadiansToDegrees(AngSpeedRad);
+			if (bWasSleeping)
+			{
+				NewRD->putToSleep();
+			}
+			else
+			{
+				NewRD->setLinearVelocity(LinearVelocity);
+				NewRD->setAngularVelocity(AngularVelocity);
+			}
 		}
 	}
 
-	if (Job.CCDConfig.Mode == EPhysXInstanceCCDMode::AutoByVelocity)
+	return true;
+}
+
+PxRigidDynamic* UPhysXInstancedWorldSubsystem::FindOrBakeArchetypeTemplate(
+	const UPhysXInstanceArchetype& Archetype,
+	UInstancedStaticMeshComponent* ISMC,
+	int32 InstanceIndex,
+	const FTransform* InstanceLocalTransform)
+{
+	if (!ISMC || !GInstancedDefaultMaterial)
 	{
-		const float MinVel = Job.CCDConfig.MinCCDVelocity;
-		const bool  bShouldUseCCD = (Job.CachedLinearSpeed >= MinVel);
+		return nullptr;
+	}
 
-		const bool bCurrentlyCCD =
-			Job.RigidDynamic->getRigidBodyFlags().isSet(PxRigidBodyFlag::eENABLE_CCD);
+	FTransform InstanceLocalTM = FTransform::Identity;
+	if (InstanceLocalTransform)
+	{
+		InstanceLocalTM = *InstanceLocalTransform;
+	}
+	else
+	{
+		ISMC->GetInstanceTransform(InstanceIndex, InstanceLocalTM, /*bWorldSpace=*/false);
+	}
 
-		if (bShouldUseCCD && !bCurrentlyCCD)
-		{
-			Job.bEnableCCD = true;
-		}
-		else if (!bShouldUseCCD && bCurrentlyCCD)
+	// Same geometry scale as FPhysXInstanceBody: meshes follow the component, fitted primitives the instance too.
+	const bool bUsesMeshScale =
+		Archetype.ShapeType == EPhysXInstanceShapeType::Convex ||
+		Archetype.ShapeType == EPhysXInstanceShapeType::TriangleMeshStatic;
+
+	FVector Scale = ISMC->GetComponentScale();
+	if (!bUsesMeshScale)
+	{
+		Scale *= InstanceLocalTM.GetScale3D();
+	}
+
+	// Instances within one scale quantum share a template, as they would share a shape.
+	// The shared cache is left alone: workers may be reading its quantum.
+	FArchetypeTemplateKey Key;
+	Key.Archetype  = &Archetype;
+	Key.StaticMesh = ISMC->GetStaticMesh();
+	Key.Scale      = FPhysXInstancedShapeCache::QuantizeScale(Scale, SharedShapeScaleQuantum);
+	Key.Revision   = Archetype.GetBakeRevision();
+
+	if (Archetype.ShapeType == EPhysXInstanceShapeType::Capsule)
+	{
+		if (const APhysXInstancedMeshActor* OwnerActor = Cast<APhysXInstancedMeshActor>(ISMC->GetOwner()))
 		{
-			Job.bDisableCCD = true;
+			Key.ShapeOffset = OwnerActor->ShapeCollisionOffset;
 		}
 	}
 
-	return true;
-}
-
-static bool ComputeRule_MaxFallTime(float TimerDelta, FPhysXInstanceAsyncStepJob& Job)
-{
-	if (Job.StopConfig.bUseMaxFallTime)
+	if (PxRigidDynamic** Found = ArchetypeTemplates.Find(Key))
 	{
-		if (Job.CachedLinearVelocityU.Z < 0.0f)
-		{
-			Job.NewFallTime += TimerDelta;
-		}
-		else
-		{
-			Job.NewFallTime = 0.0f;
-		}
-
-		if (Job.NewFallTime >= Job.StopConfig.MaxFallTime &&
-			Job.StopConfig.Action != EPhysXInstanceStopAction::None)
-		{
-			Job.bApplyStopAction = true;
-			Job.ActionToApply    = Job.StopConfig.Action;
-			Job.NewSleepTime     = 0.0f;
-			Job.NewFallTime      = 0.0f;
-			return false;
-		}
+		return *Found;
 	}
-	else
+
+	PxRigidDynamic* Template = FPhysXInstanceBody::BakeArchetypeTemplate(
+		Archetype, ISMC, InstanceIndex, GInstancedDefaultMaterial, &InstanceLocalTM);
+	if (Template)
 	{
-		Job.NewFallTime = 0.0f;
+		ReleaseStaleArchetypeTemplates(Archetype);
+		ArchetypeTemplates.Add(Key, Template);
 	}
-
-	return true;
+	return Template;
 }
 
-static bool ComputeRule_MaxDistanceFromActor(float /*TimerDelta*/, FPhysXInstanceAsyncStepJob& Job)
+bool UPhysXInstancedWorldSubsystem::CreateInstanceBody(
+	FPhysXInstanceBody& OutBody,
+	UInstancedStaticMeshComponent* ISMC,
+	int32 InstanceIndex,
+	bool bSimulate)
 {
-	if (Job.StopConfig.bUseMaxDistanceFromActor &&
-		Job.bHasOwnerLocation &&
-		Job.StopConfig.MaxDistanceFromActor > 0.0f &&
-		Job.StopConfig.Action != EPhysXInstanceStopAction::None)
+	if (!ISMC || !GInstancedDefaultMaterial)
 	{
-		const float MaxDistSq = FMath::Square(Job.StopConfig.MaxDistanceFromActor);
-		const float DistSq    = FVector::DistSquared(Job.OwnerLocation, Job.NewLocation);
-
-		if (DistSq > MaxDistSq)
-		{
-			Job.bApplyStopAction = true;
-			Job.ActionToApply    = Job.StopConfig.Action;
-			Job.NewSleepTime     = 0.0f;
-			Job.NewFallTime      = 0.0f;
-			return false;
-		}
+		return false;
 	}
 
-	return true;
-}
+	const APhysXInstancedMeshActor* OwnerActor = Cast<APhysXInstancedMeshActor>(ISMC->GetOwner());
 
-static bool ComputeRule_StopCondition(float TimerDelta, FPhysXInstanceAsyncStepJob& Job)
-{
-	const bool bSleepingNow = Job.bSleeping;
+	if (OwnerActor && OwnerActor->InstanceArchetype)
+	{
+		const UPhysXInstanceArchetype& Archetype = *OwnerActor->InstanceArchetype;
 
-	const bool bBelowVelocityThreshold =
-		(Job.CachedLinearSpeed <= Job.StopConfig.LinearSpeedThreshold) &&
-		(Job.CachedAngularSpeedDeg <= Job.StopConfig.AngularSpeedThreshold);
+		if (PxRigidDynamic* Template = FindOrBakeArchetypeTemplate(Archetype, ISMC, InstanceIndex))
+		{
+			return OutBody.CreateFromArchetypeTemplate(*Template, ISMC, InstanceIndex, bSimulate);
+		}
 
-	bool bStopConditionNow = false;
+		// No template while the collision mesh cooks: a proxy body, rebuilt from the template once baked.
+		return OutBody.CreateFromInstancedStaticMesh(
+			ISMC,
+			InstanceIndex,
+			bSimulate,
+			GInstancedDefaultMaterial,
+			Archetype.ShapeType,
+			Archetype.CollisionMesh,
+			GetShapeCacheForNewBodies());
+	}
 
-	switch (static_cast<int32>(Job.StopConfig.Condition))
+	EPhysXInstanceShapeType ShapeType = EPhysXInstanceShapeType::Box;
+	UStaticMesh* OverrideMesh         = nullptr;
+
+	if (OwnerActor)
 	{
-	case 0: // PhysXSleepFlag
-		bStopConditionNow = bSleepingNow;
-		break;
-	case 1: // VelocityThreshold
-		bStopConditionNow = bBelowVelocityThreshold;
-		break;
-	case 2: // SleepOrVelocity
-		bStopConditionNow = bSleepingNow || bBelowVelocityThreshold;
-		break;
-	case 3: // SleepAndVelocity
-		bStopConditionNow = bSleepingNow && bBelowVelocityThreshold;
-		break;
-	default:
-		bStopConditionNow = false;
-		break;
+		ShapeType    = OwnerActor->InstanceShapeType;
+		OverrideMesh = OwnerActor->OverrideCollisionMesh;
 	}
 
-	if (!bStopConditionNow || Job.StopConfig.MinStoppedTime <= 0.0f)
+	if (!OutBody.CreateFromInstancedStaticMesh(
+		ISMC,
+		InstanceIndex,
+		bSimulate,
+		GInstancedDefaultMaterial,
+		ShapeType,
+		OverrideMesh,
+		GetShapeCacheForNewBodies()))
 	{
-		Job.NewSleepTime = 0.0f;
 		return false;
 	}
 
-	Job.NewSleepTime += TimerDelta;
-	if (Job.NewSleepTime >= Job.StopConfig.MinStoppedTime)
+	// Apply actor-level overrides (mass/damping) before storing/enqueueing.
+	if (OwnerActor)
 	{
-		Job.bApplyStopAction = true;
-		Job.ActionToApply    = Job.StopConfig.Action;
-		Job.NewSleepTime     = 0.0f;
-		Job.NewFallTime      = 0.0f;
+		ApplyOwnerPhysicsOverrides(OwnerActor, ISMC, OverrideMesh, OutBody.PxBody);
 	}
-
-	return false;
+	return true;
 }
 
-static const FPhysXISAsyncComputeRuleFn GPhysXISAsyncComputeRules[] =
-{
-	&ComputeRule_InitAndFastPath,
-	&ComputeRule_ReadPose,
-	&ComputeRule_CustomKillZ,
-	&ComputeRule_AutoStopDisabled,
-	&ComputeRule_ReadVelocitiesAndCCD,
-	&ComputeRule_MaxFallTime,
-	&ComputeRule_MaxDistanceFromActor,
-	&ComputeRule_StopCondition,
-	nullptr
-};
-
-static void ComputeAsyncStep_Core(float TimerDelta, FPhysXInstanceAsyncStepJob& Job)
+void UPhysXInstancedWorldSubsystem::ReleaseStaleArchetypeTemplates(const UPhysXInstanceArchetype& Archetype)
 {
-	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_AsyncJobWorker);
+	// An edit bumped the revision: older templates are never looked up again.
+	const uint32 Revision = Archetype.GetBakeRevision();
 
-	for (int32 Index = 0; GPhysXISAsyncComputeRules[Index] != nullptr; ++Index)
+	for (auto It = ArchetypeTemplates.CreateIterator(); It; ++It)
 	{
-		if (!GPhysXISAsyncComputeRules[Index](TimerDelta, Job))
+		if (It->Key.Archetype == &Archetype && It->Key.Revision != Revision)
 		{
-			break;
+			It->Value->release();
+			It.RemoveCurrent();
 		}
 	}
 }
-}
 
-bool UPhysXInstancedWorldSubsystem::ExecuteInstanceStopAction_Internal(
-	FPhysXInstanceID ID,
-	EPhysXInstanceStopAction Action,
-	const FStopActionExecOptions& Opt)
+void UPhysXInstancedWorldSubsystem::ReleaseArchetypeTemplates()
 {
-	if (Action == EPhysXInstanceStopAction::None)
+	// Templates never enter a scene; clones hold their own shape references.
+	for (TPair<FArchetypeTemplateKey, PxRigidDynamic*>& Pair : ArchetypeTemplates)
 	{
-		return Instances.Contains(ID);
+		Pair.Value->release();
 	}
+	ArchetypeTemplates.Reset();
+}
 
-	FPhysXInstanceData* Data = Instances.Find(ID);
-	if (!Data)
+void UPhysXInstancedWorldSubsystem::ProcessAsyncBodyCreation()
+{
+	if (AsyncBodyCreateBatches.Num() == 0)
 	{
-		return false;
+		SET_DWORD_STAT(STAT_PhysXInstanced_AsyncCreateBacklog, 0);
+		return;
 	}
 
-	using FHandler = bool (UPhysXInstancedWorldSubsystem::*)(
-		FPhysXInstanceID,
-		const FStopActionExecOptions&,
-		FPhysXInstanceData&);
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_AsyncCreateFinalize);
 
-	static const FHandler Handlers[] =
-	{
-		&UPhysXInstancedWorldSubsystem::HandleStopAction_None,                       // None
-		&UPhysXInstancedWorldSubsystem::HandleStopAction_DisableSimulation,          // DisableSimulation
-		&UPhysXInstancedWorldSubsystem::HandleStopAction_DestroyBody,                // DestroyBody
-		&UPhysXInstancedWorldSubsystem::HandleStopAction_DestroyBodyAndRemoveInstance,// DestroyBodyAndRemoveInstance
-		&UPhysXInstancedWorldSubsystem::HandleStopAction_ConvertToStorage            // ConvertToStorage
-	};
+	int32 Budget = (MaxAsyncBodyFinalizePerFrame > 0) ? MaxAsyncBodyFinalizePerFrame : MAX_int32;
 
-	const int32 ActionIndex = (int32)Action;
-	if (ActionIndex < 0 || ActionIndex >= UE_ARRAY_COUNT(Handlers) || !Handlers[ActionIndex])
+	for (int32 BatchIndex = 0; BatchIndex < AsyncBodyCreateBatches.Num(); )
 	{
-		return true;
-	}
+		FAsyncBodyCreateBatch& Batch = *AsyncBodyCreateBatches[BatchIndex];
 
-	const bool bStillExists = (this->*Handlers[ActionIndex])(ID, Opt, *Data);
-	if (!bStillExists)
-	{
-		return false;
-	}
+		// Collect the chunk that finished since last frame and keep the workers busy with the next one.
+		if (Batch.NumCreated < Batch.NumDispatched && Batch.InFlight.IsReady())
+		{
+			Batch.NumCreated = Batch.NumDispatched;
+			DispatchAsyncBodyChunk(Batch);
+		}
 
-	if (Opt.bResetTimers)
-	{
-		if (FPhysXInstanceData* After = Instances.Find(ID))
+		while (Budget > 0 && Batch.NumFinalized < Batch.NumCreated)
 		{
-			After->SleepTime = 0.0f;
-			After->FallTime  = 0.0f;
+			FinalizeAsyncBody(Batch, Batch.Jobs[Batch.NumFinalized++]);
+			--Budget;
 		}
+
+		if (Batch.NumFinalized < Batch.Jobs.Num())
+		{
+			++BatchIndex;
+			continue;
+		}
+
+		TUniquePtr<FAsyncBodyCreateBatch> Done = MoveTemp(AsyncBodyCreateBatches[BatchIndex]);
+		AsyncBodyCreateBatches.RemoveAt(BatchIndex);
+		AsyncBodyCreateComponents.RemoveSingleSwap(Done->InstancedMesh);
+
+		// The callback may register more instances; the finished batch is already out of the queue.
+		Done->OnCompleted.ExecuteIfBound(Done->CreatedIDs);
 	}
 
-	return true;
+	SET_DWORD_STAT(STAT_PhysXInstanced_AsyncCreateBacklog, NumPendingAsyncBodies);
 }
 
-#endif // PHYSICS_INTERFACE_PHYSX
-
-// ============================================================================
-// Physics update
-// ============================================================================
-void UPhysXInstancedWorldSubsystem::PhysicsStep_ApplyStopActionsAndCCD()
+void UPhysXInstancedWorldSubsystem::FinalizeAsyncBody(FAsyncBodyCreateBatch& Batch, FAsyncBodyCreateJob& Job)
 {
-	if (!bPhysicsStepHasPendingApply)
+	NumPendingAsyncBodies = FMath::Max(0, NumPendingAsyncBodies - 1);
+
+	FPhysXInstanceData* Data = Instances.Find(Job.ID);
+
+	// Removal, storage conversion or a synchronous rebuild while waiting all cancel the async body.
+	const bool bStillWaiting =
+		Data &&
+		Data->bBodyPending &&
+		!Data->Body.PxBody &&
+		Data->InstancedComponent.Get() == Batch.InstancedMesh;
+
+	if (Data)
+	{
+		Data->bBodyPending = false;
+	}
+
+	if (!bStillWaiting)
 	{
+		Job.Body.Destroy();
 		return;
 	}
 
-	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_AsyncApply);
+	if (!Job.bSuccess)
+	{
+		// Same as the synchronous batch: a failed body drops the instance record.
+		Job.Body.Destroy();
+		RemoveSlotMapping(Job.ID);
+		Instances.Remove(Job.ID);
+		return;
+	}
 
-	TArray<FPhysXInstanceAsyncStepJob>& Jobs = GAsyncStepJobs;
+	UInstancedStaticMeshComponent* ISMC = Batch.InstancedMesh;
 
-	for (FPhysXInstanceAsyncStepJob& JobData : Jobs)
+	Data->Body = Job.Body;
+	Job.Body   = FPhysXInstanceBody();
+
+	// The body was built from a snapshot; follow the instance if it moved or shifted index since.
+	FTransform CurrentWorldTM;
+	if (ISMC->GetInstanceTransform(Data->InstanceIndex, CurrentWorldTM, /*bWorldSpace=*/true))
 	{
-		FPhysXInstanceData* InstanceData = JobData.Data;
-		if (!InstanceData)
-		{
-			continue;
-		}
+		Data->Body.PxBody->setGlobalPose(U2PTransform(CurrentWorldTM));
+	}
 
-		if (JobData.bEnableCCD && JobData.RigidDynamic)
-		{
-			JobData.RigidDynamic->setRigidBodyFlag(PxRigidBodyFlag::eENABLE_CCD, true);
-		}
-		else if (JobData.bDisableCCD && JobData.RigidDynamic)
-		{
-			JobData.RigidDynamic->setRigidBodyFlag(PxRigidBodyFlag::eENABLE_CCD, false);
-		}
+	if (const APhysXInstancedMeshActor* OwnerActor = Cast<APhysXInstancedMeshActor>(ISMC->GetOwner()))
+	{
+		ApplyOwnerPhysicsOverrides(OwnerActor, ISMC, Batch.OverrideMesh, Data->Body.PxBody);
+	}
 
-		if (JobData.bApplyStopAction && JobData.ActionToApply != EPhysXInstanceStopAction::None)
-		{
-			FStopActionExecOptions Opt;
-			Opt.RemoveReason                = JobData.RemoveReason;
-			Opt.bRemoveVisualInstance       = true;
-			Opt.bCreateStorageActorIfNeeded = true;
+	EnsureInstanceUserData(Job.ID);
+	EnqueueAddActorToScene(Job.ID, ISMC);
 
-			Opt.bUseSetInstancePhysicsEnabled = false;
-			Opt.bResetTimers                 = true;
-			Opt.bDestroyBodyOnConvertFailure = true;
+	++NumBodiesLifetimeCreated;
+	++NumBodiesTotal;
 
-			const bool bStillExists = ExecuteInstanceStopAction_Internal(JobData.ID, JobData.ActionToApply, Opt);
+	if (Data->bSimulating)
+	{
+		++NumBodiesSimulating;
+	}
 
-			if (!bStillExists || JobData.ActionToApply == EPhysXInstanceStopAction::ConvertToStorage)
-			{
-				JobData.Data         = nullptr;
-				JobData.ISMC         = nullptr;
-				JobData.RigidDynamic = nullptr;
-				continue;
-			}
-		}
-		else
+	Batch.CreatedIDs.Add(Job.ID);
+}
+
+void UPhysXInstancedWorldSubsystem::CancelAsyncBodyCreation()
+{
+	for (TUniquePtr<FAsyncBodyCreateBatch>& Batch : AsyncBodyCreateBatches)
+	{
+		if (Batch->InFlight.IsValid())
 		{
-			InstanceData->SleepTime = JobData.NewSleepTime;
-			InstanceData->FallTime  = JobData.NewFallTime;
+			Batch->InFlight.Wait();
 		}
 
-		if (JobData.bSleeping)
+		// Bodies past NumFinalized were never handed to an instance and are not in any scene.
+		for (int32 JobIndex = Batch->NumFinalized; JobIndex < Batch->NumDispatched; ++JobIndex)
 		{
-			++PhysicsStepLocalSleeping;
+			Batch->Jobs[JobIndex].Body.Destroy();
 		}
-
-		InstanceData->bWasSleeping = JobData.bSleeping;
 	}
+
+	AsyncBodyCreateBatches.Reset();
+	AsyncBodyCreateComponents.Reset();
+	NumPendingAsyncBodies = 0;
 }
 
-void UPhysXInstancedWorldSubsystem::PhysicsStep_ApplyTransformSync()
+#endif // PHYSICS_INTERFACE_PHYSX
+
+void UPhysXInstancedWorldSubsystem::UnregisterInstance(FPhysXInstanceID ID)
 {
-	if (!bPhysicsStepHasPendingApply)
+	if (FPhysXInstanceData* Data = Instances.Find(ID))
 	{
-		return;
-	}
-
-	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_AsyncApply);
+#if PHYSICS_INTERFACE_PHYSX
+		DestroyInstanceBody(ID, *Data);
+#endif
 
-	TArray<FPhysXInstanceAsyncStepJob>& Jobs = GAsyncStepJobs;
+		if (NumBodiesTotal > 0)
+		{
+			--NumBodiesTotal;
+		}
 
-	for (FPhysXInstanceAsyncStepJob& JobData : Jobs)
-	{
-		FPhysXInstanceData* InstanceData = JobData.Data;
-		if (!InstanceData)
+		if (Data->bSimulating && NumBodiesSimulating > 0)
 		{
-			continue;
+			--NumBodiesSimulating;
 		}
 
-		UInstancedStaticMeshComponent* ISMComponent = JobData.ISMC;
-		if (!ISMComponent || !ISMComponent->IsValidLowLevelFast())
-		{
-			continue;
-		}
+		RemoveSlotMapping(ID);
+		InvalidatePendingAddEntries(ID);
+		Instances.Remove(ID);
+	}
+#if PHYSICS_INTERFACE_PHYSX
+	else
+	{
+		// If the instance record is already gone, still ensure we don't leak user-data.
+		ClearInstanceUserData(ID);
+	}
+#endif
+}
 
-		if (InstanceData->InstanceIndex == INDEX_NONE)
-		{
-			continue;
-		}
+#if PHYSICS_INTERFACE_PHYSX
 
-		const bool bWasSleeping = JobData.bWasSleepingInitial;
-		const bool bIsSleeping  = JobData.bSleeping;
+namespace
+{
+	struct FPhysXInstanceAsyncStepJob
+	{
+		// Input data populated on the game thread.
+		FPhysXInstanceID               ID;
+		FPhysXInstanceData*            Data = nullptr;
+		UInstancedStaticMeshComponent* ISMC = nullptr;
+		physx::PxRigidDynamic*         RigidDynamic = nullptr;
 
-		if (bIsSleeping && bWasSleeping)
-		{
-			continue;
-		}
+		// Per-frame config snapshots copied from the owning actor.
+		FPhysXInstanceStopConfig       StopConfig;
+		FPhysXInstanceCCDConfig        CCDConfig;
+		bool                           bUseCustomKillZ = false;
+		float                          CustomKillZ = 0.0f;
+		EPhysXInstanceStopAction       LostInstanceAction = EPhysXInstanceStopAction::None;
 
-		if (UPhysXInstancedStaticMeshComponent* PhysXISMC = Cast<UPhysXInstancedStaticMeshComponent>(ISMComponent))
-		{
-			FPhysicsStepTransformBatch& Batch = PhysicsStepApplyCtx.ComponentBatches.FindOrAdd(PhysXISMC);
-			Batch.InstanceIndices.Add(InstanceData->InstanceIndex);
-			Batch.WorldTransforms.Add(JobData.NewWorldTransform);
-		}
-		else
-		{
-			ISMComponent->UpdateInstanceTransform(
-				InstanceData->InstanceIndex,
-				JobData.NewWorldTransform,
-				/*bWorldSpace=*/true,
-				/*bMarkRenderStateDirty=*/false,
-				/*bTeleport=*/false);
+		// Owner actor location used for max-distance checks.
+		bool                           bHasOwnerLocation = false;
+		FVector                        OwnerLocation = FVector::ZeroVector;
 
-			PhysicsStepApplyCtx.DirtyComponents.Add(ISMComponent);
-		}
-	}
+		// Results computed in the worker.
+		FTransform                     NewWorldTransform;
+		FVector                        NewLocation = FVector::ZeroVector;
+		bool                           bSleeping = false;
 
-	for (auto& Pair : PhysicsStepApplyCtx.ComponentBatches)
-	{
-		UPhysXInstancedStaticMeshComponent* PhysXISMC = Pair.Key;
-		FPhysicsStepTransformBatch&         Batch     = Pair.Value;
+		// Copy of InstanceData->bWasSleeping from the start of the frame.
+		bool                           bWasSleepingInitial = false;
 
-		if (!PhysXISMC || !PhysXISMC->IsValidLowLevelFast())
-		{
-			continue;
-		}
+		// Auto-stop decisions.
+		bool                           bApplyStopAction = false;
+		EPhysXInstanceRemoveReason      RemoveReason = EPhysXInstanceRemoveReason::AutoStop;
+		EPhysXInstanceStopAction       ActionToApply = EPhysXInstanceStopAction::None;
 
-		if (Batch.InstanceIndices.Num() == 0 ||
-			Batch.InstanceIndices.Num() != Batch.WorldTransforms.Num())
+		// CCD decisions.
+		bool                           bEnableCCD  = false;
+		bool                           bDisableCCD = false;
+
+		// Velocity caches (computed only when required by rules).
+		FVector                        CachedLinearVelocityU = FVector::ZeroVector;
+		float                          CachedLinearSpeed = 0.0f;
+		float                          CachedAngularSpeedDeg = 0.0f;
+		
+		// Updated timers.
+		float                          NewSleepTime = 0.0f;
+		float                          NewFallTime  = 0.0f;
+	};
+
+	// Reused every frame to avoid per-tick allocations in AsyncPhysicsStep.
+	static TArray<FPhysXInstanceAsyncStepJob> GAsyncStepJobs;
+	
+	using FPhysXISAsyncPreComputeRuleFn  = bool (*)(float /*TimerDelta*/, FPhysXInstanceAsyncStepJob& /*Job*/);
+using FPhysXISAsyncPostComputeRuleFn = void (*)(float /*TimerDelta*/, FPhysXInstanceAsyncStepJob& /*Job*/);
+using FPhysXISAsyncPostApplyRuleFn   = void (*)(UPhysXInstancedWorldSubsystem& /*Subsystem*/, float /*TimerDelta*/, TArray<FPhysXInstanceAsyncStepJob>& /*Jobs*/);
+
+static const FPhysXISAsyncPreComputeRuleFn  GPhysXISAsyncPreComputeRules[]  = { nullptr };
+static const FPhysXISAsyncPostComputeRuleFn GPhysXISAsyncPostComputeRules[] = { nullptr };
+static const FPhysXISAsyncPostApplyRuleFn   GPhysXISAsyncPostApplyRules[]   = { nullptr };
+
+static FORCEINLINE bool RunAsyncPreComputeRules(float TimerDelta, FPhysXInstanceAsyncStepJob& Job)
+{
+	for (int32 Index = 0; GPhysXISAsyncPreComputeRules[Index] != nullptr; ++Index)
+	{
+		if (!GPhysXISAsyncPreComputeRules[Index](TimerDelta, Job))
 		{
-			continue;
+			return false;
 		}
-
-		PhysXISMC->UpdateInstancesFromPhysXBatch_MT(
-			Batch.InstanceIndices,
-			Batch.WorldTransforms,
-			/*bTeleport=*/false);
 	}
+	return true;
 }
 
-void UPhysXInstancedWorldSubsystem::PhysicsStep_Finalize()
+static FORCEINLINE void RunAsyncPostComputeRules(float TimerDelta, FPhysXInstanceAsyncStepJob& Job)
 {
-	if (!bPhysicsStepHasPendingApply)
+	for (int32 Index = 0; GPhysXISAsyncPostComputeRules[Index] != nullptr; ++Index)
 	{
-		return;
+		GPhysXISAsyncPostComputeRules[Index](TimerDelta, Job);
 	}
+}
 
-	for (UInstancedStaticMeshComponent* ISMC : PhysicsStepApplyCtx.DirtyComponents)
+static FORCEINLINE void RunAsyncPostApplyRules(UPhysXInstancedWorldSubsystem& Subsystem, float TimerDelta, TArray<FPhysXInstanceAsyncStepJob>& Jobs)
+{
+	for (int32 Index = 0; GPhysXISAsyncPostApplyRules[Index] != nullptr; ++Index)
 	{
-		if (ISMC && ISMC->IsValidLowLevelFast())
-		{
-			ISMC->MarkRenderStateDirty();
-		}
+		GPhysXISAsyncPostApplyRules[Index](Subsystem, TimerDelta, Jobs);
 	}
+}
 
-	TArray<FPhysXInstanceAsyncStepJob>& Jobs = GAsyncStepJobs;
-	RunAsyncPostApplyRules(*this, PhysicsStepTimerDelta, Jobs);
-
-	NumBodiesTotal      = PhysicsStepLocalTotal;
-	NumBodiesSleeping   = PhysicsStepLocalSleeping;
-	NumBodiesSimulating = NumBodiesTotal - NumBodiesSleeping;
+using FPhysXISAsyncComputeRuleFn = bool (*)(float /*TimerDelta*/, FPhysXInstanceAsyncStepJob& /*Job*/);
 
-	SET_DWORD_STAT(STAT_PhysXInstanced_BodiesTotal,      NumBodiesTotal);
-	SET_DWORD_STAT(STAT_PhysXInstanced_BodiesSimulating, NumBodiesSimulating);
-	SET_DWORD_STAT(STAT_PhysXInstanced_BodiesSleeping,   NumBodiesSleeping);
+static bool ComputeRule_InitAndFastPath(float TimerDelta, FPhysXInstanceAsyncStepJob& Job)
+{
+	if (!Job.Data || !Job.RigidDynamic)
+	{
+		return false;
+	}
 
-	const uint32 LifetimeClamped = (uint32)FMath::Min<uint64>(NumBodiesLifetimeCreated, (uint64)MAX_uint32);
-	SET_DWORD_STAT(STAT_PhysXInstanced_BodiesLifetimeCreated, LifetimeClamped);
+	FPhysXInstanceData* InstanceData = Job.Data;
 
-	bPhysicsStepHasPendingApply = false;
-}
+	const bool bSleepingNow = Job.RigidDynamic->isSleeping();
+	Job.bSleeping = bSleepingNow;
 
+	Job.bApplyStopAction = false;
+	Job.ActionToApply    = EPhysXInstanceStopAction::None;
+	Job.bEnableCCD       = false;
+	Job.bDisableCCD      = false;
 
-void UPhysXInstancedWorldSubsystem::AsyncPhysicsStep(float DeltaTime, float SimTime)
-{
-#if !PHYSICS_INTERFACE_PHYSX
-	return;
-#else
-	PhysicsStep_Compute(DeltaTime, SimTime);
-	PhysicsStep_ApplyStopActionsAndCCD();
-	PhysicsStep_ApplyTransformSync();
-	PhysicsStep_Finalize();
-#endif
-}
+	Job.CachedLinearVelocityU = FVector::ZeroVector;
+	Job.CachedLinearSpeed     = 0.0f;
+	Job.CachedAngularSpeedDeg = 0.0f;
 
-void UPhysXInstancedWorldSubsystem::PhysicsStep_Compute(float DeltaTime, float SimTime)
-{
-	const float TimerDelta = FMath::Max(0.0f, SimTime);
+	const bool bHasAutoStop =
+		(Job.StopConfig.bEnableAutoStop &&
+		 Job.StopConfig.Action != EPhysXInstanceStopAction::None);
 
-	PhysicsStepTimerDelta       = TimerDelta;
-	bPhysicsStepHasPendingApply = false;
+	const bool bHasSafetyRule =
+		Job.StopConfig.bUseMaxFallTime ||
+		Job.StopConfig.bUseMaxDistanceFromActor ||
+		Job.bUseCustomKillZ;
 
-	TArray<FPhysXInstanceAsyncStepJob>& Jobs = GAsyncStepJobs;
-	Jobs.Reset();
+	const bool bUsesAutoCCD =
+		(Job.CCDConfig.Mode == EPhysXInstanceCCDMode::AutoByVelocity);
 
-	PhysicsStepApplyCtx.Reset(0);
+	const bool bCanUseSleepingFastPath =
+		InstanceData->bWasSleeping &&
+		bSleepingNow &&
+		!bHasAutoStop &&
+		!bHasSafetyRule &&
+		!bUsesAutoCCD;
 
-	if (Instances.Num() == 0)
+	if (bCanUseSleepingFastPath)
 	{
-		NumBodiesTotal      = 0;
-		NumBodiesSimulating = 0;
-		NumBodiesSleeping   = 0;
-
-		SET_DWORD_STAT(STAT_PhysXInstanced_BodiesTotal,      0);
-		SET_DWORD_STAT(STAT_PhysXInstanced_BodiesSimulating, 0);
-		SET_DWORD_STAT(STAT_PhysXInstanced_BodiesSleeping,   0);
-		SET_DWORD_STAT(STAT_PhysXInstanced_JobsPerFrame,     0);
-		SET_DWORD_STAT(STAT_PhysXInstanced_InstancesTotal,   0);
-
-		const uint32 LifetimeClamped = (uint32)FMath::Min<uint64>(NumBodiesLifetimeCreated, (uint64)MAX_uint32);
-		SET_DWORD_STAT(STAT_PhysXInstanced_BodiesLifetimeCreated, LifetimeClamped);
-		return;
+		Job.NewSleepTime = InstanceData->SleepTime;
+		Job.NewFallTime  = InstanceData->FallTime;
+		return false;
 	}
 
-	SET_DWORD_STAT(STAT_PhysXInstanced_InstancesTotal, Instances.Num());
+	return true;
+}
 
-	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_AsyncPhysicsStep);
+static bool ComputeRule_ReadPose(float /*TimerDelta*/, FPhysXInstanceAsyncStepJob& Job)
+{
+	const PxTransform PxPose = Job.RigidDynamic->getGlobalPose();
 
-	int32 LocalTotal    = 0;
-	int32 LocalSleeping = 0;
+	const FVector ULocation = P2UVector(PxPose.p);
+	const FQuat   URotation = P2UQuat(PxPose.q);
 
-	PxScene* PxScenePtr = nullptr;
-	if (UWorld* World = GetWorld())
-	{
-		PxScenePtr = GetPhysXSceneFromWorld(World);
-	}
+	Job.NewWorldTransform = FTransform(URotation, ULocation, FVector::OneVector);
+	Job.NewLocation       = ULocation;
 
-	TSet<PxRigidActor*> ActiveActorsSet;
-	int32 NumActiveActorsFromScene = 0;
+	return true;
+}
 
-	if (PxScenePtr)
+static bool ComputeRule_CustomKillZ(float /*TimerDelta*/, FPhysXInstanceAsyncStepJob& Job)
+{
+	if (Job.bUseCustomKillZ && Job.NewLocation.Z < Job.CustomKillZ)
 	{
-		PxU32     NumActive   = 0;
-		PxActor** ActiveArray = PxScenePtr->getActiveActors(NumActive);
-
-		if (ActiveArray && NumActive > 0)
+		if (Job.LostInstanceAction != EPhysXInstanceStopAction::None)
 		{
-			NumActiveActorsFromScene = static_cast<int32>(NumActive);
-			ActiveActorsSet.Reserve(NumActiveActorsFromScene);
-
-			for (PxU32 Index = 0; Index < NumActive; ++Index)
-			{
-				if (PxActor* Actor = ActiveArray[Index])
-				{
-					if (PxRigidActor* Rigid = Actor->is<PxRigidActor>())
-					{
-						ActiveActorsSet.Add(Rigid);
-					}
-				}
-			}
+			Job.bApplyStopAction = true;
+			Job.ActionToApply    = Job.LostInstanceAction;
 		}
+
+		Job.NewSleepTime = 0.0f;
+		Job.NewFallTime  = 0.0f;
+		Job.RemoveReason = EPhysXInstanceRemoveReason::KillZ;
+		return false;
 	}
 
-#if DO_GUARD_SLOW
+	return true;
+}
+
+static bool ComputeRule_AutoStopDisabled(float TimerDelta, FPhysXInstanceAsyncStepJob& Job)
+{
+	if (!Job.StopConfig.bEnableAutoStop ||
+		Job.StopConfig.Action == EPhysXInstanceStopAction::None)
 	{
-		TMap<TPair<UInstancedStaticMeshComponent*, int32>, FPhysXInstanceID> SlotOwners;
+		const bool bSleepingNow = Job.bSleeping;
 
-		for (const TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
-		{
-			const FPhysXInstanceData& DataCheck = Pair.Value;
-			UInstancedStaticMeshComponent* ISMC = DataCheck.InstancedComponent.Get();
-			if (!ISMC || DataCheck.InstanceIndex == INDEX_NONE)
-			{
-				continue;
-			}
+		FPhysXInstanceData* InstanceData = Job.Data;
 
-			const TPair<UInstancedStaticMeshComponent*, int32> Key(ISMC, DataCheck.InstanceIndex);
-			if (const FPhysXInstanceID* Existing = SlotOwners.Find(Key))
-			{
-				ensureMsgf(false, TEXT("Duplicate ISM slot owner: ID=%u and ID=%u on Component=%s Index=%d"),
-					Existing->GetUniqueID(), Pair.Key.GetUniqueID(),
-					*GetNameSafe(ISMC), DataCheck.InstanceIndex);
-			}
-			else
-			{
-				SlotOwners.Add(Key, Pair.Key);
-			}
-		}
+		Job.NewSleepTime = bSleepingNow
+			? (InstanceData->SleepTime + TimerDelta)
+			: 0.0f;
+
+		Job.NewFallTime = 0.0f;
+		return false;
 	}
-#endif
 
-	Jobs.Reserve(Instances.Num());
+	return true;
+}
 
-	int32 NumJobsAdded = 0;
+static bool ComputeRule_ReadVelocitiesAndCCD(float /*TimerDelta*/, FPhysXInstanceAsyncStepJob& Job)
+{
+	const bool bNeedVelForStopCondition =
+		(Job.StopConfig.Condition == EPhysXInstanceStopCondition::VelocityThreshold ||
+		 Job.StopConfig.Condition == EPhysXInstanceStopCondition::SleepOrVelocity ||
+		 Job.StopConfig.Condition == EPhysXInstanceStopCondition::SleepAndVelocity);
 
-	for (TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
+	const bool bNeedVelForFallTime = Job.StopConfig.bUseMaxFallTime;
+	const bool bNeedVelForCCD      = (Job.CCDConfig.Mode == EPhysXInstanceCCDMode::AutoByVelocity);
+
+	const bool bNeedAngularSpeed =
+		bNeedVelForStopCondition && (Job.StopConfig.AngularSpeedThreshold > 0.0f);
+
+	const bool bNeedLinearSpeed =
+		bNeedVelForStopCondition || bNeedVelForFallTime || bNeedVelForCCD;
+
+	if (bNeedLinearSpeed || bNeedAngularSpeed)
 	{
-		const FPhysXInstanceID ID = Pair.Key;
-		FPhysXInstanceData& InstanceData = Pair.Value;
+		const PxVec3 LinVelPx = Job.RigidDynamic->getLinearVelocity();
+		Job.CachedLinearVelocityU = P2UVector(LinVelPx);
+		Job.CachedLinearSpeed     = Job.CachedLinearVelocityU.Size();
 
-		if (!InstanceData.bSimulating)
+		if (bNeedAngularSpeed)
 		{
-			continue;
+			const PxVec3 AngVelPx    = Job.RigidDynamic->getAngularVelocity();
+			const float  AngSpeedRad = AngVelPx.magnitude();
+			Job.CachedAngularSpeedDeg = FMath::RadiansToDegrees(AngSpeedRad);
 		}
+	}
 
-		physx::PxRigidActor* PxActor = InstanceData.Body.GetPxActor();
-		if (!PxActor)
+	if (Job.CCDConfig.Mode == EPhysXInstanceCCDMode::AutoByVelocity)
+	{
+		const float MinVel = Job.CCDConfig.MinCCDVelocity;
+		const bool  bShouldUseCCD = (Job.CachedLinearSpeed >= MinVel);
+
+		const bool bCurrentlyCCD =
+			Job.RigidDynamic->getRigidBodyFlags().isSet(PxRigidBodyFlag::eENABLE_CCD);
+
+		if (bShouldUseCCD && !bCurrentlyCCD)
 		{
-			continue;
+			Job.bEnableCCD = true;
 		}
-
-		physx::PxRigidDynamic* RigidDynamic = PxActor->is<physx::PxRigidDynamic>();
-		if (!RigidDynamic)
+		else if (!bShouldUseCCD && bCurrentlyCCD)
 		{
-			continue;
+			Job.bDisableCCD = true;
 		}
+	}
 
-		++LocalTotal;
-
-		const bool bSleepingNow = RigidDynamic->isSleeping();
-		const bool bIsActive    = ActiveActorsSet.Contains(PxActor);
+	return true;
+}
 
-		if (!bIsActive && bSleepingNow)
+static bool ComputeRule_MaxFallTime(float TimerDelta, FPhysXInstanceAsyncStepJob& Job)
+{
+	if (Job.StopConfig.bUseMaxFallTime)
+	{
+		if (Job.CachedLinearVelocityU.Z < 0.0f)
 		{
-			++LocalSleeping;
-			InstanceData.bWasSleeping = true;
-			continue;
+			Job.NewFallTime += TimerDelta;
 		}
-
-		UInstancedStaticMeshComponent* ISMC = InstanceData.InstancedComponent.Get();
-		if (!ISMC)
+		else
 		{
-			continue;
+			Job.NewFallTime = 0.0f;
 		}
 
-		const APhysXInstancedMeshActor* OwnerActor = Cast<APhysXInstancedMeshActor>(ISMC->GetOwner());
-		if (!OwnerActor)
+		if (Job.NewFallTime >= Job.StopConfig.MaxFallTime &&
+			Job.StopConfig.Action != EPhysXInstanceStopAction::None)
 		{
-			continue;
+			Job.bApplyStopAction = true;
+			Job.ActionToApply    = Job.StopConfig.Action;
+			Job.NewSleepTime     = 0.0f;
+			Job.NewFallTime      = 0.0f;
+			return false;
 		}
+	}
+	else
+	{
+		Job.NewFallTime = 0.0f;
+	}
 
-		const FPhysXInstanceStopConfig StopConfig = OwnerActor->AutoStopConfig;
-		const FPhysXInstanceCCDConfig  CCDConfig  = OwnerActor->CCDConfig;
-
-		const bool bUseCustomKillZ = OwnerActor->bUseCustomKillZ;
-		const float CustomKillZ    = OwnerActor->CustomKillZ;
+	return true;
+}
 
-		const EPhysXInstanceStopAction LostInstanceAction = OwnerActor->LostInstanceAction;
+static bool ComputeRule_MaxDistanceFromActor(float /*TimerDelta*/, FPhysXInstanceAsyncStepJob& Job)
+{
+	if (Job.StopConfig.bUseMaxDistanceFromActor &&
+		Job.bHasOwnerLocation &&
+		Job.StopConfig.MaxDistanceFromActor > 0.0f &&
+		Job.StopConfig.Action != EPhysXInstanceStopAction::None)
+	{
+		const float MaxDistSq = FMath::Square(Job.StopConfig.MaxDistanceFromActor);
+		const float DistSq    = FVector::DistSquared(Job.OwnerLocation, Job.NewLocation);
 
-		const bool bHasOwnerLocation = true;
-		const FVector OwnerLocation  = OwnerActor->GetActorLocation();
+		if (DistSq > MaxDistSq)
+		{
+			Job.bApplyStopAction = true;
+			Job.ActionToApply    = Job.StopConfig.Action;
+			Job.NewSleepTime     = 0.0f;
+			Job.NewFallTime      = 0.0f;
+			return false;
+		}
+	}
 
-		FPhysXInstanceAsyncStepJob Job;
-		Job.ID           = ID;
-		Job.Data         = &InstanceData;
-		Job.ISMC         = ISMC;
-		Job.RigidDynamic = RigidDynamic;
+	return true;
+}
 
-		Job.StopConfig         = StopConfig;
-		Job.CCDConfig          = CCDConfig;
-		Job.bUseCustomKillZ    = bUseCustomKillZ;
-		Job.CustomKillZ        = CustomKillZ;
-		Job.LostInstanceAction = LostInstanceAction;
-		Job.bHasOwnerLocation  = bHasOwnerLocation;
-		Job.OwnerLocation      = OwnerLocation;
+static bool ComputeRule_StopCondition(float TimerDelta, FPhysXInstanceAsyncStepJob& Job)
+{
+	const bool bSleepingNow = Job.bSleeping;
 
-		Job.NewSleepTime = InstanceData.SleepTime;
-		Job.NewFallTime  = InstanceData.FallTime;
+	const bool bBelowVelocityThreshold =
+		(Job.CachedLinearSpeed <= Job.StopConfig.LinearSpeedThreshold) &&
+		(Job.CachedAngularSpeedDeg <= Job.StopConfig.AngularSpeedThreshold);
 
-		Job.bWasSleepingInitial = InstanceData.bWasSleeping;
+	bool bStopConditionNow = false;
 
-		Jobs.Add(Job);
-		++NumJobsAdded;
+	switch (static_cast<int32>(Job.StopConfig.Condition))
+	{
+	case 0: // PhysXSleepFlag
+		bStopConditionNow = bSleepingNow;
+		break;
+	case 1: // VelocityThreshold
+		bStopConditionNow = bBelowVelocityThreshold;
+		break;
+	case 2: // SleepOrVelocity
+		bStopConditionNow = bSleepingNow || bBelowVelocityThreshold;
+		break;
+	case 3: // SleepAndVelocity
+		bStopConditionNow = bSleepingNow && bBelowVelocityThreshold;
+		break;
+	default:
+		bStopConditionNow = false;
+		break;
 	}
 
-	if (Jobs.Num() == 0)
+	if (!bStopConditionNow || Job.StopConfig.MinStoppedTime <= 0.0f)
 	{
-		NumBodiesTotal      = LocalTotal;
-		NumBodiesSleeping   = LocalSleeping;
-		NumBodiesSimulating = NumBodiesTotal - NumBodiesSleeping;
-
-		SET_DWORD_STAT(STAT_PhysXInstanced_BodiesTotal,      NumBodiesTotal);
-		SET_DWORD_STAT(STAT_PhysXInstanced_BodiesSimulating, NumBodiesSimulating);
-		SET_DWORD_STAT(STAT_PhysXInstanced_BodiesSleeping,   NumBodiesSleeping);
-		SET_DWORD_STAT(STAT_PhysXInstanced_JobsPerFrame,     0);
-
-		const uint32 LifetimeClamped = (uint32)FMath::Min<uint64>(NumBodiesLifetimeCreated, (uint64)MAX_uint32);
-		SET_DWORD_STAT(STAT_PhysXInstanced_BodiesLifetimeCreated, LifetimeClamped);
-		return;
+		Job.NewSleepTime = 0.0f;
+		return false;
 	}
 
-	SET_DWORD_STAT(STAT_PhysXInstanced_JobsPerFrame, Jobs.Num());
-
-	auto StepAsyncJob = [TimerDelta](FPhysXInstanceAsyncStepJob& Job)
+	Job.NewSleepTime += TimerDelta;
+	if (Job.NewSleepTime >= Job.StopConfig.MinStoppedTime)
 	{
-		if (!Job.Data || !Job.RigidDynamic)
-		{
-			return;
-		}
-
-		if (!RunAsyncPreComputeRules(TimerDelta, Job))
-		{
-			return;
-		}
+		Job.bApplyStopAction = true;
+		Job.ActionToApply    = Job.StopConfig.Action;
+		Job.NewSleepTime     = 0.0f;
+		Job.NewFallTime      = 0.0f;
+	}
 
-		ComputeAsyncStep_Core(TimerDelta, Job);
+	return false;
+}
 
-		RunAsyncPostComputeRules(TimerDelta, Job);
+static const FPhysXISAsyncComputeRuleFn GPhysXISAsyncComputeRules[] =
+{
+	&ComputeRule_InitAndFastPath,
+	&ComputeRule_ReadPose,
+	&ComputeRule_CustomKillZ,
+	&ComputeRule_AutoStopDisabled,
+	&ComputeRule_ReadVelocitiesAndCCD,
+	&ComputeRule_MaxFallTime,
+	&ComputeRule_MaxDistanceFromActor,
+	&ComputeRule_StopCondition,
+	nullptr
+};
+
+static void ComputeAsyncStep_Core(float TimerDelta, FPhysXInstanceAsyncStepJob& Job)
+{
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_AsyncJobWorker);
+
+	for (int32 Index = 0; GPhysXISAsyncComputeRules[Index] != nullptr; ++Index)
+	{
+		if (!GPhysXISAsyncComputeRules[Index](TimerDelta, Job))
+		{
+			break;
+		}
+	}
+}
+}
+
+bool UPhysXInstancedWorldSubsystem::ExecuteInstanceStopAction_Internal(
+	FPhysXInstanceID ID,
+	EPhysXInstanceStopAction Action,
+	const FStopActionExecOptions& Opt)
+{
+	if (Action == EPhysXInstanceStopAction::None)
+	{
+		return Instances.Contains(ID);
+	}
+
+	FPhysXInstanceData* Data = Instances.Find(ID);
+	if (!Data)
+	{
+		return false;
+	}
+
+	using FHandler = bool (UPhysXInstancedWorldSubsystem::*)(
+		FPhysXInstanceID,
+		const FStopActionExecOptions&,
+		FPhysXInstanceData&);
+
+	static const FHandler Handlers[] =
+	{
+		&UPhysXInstancedWorldSubsystem::HandleStopAction_None,                       // None
+		&UPhysXInstancedWorldSubsystem::HandleStopAction_DisableSimulation,          // DisableSimulation
+		&UPhysXInstancedWorldSubsystem::HandleStopAction_DestroyBody,                // DestroyBody
+		&UPhysXInstancedWorldSubsystem::HandleStopAction_DestroyBodyAndRemoveInstance,// DestroyBodyAndRemoveInstance
+		&UPhysXInstancedWorldSubsystem::HandleStopAction_ConvertToStorage            // ConvertToStorage
 	};
 
+	const int32 ActionIndex = (int32)Action;
+	if (ActionIndex < 0 || ActionIndex >= UE_ARRAY_COUNT(Handlers) || !Handlers[ActionIndex])
 	{
-		SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_AsyncParallel);
+		return true;
+	}
 
-		const bool bUseParallel =
-			(CVarPhysXInstancedUseParallelStep.GetValueOnGameThread() != 0) &&
-			(Jobs.Num() >= 64);
+	const bool bStillExists = (this->*Handlers[ActionIndex])(ID, Opt, *Data);
+	if (!bStillExists)
+	{
+		return false;
+	}
 
-		if (bUseParallel)
+	if (Opt.bResetTimers)
+	{
+		if (FPhysXInstanceData* After = Instances.Find(ID))
 		{
-			ParallelFor(Jobs.Num(), [&Jobs, &StepAsyncJob](int32 JobIndex)
+			After->SleepTime = 0.0f;
+			After->FallTime  = 0.0f;
+		}
+	}
+
+	return true;
+}
+
+#endif // PHYSICS_INTERFACE_PHYSX
+
+// ============================================================================
+// Physics update
+// ============================================================================
+void UPhysXInstancedWorldSubsystem::PhysicsStep_ApplyStopActionsAndCCD()
+{
+	if (!bPhysicsStepHasPendingApply)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_AsyncApply);
+
+	TArray<FPhysXInstanceAsyncStepJob>& Jobs = GAsyncStepJobs;
+
+#if PHYSICS_INTERFACE_PHYSX
+	// Stop actions (KillZ, max fall time, auto-stop) can destroy many bodies in one step.
+	FScopedBodyDestroyBatch BodyDestroyScope(*this);
+#endif
+
+	for (FPhysXInstanceAsyncStepJob& JobData : Jobs)
+	{
+		FPhysXInstanceData* InstanceData = JobData.Data;
+		if (!InstanceData)
+		{
+			continue;
+		}
+
+		if (JobData.bEnableCCD && JobData.RigidDynamic)
+		{
+			JobData.RigidDynamic->setRigidBodyFlag(PxRigidBodyFlag::eENABLE_CCD, true);
+		}
+		else if (JobData.bDisableCCD && JobData.RigidDynamic)
+		{
+			JobData.RigidDynamic->setRigidBodyFlag(PxRigidBodyFlag::eENABLE_CCD, false);
+		}
+
+		if (JobData.bApplyStopAction && JobData.ActionToApply != EPhysXInstanceStopAction::None)
+		{
+			FStopActionExecOptions Opt;
+			Opt.RemoveReason                = JobData.RemoveReason;
+			Opt.bRemoveVisualInstance       = true;
+			Opt.bCreateStorageActorIfNeeded = true;
+
+			Opt.bUseSetInstancePhysicsEnabled = false;
+			Opt.bResetTimers                 = true;
+			Opt.bDestroyBodyOnConvertFailure = true;
+
+			const bool bStillExists = ExecuteInstanceStopAction_Internal(JobData.ID, JobData.ActionToApply, Opt);
+
+			if (!bStillExists || JobData.ActionToApply == EPhysXInstanceStopAction::ConvertToStorage)
 			{
-				StepAsyncJob(Jobs[JobIndex]);
-			});
+				JobData.Data         = nullptr;
+				JobData.ISMC         = nullptr;
+				JobData.RigidDynamic = nullptr;
+				continue;
+			}
 		}
 		else
 		{
-			for (int32 JobIndex = 0; JobIndex < Jobs.Num(); ++JobIndex)
+			InstanceData->SleepTime = JobData.NewSleepTime;
+			InstanceData->FallTime  = JobData.NewFallTime;
+		}
+
+		if (JobData.bSleeping)
+		{
+			++PhysicsStepLocalSleeping;
+		}
+
+		InstanceData->bWasSleeping = JobData.bSleeping;
+	}
+}
+
+void UPhysXInstancedWorldSubsystem::PhysicsStep_ApplyTransformSync()
+{
+	if (!bPhysicsStepHasPendingApply)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_AsyncApply);
+
+	TArray<FPhysXInstanceAsyncStepJob>& Jobs = GAsyncStepJobs;
+
+	for (FPhysXInstanceAsyncStepJob& JobData : Jobs)
+	{
+		FPhysXInstanceData* InstanceData = JobData.Data;
+		if (!InstanceData)
+		{
+			continue;
+		}
+
+		UInstancedStaticMeshComponent* ISMComponent = JobData.ISMC;
+		if (!ISMComponent || !ISMComponent->IsValidLowLevelFast())
+		{
+			continue;
+		}
+
+		if (InstanceData->InstanceIndex == INDEX_NONE)
+		{
+			continue;
+		}
+
+		const bool bWasSleeping = JobData.bWasSleepingInitial;
+		const bool bIsSleeping  = JobData.bSleeping;
+
+		if (bIsSleeping && bWasSleeping)
+		{
+			continue;
+		}
+
+		SpatialHash.Update(JobData.ID, JobData.NewLocation);
+
+		if (UPhysXInstancedStaticMeshComponent* PhysXISMC = Cast<UPhysXInstancedStaticMeshComponent>(ISMComponent))
+		{
+			FPhysicsStepTransformBatch& Batch = PhysicsStepApplyCtx.ComponentBatches.FindOrAdd(PhysXISMC);
+			Batch.InstanceIndices.Add(InstanceData->InstanceIndex);
+			Batch.WorldTransforms.Add(JobData.NewWorldTransform);
+
+			// Instances that left their spatial chunk are moved by the render component migration pass.
+			if (PhysXISMC->bIsSpatialChunk &&
+				PhysXISMC->OwningPhysXActor &&
+				PhysXISMC->OwningPhysXActor->HasLeftChunkCell(PhysXISMC, JobData.NewLocation))
 			{
-				StepAsyncJob(Jobs[JobIndex]);
+				QueueRenderComponentMigration(JobData.ID, *InstanceData);
 			}
 		}
+		else
+		{
+			ISMComponent->UpdateInstanceTransform(
+				InstanceData->InstanceIndex,
+				JobData.NewWorldTransform,
+				/*bWorldSpace=*/true,
+				/*bMarkRenderStateDirty=*/false,
+				/*bTeleport=*/false);
+
+			PhysicsStepApplyCtx.DirtyComponents.Add(ISMComponent);
+		}
 	}
 
-	PhysicsStepLocalTotal    = LocalTotal;
-	PhysicsStepLocalSleeping = LocalSleeping;
+	for (auto& Pair : PhysicsStepApplyCtx.ComponentBatches)
+	{
+		UPhysXInstancedStaticMeshComponent* PhysXISMC = Pair.Key;
+		FPhysicsStepTransformBatch&         Batch     = Pair.Value;
 
-	PhysicsStepApplyCtx.Reset(Jobs.Num());
-	bPhysicsStepHasPendingApply = true;
+		if (!PhysXISMC || !PhysXISMC->IsValidLowLevelFast())
+		{
+			continue;
+		}
+
+		if (Batch.InstanceIndices.Num() == 0 ||
+			Batch.InstanceIndices.Num() != Batch.WorldTransforms.Num())
+		{
+			continue;
+		}
+
+		PhysXISMC->UpdateInstancesFromPhysXBatch_MT(
+			Batch.InstanceIndices,
+			Batch.WorldTransforms,
+			/*bTeleport=*/false);
+	}
 }
 
-// ============================================================================
-// High level physics control
-// ============================================================================
+void UPhysXInstancedWorldSubsystem::PhysicsStep_Finalize()
+{
+	if (!bPhysicsStepHasPendingApply)
+	{
+		return;
+	}
+
+	for (UInstancedStaticMeshComponent* ISMC : PhysicsStepApplyCtx.DirtyComponents)
+	{
+		if (ISMC && ISMC->IsValidLowLevelFast())
+		{
+			ISMC->MarkRenderStateDirty();
+		}
+	}
+
+	TArray<FPhysXInstanceAsyncStepJob>& Jobs = GAsyncStepJobs;
+	RunAsyncPostApplyRules(*this, PhysicsStepTimerDelta, Jobs);
+
+	NumBodiesTotal      = PhysicsStepLocalTotal;
+	NumBodiesSleeping   = PhysicsStepLocalSleeping;
+	NumBodiesSimulating = NumBodiesTotal - NumBodiesSleeping;
+
+	SET_DWORD_STAT(STAT_PhysXInstanced_BodiesTotal,      NumBodiesTotal);
+	SET_DWORD_STAT(STAT_PhysXInstanced_BodiesSimulating, NumBodiesSimulating);
+	SET_DWORD_STAT(STAT_PhysXInstanced_BodiesSleeping,   NumBodiesSleeping);
+
+	const uint32 LifetimeClamped = (uint32)FMath::Min<uint64>(NumBodiesLifetimeCreated, (uint64)MAX_uint32);
+	SET_DWORD_STAT(STAT_PhysXInstanced_BodiesLifetimeCreated, LifetimeClamped);
+
+	bPhysicsStepHasPendingApply = false;
+}
+
+
+void UPhysXInstancedWorldSubsystem::AsyncPhysicsStep(float DeltaTime, float SimTime)
+{
+#if !PHYSICS_INTERFACE_PHYSX
+	return;
+#else
+	PhysicsStep_Compute(DeltaTime, SimTime);
+	PhysicsStep_ApplyStopActionsAndCCD();
+	PhysicsStep_ApplyTransformSync();
+	PhysicsStep_Finalize();
+#endif
+}
+
+void UPhysXInstancedWorldSubsystem::PhysicsStep_Compute(float DeltaTime, float SimTime)
+{
+	const float TimerDelta = FMath::Max(0.0f, SimTime);
+
+	PhysicsStepTimerDelta       = TimerDelta;
+	bPhysicsStepHasPendingApply = false;
+
+	TArray<FPhysXInstanceAsyncStepJob>& Jobs = GAsyncStepJobs;
+	Jobs.Reset();
+
+	PhysicsStepApplyCtx.Reset(0);
+
+	if (Instances.Num() == 0)
+	{
+		NumBodiesTotal      = 0;
+		NumBodiesSimulating = 0;
+		NumBodiesSleeping   = 0;
+
+		SET_DWORD_STAT(STAT_PhysXInstanced_BodiesTotal,      0);
+		SET_DWORD_STAT(STAT_PhysXInstanced_BodiesSimulating, 0);
+		SET_DWORD_STAT(STAT_PhysXInstanced_BodiesSleeping,   0);
+		SET_DWORD_STAT(STAT_PhysXInstanced_JobsPerFrame,     0);
+		SET_DWORD_STAT(STAT_PhysXInstanced_InstancesTotal,   0);
+
+		const uint32 LifetimeClamped = (uint32)FMath::Min<uint64>(NumBodiesLifetimeCreated, (uint64)MAX_uint32);
+		SET_DWORD_STAT(STAT_PhysXInstanced_BodiesLifetimeCreated, LifetimeClamped);
+		return;
+	}
+
+	SET_DWORD_STAT(STAT_PhysXInstanced_InstancesTotal, Instances.Num());
+	SET_DWORD_STAT(STAT_PhysXInstanced_SpatialHashCells, SpatialHash.NumCells());
+#if PHYSICS_INTERFACE_PHYSX
+	SET_DWORD_STAT(STAT_PhysXInstanced_SharedShapes, ShapeCache.Num());
+	SET_DWORD_STAT(STAT_PhysXInstanced_PooledBodies, ShapeCache.NumPooledActors());
+#endif
+
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_AsyncPhysicsStep);
+
+	int32 LocalTotal    = 0;
+	int32 LocalSleeping = 0;
+
+	PxScene* PxScenePtr = nullptr;
+	if (UWorld* World = GetWorld())
+	{
+		PxScenePtr = GetPhysXSceneFromWorld(World);
+	}
+
+	TSet<PxRigidActor*> ActiveActorsSet;
+	int32 NumActiveActorsFromScene = 0;
+
+	if (PxScenePtr)
+	{
+		PxU32     NumActive   = 0;
+		PxActor** ActiveArray = PxScenePtr->getActiveActors(NumActive);
+
+		if (ActiveArray && NumActive > 0)
+		{
+			NumActiveActorsFromScene = static_cast<int32>(NumActive);
+			ActiveActorsSet.Reserve(NumActiveActorsFromScene);
+
+			for (PxU32 Index = 0; Index < NumActive; ++Index)
+			{
+				if (PxActor* Actor = ActiveArray[Index])
+				{
+					if (PxRigidActor* Rigid = Actor->is<PxRigidActor>())
+					{
+						ActiveActorsSet.Add(Rigid);
+					}
+				}
+			}
+		}
+	}
+
+#if DO_GUARD_SLOW
+	{
+		TMap<TPair<UInstancedStaticMeshComponent*, int32>, FPhysXInstanceID> SlotOwners;
+
+		for (const TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
+		{
+			const FPhysXInstanceData& DataCheck = Pair.Value;
+			UInstancedStaticMeshComponent* ISMC = DataCheck.InstancedComponent.Get();
+			if (!ISMC || DataCheck.InstanceIndex == INDEX_NONE)
+			{
+				continue;
+			}
+
+			const TPair<UInstancedStaticMeshComponent*, int32> Key(ISMC, DataCheck.InstanceIndex);
+			if (const FPhysXInstanceID* Existing = SlotOwners.Find(Key))
+			{
+				ensureMsgf(false, TEXT("Duplicate ISM slot owner: ID=%u and ID=%u on Component=%s Index=%d"),
+					Existing->GetUniqueID(), Pair.Key.GetUniqueID(),
+					*GetNameSafe(ISMC), DataCheck.InstanceIndex);
+			}
+			else
+			{
+				SlotOwners.Add(Key, Pair.Key);
+			}
+		}
+	}
+#endif
+
+	UpdateShadowLODView();
+
+	RefreshActorRenderTierSettings();
+
+	Jobs.Reserve(Instances.Num());
+	SleepingShadowLODCandidates.Reset();
+
+	int32 NumJobsAdded = 0;
+
+	for (TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
+	{
+		const FPhysXInstanceID ID = Pair.Key;
+		FPhysXInstanceData& InstanceData = Pair.Value;
+
+		if (!InstanceData.bSimulating)
+		{
+			continue;
+		}
+
+		physx::PxRigidActor* PxActor = InstanceData.Body.GetPxActor();
+		if (!PxActor)
+		{
+			continue;
+		}
+
+		physx::PxRigidDynamic* RigidDynamic = PxActor->is<physx::PxRigidDynamic>();
+		if (!RigidDynamic)
+		{
+			continue;
+		}
+
+		++LocalTotal;
+
+		const bool bSleepingNow = RigidDynamic->isSleeping();
+		const bool bIsActive    = ActiveActorsSet.Contains(PxActor);
+
+		if (!bIsActive && bSleepingNow)
+		{
+			++LocalSleeping;
+			InstanceData.bWasSleeping = true;
+
+			// Entering the sleeping tier is opt-in; everyone else skips the owner lookup.
+			if (InstanceData.bInSleepingRenderTier)
+			{
+				InstanceData.RenderTierMismatchTime = 0.0f;
+			}
+			else if (bAnySleepingRenderTierActor && InstanceData.bOwnerUsesSleepingTier)
+			{
+				UpdateRenderTierHysteresis(ID, InstanceData, /*bSleeping=*/true, TimerDelta, /*OwnerActor=*/nullptr);
+			}
+
+			// The viewer moves while bodies sleep; these are re-evaluated round-robin after the loop.
+			if (bShadowLODViewValid && InstanceData.bOwnerUsesShadowLOD)
+			{
+				SleepingShadowLODCandidates.Add(ID);
+			}
+			continue;
+		}
+
+		UInstancedStaticMeshComponent* ISMC = InstanceData.InstancedComponent.Get();
+		if (!ISMC)
+		{
+			continue;
+		}
+
+		const APhysXInstancedMeshActor* OwnerActor = Cast<APhysXInstancedMeshActor>(ISMC->GetOwner());
+		if (!OwnerActor)
+		{
+			continue;
+		}
+
+		UpdateRenderTierHysteresis(ID, InstanceData, bSleepingNow, TimerDelta, OwnerActor);
+
+		if (bShadowLODViewValid && OwnerActor->bUseShadowDistanceLOD)
+		{
+			UpdateShadowDistanceLOD(ID, InstanceData, P2UVector(RigidDynamic->getGlobalPose().p), OwnerActor);
+		}
+
+		const FPhysXInstanceStopConfig StopConfig = OwnerActor->AutoStopConfig;
+		const FPhysXInstanceCCDConfig  CCDConfig  = OwnerActor->CCDConfig;
+
+		const bool bUseCustomKillZ = OwnerActor->bUseCustomKillZ;
+		const float CustomKillZ    = OwnerActor->CustomKillZ;
+
+		const EPhysXInstanceStopAction LostInstanceAction = OwnerActor->LostInstanceAction;
+
+		const bool bHasOwnerLocation = true;
+		const FVector OwnerLocation  = OwnerActor->GetActorLocation();
+
+		FPhysXInstanceAsyncStepJob Job;
+		Job.ID           = ID;
+		Job.Data         = &InstanceData;
+		Job.ISMC         = ISMC;
+		Job.RigidDynamic = RigidDynamic;
+
+		Job.StopConfig         = StopConfig;
+		Job.CCDConfig          = CCDConfig;
+		Job.bUseCustomKillZ    = bUseCustomKillZ;
+		Job.CustomKillZ        = CustomKillZ;
+		Job.LostInstanceAction = LostInstanceAction;
+		Job.bHasOwnerLocation  = bHasOwnerLocation;
+		Job.OwnerLocation      = OwnerLocation;
+
+		Job.NewSleepTime = InstanceData.SleepTime;
+		Job.NewFallTime  = InstanceData.FallTime;
+
+		Job.bWasSleepingInitial = InstanceData.bWasSleeping;
+
+		Jobs.Add(Job);
+		++NumJobsAdded;
+	}
+
+	UpdateSleepingShadowDistanceLOD();
+
+	if (Jobs.Num() == 0)
+	{
+		NumBodiesTotal      = LocalTotal;
+		NumBodiesSleeping   = LocalSleeping;
+		NumBodiesSimulating = NumBodiesTotal - NumBodiesSleeping;
+
+		SET_DWORD_STAT(STAT_PhysXInstanced_BodiesTotal,      NumBodiesTotal);
+		SET_DWORD_STAT(STAT_PhysXInstanced_BodiesSimulating, NumBodiesSimulating);
+		SET_DWORD_STAT(STAT_PhysXInstanced_BodiesSleeping,   NumBodiesSleeping);
+		SET_DWORD_STAT(STAT_PhysXInstanced_JobsPerFrame,     0);
+
+		const uint32 LifetimeClamped = (uint32)FMath::Min<uint64>(NumBodiesLifetimeCreated, (uint64)MAX_uint32);
+		SET_DWORD_STAT(STAT_PhysXInstanced_BodiesLifetimeCreated, LifetimeClamped);
+		return;
+	}
+
+	SET_DWORD_STAT(STAT_PhysXInstanced_JobsPerFrame, Jobs.Num());
+
+	auto StepAsyncJob = [TimerDelta](FPhysXInstanceAsyncStepJob& Job)
+	{
+		if (!Job.Data || !Job.RigidDynamic)
+		{
+			return;
+		}
+
+		if (!RunAsyncPreComputeRules(TimerDelta, Job))
+		{
+			return;
+		}
+
+		ComputeAsyncStep_Core(TimerDelta, Job);
+
+		RunAsyncPostComputeRules(TimerDelta, Job);
+	};
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_AsyncParallel);
+
+		const bool bUseParallel =
+			(CVarPhysXInstancedUseParallelStep.GetValueOnGameThread() != 0) &&
+			(Jobs.Num() >= 64);
+
+		if (bUseParallel)
+		{
+			ParallelFor(Jobs.Num(), [&Jobs, &StepAsyncJob](int32 JobIndex)
+			{
+				StepAsyncJob(Jobs[JobIndex]);
+			});
+		}
+		else
+		{
+			for (int32 JobIndex = 0; JobIndex < Jobs.Num(); ++JobIndex)
+			{
+				StepAsyncJob(Jobs[JobIndex]);
+			}
+		}
+	}
+
+	PhysicsStepLocalTotal    = LocalTotal;
+	PhysicsStepLocalSleeping = LocalSleeping;
+
+	PhysicsStepApplyCtx.Reset(Jobs.Num());
+	bPhysicsStepHasPendingApply = true;
+}
+
+// ============================================================================
+// High level physics control
+// ============================================================================
+
+bool UPhysXInstancedWorldSubsystem::SetInstancePhysicsEnabled(
+	FPhysXInstanceID ID,
+	bool bEnable,
+	bool bDestroyBodyIfDisabling)
+{
+	FPhysXInstanceData* Data = Instances.Find(ID);
+	if (!Data)
+	{
+		return false;
+	}
+
+	const bool bWasSimulating = Data->bSimulating;
+
+#if !PHYSICS_INTERFACE_PHYSX
+	// Without PhysX backend, simulation cannot be toggled.
+	return false;
+#else
+	UInstancedStaticMeshComponent* ISMC = Data->InstancedComponent.Get();
+	if (!ISMC || !ISMC->IsValidLowLevelFast())
+	{
+		return false;
+	}
+
+	APhysXInstancedMeshActor* Owner = Cast<APhysXInstancedMeshActor>(ISMC->GetOwner());
+	const TWeakObjectPtr<APhysXInstancedMeshActor> OwnerWeak(Owner);
+
+	// ---------------------------------------------------------------------
+	// PRE/POST PHYSICS EVENTS
+	// Pre: fire right before we start touching PhysX/flags
+	// Post: always fire on exit with bSuccess (final return value)
+	// ---------------------------------------------------------------------
+
+	const bool bFirePre =
+		IsValid(Owner) &&
+		IsEventEnabled(Owner, EPhysXInstanceEventFlags::PrePhysics) &&
+		(Owner->OnInstancePrePhysics.IsBound() || HasInterfaceEvents(Owner));
+
+	const bool bFirePost =
+		IsValid(Owner) &&
+		IsEventEnabled(Owner, EPhysXInstanceEventFlags::PostPhysics) &&
+		(Owner->OnInstancePostPhysics.IsBound() || HasInterfaceEvents(Owner));
+
+	if (bFirePre)
+	{
+		// Use shared helper from anonymous namespace (defined выше в файле).
+		::FirePrePhysics(Owner, ID, bEnable, bDestroyBodyIfDisabling);
+	}
+
+	bool bSuccess = false;
+	ON_SCOPE_EXIT
+	{
+		if (!bFirePost)
+		{
+			return;
+		}
+
+		if (OwnerWeak.IsValid())
+		{
+			::FirePostPhysics(OwnerWeak.Get(), ID, bEnable, bDestroyBodyIfDisabling, bSuccess);
+		}
+	};
+
+	// ---------------------------------------------------------------------
+	// Main logic
+	// ---------------------------------------------------------------------
+
+	physx::PxRigidActor*   Actor        = Data->Body.GetPxActor();
+	physx::PxRigidDynamic* RigidDynamic = Actor ? Actor->is<physx::PxRigidDynamic>() : nullptr;
+
+	if (bEnable)
+	{
+		// Read settings once (authoritative source is the owner actor).
+		UStaticMesh* OverrideMesh = nullptr;
+		bool bUseGravity          = true;
+
+		const APhysXInstancedMeshActor* OwnerActor = Cast<APhysXInstancedMeshActor>(ISMC->GetOwner());
+		const UPhysXInstanceArchetype*  Archetype  = OwnerActor ? OwnerActor->InstanceArchetype : nullptr;
+
+		if (OwnerActor)
+		{
+			OverrideMesh = OwnerActor->GetEffectiveCollisionMesh();
+			bUseGravity  = Archetype ? Archetype->bEnableGravity : OwnerActor->bInstancesUseGravity;
+		}
+
+		// Fallback to component mesh if no override mesh.
+		if (!OverrideMesh)
+		{
+			OverrideMesh = ISMC->GetStaticMesh();
+		}
+
+		// If there is no body yet, try to create one now.
+		if (!RigidDynamic)
+		{
+			if (!CreateInstanceBody(Data->Body, ISMC, Data->InstanceIndex, /*bSimulate=*/true))
+			{
+				// bSuccess stays false; PostPhysics will get false.
+				return false;
+			}
+
+			EnsureInstanceUserData(ID);
+			EnqueueAddActorToScene(ID, ISMC);
+			++NumBodiesLifetimeCreated;
+
+			Actor        = Data->Body.GetPxActor();
+			RigidDynamic = Actor ? Actor->is<physx::PxRigidDynamic>() : nullptr;
+		}
+
+		if (RigidDynamic)
+		{
+			// Switch from kinematic back to dynamic simulation.
+			RigidDynamic->setRigidBodyFlag(PxRigidBodyFlag::eKINEMATIC, false);
+
+			RigidDynamic->setActorFlag(PxActorFlag::eDISABLE_GRAVITY, !bUseGravity);
+			RigidDynamic->setActorFlag(PxActorFlag::eDISABLE_SIMULATION, false);
+
+			// Apply mass/damping overrides every time we (re)enable; archetype bodies keep the baked values.
+			if (OwnerActor && !Archetype)
+			{
+				ApplyOwnerPhysicsOverrides(OwnerActor, ISMC, OverrideMesh, RigidDynamic);
+			}
+
+			Data->bSimulating = true;
+		}
+		else
+		{
+			Data->bSimulating = false;
+		}
+	}
+	else
+	{
+		if (RigidDynamic)
+		{
+			if (bDestroyBodyIfDisabling)
+			{
+				// IMPORTANT: if this ID is queued for deferred AddActorToScene, kill those entries.
+				InvalidatePendingAddEntries(ID);
+
+				// Destroy the PhysX body while keeping the visual instance.
+				DestroyInstanceBody(ID, *Data);
+			}
+			else
+			{
+				// Keep the body but disable simulation by switching to kinematic.
+				RigidDynamic->setRigidBodyFlag(PxRigidBodyFlag::eKINEMATIC, true);
+				RigidDynamic->setActorFlag(PxActorFlag::eDISABLE_SIMULATION, true);
+			}
+		}
+
+		Data->bSimulating = false;
+	}
+
+	// Keep global sim-count in sync with the flag.
+	if (bWasSimulating != Data->bSimulating)
+	{
+		if (Data->bSimulating)
+		{
+			++NumBodiesSimulating;
+		}
+		else if (NumBodiesSimulating > 0)
+		{
+			--NumBodiesSimulating;
+		}
+	}
+
+	// Success must reflect the actual outcome.
+	bSuccess = bEnable ? Data->bSimulating : true;
+	return bSuccess;
+#endif // PHYSICS_INTERFACE_PHYSX
+}
+
+
+
+bool UPhysXInstancedWorldSubsystem::ConvertInstanceToStaticStorage(
+	FPhysXInstanceID ID,
+	bool bCreateStorageActorIfNeeded)
+{
+	// Public call is always explicit.
+	return ConvertInstanceToStaticStorage_Internal(
+		ID,
+		bCreateStorageActorIfNeeded,
+		EPhysXInstanceConvertReason::Explicit);
+}
+
+
+bool UPhysXInstancedWorldSubsystem::ConvertStorageInstanceToDynamic(
+	FPhysXInstanceID ID,
+	bool bCreateDynamicActorIfNeeded)
+{
+	// Public call is always explicit.
+	return ConvertStorageInstanceToDynamic_Internal(
+		ID,
+		bCreateDynamicActorIfNeeded,
+		EPhysXInstanceConvertReason::Explicit);
+}
+
+
+bool UPhysXInstancedWorldSubsystem::ConvertInstanceToStaticStorage_Internal(
+	FPhysXInstanceID ID,
+	bool bCreateStorageActorIfNeeded,
+	EPhysXInstanceConvertReason Reason)
+{
+	FPhysXInstanceData* Data = Instances.Find(ID);
+	if (!Data)
+	{
+		return false;
+	}
+
+	UInstancedStaticMeshComponent* ISMC = Data->InstancedComponent.Get();
+	if (!ISMC || !ISMC->IsValidLowLevelFast())
+	{
+		return false;
+	}
+
+	const int32 InstanceIndex = Data->InstanceIndex;
+	if (InstanceIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// World-space transform of the source instance.
+	FTransform WorldTM;
+	if (!ISMC->GetInstanceTransform(InstanceIndex, WorldTM, /*bWorldSpace=*/true))
+	{
+		return false;
+	}
+
+	APhysXInstancedMeshActor* SourceActor = Cast<APhysXInstancedMeshActor>(ISMC->GetOwner());
+	if (!SourceActor)
+	{
+		return false;
+	}
+
+	UStaticMesh* StaticMesh = SourceActor->InstanceStaticMesh;
+	if (!StaticMesh)
+	{
+		StaticMesh = ISMC->GetStaticMesh();
+	}
+	if (!StaticMesh)
+	{
+		return false;
+	}
+
+	// ---------------------------------------------------------------------
+	// 1) Find or create a storage actor with matching mesh/material settings
+	// ---------------------------------------------------------------------
+
+	APhysXInstancedMeshActor* StorageActor = nullptr;
+
+	// Materials this instance stands for (its variant when the source actor uses a variant table).
+	TArray<UMaterialInterface*> InstanceMaterials;
+	SourceActor->GetInstanceResolvedMaterials(ISMC, InstanceIndex, InstanceMaterials);
+
+	const bool bSourceUsesVariants = SourceActor->UsesMaterialVariants();
+	int32 StorageVariant = INDEX_NONE;
+
+	auto DoMaterialsMatch = [](const APhysXInstancedMeshActor* A, const APhysXInstancedMeshActor* B)
+	{
+		if (!A || !B)
+		{
+			return false;
+		}
+
+		if (A->bOverrideInstanceMaterials != B->bOverrideInstanceMaterials)
+		{
+			return false;
+		}
+
+		if (!A->bOverrideInstanceMaterials)
+		{
+			return true;
+		}
+
+		const int32 NumA = A->InstanceOverrideMaterials.Num();
+		const int32 NumB = B->InstanceOverrideMaterials.Num();
+
+		if (NumA != NumB)
+		{
+			return false;
+		}
+
+		for (int32 Index = 0; Index < NumA; ++Index)
+		{
+			if (A->InstanceOverrideMaterials[Index] != B->InstanceOverrideMaterials[Index])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	};
+
+	for (const TPair<FPhysXActorID, FPhysXActorData>& Pair : Actors)
+	{
+		APhysXInstancedMeshActor* Actor = Pair.Value.Actor.Get();
+		if (!Actor || !Actor->IsValidLowLevelFast())
+		{
+			continue;
+		}
+
+		if (!Actor->bStorageOnly)
+		{
+			continue;
+		}
+
+		if (Actor->InstanceStaticMesh != StaticMesh)
+		{
+			continue;
+		}
+
+		if (bSourceUsesVariants || Actor->UsesMaterialVariants())
+		{
+			if (!DoesActorAcceptMaterials(Actor, InstanceMaterials, StorageVariant))
+			{
+				continue;
+			}
+		}
+		else if (!DoMaterialsMatch(Actor, SourceActor))
+		{
+			continue;
+		}
+
+		StorageActor = Actor;
+		break;
+	}
+
+	// Create a new storage actor when allowed and none exists.
+	if (!StorageActor)
+	{
+		if (!bCreateStorageActorIfNeeded)
+		{
+			return false;
+		}
+
+		UWorld* World = GetWorld();
+		if (!World)
+		{
+			return false;
+		}
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		StorageActor = World->SpawnActor<APhysXInstancedMeshActor>(
+			APhysXInstancedMeshActor::StaticClass(),
+			WorldTM,
+			SpawnParams);
+
+		if (!StorageActor)
+		{
+			return false;
+		}
+
+		// Register the storage actor in the subsystem.
+		const FPhysXActorID NewActorID = RegisterInstancedMeshActor(StorageActor);
+		StorageActor->PhysXActorID = NewActorID;
+
+		// Storage mode settings.
+		StorageActor->bStorageOnly       = true;
+		StorageActor->bIsStorageActor    = true;
+		StorageActor->bSimulateInstances = false;
+		StorageActor->bDisableISMPhysics = false;
+
+		StorageActor->bUseHierarchicalStorage = bUseHierarchicalStorageActors;
+
+		// Copy mesh/material settings from the source actor.
+		StorageActor->InstanceStaticMesh         = StaticMesh;
+		StorageActor->bOverrideInstanceMaterials = SourceActor->bOverrideInstanceMaterials;
+		StorageActor->InstanceOverrideMaterials  = SourceActor->InstanceOverrideMaterials;
+
+		// Variant table travels with the instances so storage collapses variants as well.
+		StorageActor->bUseMaterialVariants           = SourceActor->bUseMaterialVariants;
+		StorageActor->MaterialVariants               = SourceActor->MaterialVariants;
+		StorageActor->MaterialVariantCustomDataIndex = SourceActor->MaterialVariantCustomDataIndex;
+
+		StorageVariant = StorageActor->FindMaterialVariant(InstanceMaterials);
+
+		// Copy storage collision/navigation settings from the source actor.
+		StorageActor->bStorageInstancesAffectNavigation = SourceActor->bStorageInstancesAffectNavigation;
+		StorageActor->StorageCollisionProfile           = SourceActor->StorageCollisionProfile;
+		StorageActor->StorageCollisionEnabled           = SourceActor->StorageCollisionEnabled;
+
+		if (StorageActor->InstancedMesh)
+		{
+			UPhysXInstancedStaticMeshComponent* StorageISMC = StorageActor->InstancedMesh;
+
+			StorageISMC->SetStaticMesh(StaticMesh);
+			StorageActor->ApplyInstanceMaterials();
+
+			StorageISMC->SetSimulatePhysics(false);
+
+			const FName StorageProfile =
+				(StorageActor->StorageCollisionProfile.Name != NAME_None)
+					? StorageActor->StorageCollisionProfile.Name
+					: StorageActor->InstancesCollisionProfile.Name;
+
+			if (StorageProfile != NAME_None)
+			{
+				StorageISMC->SetCollisionProfileName(StorageProfile);
+			}
+
+			StorageISMC->SetCollisionEnabled(StorageActor->StorageCollisionEnabled);
+
+			StorageISMC->SetInstancesAffectNavigation(StorageActor->bStorageInstancesAffectNavigation);
+		}
+	}
+
+	if (!StorageActor || !StorageActor->InstancedMesh)
+	{
+		return false;
+	}
+
+	// Ensure storage actor navigation settings are applied.
+	StorageActor->InstancedMesh->SetInstancesAffectNavigation(StorageActor->bStorageInstancesAffectNavigation);
+
+	// Hierarchical storage actors keep their instances in StorageHierarchicalMesh.
+	UInstancedStaticMeshComponent* StorageISMC = StorageActor->GetStorageComponent();
+	if (!StorageISMC)
+	{
+		return false;
+	}
+
+	// ---------------------------------------------------------------------
+	// PRE/POST CONVERT EVENTS
+	// Signature assumed: (ID, Reason, FromActor, ToActor, WorldTM)
+	// ---------------------------------------------------------------------
+
+	const bool bFirePre_Source =
+		IsEventEnabled(SourceActor, EPhysXInstanceEventFlags::PreConvert) &&
+		(SourceActor->OnInstancePreConvert.IsBound() || HasInterfaceEvents(SourceActor));
+
+	const bool bFirePost_Source =
+		IsEventEnabled(SourceActor, EPhysXInstanceEventFlags::PostConvert) &&
+		(SourceActor->OnInstancePostConvert.IsBound() || HasInterfaceEvents(SourceActor));
+
+	const bool bFirePre_Storage =
+		IsEventEnabled(StorageActor, EPhysXInstanceEventFlags::PreConvert) &&
+		(StorageActor->OnInstancePreConvert.IsBound() || HasInterfaceEvents(StorageActor));
+
+	const bool bFirePost_Storage =
+		IsEventEnabled(StorageActor, EPhysXInstanceEventFlags::PostConvert) &&
+		(StorageActor->OnInstancePostConvert.IsBound() || HasInterfaceEvents(StorageActor));
+
+	auto FirePreConvert = [&](APhysXInstancedMeshActor* Actor)
+	{
+		if (!Actor)
+		{
+			return;
+		}
+
+		Actor->OnInstancePreConvert.Broadcast(ID, Reason, SourceActor, StorageActor, WorldTM);
+
+		if (HasInterfaceEvents(Actor))
+		{
+			IPhysXInstanceEvents::Execute_OnInstancePreConvert(Actor, ID, Reason, SourceActor, StorageActor, WorldTM);
+		}
+	};
+
+	auto FirePostConvert = [&](APhysXInstancedMeshActor* Actor)
+	{
+		if (!Actor)
+		{
+			return;
+		}
+
+		Actor->OnInstancePostConvert.Broadcast(ID, Reason, SourceActor, StorageActor, WorldTM);
+
+		if (HasInterfaceEvents(Actor))
+		{
+			IPhysXInstanceEvents::Execute_OnInstancePostConvert(Actor, ID, Reason, SourceActor, StorageActor, WorldTM);
+		}
+	};
+
+	// Fire PreConvert right before we start mutating data.
+	if (bFirePre_Source)
+	{
+		FirePreConvert(SourceActor);
+	}
+	if (bFirePre_Storage && StorageActor != SourceActor)
+	{
+		FirePreConvert(StorageActor);
+	}
+
+	// Always fire PostConvert even on early returns after this point.
+	const bool bNeedPost = (bFirePost_Source || bFirePost_Storage);
+	ON_SCOPE_EXIT
+	{
+		if (!bNeedPost)
+		{
+			return;
+		}
+
+		if (bFirePost_Source)
+		{
+			FirePostConvert(SourceActor);
+		}
+		if (bFirePost_Storage && StorageActor != SourceActor)
+		{
+			FirePostConvert(StorageActor);
+		}
+	};
+
+	// ---------------------------------------------------------------------
+	// 2) Add a new ISM instance into the storage actor
+	// ---------------------------------------------------------------------
+
+	const int32 StorageIndex = StorageISMC->AddInstanceWorldSpace(WorldTM);
+	if (StorageIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	if (StorageVariant != INDEX_NONE)
+	{
+		StorageActor->SetInstanceMaterialVariant(StorageISMC, StorageIndex, StorageVariant);
+	}
+
+	// Cluster-tree rebuild is deferred until a batch of conversions landed.
+	NotifyStorageInstancesChanged(StorageISMC, 1);
+
+	// ---------------------------------------------------------------------
+	// 3) Remove the source visual instance and destroy its PhysX body
+	//    (ID stays registered; we just rebind it to the storage component/index).
+	// ---------------------------------------------------------------------
+
+	const int32 RemovedIndex = Data->InstanceIndex;
+
+#if PHYSICS_INTERFACE_PHYSX
+	InvalidatePendingAddEntries(ID);
+#endif
+
+	// Remove old slot mapping (source component/index) BEFORE we mutate anything.
+	RemoveSlotMapping(ID);
+
+	const int32 SourceLastIndex = ISMC->GetInstanceCount() - 1;
+
+	// Remove from the dynamic component (this compacts indices).
+	if (!ISMC->RemoveInstance(RemovedIndex))
+	{
+		// Roll back storage add.
+		StorageISMC->RemoveInstance(StorageIndex);
+
+		// Restore old slot mapping (Data still points to the old slot at this moment).
+		AddSlotMapping(ID);
+		RebuildSlotMappingForComponent(ISMC);
+
+		return false;
+	}
+
+	// Keep actor bookkeeping in sync AFTER we know the remove succeeded.
+	SourceActor->RegisteredInstanceIDs.Remove(ID);
+	StorageActor->RegisteredInstanceIDs.Add(ID);
+
+	// Fix indices for other IDs still pointing to the source component (RemoveAt shift).
+	FixInstanceIndicesAfterRemoval(ISMC, RemovedIndex, SourceLastIndex);
+	ISMC->MarkRenderStateDirty();
+
+#if PHYSICS_INTERFACE_PHYSX
+	// Body is gone in storage mode.
+	DestroyInstanceBody(ID, *Data);
+#endif
+
+	// Rebind the stable ID to the storage slot.
+	Data->bSimulating            = false;
+	Data->InstancedComponent     = StorageISMC;
+	Data->InstanceIndex          = StorageIndex;
+	Data->bInSleepingRenderTier  = false;
+	Data->RenderTierMismatchTime = 0.0f;
+	Data->bBeyondShadowDistance  = false;
+
+	// Add new slot mapping AFTER Data points to the storage slot.
+	AddSlotMapping(ID);
+
+	// Rebuild mappings for both components to guarantee correctness.
+	RebuildSlotMappingForComponent(ISMC);
+	RebuildSlotMappingForComponent(StorageISMC);
+
+	// Storage component render state.
+	StorageISMC->MarkRenderStateDirty();
+
+	return true;
+}
+
+
+bool UPhysXInstancedWorldSubsystem::ConvertStorageInstanceToDynamic_Internal(
+	FPhysXInstanceID ID,
+	bool bCreateDynamicActorIfNeeded,
+	EPhysXInstanceConvertReason Reason,
+	bool bDeferStorageIndexFixup)
+{
+	FPhysXInstanceData* Data = Instances.Find(ID);
+	if (!Data)
+	{
+		return false;
+	}
+
+	UInstancedStaticMeshComponent* StorageISMC_Base = Data->InstancedComponent.Get();
+	if (!StorageISMC_Base || !StorageISMC_Base->IsValidLowLevelFast())
+	{
+		return false;
+	}
+
+	const int32 StorageIndex = Data->InstanceIndex;
+	if (StorageIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	APhysXInstancedMeshActor* StorageActor = Cast<APhysXInstancedMeshActor>(StorageISMC_Base->GetOwner());
+	if (!StorageActor)
+	{
+		return false;
+	}
+
+	// Must be a storage owner.
+	if (!(StorageActor->bIsStorageActor || StorageActor->bStorageOnly))
+	{
+		return false;
+	}
+
+	// Get world transform from the storage instance.
+	FTransform WorldTM;
+	if (!StorageISMC_Base->GetInstanceTransform(StorageIndex, WorldTM, /*bWorldSpace=*/true))
+	{
+		return false;
+	}
+
+	UStaticMesh* StaticMesh = StorageActor->InstanceStaticMesh;
+	if (!StaticMesh)
+	{
+		StaticMesh = StorageISMC_Base->GetStaticMesh();
+	}
+	if (!StaticMesh)
+	{
+		return false;
+	}
+
+	// ---------------------------------------------------------------------
+	// 1) Find or create a NON-storage actor with matching mesh/materials.
+	// ---------------------------------------------------------------------
+
+	auto DoMaterialsMatch = [](const APhysXInstancedMeshActor* A, const APhysXInstancedMeshActor* B)
+	{
+		if (!A || !B)
+		{
+			return false;
+		}
+
+		if (A->bOverrideInstanceMaterials != B->bOverrideInstanceMaterials)
+		{
+			return false;
+		}
+
+		if (!A->bOverrideInstanceMaterials)
+		{
+			return true;
+		}
+
+		if (A->InstanceOverrideMaterials.Num() != B->InstanceOverrideMaterials.Num())
+		{
+			return false;
+		}
+
+		for (int32 i = 0; i < A->InstanceOverrideMaterials.Num(); ++i)
+		{
+			if (A->InstanceOverrideMaterials[i] != B->InstanceOverrideMaterials[i])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	};
+
+	APhysXInstancedMeshActor* TargetActor = nullptr;
+
+	// Materials this instance stands for (its variant when the storage actor uses a variant table).
+	TArray<UMaterialInterface*> InstanceMaterials;
+	StorageActor->GetInstanceResolvedMaterials(StorageISMC_Base, StorageIndex, InstanceMaterials);
+
+	const bool bStorageUsesVariants = StorageActor->UsesMaterialVariants();
+	int32 TargetVariant = INDEX_NONE;
+
+	for (const TPair<FPhysXActorID, FPhysXActorData>& Pair : Actors)
+	{
+		APhysXInstancedMeshActor* Actor = Pair.Value.Actor.Get();
+		if (!Actor || !Actor->IsValidLowLevelFast())
+		{
+			continue;
+		}
+
+		// Skip storage actors.
+		if (Actor->bIsStorageActor || Actor->bStorageOnly)
+		{
+			continue;
+		}
+
+		if (Actor->InstanceStaticMesh != StaticMesh)
+		{
+			continue;
+		}
+
+		if (bStorageUsesVariants || Actor->UsesMaterialVariants())
+		{
+			if (!DoesActorAcceptMaterials(Actor, InstanceMaterials, TargetVariant))
+			{
+				continue;
+			}
+		}
+		else if (!DoMaterialsMatch(Actor, StorageActor))
+		{
+			continue;
+		}
+
+		if (!Actor->InstancedMesh)
+		{
+			continue;
+		}
+
+		TargetActor = Actor;
+		break;
+	}
+
+	if (!TargetActor)
+	{
+		if (!bCreateDynamicActorIfNeeded)
+		{
+			return false;
+		}
+
+		UWorld* World = GetWorld();
+		if (!World)
+		{
+			return false;
+		}
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		TargetActor = World->SpawnActor<APhysXInstancedMeshActor>(
+			APhysXInstancedMeshActor::StaticClass(),
+			WorldTM,
+			SpawnParams);
+
+		if (!TargetActor)
+		{
+			return false;
+		}
+
+		// Register in subsystem.
+		const FPhysXActorID NewActorID = RegisterInstancedMeshActor(TargetActor);
+		TargetActor->PhysXActorID = NewActorID;
+
+		// Dynamic mode defaults.
+		TargetActor->bStorageOnly       = false;
+		TargetActor->bIsStorageActor    = false;
+		TargetActor->bSimulateInstances = true;
+
+		// IMPORTANT: dynamic ISM collision should be disabled to avoid double collision.
+		TargetActor->bDisableISMPhysics = true;
+
+		// Copy mesh/material settings from the storage actor.
+		TargetActor->InstanceStaticMesh         = StaticMesh;
+		TargetActor->bOverrideInstanceMaterials = StorageActor->bOverrideInstanceMaterials;
+		TargetActor->InstanceOverrideMaterials  = StorageActor->InstanceOverrideMaterials;
+
+		TargetActor->bUseMaterialVariants           = StorageActor->bUseMaterialVariants;
+		TargetActor->MaterialVariants               = StorageActor->MaterialVariants;
+		TargetActor->MaterialVariantCustomDataIndex = StorageActor->MaterialVariantCustomDataIndex;
+
+		TargetVariant = TargetActor->FindMaterialVariant(InstanceMaterials);
+	}
+
+	if (!TargetActor || !TargetActor->InstancedMesh)
+	{
+		return false;
+	}
+
+	// Ensure the actor is registered (in case it existed but wasn't registered yet).
+	if (TargetActor->PhysXActorID.GetUniqueID() == 0u)
+	{
+		const FPhysXActorID NewActorID = RegisterInstancedMeshActor(TargetActor);
+		TargetActor->PhysXActorID = NewActorID;
+	}
+
+	UPhysXInstancedStaticMeshComponent* TargetISMC = TargetActor->InstancedMesh;
+	if (!TargetISMC || !TargetISMC->IsValidLowLevelFast())
+	{
+		return false;
+	}
+
+	// Enforce dynamic container invariants (avoid double collision).
+	TargetActor->bStorageOnly       = false;
+	TargetActor->bIsStorageActor    = false;
+	TargetActor->bSimulateInstances = true;
+	TargetActor->bDisableISMPhysics = true;
+
+	if (TargetISMC->GetStaticMesh() != StaticMesh)
+	{
+		TargetISMC->SetStaticMesh(StaticMesh);
+	}
+	TargetActor->ApplyInstanceMaterials();
+
+	TargetISMC->SetSimulatePhysics(false);
+	TargetISMC->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	// ---------------------------------------------------------------------
+	// PRE/POST CONVERT EVENTS
+	// Signature assumed: (ID, Reason, FromActor, ToActor, WorldTM)
+	// ---------------------------------------------------------------------
+
+	const bool bFirePre_From =
+		IsEventEnabled(StorageActor, EPhysXInstanceEventFlags::PreConvert) &&
+		(StorageActor->OnInstancePreConvert.IsBound() || HasInterfaceEvents(StorageActor));
+
+	const bool bFirePost_From =
+		IsEventEnabled(StorageActor, EPhysXInstanceEventFlags::PostConvert) &&
+		(StorageActor->OnInstancePostConvert.IsBound() || HasInterfaceEvents(StorageActor));
+
+	const bool bFirePre_To =
+		IsEventEnabled(TargetActor, EPhysXInstanceEventFlags::PreConvert) &&
+		(TargetActor->OnInstancePreConvert.IsBound() || HasInterfaceEvents(TargetActor));
+
+	const bool bFirePost_To =
+		IsEventEnabled(TargetActor, EPhysXInstanceEventFlags::PostConvert) &&
+		(TargetActor->OnInstancePostConvert.IsBound() || HasInterfaceEvents(TargetActor));
+
+	auto FirePreConvert = [&](APhysXInstancedMeshActor* Actor)
+	{
+		if (!Actor)
+		{
+			return;
+		}
+
+		Actor->OnInstancePreConvert.Broadcast(ID, Reason, StorageActor, TargetActor, WorldTM);
+
+		if (HasInterfaceEvents(Actor))
+		{
+			IPhysXInstanceEvents::Execute_OnInstancePreConvert(Actor, ID, Reason, StorageActor, TargetActor, WorldTM);
+		}
+	};
+
+	auto FirePostConvert = [&](APhysXInstancedMeshActor* Actor)
+	{
+		if (!Actor)
+		{
+			return;
+		}
+
+		Actor->OnInstancePostConvert.Broadcast(ID, Reason, StorageActor, TargetActor, WorldTM);
+
+		if (HasInterfaceEvents(Actor))
+		{
+			IPhysXInstanceEvents::Execute_OnInstancePostConvert(Actor, ID, Reason, StorageActor, TargetActor, WorldTM);
+		}
+	};
+
+	// Fire PreConvert right before we start mutating data/instances.
+	if (bFirePre_From)
+	{
+		FirePreConvert(StorageActor);
+	}
+	if (bFirePre_To && TargetActor != StorageActor)
+	{
+		FirePreConvert(TargetActor);
+	}
+
+	bool bConvertedSuccessfully = false;
+	ON_SCOPE_EXIT
+	{
+		if (!bConvertedSuccessfully)
+		{
+			return;
+		}
+
+		if (bFirePost_From)
+		{
+			FirePostConvert(StorageActor);
+		}
+		if (bFirePost_To && TargetActor != StorageActor)
+		{
+			FirePostConvert(TargetActor);
+		}
+	};
+
+	// ---------------------------------------------------------------------
+	// 2) Add a visual instance to the target actor (dynamic container).
+	// ---------------------------------------------------------------------
+
+	// Chunked actors route the instance to the component that covers its location.
+	if (UPhysXInstancedStaticMeshComponent* ChunkISMC = TargetActor->GetRenderComponentForLocation(WorldTM.GetLocation()))
+	{
+		TargetISMC = ChunkISMC;
+	}
+
+	const int32 TargetIndex = TargetISMC->AddInstanceWorldSpace(WorldTM);
+	if (TargetIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	if (TargetVariant != INDEX_NONE)
+	{
+		TargetActor->SetInstanceMaterialVariant(TargetISMC, TargetIndex, TargetVariant);
+	}
+
+#if PHYSICS_INTERFACE_PHYSX
+	// ---------------------------------------------------------------------
+	// 3) Create a PhysX body for the NEW target slot first (so we can rollback safely).
+	// ---------------------------------------------------------------------
+
+	if (!GInstancedDefaultMaterial)
+	{
+		TargetISMC->RemoveInstance(TargetIndex);
+		return false;
+	}
+
+	EPhysXInstanceShapeType ShapeType = EPhysXInstanceShapeType::Box;
+	UStaticMesh* OverrideMesh = nullptr;
+
+	ShapeType    = TargetActor->InstanceShapeType;
+	OverrideMesh = TargetActor->OverrideCollisionMesh;
+
+	// Archetype targets clone their template; others keep building from the mesh.
+	FPhysXInstanceBody NewBody;
+	const bool bCreated = TargetActor->InstanceArchetype
+		? CreateInstanceBody(NewBody, TargetISMC, TargetIndex, /*bSimulate=*/true)
+		: NewBody.CreateFromInstancedStaticMesh(
+			TargetISMC,
+			TargetIndex,
+			/*bSimulate=*/true,
+			GInstancedDefaultMaterial,
+			ShapeType,
+			OverrideMesh,
+			GetShapeCacheForNewBodies());
+
+	if (!bCreated)
+	{
+		TargetISMC->RemoveInstance(TargetIndex);
+		return false;
+	}
+#endif // PHYSICS_INTERFACE_PHYSX
+
+	// ---------------------------------------------------------------------
+	// 4) Commit: remove storage instance and rebind the stable ID.
+	// ---------------------------------------------------------------------
+
+#if PHYSICS_INTERFACE_PHYSX
+	// If ID was still queued from a previous dynamic state, kill those entries before rebinding.
+	InvalidatePendingAddEntries(ID);
+#endif
+
+	// Remove the old slot mapping BEFORE changing Data.
+	RemoveSlotMapping(ID);
+
+	const int32 StorageLastIndex = StorageISMC_Base->GetInstanceCount() - 1;
+
+	// Remove from storage (compacts indices, or swap-removes for hierarchical storage).
+	if (!StorageISMC_Base->RemoveInstance(StorageIndex))
+	{
+		// Rollback: remove the new target instance.
+		TargetISMC->RemoveInstance(TargetIndex);
+
+		// Restore old mapping (Data still points to old storage slot).
+		AddSlotMapping(ID);
+
+#if PHYSICS_INTERFACE_PHYSX
+		// NewBody owns a Px pointer; destroy explicitly on rollback.
+		NewBody.Destroy();
+#endif
+		return false;
+	}
+
+	// Actor bookkeeping.
+	StorageActor->RegisteredInstanceIDs.Remove(ID);
+	TargetActor->RegisteredInstanceIDs.Add(ID);
+
+	// Fix indices for other storage-bound IDs affected by the removal.
+	if (!bDeferStorageIndexFixup)
+	{
+		FixInstanceIndicesAfterRemoval(StorageISMC_Base, StorageIndex, StorageLastIndex);
+	}
+	NotifyStorageInstancesChanged(StorageISMC_Base, 1);
+
+	// Rebind stable ID to the new dynamic slot (always the active render tier).
+	Data->InstancedComponent     = TargetISMC;
+	Data->InstanceIndex          = TargetIndex;
+	Data->bInSleepingRenderTier  = false;
+	Data->RenderTierMismatchTime = 0.0f;
+	Data->bBeyondShadowDistance  = false;
+
+#if PHYSICS_INTERFACE_PHYSX
+	Data->bSimulating  = true;
+	Data->SleepTime    = 0.0f;
+	Data->FallTime     = 0.0f;
+	Data->bWasSleeping = false;
+
+	// Replace body (storage instances should have no body).
+	DestroyInstanceBody(ID, *Data);
+	Data->Body = NewBody;
+
+	EnsureInstanceUserData(ID);
+	++NumBodiesLifetimeCreated;
+#else
+	Data->bSimulating  = false;
+	Data->SleepTime    = 0.0f;
+	Data->FallTime     = 0.0f;
+	Data->bWasSleeping = false;
+#endif
+
+	// Add new slot mapping AFTER Data points to the target slot.
+	AddSlotMapping(ID);
+
+	RebuildSlotMappingForComponent(StorageISMC_Base);
+	RebuildSlotMappingForComponent(TargetISMC);
+
+#if PHYSICS_INTERFACE_PHYSX
+	// Queue for scene insertion AFTER rebinding.
+	EnqueueAddActorToScene(ID, TargetISMC);
+#endif
+
+	StorageISMC_Base->MarkRenderStateDirty();
+	TargetISMC->MarkRenderStateDirty();
+
+	// Optional: auto-destroy empty storage actors.
+	if (StorageActor != TargetActor &&
+		StorageActor->RegisteredInstanceIDs.Num() == 0 &&
+		StorageActor->InstancedMesh &&
+		StorageActor->GetInstanceCount() == 0)
+	{
+		if (StorageActor->PhysXActorID.IsValid())
+		{
+			UnregisterInstancedMeshActor(StorageActor->PhysXActorID);
+		}
+		StorageActor->Destroy();
+	}
+
+	bConvertedSuccessfully = true;
+	return true;
+}
+
+int32 UPhysXInstancedWorldSubsystem::ConvertStorageInstancesToDynamic_Internal(
+	TArrayView<const FPhysXInstanceID> IDs,
+	bool bCreateDynamicActorIfNeeded,
+	EPhysXInstanceConvertReason Reason)
+{
+	// Each conversion would otherwise rescan the whole instance map twice to rebuild slot mappings.
+	FScopedSlotMappingBatch SlotMappingScope(*this);
+
+	struct FStorageConversion
+	{
+		FPhysXInstanceID ID;
+		int32            InstanceIndex = INDEX_NONE;
+	};
+
+	TMap<UInstancedStaticMeshComponent*, TArray<FStorageConversion>> ConversionsByComponent;
+	for (const FPhysXInstanceID ID : IDs)
+	{
+		const FPhysXInstanceData* Data = Instances.Find(ID);
+		UInstancedStaticMeshComponent* StorageISMC = Data ? Data->InstancedComponent.Get() : nullptr;
+
+		if (StorageISMC && Data->InstanceIndex != INDEX_NONE)
+		{
+			ConversionsByComponent.FindOrAdd(StorageISMC).Add({ ID, Data->InstanceIndex });
+		}
+	}
+
+	int32 NumConverted = 0;
+	TArray<FInstanceRemoval> Removals;
+
+	for (TPair<UInstancedStaticMeshComponent*, TArray<FStorageConversion>>& Group : ConversionsByComponent)
+	{
+		UInstancedStaticMeshComponent* StorageISMC = Group.Key;
+		TWeakObjectPtr<UInstancedStaticMeshComponent> WeakStorageISMC(StorageISMC);
+
+		// Highest index first: neither compacting nor swap removal can then move a pending instance of the batch,
+		// so their indices and slot keys stay exact and only the other instances need a fix-up.
+		TArray<FStorageConversion>& Conversions = Group.Value;
+		Conversions.Sort([](const FStorageConversion& A, const FStorageConversion& B)
+		{
+			return A.InstanceIndex > B.InstanceIndex;
+		});
+
+		Removals.Reset();
+
+		for (const FStorageConversion& Conversion : Conversions)
+		{
+			// The storage actor destroys itself once its last instance has converted.
+			if (!WeakStorageISMC.IsValid())
+			{
+				break;
+			}
+
+			const int32 OldLastIndex = StorageISMC->GetInstanceCount() - 1;
+
+			if (ConvertStorageInstanceToDynamic_Internal(Conversion.ID, bCreateDynamicActorIfNeeded, Reason, /*bDeferStorageIndexFixup=*/true))
+			{
+				Removals.Add({ Conversion.InstanceIndex, OldLastIndex });
+				++NumConverted;
+			}
+		}
+
+		if (WeakStorageISMC.IsValid())
+		{
+			FixInstanceIndicesAfterRemovals(StorageISMC, Removals);
+		}
+	}
+
+	return NumConverted;
+}
+
+
+bool UPhysXInstancedWorldSubsystem::IsInstancePhysicsEnabled(FPhysXInstanceID ID) const
+{
+#if !PHYSICS_INTERFACE_PHYSX
+	return false;
+#else
+	const FPhysXInstanceData* Data = Instances.Find(ID);
+	if (!Data)
+	{
+		return false;
+	}
+
+	physx::PxRigidActor* Actor = Data->Body.GetPxActor();
+	physx::PxRigidDynamic* RigidDynamic = Actor ? Actor->is<physx::PxRigidDynamic>() : nullptr;
+	if (!RigidDynamic)
+	{
+		return false;
+	}
+
+	const PxActorFlags Flags = RigidDynamic->getActorFlags();
+	const PxRigidBodyFlags BodyFlags = RigidDynamic->getRigidBodyFlags();
+
+	const bool bSimDisabled = Flags.isSet(PxActorFlag::eDISABLE_SIMULATION);
+	const bool bKinematic   = BodyFlags.isSet(PxRigidBodyFlag::eKINEMATIC);
+
+	return !bSimDisabled && !bKinematic;
+#endif
+}
+
+// ============================================================================
+// Material variants
+// ============================================================================
+
+bool UPhysXInstancedWorldSubsystem::SetInstanceMaterialVariant(FPhysXInstanceID ID, int32 Variant)
+{
+	const FPhysXInstanceData* Data = Instances.Find(ID);
+	if (!Data || Data->InstanceIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	UInstancedStaticMeshComponent* ISMC = Data->InstancedComponent.Get();
+	const APhysXInstancedMeshActor* OwnerActor = ISMC ? Cast<APhysXInstancedMeshActor>(ISMC->GetOwner()) : nullptr;
+
+	if (!OwnerActor || !OwnerActor->UsesMaterialVariants())
+	{
+		return false;
+	}
+
+	return OwnerActor->SetInstanceMaterialVariant(ISMC, Data->InstanceIndex, Variant);
+}
+
+int32 UPhysXInstancedWorldSubsystem::GetInstanceMaterialVariant(FPhysXInstanceID ID) const
+{
+	const FPhysXInstanceData* Data = Instances.Find(ID);
+	if (!Data || Data->InstanceIndex == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	const UInstancedStaticMeshComponent* ISMC = Data->InstancedComponent.Get();
+	const APhysXInstancedMeshActor* OwnerActor = ISMC ? Cast<APhysXInstancedMeshActor>(ISMC->GetOwner()) : nullptr;
+
+	return OwnerActor ? OwnerActor->GetInstanceMaterialVariant(ISMC, Data->InstanceIndex) : INDEX_NONE;
+}
+
+bool UPhysXInstancedWorldSubsystem::AddImpulseToInstance(
+	FPhysXInstanceID ID,
+	FVector WorldImpulse,
+	bool bVelChange)
+{
+	// Backward-compatible wrapper: behave like AddRadialImpulse defaults.
+	return AddImpulseToInstanceAdvanced(
+		ID,
+		WorldImpulse,
+		bVelChange,
+		/*bIncludeStorage=*/true,
+		/*bConvertStorageToDynamic=*/true);
+}
+
+bool UPhysXInstancedWorldSubsystem::AddImpulseToInstanceAdvanced(
+	FPhysXInstanceID ID,
+	FVector WorldImpulse,
+	bool bVelChange,
+	bool bIncludeStorage,
+	bool bConvertStorageToDynamic)
+{
+	if (!Instances.Contains(ID))
+	{
+		return false;
+	}
+
+	FPhysXInstanceTask Task;
+	Task.Type = EPhysXInstanceTaskType::AddImpulse;
+	Task.ID = ID;
+	Task.Vector = WorldImpulse;
+	Task.bModeFlag = bVelChange;
+	Task.bIncludeStorage = bIncludeStorage;
+	Task.bConvertStorageToDynamic = bConvertStorageToDynamic;
+
+	EnqueueInstanceTask(Task);
+	return true; // queued
+}
+
+
+bool UPhysXInstancedWorldSubsystem::AddRadialImpulse(
+	const FVector& OriginWorld,
+	float Radius,
+	float Strength,
+	bool bVelChange,
+	bool bIncludeStorage,
+	bool bConvertStorageToDynamic,
+	bool bLinearFalloff,
+	EPhysXInstancedQueryDebugMode DebugMode,
+	float DebugDrawDuration)
+{
+	if (Radius <= 0.0f || FMath::IsNearlyZero(Strength))
+	{
+		return false;
+	}
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return false;
+	}
+
+#if !PHYSICS_INTERFACE_PHYSX
+	return false;
+#else
+
+	struct FRadialImpulseTarget
+	{
+		FPhysXInstanceID ID;
+		FVector          PositionUU = FVector::ZeroVector;
+		FVector          ImpulseUU  = FVector::ZeroVector;
+	};
+
+	const float RadiusSq  = Radius * Radius;
+	const float InvRadius = 1.0f / Radius;
+	const float MinDistSq = KINDA_SMALL_NUMBER * KINDA_SMALL_NUMBER;
+
+	// Direction away from the origin scaled by strength and falloff; zero outside the radius or at the origin.
+	auto ComputeImpulse = [&](const FVector& PositionUU)
+	{
+		const FVector Delta  = PositionUU - OriginWorld;
+		const float   DistSq = Delta.SizeSquared();
+		if (DistSq <= MinDistSq || DistSq > RadiusSq)
+		{
+			return FVector::ZeroVector;
+		}
+
+		const float InvDist = FMath::InvSqrt(DistSq);
+		const float Falloff = bLinearFalloff ? FMath::Clamp(1.0f - DistSq * InvDist * InvRadius, 0.0f, 1.0f) : 1.0f;
+		return Delta * (InvDist * Strength * Falloff);
+	};
+
+	physx::PxScene* PxScenePtr = GetPhysXSceneFromWorld(World);
+	const uint16 Epoch = BeginQueryVisit();
+
+	// 1) Bodies already in the scene: one sphere overlap under a read lock gathers actors and positions.
+	TArray<physx::PxRigidDynamic*> SceneBodies;
+	TArray<FPhysXInstanceID>       SceneBodyIDs;
+	TArray<FVector>                SceneBodyPositions;
+
+	if (PxScenePtr)
+	{
+		PxScenePtr->lockRead();
+
+		OverlapPhysXScene_Internal(*PxScenePtr,
+			physx::PxSphereGeometry((physx::PxReal)U2PScalar(Radius)),
+			physx::PxTransform(U2PVector(OriginWorld)),
+			[&](FPhysXInstanceID ID)
+			{
+				const FPhysXInstanceData* Data = Instances.Find(ID);
+				physx::PxRigidActor* RA = Data ? Data->Body.GetPxActor() : nullptr;
+				physx::PxRigidDynamic* RD = RA ? RA->is<physx::PxRigidDynamic>() : nullptr;
+
+				// Multi-shape bodies touch once per shape; kinematic bodies are marked too so they never reach the task path.
+				if (!RD || !MarkQueryVisited(ID, Epoch))
+				{
+					return true;
+				}
+
+				if (RD->getRigidBodyFlags().isSet(physx::PxRigidBodyFlag::eKINEMATIC) ||
+					RD->getActorFlags().isSet(physx::PxActorFlag::eDISABLE_SIMULATION))
+				{
+					return true;
+				}
+
+				SceneBodies.Add(RD);
+				SceneBodyIDs.Add(ID);
+				SceneBodyPositions.Add(P2UVector(RD->getGlobalPose().p));
+				return true;
+			});
+
+		PxScenePtr->unlockRead();
+	}
+
+	// 2) Impulses for the gathered bodies in one pass over contiguous positions.
+	const int32 NumSceneBodies = SceneBodies.Num();
+
+	TArray<FVector> SceneBodyImpulses;
+	SceneBodyImpulses.SetNumUninitialized(NumSceneBodies);
+
+	for (int32 Index = 0; Index < NumSceneBodies; ++Index)
+	{
+		SceneBodyImpulses[Index] = ComputeImpulse(SceneBodyPositions[Index]);
+	}
+
+	// 3) Apply them now in one write-locked loop instead of queueing a task per body.
+	int32 NumApplied = 0;
+
+	if (NumSceneBodies > 0)
+	{
+		const physx::PxForceMode::Enum Mode = bVelChange
+			? physx::PxForceMode::eVELOCITY_CHANGE
+			: physx::PxForceMode::eIMPULSE;
+
+		PxScenePtr->lockWrite();
+
+		for (int32 Index = 0; Index < NumSceneBodies; ++Index)
+		{
+			if (!SceneBodyImpulses[Index].IsZero())
+			{
+				SceneBodies[Index]->addForce(U2PVector(SceneBodyImpulses[Index]), Mode, /*autowake=*/true);
+				++NumApplied;
+			}
+		}
+
+		PxScenePtr->unlockWrite();
+	}
+
+	// 4) Everything else in range comes from the spatial hash: storage instances and instances whose body
+	//    is missing or still waiting for scene insertion.
+	TArray<FRadialImpulseTarget> StorageTargets;
+	TArray<FRadialImpulseTarget> DeferredTargets;
+
+	SpatialHash.ForEachInSphere(OriginWorld, Radius,
+		[&](FPhysXInstanceID ID, const FVector& InstanceLoc)
+		{
+			if (!MarkQueryVisited(ID, Epoch))
+			{
+				return true;
+			}
+
+			const FPhysXInstanceData* Data = Instances.Find(ID);
+			if (!Data)
+			{
+				return true;
+			}
+
+			UInstancedStaticMeshComponent* ISMC = Data->InstancedComponent.Get();
+			if (!ISMC || !ISMC->IsValidLowLevelFast() || Data->InstanceIndex == INDEX_NONE)
+			{
+				return true;
+			}
+
+			const bool bIsStorageOwner = IsOwnerStorageActor(ISMC);
+
+			// Cannot apply impulses to storage unless we are allowed to convert it to dynamic.
+			if (bIsStorageOwner && (!bIncludeStorage || !bConvertStorageToDynamic))
+			{
+				return true;
+			}
+
+			// Validate index range to avoid stale IDs returning nonsense.
+			if (Data->InstanceIndex < 0 || Data->InstanceIndex >= ISMC->GetInstanceCount())
+			{
+				return true;
+			}
+
+			const FVector ImpulseUU = ComputeImpulse(InstanceLoc);
+			if (ImpulseUU.IsZero())
+			{
+				return true;
+			}
+
+			FRadialImpulseTarget& T = (bIsStorageOwner ? StorageTargets : DeferredTargets).AddDefaulted_GetRef();
+			T.ID         = ID;
+			T.PositionUU = InstanceLoc;
+			T.ImpulseUU  = ImpulseUU;
+			return true;
+		});
+
+	// 5) Storage conversions as one batch; the new bodies wait for scene insertion, so their impulses are queued.
+	//    Instances that failed to convert keep their task too, which retries the conversion.
+	if (StorageTargets.Num() > 0)
+	{
+		TArray<FPhysXInstanceID> StorageIDs;
+		StorageIDs.Reserve(StorageTargets.Num());
+		for (const FRadialImpulseTarget& T : StorageTargets)
+		{
+			StorageIDs.Add(T.ID);
+		}
+
+		ConvertStorageInstancesToDynamic_Internal(StorageIDs, /*bCreateDynamicActorIfNeeded=*/true, EPhysXInstanceConvertReason::Explicit);
+		DeferredTargets.Append(StorageTargets);
+	}
+
+	int32 NumQueued = 0;
+	for (const FRadialImpulseTarget& T : DeferredTargets)
+	{
+		NumQueued += AddImpulseToInstanceAdvanced(T.ID, T.ImpulseUU, bVelChange, bIncludeStorage, bConvertStorageToDynamic) ? 1 : 0;
+	}
+
+	const bool bAppliedAny = (NumApplied + NumQueued) > 0;
+
+#if ENABLE_DRAW_DEBUG
+	if (bAppliedAny && DebugMode != EPhysXInstancedQueryDebugMode::None)
+	{
+		DrawSphereSafe(World, OriginWorld, Radius, FColor::Green, DebugDrawDuration, 1.5f);
+
+		if (DebugMode == EPhysXInstancedQueryDebugMode::Detailed)
+		{
+			const int32 MaxArrows  = 64;
+			const int32 NumTargets = NumSceneBodies + DeferredTargets.Num();
+			const int32 NumToDraw  = FMath::Min(NumTargets, MaxArrows);
+
+			for (int32 i = 0; i < NumToDraw; ++i)
+			{
+				const bool bSceneBody = (i < NumSceneBodies);
+				const FPhysXInstanceID ID = bSceneBody ? SceneBodyIDs[i] : DeferredTargets[i - NumSceneBodies].ID;
+				const FVector Position   = bSceneBody ? SceneBodyPositions[i] : DeferredTargets[i - NumSceneBodies].PositionUU;
+
+				DrawArrowSafe(World, OriginWorld, Position, bSceneBody ? FColor::Cyan : FColor::Yellow, DebugDrawDuration, 1.5f);
+				DrawTextSafe(World, Position + FVector(0, 0, 10.0f),
+					FString::Printf(TEXT("ID=%u"), ID.GetUniqueID()),
+					FColor::White, DebugDrawDuration);
+			}
+
+			if (NumTargets > MaxArrows)
+			{
+				DrawTextSafe(World,
+					OriginWorld + FVector(0, 0, 20.0f),
+					FString::Printf(TEXT("RadialImpulse: %d hits (showing %d)"), NumTargets, MaxArrows),
+					FColor::White,
+					DebugDrawDuration);
+			}
+		}
+	}
+	else if (!bAppliedAny && DebugMode != EPhysXInstancedQueryDebugMode::None)
+	{
+		DrawSphereSafe(World, OriginWorld, Radius, FColor::Red, DebugDrawDuration, 1.5f);
+	}
+#endif // ENABLE_DRAW_DEBUG
+
+	return bAppliedAny;
+#endif // PHYSICS_INTERFACE_PHYSX
+}
+
+bool UPhysXInstancedWorldSubsystem::AddForceToInstance(
+	FPhysXInstanceID ID,
+	FVector WorldForce,
+	bool bAccelChange)
+{
+	// Backward-compatible wrapper: behave like AddRadialImpulse defaults.
+	return AddForceToInstanceAdvanced(
+		ID,
+		WorldForce,
+		bAccelChange,
+		/*bIncludeStorage=*/true,
+		/*bConvertStorageToDynamic=*/true);
+}
+
+bool UPhysXInstancedWorldSubsystem::AddForceToInstanceAdvanced(
+	FPhysXInstanceID ID,
+	FVector WorldForce,
+	bool bAccelChange,
+	bool bIncludeStorage,
+	bool bConvertStorageToDynamic)
+{
+	if (!Instances.Contains(ID))
+	{
+		return false;
+	}
+
+	FPhysXInstanceTask Task;
+	Task.Type = EPhysXInstanceTaskType::AddForce;
+	Task.ID = ID;
+	Task.Vector = WorldForce;
+	Task.bModeFlag = bAccelChange;
+	Task.bIncludeStorage = bIncludeStorage;
+	Task.bConvertStorageToDynamic = bConvertStorageToDynamic;
+
+	EnqueueInstanceTask(Task);
+	return true; // queued
+}
+
+
+bool UPhysXInstancedWorldSubsystem::PutInstanceToSleep(FPhysXInstanceID ID)
+{
+	return PutInstanceToSleepAdvanced(
+		ID,
+		/*bIncludeStorage=*/true,
+		/*bConvertStorageToDynamic=*/true);
+}
+
+bool UPhysXInstancedWorldSubsystem::WakeInstanceUp(FPhysXInstanceID ID)
+{
+	return WakeInstanceUpAdvanced(
+		ID,
+		/*bIncludeStorage=*/true,
+		/*bConvertStorageToDynamic=*/true);
+}
+
+bool UPhysXInstancedWorldSubsystem::PutInstanceToSleepAdvanced(
+	FPhysXInstanceID ID,
+	bool bIncludeStorage,
+	bool bConvertStorageToDynamic)
+{
+	if (!Instances.Contains(ID))
+	{
+		return false;
+	}
+
+	FPhysXInstanceTask Task;
+	Task.Type = EPhysXInstanceTaskType::PutToSleep;
+	Task.ID = ID;
+	Task.bIncludeStorage = bIncludeStorage;
+	Task.bConvertStorageToDynamic = bConvertStorageToDynamic;
+
+	EnqueueInstanceTask(Task);
+	return true;
+}
+
+bool UPhysXInstancedWorldSubsystem::WakeInstanceUpAdvanced(
+	FPhysXInstanceID ID,
+	bool bIncludeStorage,
+	bool bConvertStorageToDynamic)
+{
+	if (!Instances.Contains(ID))
+	{
+		return false;
+	}
+
+	FPhysXInstanceTask Task;
+	Task.Type = EPhysXInstanceTaskType::WakeUp;
+	Task.ID = ID;
+	Task.bIncludeStorage = bIncludeStorage;
+	Task.bConvertStorageToDynamic = bConvertStorageToDynamic;
+
+	EnqueueInstanceTask(Task);
+	return true;
+}
+
+
+// ============================================================================
+// Per-instance physics properties
+// ============================================================================
+
+bool UPhysXInstancedWorldSubsystem::SetInstanceGravityEnabled(FPhysXInstanceID ID, bool bEnable)
+{
+	FPhysXInstanceData* Data = Instances.Find(ID);
+	if (!Data)
+	{
+		return false;
+	}
+
+#if !PHYSICS_INTERFACE_PHYSX
+	return false;
+#else
+	physx::PxRigidActor* Actor = Data->Body.GetPxActor();
+	physx::PxRigidDynamic* RigidDynamic =
+		Actor ? Actor->is<physx::PxRigidDynamic>() : nullptr;
+
+	if (!RigidDynamic)
+	{
+		return false;
+	}
+
+	// DISABLE_GRAVITY disables gravity when true, so it is inverted relative to bEnable.
+	RigidDynamic->setActorFlag(physx::PxActorFlag::eDISABLE_GRAVITY, !bEnable);
+	return true;
+#endif
+}
+
+bool UPhysXInstancedWorldSubsystem::IsInstanceGravityEnabled(FPhysXInstanceID ID) const
+{
+#if !PHYSICS_INTERFACE_PHYSX
+	return false;
+#else
+	const FPhysXInstanceData* Data = Instances.Find(ID);
+	if (!Data)
+	{
+		return false;
+	}
+
+	physx::PxRigidActor* Actor = Data->Body.GetPxActor();
+	physx::PxRigidDynamic* RigidDynamic =
+		Actor ? Actor->is<physx::PxRigidDynamic>() : nullptr;
+
+	if (!RigidDynamic)
+	{
+		return false;
+	}
+
+	const physx::PxActorFlags Flags = RigidDynamic->getActorFlags();
+	return !Flags.isSet(physx::PxActorFlag::eDISABLE_GRAVITY);
+#endif
+}
+
+bool UPhysXInstancedWorldSubsystem::SetInstanceLinearVelocity(
+	FPhysXInstanceID ID,
+	FVector NewVelocity,
+	bool bAutoWake)
+{
+	FPhysXInstanceData* Data = Instances.Find(ID);
+	if (!Data)
+	{
+		return false;
+	}
+
+#if !PHYSICS_INTERFACE_PHYSX
+	return false;
+#else
+	physx::PxRigidActor* Actor = Data->Body.GetPxActor();
+	physx::PxRigidDynamic* RigidDynamic =
+		Actor ? Actor->is<physx::PxRigidDynamic>() : nullptr;
+
+	if (!RigidDynamic)
+	{
+		return false;
+	}
+
+	const physx::PxVec3 PxVel = U2PVector(NewVelocity);
+	RigidDynamic->setLinearVelocity(PxVel, bAutoWake);
+	return true;
+#endif
+}
+
+bool UPhysXInstancedWorldSubsystem::GetInstanceLinearVelocity(
+	FPhysXInstanceID ID,
+	FVector& OutVelocity) const
+{
+	OutVelocity = FVector::ZeroVector;
+
+#if !PHYSICS_INTERFACE_PHYSX
+	return false;
+#else
+	const FPhysXInstanceData* Data = Instances.Find(ID);
+	if (!Data)
+	{
+		return false;
+	}
+
+	physx::PxRigidActor* Actor = Data->Body.GetPxActor();
+	physx::PxRigidDynamic* RigidDynamic =
+		Actor ? Actor->is<physx::PxRigidDynamic>() : nullptr;
+
+	if (!RigidDynamic)
+	{
+		return false;
+	}
+
+	const physx::PxVec3 PxVel = RigidDynamic->getLinearVelocity();
+	OutVelocity = P2UVector(PxVel);
+	return true;
+#endif
+}
 
-bool UPhysXInstancedWorldSubsystem::SetInstancePhysicsEnabled(
+bool UPhysXInstancedWorldSubsystem::SetInstanceAngularVelocityInRadians(
 	FPhysXInstanceID ID,
-	bool bEnable,
-	bool bDestroyBodyIfDisabling)
+	FVector NewAngVelRad,
+	bool bAutoWake)
 {
 	FPhysXInstanceData* Data = Instances.Find(ID);
 	if (!Data)
@@ -2512,2913 +5169,3575 @@ bool UPhysXInstancedWorldSubsystem::SetInstancePhysicsEnabled(
 		return false;
 	}
 
-	const bool bWasSimulating = Data->bSimulating;
-
 #if !PHYSICS_INTERFACE_PHYSX
-	// Without PhysX backend, simulation cannot be toggled.
 	return false;
 #else
-	UInstancedStaticMeshComponent* ISMC = Data->InstancedComponent.Get();
-	if (!ISMC || !ISMC->IsValidLowLevelFast())
+	physx::PxRigidActor* Actor = Data->Body.GetPxActor();
+	physx::PxRigidDynamic* RigidDynamic =
+		Actor ? Actor->is<physx::PxRigidDynamic>() : nullptr;
+
+	if (!RigidDynamic)
 	{
 		return false;
 	}
 
-	APhysXInstancedMeshActor* Owner = Cast<APhysXInstancedMeshActor>(ISMC->GetOwner());
-	const TWeakObjectPtr<APhysXInstancedMeshActor> OwnerWeak(Owner);
-
-	// ---------------------------------------------------------------------
-	// PRE/POST PHYSICS EVENTS
-	// Pre: fire right before we start touching PhysX/flags
-	// Post: always fire on exit with bSuccess (final return value)
-	// ---------------------------------------------------------------------
-
-	const bool bFirePre =
-		IsValid(Owner) &&
-		IsEventEnabled(Owner, EPhysXInstanceEventFlags::PrePhysics) &&
-		(Owner->OnInstancePrePhysics.IsBound() || HasInterfaceEvents(Owner));
+	const physx::PxVec3 PxOmega = U2PVector(NewAngVelRad);
+	RigidDynamic->setAngularVelocity(PxOmega, bAutoWake);
+	return true;
+#endif
+}
 
-	const bool bFirePost =
-		IsValid(Owner) &&
-		IsEventEnabled(Owner, EPhysXInstanceEventFlags::PostPhysics) &&
-		(Owner->OnInstancePostPhysics.IsBound() || HasInterfaceEvents(Owner));
+bool UPhysXInstancedWorldSubsystem::GetInstanceAngularVelocityInRadians(
+	FPhysXInstanceID ID,
+	FVector& OutAngVelRad) const
+{
+	OutAngVelRad = FVector::ZeroVector;
 
-	if (bFirePre)
+#if !PHYSICS_INTERFACE_PHYSX
+	return false;
+#else
+	const FPhysXInstanceData* Data = Instances.Find(ID);
+	if (!Data)
 	{
-		// Use shared helper from anonymous namespace (defined выше в файле).
-		::FirePrePhysics(Owner, ID, bEnable, bDestroyBodyIfDisabling);
+		return false;
 	}
 
-	bool bSuccess = false;
-	ON_SCOPE_EXIT
-	{
-		if (!bFirePost)
-		{
-			return;
-		}
-
-		if (OwnerWeak.IsValid())
-		{
-			::FirePostPhysics(OwnerWeak.Get(), ID, bEnable, bDestroyBodyIfDisabling, bSuccess);
-		}
-	};
-
-	// ---------------------------------------------------------------------
-	// Main logic
-	// ---------------------------------------------------------------------
-
-	physx::PxRigidActor*   Actor        = Data->Body.GetPxActor();
-	physx::PxRigidDynamic* RigidDynamic = Actor ? Actor->is<physx::PxRigidDynamic>() : nullptr;
+	physx::PxRigidActor* Actor = Data->Body.GetPxActor();
+	physx::PxRigidDynamic* RigidDynamic =
+		Actor ? Actor->is<physx::PxRigidDynamic>() : nullptr;
 
-	if (bEnable)
+	if (!RigidDynamic)
 	{
-		// Read settings once (authoritative source is the owner actor).
-		EPhysXInstanceShapeType ShapeType = EPhysXInstanceShapeType::Box;
-		UStaticMesh* OverrideMesh         = nullptr;
-		bool bUseGravity                  = true;
-
-		if (const APhysXInstancedMeshActor* OwnerActor = Cast<APhysXInstancedMeshActor>(ISMC->GetOwner()))
-		{
-			ShapeType    = OwnerActor->InstanceShapeType;
-			OverrideMesh = OwnerActor->OverrideCollisionMesh;
-			bUseGravity  = OwnerActor->bInstancesUseGravity;
-		}
-
-		// Fallback to component mesh if no override mesh.
-		if (!OverrideMesh)
-		{
-			OverrideMesh = ISMC->GetStaticMesh();
-		}
-
-		// If there is no body yet, try to create one now.
-		if (!RigidDynamic)
-		{
-			if (!GInstancedDefaultMaterial)
-			{
-				// bSuccess stays false; PostPhysics will get false.
-				return false;
-			}
-
-			if (!Data->Body.CreateFromInstancedStaticMesh(
-				ISMC,
-				Data->InstanceIndex,
-				/*bSimulate=*/true,
-				GInstancedDefaultMaterial,
-				ShapeType,
-				OverrideMesh))
-			{
-				// bSuccess stays false; PostPhysics will get false.
-				return false;
-			}
-
-			EnsureInstanceUserData(ID);
-			EnqueueAddActorToScene(ID, ISMC);
-			++NumBodiesLifetimeCreated;
-
-			Actor        = Data->Body.GetPxActor();
-			RigidDynamic = Actor ? Actor->is<physx::PxRigidDynamic>() : nullptr;
-		}
-
-		if (RigidDynamic)
-		{
-			// Switch from kinematic back to dynamic simulation.
-			RigidDynamic->setRigidBodyFlag(PxRigidBodyFlag::eKINEMATIC, false);
+		return false;
+	}
 
-			RigidDynamic->setActorFlag(PxActorFlag::eDISABLE_GRAVITY, !bUseGravity);
-			RigidDynamic->setActorFlag(PxActorFlag::eDISABLE_SIMULATION, false);
+	const physx::PxVec3 PxOmega = RigidDynamic->getAngularVelocity();
+	OutAngVelRad = P2UVector(PxOmega);
+	return true;
+#endif
+}
 
-			// Apply mass/damping overrides every time we (re)enable.
-			if (const APhysXInstancedMeshActor* OwnerActor = Cast<APhysXInstancedMeshActor>(ISMC->GetOwner()))
-			{
-				ApplyOwnerPhysicsOverrides(OwnerActor, ISMC, OverrideMesh, RigidDynamic);
-			}
+// ============================================================================
+// Query helpers / actor registry
+// ============================================================================
 
-			Data->bSimulating = true;
-		}
-		else
-		{
-			Data->bSimulating = false;
-		}
-	}
-	else
+bool UPhysXInstancedWorldSubsystem::IsInstanceValid(FPhysXInstanceID ID) const
+{
+	const FPhysXInstanceData* Data = Instances.Find(ID);
+	if (!Data)
 	{
-		if (RigidDynamic)
-		{
-			if (bDestroyBodyIfDisabling)
-			{
-				// IMPORTANT: if this ID is queued for deferred AddActorToScene, kill those entries.
-				InvalidatePendingAddEntries(ID);
-
-				ClearInstanceUserData(ID);
-				// Destroy the PhysX body while keeping the visual instance.
-				Data->Body.Destroy();
-			}
-			else
-			{
-				// Keep the body but disable simulation by switching to kinematic.
-				RigidDynamic->setRigidBodyFlag(PxRigidBodyFlag::eKINEMATIC, true);
-				RigidDynamic->setActorFlag(PxActorFlag::eDISABLE_SIMULATION, true);
-			}
-		}
-
-		Data->bSimulating = false;
+		return false;
 	}
 
-	// Keep global sim-count in sync with the flag.
-	if (bWasSimulating != Data->bSimulating)
+	UInstancedStaticMeshComponent* ISMC = Data->InstancedComponent.Get();
+	if (!ISMC || !ISMC->IsValidLowLevelFast())
 	{
-		if (Data->bSimulating)
-		{
-			++NumBodiesSimulating;
-		}
-		else if (NumBodiesSimulating > 0)
-		{
-			--NumBodiesSimulating;
-		}
+		return false;
 	}
 
-	// Success must reflect the actual outcome.
-	bSuccess = bEnable ? Data->bSimulating : true;
-	return bSuccess;
-#endif // PHYSICS_INTERFACE_PHYSX
-}
-
-
+	if (Data->InstanceIndex == INDEX_NONE)
+	{
+		return false;
+	}
 
-bool UPhysXInstancedWorldSubsystem::ConvertInstanceToStaticStorage(
-	FPhysXInstanceID ID,
-	bool bCreateStorageActorIfNeeded)
-{
-	// Public call is always explicit.
-	return ConvertInstanceToStaticStorage_Internal(
-		ID,
-		bCreateStorageActorIfNeeded,
-		EPhysXInstanceConvertReason::Explicit);
+	const int32 NumInstances = ISMC->GetInstanceCount();
+	return (Data->InstanceIndex >= 0 && Data->InstanceIndex < NumInstances);
 }
 
-
-bool UPhysXInstancedWorldSubsystem::ConvertStorageInstanceToDynamic(
+bool UPhysXInstancedWorldSubsystem::GetInstanceInfo(
 	FPhysXInstanceID ID,
-	bool bCreateDynamicActorIfNeeded)
+	UInstancedStaticMeshComponent*& OutComponent,
+	int32& OutInstanceIndex) const
 {
-	// Public call is always explicit.
-	return ConvertStorageInstanceToDynamic_Internal(
-		ID,
-		bCreateDynamicActorIfNeeded,
-		EPhysXInstanceConvertReason::Explicit);
-}
-
+	OutComponent     = nullptr;
+	OutInstanceIndex = INDEX_NONE;
 
-bool UPhysXInstancedWorldSubsystem::ConvertInstanceToStaticStorage_Internal(
-	FPhysXInstanceID ID,
-	bool bCreateStorageActorIfNeeded,
-	EPhysXInstanceConvertReason Reason)
-{
-	FPhysXInstanceData* Data = Instances.Find(ID);
+	const FPhysXInstanceData* Data = Instances.Find(ID);
 	if (!Data)
 	{
 		return false;
 	}
 
 	UInstancedStaticMeshComponent* ISMC = Data->InstancedComponent.Get();
-	if (!ISMC || !ISMC->IsValidLowLevelFast())
+	if (!ISMC || !ISMC->IsValidLowLevelFast() || Data->InstanceIndex == INDEX_NONE)
 	{
 		return false;
 	}
 
-	const int32 InstanceIndex = Data->InstanceIndex;
-	if (InstanceIndex == INDEX_NONE)
+	const int32 NumInstances = ISMC->GetInstanceCount();
+	if (Data->InstanceIndex < 0 || Data->InstanceIndex >= NumInstances)
 	{
 		return false;
 	}
+	
+	OutComponent     = ISMC;
+	OutInstanceIndex = Data->InstanceIndex;
+	return true;
+}
+
+TArray<FPhysXInstanceID> UPhysXInstancedWorldSubsystem::GetAllInstanceIDs() const
+{
+	TArray<FPhysXInstanceID> Result;
+	Result.Reserve(Instances.Num());
+
+	for (const TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
+	{
+		Result.Add(Pair.Key);
+	}
+
+	return Result;
+}
+
+FPhysXInstanceID UPhysXInstancedWorldSubsystem::FindNearestInstance(
+	FVector WorldLocation,
+	UInstancedStaticMeshComponent* OptionalFilterComponent) const
+{
+	// Backward-compatible wrapper: ignore nothing, do not include storage.
+	return FindNearestInstanceAdvanced(
+		WorldLocation,
+		OptionalFilterComponent,
+		FPhysXInstanceID(),
+		INDEX_NONE,
+		/*bIncludeStorage=*/false);
+}
 
-	// World-space transform of the source instance.
-	FTransform WorldTM;
-	if (!ISMC->GetInstanceTransform(InstanceIndex, WorldTM, /*bWorldSpace=*/true))
+bool UPhysXInstancedWorldSubsystem::IsSpatialQueryCandidate(
+	const FPhysXInstanceData& Data,
+	UInstancedStaticMeshComponent* OptionalFilterComponent,
+	bool bIncludeStorage) const
+{
+	UInstancedStaticMeshComponent* ISMC = Data.InstancedComponent.Get();
+	if (!ISMC || !ISMC->IsValidLowLevelFast())
 	{
 		return false;
 	}
 
-	APhysXInstancedMeshActor* SourceActor = Cast<APhysXInstancedMeshActor>(ISMC->GetOwner());
-	if (!SourceActor)
+	if (OptionalFilterComponent && ISMC != OptionalFilterComponent)
 	{
 		return false;
 	}
 
-	UStaticMesh* StaticMesh = SourceActor->InstanceStaticMesh;
-	if (!StaticMesh)
-	{
-		StaticMesh = ISMC->GetStaticMesh();
-	}
-	if (!StaticMesh)
+	// Validate InstanceIndex to avoid returning IDs bound to non-existent visual instances.
+	if (Data.InstanceIndex < 0 || Data.InstanceIndex >= ISMC->GetInstanceCount())
 	{
 		return false;
 	}
 
-	// ---------------------------------------------------------------------
-	// 1) Find or create a storage actor with matching mesh/material settings
-	// ---------------------------------------------------------------------
-
-	APhysXInstancedMeshActor* StorageActor = nullptr;
-
-	auto DoMaterialsMatch = [](const APhysXInstancedMeshActor* A, const APhysXInstancedMeshActor* B)
+	// If storage is excluded, require a real PhysX actor that is already in a scene.
+	if (!bIncludeStorage)
 	{
-		if (!A || !B)
+		if (IsOwnerStorageActor(ISMC))
 		{
 			return false;
 		}
 
-		if (A->bOverrideInstanceMaterials != B->bOverrideInstanceMaterials)
+#if PHYSICS_INTERFACE_PHYSX
+		const physx::PxRigidActor* RigidActor = Data.Body.GetPxActor();
+		if (!RigidActor || !RigidActor->getScene())
 		{
+			// Body missing or not inserted yet (pending add) -> not a valid physics candidate.
 			return false;
 		}
+#endif
+	}
 
-		if (!A->bOverrideInstanceMaterials)
-		{
-			return true;
-		}
+	return true;
+}
 
-		const int32 NumA = A->InstanceOverrideMaterials.Num();
-		const int32 NumB = B->InstanceOverrideMaterials.Num();
+FPhysXInstanceID UPhysXInstancedWorldSubsystem::FindNearestInstanceAdvanced(
+	FVector WorldLocation,
+	UInstancedStaticMeshComponent* OptionalFilterComponent,
+	FPhysXInstanceID IgnoreInstanceID,
+	int32 IgnoreInstanceIndex,
+	bool bIncludeStorage) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_SpatialHashQuery);
 
-		if (NumA != NumB)
+	// The hash walks outward from WorldLocation; the filter only runs for entries closer than the current best.
+	return SpatialHash.FindNearest(WorldLocation, /*MaxDistance=*/0.0f,
+		[&](FPhysXInstanceID ID, const FVector& /*Location*/)
 		{
-			return false;
-		}
+			// Ignore self by stable ID (recommended; indices are not stable after removals).
+			if (IgnoreInstanceID.IsValid() && ID == IgnoreInstanceID)
+			{
+				return false;
+			}
 
-		for (int32 Index = 0; Index < NumA; ++Index)
-		{
-			if (A->InstanceOverrideMaterials[Index] != B->InstanceOverrideMaterials[Index])
+			const FPhysXInstanceData* Data = Instances.Find(ID);
+			if (!Data)
 			{
 				return false;
 			}
-		}
 
-		return true;
-	};
+			// Ignore self by component-local index (only meaningful when the component is specified).
+			if (OptionalFilterComponent && IgnoreInstanceIndex != INDEX_NONE && Data->InstanceIndex == IgnoreInstanceIndex)
+			{
+				return false;
+			}
 
-	for (const TPair<FPhysXActorID, FPhysXActorData>& Pair : Actors)
+			return IsSpatialQueryCandidate(*Data, OptionalFilterComponent, bIncludeStorage);
+		});
+}
+
+int32 UPhysXInstancedWorldSubsystem::FindKNearestInstances(
+	FVector WorldLocation,
+	int32 K,
+	TArray<FPhysXInstanceNearestHit>& OutHits,
+	UInstancedStaticMeshComponent* OptionalFilterComponent,
+	FPhysXInstanceID IgnoreInstanceID,
+	bool bIncludeStorage,
+	float MaxDistance) const
+{
+	OutHits.SetNum(FMath::Max(K, 0));
+
+	const int32 NumFound = FindKNearestInstances(
+		WorldLocation, OutHits, OptionalFilterComponent, IgnoreInstanceID, bIncludeStorage, MaxDistance);
+
+	OutHits.SetNum(NumFound);
+	return NumFound;
+}
+
+int32 UPhysXInstancedWorldSubsystem::FindKNearestInstances(
+	const FVector& WorldLocation,
+	TArrayView<FPhysXInstanceNearestHit> OutHits,
+	UInstancedStaticMeshComponent* OptionalFilterComponent,
+	FPhysXInstanceID IgnoreInstanceID,
+	bool bIncludeStorage,
+	float MaxDistance) const
+{
+	const int32 K = OutHits.Num();
+	if (K == 0)
 	{
-		APhysXInstancedMeshActor* Actor = Pair.Value.Actor.Get();
-		if (!Actor || !Actor->IsValidLowLevelFast())
-		{
-			continue;
-		}
+		return 0;
+	}
 
-		if (!Actor->bStorageOnly)
-		{
-			continue;
-		}
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_SpatialHashQuery);
 
-		if (Actor->InstanceStaticMesh != StaticMesh)
-		{
-			continue;
-		}
+	TArray<FPhysXInstancedSpatialHash::FNeighbor, TInlineAllocator<32>> Neighbors;
+	Neighbors.SetNumUninitialized(K);
 
-		if (!DoMaterialsMatch(Actor, SourceActor))
+	const int32 NumFound = SpatialHash.FindKNearest(WorldLocation, MaxDistance,
+		[&](FPhysXInstanceID ID, const FVector& /*Location*/)
 		{
-			continue;
-		}
+			if (IgnoreInstanceID.IsValid() && ID == IgnoreInstanceID)
+			{
+				return false;
+			}
 
-		StorageActor = Actor;
-		break;
+			const FPhysXInstanceData* Data = Instances.Find(ID);
+			return Data && IsSpatialQueryCandidate(*Data, OptionalFilterComponent, bIncludeStorage);
+		},
+		Neighbors);
+
+	for (int32 i = 0; i < NumFound; ++i)
+	{
+		OutHits[i].InstanceID = Neighbors[i].ID;
+		OutHits[i].Distance   = FMath::Sqrt(Neighbors[i].DistSq);
 	}
 
-	// Create a new storage actor when allowed and none exists.
-	if (!StorageActor)
+	return NumFound;
+}
+
+int32 UPhysXInstancedWorldSubsystem::FindKNearestInstancesBatch(
+	TArrayView<const FVector> Locations,
+	int32 K,
+	FPhysXInstanceNearestBatchResult& OutResult,
+	UInstancedStaticMeshComponent* OptionalFilterComponent,
+	TArrayView<const FPhysXInstanceID> IgnoreInstanceIDs,
+	bool bIncludeStorage,
+	float MaxDistance) const
+{
+	const int32 NumQueries = Locations.Num();
+	K = FMath::Max(K, 0);
+
+	OutResult.MaxPerQuery = K;
+	OutResult.Hits.SetNum(NumQueries * K);
+	OutResult.Counts.SetNumZeroed(NumQueries);
+
+	if (NumQueries == 0 || K == 0)
 	{
-		if (!bCreateStorageActorIfNeeded)
-		{
-			return false;
-		}
+		return 0;
+	}
 
-		UWorld* World = GetWorld();
-		if (!World)
-		{
-			return false;
-		}
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_BatchQuery);
+	INC_DWORD_STAT_BY(STAT_PhysXInstanced_BatchQueryCount, NumQueries);
 
-		FActorSpawnParameters SpawnParams;
-		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	const bool bPerQueryIgnore = (IgnoreInstanceIDs.Num() == NumQueries);
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumQueries, BatchQueryChunkSize);
 
-		StorageActor = World->SpawnActor<APhysXInstancedMeshActor>(
-			APhysXInstancedMeshActor::StaticClass(),
-			WorldTM,
-			SpawnParams);
+	// Each query owns its own K slots, so chunks write without synchronization.
+	// The hash and instance map are only read; nothing updates them while the game thread waits here.
+	auto SearchChunk = [&](int32 ChunkIndex)
+	{
+		const int32 Begin = ChunkIndex * BatchQueryChunkSize;
+		const int32 End   = FMath::Min(Begin + BatchQueryChunkSize, NumQueries);
 
-		if (!StorageActor)
+		for (int32 QueryIndex = Begin; QueryIndex < End; ++QueryIndex)
 		{
-			return false;
+			OutResult.Counts[QueryIndex] = FindKNearestInstances(
+				Locations[QueryIndex],
+				MakeArrayView(OutResult.Hits.GetData() + QueryIndex * K, K),
+				OptionalFilterComponent,
+				bPerQueryIgnore ? IgnoreInstanceIDs[QueryIndex] : FPhysXInstanceID(),
+				bIncludeStorage,
+				MaxDistance);
 		}
+	};
 
-		// Register the storage actor in the subsystem.
-		const FPhysXActorID NewActorID = RegisterInstancedMeshActor(StorageActor);
-		StorageActor->PhysXActorID = NewActorID;
+	const bool bParallel = CVarPhysXInstancedUseParallelQueries.GetValueOnAnyThread() != 0 && NumChunks > 1;
+	ParallelFor(NumChunks, SearchChunk, /*bForceSingleThread=*/!bParallel);
 
-		// Storage mode settings.
-		StorageActor->bStorageOnly       = true;
-		StorageActor->bIsStorageActor    = true;
-		StorageActor->bSimulateInstances = false;
-		StorageActor->bDisableISMPhysics = false;
+	int32 Total = 0;
+	for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+	{
+		Total += OutResult.Counts[QueryIndex];
+	}
 
-		// Copy mesh/material settings from the source actor.
-		StorageActor->InstanceStaticMesh         = StaticMesh;
-		StorageActor->bOverrideInstanceMaterials = SourceActor->bOverrideInstanceMaterials;
-		StorageActor->InstanceOverrideMaterials  = SourceActor->InstanceOverrideMaterials;
+	return Total;
+}
 
-		// Copy storage collision/navigation settings from the source actor.
-		StorageActor->bStorageInstancesAffectNavigation = SourceActor->bStorageInstancesAffectNavigation;
-		StorageActor->StorageCollisionProfile           = SourceActor->StorageCollisionProfile;
-		StorageActor->StorageCollisionEnabled           = SourceActor->StorageCollisionEnabled;
+int32 UPhysXInstancedWorldSubsystem::FindKNearestInstanceIDsBatch(
+	const TArray<FVector>& Locations,
+	int32 K,
+	FPhysXInstanceNearestBatchResult& OutResult,
+	UInstancedStaticMeshComponent* OptionalFilterComponent,
+	const TArray<FPhysXInstanceID>& IgnoreInstanceIDs,
+	bool bIncludeStorage,
+	float MaxDistance) const
+{
+	return FindKNearestInstancesBatch(Locations, K, OutResult, OptionalFilterComponent, IgnoreInstanceIDs, bIncludeStorage, MaxDistance);
+}
 
-		if (StorageActor->InstancedMesh)
+int32 UPhysXInstancedWorldSubsystem::SelectInstancesInCone(
+	FVector Origin,
+	FVector Direction,
+	float HalfAngleDegrees,
+	float Length,
+	TArray<FPhysXInstanceID>& OutIDs,
+	UInstancedStaticMeshComponent* OptionalFilterComponent,
+	bool bIncludeStorage) const
+{
+	OutIDs.Reset();
+
+	ForEachInstanceInCone(Origin, Direction, HalfAngleDegrees, Length,
+		[&OutIDs](FPhysXInstanceID ID) { OutIDs.Add(ID); return true; },
+		OptionalFilterComponent, bIncludeStorage);
+
+	return OutIDs.Num();
+}
+
+int32 UPhysXInstancedWorldSubsystem::SelectInstancesInScreenRect(
+	APlayerController* PlayerController,
+	FVector2D ScreenA,
+	FVector2D ScreenB,
+	TArray<FPhysXInstanceID>& OutIDs,
+	float MaxDistance,
+	UInstancedStaticMeshComponent* OptionalFilterComponent,
+	bool bIncludeStorage) const
+{
+	OutIDs.Reset();
+
+	FConvexVolume Volume;
+	FBox          Bounds;
+	if (!BuildScreenRectVolume(PlayerController, ScreenA, ScreenB, MaxDistance, Volume, Bounds))
+	{
+		return 0;
+	}
+
+	ForEachInstanceInConvexVolume(Volume, Bounds,
+		[&OutIDs](FPhysXInstanceID ID) { OutIDs.Add(ID); return true; },
+		OptionalFilterComponent, bIncludeStorage);
+
+	return OutIDs.Num();
+}
+
+int32 UPhysXInstancedWorldSubsystem::FindInstancesInRadius(
+	FVector Center,
+	float Radius,
+	TArray<FPhysXInstanceID>& OutIDs,
+	UInstancedStaticMeshComponent* OptionalFilterComponent,
+	bool bIncludeStorage) const
+{
+	OutIDs.Reset();
+
+	ForEachInstanceInRadius(Center, Radius,
+		[&OutIDs](FPhysXInstanceID ID) { OutIDs.Add(ID); return true; },
+		OptionalFilterComponent, bIncludeStorage);
+
+	return OutIDs.Num();
+}
+
+int32 UPhysXInstancedWorldSubsystem::FindInstancesInBox(
+	FBox Box,
+	TArray<FPhysXInstanceID>& OutIDs,
+	UInstancedStaticMeshComponent* OptionalFilterComponent,
+	bool bIncludeStorage) const
+{
+	OutIDs.Reset();
+
+	ForEachInstanceInBox(Box,
+		[&OutIDs](FPhysXInstanceID ID) { OutIDs.Add(ID); return true; },
+		OptionalFilterComponent, bIncludeStorage);
+
+	return OutIDs.Num();
+}
+
+
+FPhysXActorID UPhysXInstancedWorldSubsystem::RegisterInstancedMeshActor(APhysXInstancedMeshActor* Actor)
+{
+	if (!Actor || !Actor->IsValidLowLevelFast())
+	{
+		return FPhysXActorID(); // invalid
+	}
+
+	// If already registered, return the existing ID.
+	for (const TPair<FPhysXActorID, FPhysXActorData>& Pair : Actors)
+	{
+		if (Pair.Value.Actor.Get() == Actor)
 		{
-			UPhysXInstancedStaticMeshComponent* StorageISMC = StorageActor->InstancedMesh;
+			return Pair.Key;
+		}
+	}
 
-			StorageISMC->SetStaticMesh(StaticMesh);
-			StorageActor->ApplyInstanceMaterials();
+	const FPhysXActorID NewID(NextActorID++);
 
-			StorageISMC->SetSimulatePhysics(false);
+	FPhysXActorData NewData;
+	NewData.Actor = Actor;
 
-			const FName StorageProfile =
-				(StorageActor->StorageCollisionProfile.Name != NAME_None)
-					? StorageActor->StorageCollisionProfile.Name
-					: StorageActor->InstancesCollisionProfile.Name;
+	Actors.Add(NewID, NewData);
+	return NewID;
+}
 
-			if (StorageProfile != NAME_None)
-			{
-				StorageISMC->SetCollisionProfileName(StorageProfile);
-			}
+void UPhysXInstancedWorldSubsystem::UnregisterInstancedMeshActor(FPhysXActorID ActorID)
+{
+	Actors.Remove(ActorID);
+}
 
-			StorageISMC->SetCollisionEnabled(StorageActor->StorageCollisionEnabled);
+bool UPhysXInstancedWorldSubsystem::IsActorValid(FPhysXActorID ActorID) const
+{
+	const FPhysXActorData* Data = Actors.Find(ActorID);
+	return Data && Data->Actor.IsValid();
+}
+
+APhysXInstancedMeshActor* UPhysXInstancedWorldSubsystem::GetActorByID(FPhysXActorID ActorID) const
+{
+	const FPhysXActorData* Data = Actors.Find(ActorID);
+	return Data ? Data->Actor.Get() : nullptr;
+}
+
+TArray<FPhysXActorID> UPhysXInstancedWorldSubsystem::GetAllActorIDs() const
+{
+	TArray<FPhysXActorID> Result;
+	Actors.GetKeys(Result);
+	return Result;
+}
+
+TArray<FPhysXInstanceID> UPhysXInstancedWorldSubsystem::GetInstanceIDsForActor(FPhysXActorID ActorID) const
+{
+	TArray<FPhysXInstanceID> OutIDs;
+	ForEachInstanceOfActor(ActorID, [&OutIDs](FPhysXInstanceID ID) { OutIDs.Add(ID); return true; });
+	return OutIDs;
+}
 
-			StorageISMC->SetInstancesAffectNavigation(StorageActor->bStorageInstancesAffectNavigation);
-		}
+FPhysXInstanceID UPhysXInstancedWorldSubsystem::GetInstanceIDForComponentAndIndex(
+	UInstancedStaticMeshComponent* InstancedMesh,
+	int32 InstanceIndex) const
+{
+	if (!InstancedMesh || InstanceIndex < 0)
+	{
+		return FPhysXInstanceID();
 	}
 
-	if (!StorageActor || !StorageActor->InstancedMesh)
+	if (const FPhysXInstanceID* Found = InstanceIDBySlot.Find(FPhysXInstanceSlotKey(InstancedMesh, InstanceIndex)))
 	{
-		return false;
+		return *Found;
 	}
 
-	UPhysXInstancedStaticMeshComponent* StorageISMC = StorageActor->InstancedMesh;
+	// Fallback (should be rare): rebuild and try again.
+	const_cast<UPhysXInstancedWorldSubsystem*>(this)->RebuildSlotMappingForComponent(InstancedMesh);
 
-	// Ensure storage actor navigation settings are applied.
-	StorageISMC->SetInstancesAffectNavigation(StorageActor->bStorageInstancesAffectNavigation);
+	if (const FPhysXInstanceID* FoundAfter = InstanceIDBySlot.Find(FPhysXInstanceSlotKey(InstancedMesh, InstanceIndex)))
+	{
+		return *FoundAfter;
+	}
 
-	// ---------------------------------------------------------------------
-	// PRE/POST CONVERT EVENTS
-	// Signature assumed: (ID, Reason, FromActor, ToActor, WorldTM)
-	// ---------------------------------------------------------------------
+	return FPhysXInstanceID();
+}
 
-	const bool bFirePre_Source =
-		IsEventEnabled(SourceActor, EPhysXInstanceEventFlags::PreConvert) &&
-		(SourceActor->OnInstancePreConvert.IsBound() || HasInterfaceEvents(SourceActor));
+// ============================================================================
+// Stats / random helpers
+// ============================================================================
 
-	const bool bFirePost_Source =
-		IsEventEnabled(SourceActor, EPhysXInstanceEventFlags::PostConvert) &&
-		(SourceActor->OnInstancePostConvert.IsBound() || HasInterfaceEvents(SourceActor));
+int32 UPhysXInstancedWorldSubsystem::GetTotalInstanceCount() const
+{
+	return Instances.Num();
+}
 
-	const bool bFirePre_Storage =
-		IsEventEnabled(StorageActor, EPhysXInstanceEventFlags::PreConvert) &&
-		(StorageActor->OnInstancePreConvert.IsBound() || HasInterfaceEvents(StorageActor));
+int32 UPhysXInstancedWorldSubsystem::GetInstanceCountForComponent(
+	UInstancedStaticMeshComponent* Component) const
+{
+	if (!Component)
+	{
+		return 0;
+	}
 
-	const bool bFirePost_Storage =
-		IsEventEnabled(StorageActor, EPhysXInstanceEventFlags::PostConvert) &&
-		(StorageActor->OnInstancePostConvert.IsBound() || HasInterfaceEvents(StorageActor));
+	int32 Count = 0;
 
-	auto FirePreConvert = [&](APhysXInstancedMeshActor* Actor)
+	for (const TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
 	{
-		if (!Actor)
+		const FPhysXInstanceData& Data = Pair.Value;
+
+		if (Data.InstancedComponent.Get() == Component &&
+			Data.InstanceIndex != INDEX_NONE)
 		{
-			return;
+			++Count;
 		}
+	}
 
-		Actor->OnInstancePreConvert.Broadcast(ID, Reason, SourceActor, StorageActor, WorldTM);
+	return Count;
+}
 
-		if (HasInterfaceEvents(Actor))
-		{
-			IPhysXInstanceEvents::Execute_OnInstancePreConvert(Actor, ID, Reason, SourceActor, StorageActor, WorldTM);
-		}
-	};
+FPhysXInstanceID UPhysXInstancedWorldSubsystem::GetRandomInstanceID(bool bOnlySimulating) const
+{
+	TArray<FPhysXInstanceID> Candidates;
+	Candidates.Reserve(Instances.Num());
 
-	auto FirePostConvert = [&](APhysXInstancedMeshActor* Actor)
+	for (const TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
 	{
-		if (!Actor)
+		const FPhysXInstanceData& Data = Pair.Value;
+
+		if (Data.InstanceIndex == INDEX_NONE)
 		{
-			return;
+			continue;
 		}
 
-		Actor->OnInstancePostConvert.Broadcast(ID, Reason, SourceActor, StorageActor, WorldTM);
+		UInstancedStaticMeshComponent* ISMC = Data.InstancedComponent.Get();
+		if (!ISMC || !ISMC->IsValidLowLevelFast())
+		{
+			continue;
+		}
 
-		if (HasInterfaceEvents(Actor))
+		if (bOnlySimulating && !IsInstancePhysicsEnabled(Pair.Key))
 		{
-			IPhysXInstanceEvents::Execute_OnInstancePostConvert(Actor, ID, Reason, SourceActor, StorageActor, WorldTM);
+			continue;
 		}
-	};
 
-	// Fire PreConvert right before we start mutating data.
-	if (bFirePre_Source)
+		Candidates.Add(Pair.Key);
+	}
+
+	if (Candidates.Num() == 0)
 	{
-		FirePreConvert(SourceActor);
+		return FPhysXInstanceID();
 	}
-	if (bFirePre_Storage && StorageActor != SourceActor)
+
+	const int32 RandomIndex = FMath::RandHelper(Candidates.Num());
+	return Candidates[RandomIndex];
+}
+
+FPhysXInstanceID UPhysXInstancedWorldSubsystem::GetRandomInstanceForComponent(
+	UInstancedStaticMeshComponent* Component,
+	bool bOnlySimulating) const
+{
+	if (!Component)
 	{
-		FirePreConvert(StorageActor);
+		return FPhysXInstanceID();
 	}
 
-	// Always fire PostConvert even on early returns after this point.
-	const bool bNeedPost = (bFirePost_Source || bFirePost_Storage);
-	ON_SCOPE_EXIT
+	TArray<FPhysXInstanceID> Candidates;
+
+	for (const TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
 	{
-		if (!bNeedPost)
+		const FPhysXInstanceData& Data = Pair.Value;
+
+		if (Data.InstanceIndex == INDEX_NONE)
 		{
-			return;
+			continue;
 		}
 
-		if (bFirePost_Source)
+		UInstancedStaticMeshComponent* ISMC = Data.InstancedComponent.Get();
+		if (ISMC != Component || !ISMC->IsValidLowLevelFast())
 		{
-			FirePostConvert(SourceActor);
+			continue;
 		}
-		if (bFirePost_Storage && StorageActor != SourceActor)
+
+		if (bOnlySimulating && !IsInstancePhysicsEnabled(Pair.Key))
 		{
-			FirePostConvert(StorageActor);
+			continue;
 		}
-	};
-
-	// ---------------------------------------------------------------------
-	// 2) Add a new ISM instance into the storage actor
-	// ---------------------------------------------------------------------
 
-	const int32 StorageIndex = StorageISMC->AddInstanceWorldSpace(WorldTM);
-	if (StorageIndex == INDEX_NONE)
-	{
-		return false;
+		Candidates.Add(Pair.Key);
 	}
 
-	// ---------------------------------------------------------------------
-	// 3) Remove the source visual instance and destroy its PhysX body
-	//    (ID stays registered; we just rebind it to the storage component/index).
-	// ---------------------------------------------------------------------
-
-	const int32 RemovedIndex = Data->InstanceIndex;
-
-#if PHYSICS_INTERFACE_PHYSX
-	InvalidatePendingAddEntries(ID);
-#endif
-
-	// Remove old slot mapping (source component/index) BEFORE we mutate anything.
-	RemoveSlotMapping(ID);
-
-	// Remove from the dynamic component (this compacts indices).
-	if (!ISMC->RemoveInstance(RemovedIndex))
+	if (Candidates.Num() == 0)
 	{
-		// Roll back storage add.
-		StorageISMC->RemoveInstance(StorageIndex);
-
-		// Restore old slot mapping (Data still points to the old slot at this moment).
-		AddSlotMapping(ID);
-		RebuildSlotMappingForComponent(ISMC);
-
-		return false;
+		return FPhysXInstanceID();
 	}
 
-	// Keep actor bookkeeping in sync AFTER we know the remove succeeded.
-	SourceActor->RegisteredInstanceIDs.Remove(ID);
-	StorageActor->RegisteredInstanceIDs.Add(ID);
-
-	// Fix indices for other IDs still pointing to the source component (RemoveAt shift).
-	FixInstanceIndicesAfterRemoval(ISMC, RemovedIndex);
-	ISMC->MarkRenderStateDirty();
-
-#if PHYSICS_INTERFACE_PHYSX
-	// Body is gone in storage mode.
-	ClearInstanceUserData(ID);
-	Data->Body.Destroy();
-#endif
-
-	// Rebind the stable ID to the storage slot.
-	Data->bSimulating        = false;
-	Data->InstancedComponent = StorageISMC;
-	Data->InstanceIndex      = StorageIndex;
-
-	// Add new slot mapping AFTER Data points to the storage slot.
-	AddSlotMapping(ID);
-
-	// Rebuild mappings for both components to guarantee correctness.
-	RebuildSlotMappingForComponent(ISMC);
-	RebuildSlotMappingForComponent(StorageISMC);
-
-	// Storage component render state.
-	StorageISMC->MarkRenderStateDirty();
-
-	return true;
+	const int32 RandomIndex = FMath::RandHelper(Candidates.Num());
+	return Candidates[RandomIndex];
 }
 
-
-bool UPhysXInstancedWorldSubsystem::ConvertStorageInstanceToDynamic_Internal(
-	FPhysXInstanceID ID,
-	bool bCreateDynamicActorIfNeeded,
-	EPhysXInstanceConvertReason Reason)
+void UPhysXInstancedWorldSubsystem::FixInstanceIndicesAfterRemoval(
+	UInstancedStaticMeshComponent* ISMC,
+	int32 RemovedIndex,
+	int32 OldLastIndex)
 {
-	FPhysXInstanceData* Data = Instances.Find(ID);
-	if (!Data)
+	if (!ISMC || RemovedIndex < 0)
 	{
-		return false;
+		return;
 	}
 
-	UInstancedStaticMeshComponent* StorageISMC_Base = Data->InstancedComponent.Get();
-	if (!StorageISMC_Base || !StorageISMC_Base->IsValidLowLevelFast())
+	// Swap removal: only the old last index moved into RemovedIndex.
+	if (UsesRemoveAtSwap(ISMC))
 	{
-		return false;
-	}
+		if (OldLastIndex == INDEX_NONE || OldLastIndex == RemovedIndex)
+		{
+			return;
+		}
 
-	const int32 StorageIndex = Data->InstanceIndex;
-	if (StorageIndex == INDEX_NONE)
-	{
-		return false;
-	}
+		for (TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
+		{
+			FPhysXInstanceData& OtherData = Pair.Value;
+			if (OtherData.InstancedComponent.Get() == ISMC && OtherData.InstanceIndex == OldLastIndex)
+			{
+				OtherData.InstanceIndex = RemovedIndex;
+				break;
+			}
+		}
 
-	APhysXInstancedMeshActor* StorageActor = Cast<APhysXInstancedMeshActor>(StorageISMC_Base->GetOwner());
-	if (!StorageActor)
-	{
-		return false;
+		return;
 	}
 
-	// Must be a storage owner.
-	if (!(StorageActor->bIsStorageActor || StorageActor->bStorageOnly))
+	// UInstancedStaticMeshComponent::RemoveInstance() compacts the array (RemoveAt),
+	// so all indices after RemovedIndex shift by -1.
+	for (TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
 	{
-		return false;
-	}
+		FPhysXInstanceData& OtherData = Pair.Value;
 
-	// Get world transform from the storage instance.
-	FTransform WorldTM;
-	if (!StorageISMC_Base->GetInstanceTransform(StorageIndex, WorldTM, /*bWorldSpace=*/true))
-	{
-		return false;
+		if (OtherData.InstancedComponent.Get() != ISMC)
+		{
+			continue;
+		}
+
+		if (OtherData.InstanceIndex != INDEX_NONE && OtherData.InstanceIndex > RemovedIndex)
+		{
+			OtherData.InstanceIndex -= 1;
+		}
 	}
+}
 
-	UStaticMesh* StaticMesh = StorageActor->InstanceStaticMesh;
-	if (!StaticMesh)
-	{
-		StaticMesh = StorageISMC_Base->GetStaticMesh();
-	}
-	if (!StaticMesh)
+void UPhysXInstancedWorldSubsystem::FixInstanceIndicesAfterRemovals(
+	UInstancedStaticMeshComponent* ISMC,
+	TArrayView<const FInstanceRemoval> Removals)
+{
+	if (!ISMC || Removals.Num() == 0)
 	{
-		return false;
+		return;
 	}
 
-	// ---------------------------------------------------------------------
-	// 1) Find or create a NON-storage actor with matching mesh/materials.
-	// ---------------------------------------------------------------------
-
-	auto DoMaterialsMatch = [](const APhysXInstancedMeshActor* A, const APhysXInstancedMeshActor* B)
+	if (UsesRemoveAtSwap(ISMC))
 	{
-		if (!A || !B)
+		// Replay the swaps on slots only: for every moved instance, its final slot and its slot before the batch.
+		TMap<int32, int32> OriginalIndexBySlot;
+		for (const FInstanceRemoval& Removal : Removals)
 		{
-			return false;
-		}
+			OriginalIndexBySlot.Remove(Removal.RemovedIndex);
 
-		if (A->bOverrideInstanceMaterials != B->bOverrideInstanceMaterials)
-		{
-			return false;
+			if (Removal.OldLastIndex == INDEX_NONE || Removal.OldLastIndex == Removal.RemovedIndex)
+			{
+				continue;
+			}
+
+			int32 OriginalIndex = Removal.OldLastIndex;
+			OriginalIndexBySlot.RemoveAndCopyValue(Removal.OldLastIndex, OriginalIndex);
+			OriginalIndexBySlot.Add(Removal.RemovedIndex, OriginalIndex);
 		}
 
-		if (!A->bOverrideInstanceMaterials)
+		if (OriginalIndexBySlot.Num() == 0)
 		{
-			return true;
+			return;
 		}
 
-		if (A->InstanceOverrideMaterials.Num() != B->InstanceOverrideMaterials.Num())
+		TMap<int32, int32> NewIndexByOriginal;
+		NewIndexByOriginal.Reserve(OriginalIndexBySlot.Num());
+		for (const TPair<int32, int32>& Pair : OriginalIndexBySlot)
 		{
-			return false;
+			NewIndexByOriginal.Add(Pair.Value, Pair.Key);
 		}
 
-		for (int32 i = 0; i < A->InstanceOverrideMaterials.Num(); ++i)
+		for (TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
 		{
-			if (A->InstanceOverrideMaterials[i] != B->InstanceOverrideMaterials[i])
+			FPhysXInstanceData& OtherData = Pair.Value;
+			if (OtherData.InstancedComponent.Get() != ISMC)
 			{
-				return false;
+				continue;
+			}
+
+			if (const int32* NewIndex = NewIndexByOriginal.Find(OtherData.InstanceIndex))
+			{
+				OtherData.InstanceIndex = *NewIndex;
 			}
 		}
 
-		return true;
-	};
+		return;
+	}
 
-	APhysXInstancedMeshActor* TargetActor = nullptr;
+	// Compacting removal: every instance moves down by the number of removed slots below it.
+	TArray<int32, TInlineAllocator<64>> RemovedIndices;
+	RemovedIndices.Reserve(Removals.Num());
+	for (const FInstanceRemoval& Removal : Removals)
+	{
+		RemovedIndices.Add(Removal.RemovedIndex);
+	}
+	RemovedIndices.Sort();
 
-	for (const TPair<FPhysXActorID, FPhysXActorData>& Pair : Actors)
+	for (TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
 	{
-		APhysXInstancedMeshActor* Actor = Pair.Value.Actor.Get();
-		if (!Actor || !Actor->IsValidLowLevelFast())
-		{
-			continue;
-		}
+		FPhysXInstanceData& OtherData = Pair.Value;
 
-		// Skip storage actors.
-		if (Actor->bIsStorageActor || Actor->bStorageOnly)
+		if (OtherData.InstancedComponent.Get() != ISMC || OtherData.InstanceIndex == INDEX_NONE)
 		{
 			continue;
 		}
 
-		if (Actor->InstanceStaticMesh != StaticMesh)
-		{
-			continue;
-		}
+		OtherData.InstanceIndex -= Algo::LowerBound(RemovedIndices, OtherData.InstanceIndex);
+	}
+}
 
-		if (!DoMaterialsMatch(Actor, StorageActor))
-		{
-			continue;
-		}
+// ============================================================================
+// Hierarchical storage (deferred cluster-tree rebuilds)
+// ============================================================================
 
-		if (!Actor->InstancedMesh)
-		{
-			continue;
-		}
+void UPhysXInstancedWorldSubsystem::NotifyStorageInstancesChanged(UInstancedStaticMeshComponent* ISMC, int32 NumChanges)
+{
+	UPhysXInstancedHierarchicalStaticMeshComponent* Hierarchical =
+		Cast<UPhysXInstancedHierarchicalStaticMeshComponent>(ISMC);
 
-		TargetActor = Actor;
-		break;
+	if (!Hierarchical || NumChanges <= 0)
+	{
+		return;
 	}
 
-	if (!TargetActor)
+	const UWorld* World = GetWorld();
+	const double Now = World ? World->GetTimeSeconds() : 0.0;
+
+	if (!Hierarchical->HasPendingTreeRebuild())
 	{
-		if (!bCreateDynamicActorIfNeeded)
-		{
-			return false;
-		}
+		PendingStorageTreeRebuilds.Add(Hierarchical);
+	}
 
-		UWorld* World = GetWorld();
-		if (!World)
+	Hierarchical->NotifyInstancesChanged(NumChanges, Now);
+}
+
+void UPhysXInstancedWorldSubsystem::ProcessStorageTreeRebuilds()
+{
+	if (StorageBVH.NeedsRebuild(StorageBVHRebuildMinChanges))
+	{
+		SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_StorageBVHRebuild);
+		StorageBVH.Rebuild();
+	}
+
+	SET_DWORD_STAT(STAT_PhysXInstanced_StorageBVHLeaves, StorageBVH.Num());
+
+	if (PendingStorageTreeRebuilds.Num() == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_StorageTreeRebuild);
+
+	const UWorld* World = GetWorld();
+	const double Now = World ? World->GetTimeSeconds() : 0.0;
+
+	const int32  BatchSize = FMath::Max(1, StorageTreeRebuildBatchSize);
+	const double MaxDelay  = FMath::Max(0.0f, StorageTreeRebuildMaxDelay);
+
+	int32 NumRebuilt = 0;
+
+	for (int32 Index = PendingStorageTreeRebuilds.Num() - 1; Index >= 0; --Index)
+	{
+		UPhysXInstancedHierarchicalStaticMeshComponent* Hierarchical = PendingStorageTreeRebuilds[Index].Get();
+
+		if (!Hierarchical || !Hierarchical->HasPendingTreeRebuild())
 		{
-			return false;
+			PendingStorageTreeRebuilds.RemoveAtSwap(Index, 1, /*bAllowShrinking=*/false);
+			continue;
 		}
 
-		FActorSpawnParameters SpawnParams;
-		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
-		TargetActor = World->SpawnActor<APhysXInstancedMeshActor>(
-			APhysXInstancedMeshActor::StaticClass(),
-			WorldTM,
-			SpawnParams);
+		// Keep accumulating until the batch is full or the oldest change waited long enough.
+		const bool bBatchFull = Hierarchical->GetPendingTreeChanges() >= BatchSize;
+		const bool bTimedOut  = (Now - Hierarchical->GetFirstPendingChangeTime()) >= MaxDelay;
 
-		if (!TargetActor)
+		if (!bBatchFull && !bTimedOut)
 		{
-			return false;
+			continue;
 		}
 
-		// Register in subsystem.
-		const FPhysXActorID NewActorID = RegisterInstancedMeshActor(TargetActor);
-		TargetActor->PhysXActorID = NewActorID;
+		Hierarchical->FlushTreeRebuild(bAsyncStorageTreeRebuilds);
+		PendingStorageTreeRebuilds.RemoveAtSwap(Index, 1, /*bAllowShrinking=*/false);
+		++NumRebuilt;
+	}
 
-		// Dynamic mode defaults.
-		TargetActor->bStorageOnly       = false;
-		TargetActor->bIsStorageActor    = false;
-		TargetActor->bSimulateInstances = true;
+	SET_DWORD_STAT(STAT_PhysXInstanced_StorageTreeRebuilds, NumRebuilt);
+	SET_DWORD_STAT(STAT_PhysXInstanced_StorageTreePending,  PendingStorageTreeRebuilds.Num());
+}
 
-		// IMPORTANT: dynamic ISM collision should be disabled to avoid double collision.
-		TargetActor->bDisableISMPhysics = true;
+// ============================================================================
+// Render components (active / sleeping / no-shadow tiers, spatial chunks)
+// ============================================================================
 
-		// Copy mesh/material settings from the storage actor.
-		TargetActor->InstanceStaticMesh         = StaticMesh;
-		TargetActor->bOverrideInstanceMaterials = StorageActor->bOverrideInstanceMaterials;
-		TargetActor->InstanceOverrideMaterials  = StorageActor->InstanceOverrideMaterials;
+void UPhysXInstancedWorldSubsystem::UpdateRenderTierHysteresis(
+	FPhysXInstanceID ID,
+	FPhysXInstanceData& Data,
+	bool bSleeping,
+	float TimerDelta,
+	const APhysXInstancedMeshActor* OwnerActor)
+{
+	if (Data.bInSleepingRenderTier == bSleeping)
+	{
+		Data.RenderTierMismatchTime = 0.0f;
+		return;
 	}
 
-	if (!TargetActor || !TargetActor->InstancedMesh)
+	if (Data.bRenderTierMigrationQueued)
 	{
-		return false;
+		return;
 	}
 
-	// Ensure the actor is registered (in case it existed but wasn't registered yet).
-	if (TargetActor->PhysXActorID.GetUniqueID() == 0u)
+	if (!OwnerActor)
 	{
-		const FPhysXActorID NewActorID = RegisterInstancedMeshActor(TargetActor);
-		TargetActor->PhysXActorID = NewActorID;
+		const UInstancedStaticMeshComponent* ISMC = Data.InstancedComponent.Get();
+		OwnerActor = ISMC ? Cast<APhysXInstancedMeshActor>(ISMC->GetOwner()) : nullptr;
 	}
 
-	UPhysXInstancedStaticMeshComponent* TargetISMC = TargetActor->InstancedMesh;
-	if (!TargetISMC || !TargetISMC->IsValidLowLevelFast())
+	float Delay = 0.0f;
+
+	if (bSleeping)
 	{
-		return false;
+		// Entering the sleeping tier is opt-in per actor; storage actors never use tiers.
+		if (!OwnerActor || !OwnerActor->bUseSleepingRenderTier || OwnerActor->bIsStorageActor || OwnerActor->bStorageOnly)
+		{
+			return;
+		}
+
+		Delay = OwnerActor->SleepingTierEnterDelay;
+	}
+	else
+	{
+		// Leaving the sleeping tier always happens, even if the actor disabled tiers meanwhile.
+		Delay = OwnerActor ? OwnerActor->SleepingTierExitDelay : 0.0f;
 	}
 
-	// Enforce dynamic container invariants (avoid double collision).
-	TargetActor->bStorageOnly       = false;
-	TargetActor->bIsStorageActor    = false;
-	TargetActor->bSimulateInstances = true;
-	TargetActor->bDisableISMPhysics = true;
+	Data.RenderTierMismatchTime += TimerDelta;
 
-	if (TargetISMC->GetStaticMesh() != StaticMesh)
+	if (Data.RenderTierMismatchTime >= Delay)
 	{
-		TargetISMC->SetStaticMesh(StaticMesh);
+		QueueRenderComponentMigration(ID, Data);
 	}
-	TargetActor->ApplyInstanceMaterials();
+}
 
-	TargetISMC->SetSimulatePhysics(false);
-	TargetISMC->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+void UPhysXInstancedWorldSubsystem::RefreshActorRenderTierSettings()
+{
+	bAnySleepingRenderTierActor = false;
 
-	// ---------------------------------------------------------------------
-	// PRE/POST CONVERT EVENTS
-	// Signature assumed: (ID, Reason, FromActor, ToActor, WorldTM)
-	// ---------------------------------------------------------------------
+	for (TPair<FPhysXActorID, FPhysXActorData>& Pair : Actors)
+	{
+		FPhysXActorData& ActorData = Pair.Value;
 
-	const bool bFirePre_From =
-		IsEventEnabled(StorageActor, EPhysXInstanceEventFlags::PreConvert) &&
-		(StorageActor->OnInstancePreConvert.IsBound() || HasInterfaceEvents(StorageActor));
+		const APhysXInstancedMeshActor* Actor = ActorData.Actor.Get();
+		if (!Actor)
+		{
+			continue;
+		}
 
-	const bool bFirePost_From =
-		IsEventEnabled(StorageActor, EPhysXInstanceEventFlags::PostConvert) &&
-		(StorageActor->OnInstancePostConvert.IsBound() || HasInterfaceEvents(StorageActor));
+		// Same rule as AddSlotMapping: storage actors never use tiers.
+		const bool bStorage = Actor->bIsStorageActor || Actor->bStorageOnly;
+		const bool bUsesSleepingTier = Actor->bUseSleepingRenderTier && !bStorage;
+		const bool bUsesShadowLOD    = Actor->bUseShadowDistanceLOD && !bStorage;
 
-	const bool bFirePre_To =
-		IsEventEnabled(TargetActor, EPhysXInstanceEventFlags::PreConvert) &&
-		(TargetActor->OnInstancePreConvert.IsBound() || HasInterfaceEvents(TargetActor));
+		bAnySleepingRenderTierActor |= bUsesSleepingTier;
 
-	const bool bFirePost_To =
-		IsEventEnabled(TargetActor, EPhysXInstanceEventFlags::PostConvert) &&
-		(TargetActor->OnInstancePostConvert.IsBound() || HasInterfaceEvents(TargetActor));
+		const bool bSleepingTierChanged = bUsesSleepingTier != ActorData.bStampedSleepingRenderTier;
+		const bool bShadowLODChanged    = bUsesShadowLOD != ActorData.bStampedShadowDistanceLOD;
 
-	auto FirePreConvert = [&](APhysXInstancedMeshActor* Actor)
-	{
-		if (!Actor)
+		if (!bSleepingTierChanged && !bShadowLODChanged)
 		{
-			return;
+			continue;
 		}
 
-		Actor->OnInstancePreConvert.Broadcast(ID, Reason, StorageActor, TargetActor, WorldTM);
+		ActorData.bStampedSleepingRenderTier = bUsesSleepingTier;
+		ActorData.bStampedShadowDistanceLOD  = bUsesShadowLOD;
 
-		if (HasInterfaceEvents(Actor))
+		// Rare (a Blueprint toggled the flag), so walking the actor's instances here is fine.
+		for (const FPhysXInstanceID& ID : Actor->RegisteredInstanceIDs)
 		{
-			IPhysXInstanceEvents::Execute_OnInstancePreConvert(Actor, ID, Reason, StorageActor, TargetActor, WorldTM);
+			FPhysXInstanceData* Data = Instances.Find(ID);
+			if (!Data)
+			{
+				continue;
+			}
+
+			Data->bOwnerUsesSleepingTier = bUsesSleepingTier;
+			Data->bOwnerUsesShadowLOD    = bUsesShadowLOD;
+
+			// Turned on: sleepers become candidates through the flags. Turned off: they go back to the active tier.
+			if (!bUsesSleepingTier && Data->bInSleepingRenderTier)
+			{
+				QueueRenderComponentMigration(ID, *Data);
+			}
+
+			// The no-shadow tier is only left by crossing back inside the distance, which is no longer evaluated.
+			if (!bUsesShadowLOD && Data->bBeyondShadowDistance)
+			{
+				Data->bBeyondShadowDistance = false;
+				QueueRenderComponentMigration(ID, *Data);
+			}
 		}
-	};
+	}
+}
 
-	auto FirePostConvert = [&](APhysXInstancedMeshActor* Actor)
+void UPhysXInstancedWorldSubsystem::UpdateShadowLODView()
+{
+	bShadowLODViewValid = false;
+
+	bool bAnyShadowLODActor = false;
+
+	for (const TPair<FPhysXActorID, FPhysXActorData>& Pair : Actors)
 	{
-		if (!Actor)
+		const APhysXInstancedMeshActor* Actor = Pair.Value.Actor.Get();
+		if (Actor && Actor->bUseShadowDistanceLOD)
 		{
-			return;
+			bAnyShadowLODActor = true;
+			break;
 		}
+	}
 
-		Actor->OnInstancePostConvert.Broadcast(ID, Reason, StorageActor, TargetActor, WorldTM);
+	if (!bAnyShadowLODActor)
+	{
+		return;
+	}
 
-		if (HasInterfaceEvents(Actor))
-		{
-			IPhysXInstanceEvents::Execute_OnInstancePostConvert(Actor, ID, Reason, StorageActor, TargetActor, WorldTM);
-		}
-	};
+	UWorld* World = CachedWorld.Get() ? CachedWorld.Get() : GetWorld();
+	APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
 
-	// Fire PreConvert right before we start mutating data/instances.
-	if (bFirePre_From)
+	// Dedicated servers have no viewer; instances then keep their current component.
+	if (!PlayerController)
 	{
-		FirePreConvert(StorageActor);
+		return;
 	}
-	if (bFirePre_To && TargetActor != StorageActor)
+
+	FRotator ViewRotation;
+	PlayerController->GetPlayerViewPoint(ShadowLODViewLocation, ViewRotation);
+
+	bShadowLODViewValid = true;
+}
+
+void UPhysXInstancedWorldSubsystem::UpdateShadowDistanceLOD(
+	FPhysXInstanceID ID,
+	FPhysXInstanceData& Data,
+	const FVector& WorldLocation,
+	const APhysXInstancedMeshActor* OwnerActor)
+{
+	if (!OwnerActor || OwnerActor->bIsStorageActor || OwnerActor->bStorageOnly)
+	{
+		return;
+	}
+
+	const float DistSq = FVector::DistSquared(WorldLocation, ShadowLODViewLocation);
+
+	// Leave the casting set only past Distance + Hysteresis, come back inside Distance.
+	const float NearDistance = FMath::Max(0.0f, OwnerActor->ShadowCastDistance);
+	const float FarDistance  = NearDistance + FMath::Max(0.0f, OwnerActor->ShadowDistanceHysteresis);
+
+	bool bBeyond = Data.bBeyondShadowDistance;
+
+	if (!bBeyond && DistSq > FMath::Square(FarDistance))
+	{
+		bBeyond = true;
+	}
+	else if (bBeyond && DistSq < FMath::Square(NearDistance))
+	{
+		bBeyond = false;
+	}
+
+	if (bBeyond == Data.bBeyondShadowDistance)
+	{
+		return;
+	}
+
+	Data.bBeyondShadowDistance = bBeyond;
+	QueueRenderComponentMigration(ID, Data);
+}
+
+void UPhysXInstancedWorldSubsystem::UpdateSleepingShadowDistanceLOD()
+{
+#if PHYSICS_INTERFACE_PHYSX
+	const int32 NumCandidates = SleepingShadowLODCandidates.Num();
+	if (NumCandidates == 0)
 	{
-		FirePreConvert(TargetActor);
+		SleepingShadowLODCursor = 0;
+		return;
 	}
 
-	bool bConvertedSuccessfully = false;
-	ON_SCOPE_EXIT
+	const int32 NumChecks = (MaxSleepingShadowLODChecksPerFrame > 0)
+		? FMath::Min(MaxSleepingShadowLODChecksPerFrame, NumCandidates)
+		: NumCandidates;
+
+	// The candidate list follows instance map order, so a cursor wrapped into it walks every sleeper in turn.
+	int32 Cursor = (SleepingShadowLODCursor < NumCandidates) ? SleepingShadowLODCursor : 0;
+
+	for (int32 Check = 0; Check < NumChecks; ++Check)
 	{
-		if (!bConvertedSuccessfully)
-		{
-			return;
-		}
+		const FPhysXInstanceID ID = SleepingShadowLODCandidates[Cursor];
+		Cursor = (Cursor + 1 < NumCandidates) ? Cursor + 1 : 0;
 
-		if (bFirePost_From)
+		FPhysXInstanceData* Data = Instances.Find(ID);
+		physx::PxRigidActor* PxActor = Data ? Data->Body.GetPxActor() : nullptr;
+		UInstancedStaticMeshComponent* ISMC = Data ? Data->InstancedComponent.Get() : nullptr;
+		if (!PxActor || !ISMC)
 		{
-			FirePostConvert(StorageActor);
+			continue;
 		}
-		if (bFirePost_To && TargetActor != StorageActor)
+
+		const APhysXInstancedMeshActor* OwnerActor = Cast<APhysXInstancedMeshActor>(ISMC->GetOwner());
+		if (!OwnerActor || !OwnerActor->bUseShadowDistanceLOD)
 		{
-			FirePostConvert(TargetActor);
+			continue;
 		}
-	};
-
-	// ---------------------------------------------------------------------
-	// 2) Add a visual instance to the target actor (dynamic container).
-	// ---------------------------------------------------------------------
 
-	const int32 TargetIndex = TargetISMC->AddInstanceWorldSpace(WorldTM);
-	if (TargetIndex == INDEX_NONE)
-	{
-		return false;
+		UpdateShadowDistanceLOD(ID, *Data, P2UVector(PxActor->getGlobalPose().p), OwnerActor);
 	}
 
-#if PHYSICS_INTERFACE_PHYSX
-	// ---------------------------------------------------------------------
-	// 3) Create a PhysX body for the NEW target slot first (so we can rollback safely).
-	// ---------------------------------------------------------------------
+	SleepingShadowLODCursor = Cursor;
+#endif // PHYSICS_INTERFACE_PHYSX
+}
 
-	if (!GInstancedDefaultMaterial)
+void UPhysXInstancedWorldSubsystem::QueueRenderComponentMigration(FPhysXInstanceID ID, FPhysXInstanceData& Data)
+{
+	if (Data.bRenderTierMigrationQueued)
 	{
-		TargetISMC->RemoveInstance(TargetIndex);
-		return false;
+		return;
 	}
 
-	EPhysXInstanceShapeType ShapeType = EPhysXInstanceShapeType::Box;
-	UStaticMesh* OverrideMesh = nullptr;
-
-	ShapeType    = TargetActor->InstanceShapeType;
-	OverrideMesh = TargetActor->OverrideCollisionMesh;
+	Data.bRenderTierMigrationQueued = true;
+	PendingRenderTierMigrations.Add(ID);
+}
 
-	FPhysXInstanceBody NewBody;
-	if (!NewBody.CreateFromInstancedStaticMesh(
-		TargetISMC,
-		TargetIndex,
-		/*bSimulate=*/true,
-		GInstancedDefaultMaterial,
-		ShapeType,
-		OverrideMesh))
+void UPhysXInstancedWorldSubsystem::ProcessRenderTierMigrations()
+{
+	const int32 NumPending = PendingRenderTierMigrations.Num();
+	if (NumPending == 0)
 	{
-		TargetISMC->RemoveInstance(TargetIndex);
-		return false;
+		SET_DWORD_STAT(STAT_PhysXInstanced_RenderTierMigrations, 0);
+		SET_DWORD_STAT(STAT_PhysXInstanced_RenderTierPending,    0);
+		return;
 	}
-#endif // PHYSICS_INTERFACE_PHYSX
 
-	// ---------------------------------------------------------------------
-	// 4) Commit: remove storage instance and rebind the stable ID.
-	// ---------------------------------------------------------------------
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_RenderTierMigrate);
 
-#if PHYSICS_INTERFACE_PHYSX
-	// If ID was still queued from a previous dynamic state, kill those entries before rebinding.
-	InvalidatePendingAddEntries(ID);
-#endif
+	int32 Budget = MaxRenderTierMigrationsPerFrame;
+	Budget = (Budget <= 0) ? NumPending : FMath::Min(Budget, NumPending);
 
-	// Remove the old slot mapping BEFORE changing Data.
-	RemoveSlotMapping(ID);
+	// Group by (source, target) so every component pair is touched once per frame.
+	TMap<TPair<UInstancedStaticMeshComponent*, UPhysXInstancedStaticMeshComponent*>, TArray<FPhysXInstanceID>> Batches;
 
-	// Remove from storage (this compacts indices).
-	if (!StorageISMC_Base->RemoveInstance(StorageIndex))
+	for (int32 Index = 0; Index < Budget; ++Index)
 	{
-		// Rollback: remove the new target instance.
-		TargetISMC->RemoveInstance(TargetIndex);
+		const FPhysXInstanceID ID = PendingRenderTierMigrations[Index];
 
-		// Restore old mapping (Data still points to old storage slot).
-		AddSlotMapping(ID);
+		FPhysXInstanceData* Data = Instances.Find(ID);
+		if (!Data)
+		{
+			continue;
+		}
 
-#if PHYSICS_INTERFACE_PHYSX
-		// NewBody owns a Px pointer; destroy explicitly on rollback.
-		NewBody.Destroy();
-#endif
-		return false;
-	}
+		Data->bRenderTierMigrationQueued = false;
+		Data->RenderTierMismatchTime     = 0.0f;
 
-	// Actor bookkeeping.
-	StorageActor->RegisteredInstanceIDs.Remove(ID);
-	TargetActor->RegisteredInstanceIDs.Add(ID);
+		UInstancedStaticMeshComponent* ISMC = Data->InstancedComponent.Get();
+		if (!ISMC || Data->InstanceIndex == INDEX_NONE)
+		{
+			continue;
+		}
 
-	// Fix indices for other storage-bound IDs affected by compaction.
-	FixInstanceIndicesAfterRemoval(StorageISMC_Base, StorageIndex);
+		APhysXInstancedMeshActor* OwnerActor = Cast<APhysXInstancedMeshActor>(ISMC->GetOwner());
+		if (!OwnerActor || !OwnerActor->InstancedMesh || OwnerActor->bIsStorageActor || OwnerActor->bStorageOnly)
+		{
+			continue;
+		}
 
-	// Rebind stable ID to the new dynamic slot.
-	Data->InstancedComponent = TargetISMC;
-	Data->InstanceIndex      = TargetIndex;
+		FTransform WorldTM;
+		if (!ISMC->GetInstanceTransform(Data->InstanceIndex, WorldTM, /*bWorldSpace=*/true))
+		{
+			continue;
+		}
 
-#if PHYSICS_INTERFACE_PHYSX
-	Data->bSimulating  = true;
-	Data->SleepTime    = 0.0f;
-	Data->FallTime     = 0.0f;
-	Data->bWasSleeping = false;
+		// The sleep state or position may have changed back while the entry waited for budget,
+		// so the target is resolved here rather than when the entry was queued.
+		UPhysXInstancedStaticMeshComponent* Target =
+			OwnerActor->ResolveRenderComponent(ISMC, Data->bWasSleeping, WorldTM.GetLocation(), Data->bBeyondShadowDistance);
 
-	// Replace body (storage instances should have no body).
-	ClearInstanceUserData(ID);
-	Data->Body.Destroy();
-	Data->Body = NewBody;
+		if (!Target || Target == ISMC)
+		{
+			const UPhysXInstancedStaticMeshComponent* CurrentPhysXISMC = Cast<UPhysXInstancedStaticMeshComponent>(ISMC);
+			Data->bInSleepingRenderTier = CurrentPhysXISMC && CurrentPhysXISMC->bIsSleepingTier;
+			continue;
+		}
 
-	EnsureInstanceUserData(ID);
-	++NumBodiesLifetimeCreated;
-#else
-	Data->bSimulating  = false;
-	Data->SleepTime    = 0.0f;
-	Data->FallTime     = 0.0f;
-	Data->bWasSleeping = false;
-#endif
+		Batches.FindOrAdd(TPair<UInstancedStaticMeshComponent*, UPhysXInstancedStaticMeshComponent*>(ISMC, Target)).Add(ID);
+	}
 
-	// Add new slot mapping AFTER Data points to the target slot.
-	AddSlotMapping(ID);
+	PendingRenderTierMigrations.RemoveAt(0, Budget, /*bAllowShrinking=*/false);
 
-	RebuildSlotMappingForComponent(StorageISMC_Base);
-	RebuildSlotMappingForComponent(TargetISMC);
+	int32 NumMoved = 0;
 
-#if PHYSICS_INTERFACE_PHYSX
-	// Queue for scene insertion AFTER rebinding.
-	EnqueueAddActorToScene(ID, TargetISMC);
-#endif
+	for (TPair<TPair<UInstancedStaticMeshComponent*, UPhysXInstancedStaticMeshComponent*>, TArray<FPhysXInstanceID>>& Pair : Batches)
+	{
+		UInstancedStaticMeshComponent*      FromISMC = Pair.Key.Key;
+		UPhysXInstancedStaticMeshComponent* ToISMC   = Pair.Key.Value;
 
-	StorageISMC_Base->MarkRenderStateDirty();
-	TargetISMC->MarkRenderStateDirty();
+		NumMoved += MigrateInstancesToComponent_Internal(FromISMC, ToISMC, Pair.Value);
 
-	// Optional: auto-destroy empty storage actors.
-	if (StorageActor != TargetActor &&
-		StorageActor->RegisteredInstanceIDs.Num() == 0 &&
-		StorageActor->InstancedMesh &&
-		StorageActor->InstancedMesh->GetInstanceCount() == 0)
-	{
-		if (StorageActor->PhysXActorID.IsValid())
+		const bool bToSleepingTier = ToISMC->bIsSleepingTier;
+
+		for (const FPhysXInstanceID& ID : Pair.Value)
 		{
-			UnregisterInstancedMeshActor(StorageActor->PhysXActorID);
+			FPhysXInstanceData* Data = Instances.Find(ID);
+			if (Data && Data->InstancedComponent.Get() == ToISMC)
+			{
+				Data->bInSleepingRenderTier = bToSleepingTier;
+			}
 		}
-		StorageActor->Destroy();
 	}
 
-	bConvertedSuccessfully = true;
-	return true;
+	SET_DWORD_STAT(STAT_PhysXInstanced_RenderTierMigrations, NumMoved);
+	SET_DWORD_STAT(STAT_PhysXInstanced_RenderTierPending,    PendingRenderTierMigrations.Num());
 }
 
-
-bool UPhysXInstancedWorldSubsystem::IsInstancePhysicsEnabled(FPhysXInstanceID ID) const
+int32 UPhysXInstancedWorldSubsystem::MigrateInstancesToComponent_Internal(
+	UInstancedStaticMeshComponent* FromISMC,
+	UInstancedStaticMeshComponent* ToISMC,
+	const TArray<FPhysXInstanceID>& IDs)
 {
-#if !PHYSICS_INTERFACE_PHYSX
-	return false;
-#else
-	const FPhysXInstanceData* Data = Instances.Find(ID);
-	if (!Data)
-	{
-		return false;
-	}
-
-	physx::PxRigidActor* Actor = Data->Body.GetPxActor();
-	physx::PxRigidDynamic* RigidDynamic = Actor ? Actor->is<physx::PxRigidDynamic>() : nullptr;
-	if (!RigidDynamic)
+	if (!FromISMC || !ToISMC || FromISMC == ToISMC || IDs.Num() == 0)
 	{
-		return false;
+		return 0;
 	}
 
-	const PxActorFlags Flags = RigidDynamic->getActorFlags();
-	const PxRigidBodyFlags BodyFlags = RigidDynamic->getRigidBodyFlags();
+	// ---------------------------------------------------------------------
+	// 1) Gather valid instances with their current world transforms
+	// ---------------------------------------------------------------------
 
-	const bool bSimDisabled = Flags.isSet(PxActorFlag::eDISABLE_SIMULATION);
-	const bool bKinematic   = BodyFlags.isSet(PxRigidBodyFlag::eKINEMATIC);
+	TArray<FPhysXInstanceData*> MovedData;
+	TArray<int32>               RemovedIndices;
+	TArray<FTransform>          LocalTransforms;
 
-	return !bSimDisabled && !bKinematic;
-#endif
-}
+	MovedData.Reserve(IDs.Num());
+	RemovedIndices.Reserve(IDs.Num());
+	LocalTransforms.Reserve(IDs.Num());
 
-bool UPhysXInstancedWorldSubsystem::AddImpulseToInstance(
-	FPhysXInstanceID ID,
-	FVector WorldImpulse,
-	bool bVelChange)
-{
-	// Backward-compatible wrapper: behave like AddRadialImpulse defaults.
-	return AddImpulseToInstanceAdvanced(
-		ID,
-		WorldImpulse,
-		bVelChange,
-		/*bIncludeStorage=*/true,
-		/*bConvertStorageToDynamic=*/true);
-}
+	const FTransform WorldToTarget = ToISMC->GetComponentTransform().Inverse();
 
-bool UPhysXInstancedWorldSubsystem::AddImpulseToInstanceAdvanced(
-	FPhysXInstanceID ID,
-	FVector WorldImpulse,
-	bool bVelChange,
-	bool bIncludeStorage,
-	bool bConvertStorageToDynamic)
-{
-	if (!Instances.Contains(ID))
+	for (const FPhysXInstanceID& ID : IDs)
 	{
-		return false;
-	}
-
-	FPhysXInstanceTask Task;
-	Task.Type = EPhysXInstanceTaskType::AddImpulse;
-	Task.ID = ID;
-	Task.Vector = WorldImpulse;
-	Task.bModeFlag = bVelChange;
-	Task.bIncludeStorage = bIncludeStorage;
-	Task.bConvertStorageToDynamic = bConvertStorageToDynamic;
-
-	EnqueueInstanceTask(Task);
-	return true; // queued
-}
+		FPhysXInstanceData* Data = Instances.Find(ID);
+		if (!Data || Data->InstancedComponent.Get() != FromISMC || Data->InstanceIndex == INDEX_NONE)
+		{
+			continue;
+		}
 
+		FTransform WorldTM;
+		if (!FromISMC->GetInstanceTransform(Data->InstanceIndex, WorldTM, /*bWorldSpace=*/true))
+		{
+			continue;
+		}
 
-bool UPhysXInstancedWorldSubsystem::AddRadialImpulse(
-	const FVector& OriginWorld,
-	float Radius,
-	float Strength,
-	bool bVelChange,
-	bool bIncludeStorage,
-	bool bConvertStorageToDynamic,
-	bool bLinearFalloff,
-	EPhysXInstancedQueryDebugMode DebugMode,
-	float DebugDrawDuration)
-{
-	if (Radius <= 0.0f || FMath::IsNearlyZero(Strength))
-	{
-		return false;
+		MovedData.Add(Data);
+		RemovedIndices.Add(Data->InstanceIndex);
+		LocalTransforms.Add(WorldTM * WorldToTarget);
 	}
 
-	UWorld* World = GetWorld();
-	if (!World)
+	const int32 NumMoved = MovedData.Num();
+	if (NumMoved == 0)
 	{
-		return false;
+		return 0;
 	}
 
-	const float RadiusSq = Radius * Radius;
+	// ---------------------------------------------------------------------
+	// 2) Append to the target component in one call, then copy custom data
+	// ---------------------------------------------------------------------
 
-	struct FRadialImpulseTarget
+	const TArray<int32> NewIndices = ToISMC->AddInstances(LocalTransforms, /*bShouldReturnIndices=*/true);
+	if (NewIndices.Num() != NumMoved)
 	{
-		FPhysXInstanceID ID;
-		FVector          PositionUU = FVector::ZeroVector;
-		FVector          ImpulseUU  = FVector::ZeroVector;
-	};
+		UE_LOG(LogTemp, Warning,
+			TEXT("[PhysXInstanced] MigrateInstancesToComponent: AddInstances failed on %s (%d/%d)."),
+			*GetNameSafe(ToISMC), NewIndices.Num(), NumMoved);
 
-	TArray<FRadialImpulseTarget> Targets;
-	Targets.Reserve(128);
+		RebuildSlotMappingForComponent(ToISMC);
+		return 0;
+	}
 
-	// 1) Collect targets and compute per-instance impulse (distance-based).
-	for (const TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
+	const int32 NumCustomFloats = FMath::Min(FromISMC->NumCustomDataFloats, ToISMC->NumCustomDataFloats);
+	if (NumCustomFloats > 0)
 	{
-		const FPhysXInstanceID& ID = Pair.Key;
-		const FPhysXInstanceData& Data = Pair.Value;
+		TArray<float> CustomData;
+		CustomData.SetNumUninitialized(NumCustomFloats);
 
-		if (!ID.IsValid())
+		for (int32 i = 0; i < NumMoved; ++i)
 		{
-			continue;
+			const int32 Offset = RemovedIndices[i] * FromISMC->NumCustomDataFloats;
+			if (!FromISMC->PerInstanceSMCustomData.IsValidIndex(Offset + NumCustomFloats - 1))
+			{
+				continue;
+			}
+
+			FMemory::Memcpy(CustomData.GetData(), &FromISMC->PerInstanceSMCustomData[Offset], NumCustomFloats * sizeof(float));
+			ToISMC->SetCustomData(NewIndices[i], CustomData, /*bMarkRenderStateDirty=*/false);
 		}
+	}
 
-		UInstancedStaticMeshComponent* ISMC = Data.InstancedComponent.Get();
-		if (!ISMC || !ISMC->IsValidLowLevelFast() || Data.InstanceIndex == INDEX_NONE)
+	// Rebind moved IDs before touching the source so the index fix-up below skips them.
+	for (int32 i = 0; i < NumMoved; ++i)
+	{
+		MovedData[i]->InstancedComponent = ToISMC;
+		MovedData[i]->InstanceIndex      = NewIndices[i];
+	}
+
+	// ---------------------------------------------------------------------
+	// 3) Remove from the source component and fix indices of the remaining IDs
+	// ---------------------------------------------------------------------
+
+	RemovedIndices.Sort();
+
+	if (UsesRemoveAtSwap(FromISMC))
+	{
+		// Swap removal moves the last element into the removed slot, so go back to front.
+		TMap<int32, FPhysXInstanceData*> DataByIndex;
+		for (TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
 		{
-			continue;
+			if (Pair.Value.InstancedComponent.Get() == FromISMC && Pair.Value.InstanceIndex != INDEX_NONE)
+			{
+				DataByIndex.Add(Pair.Value.InstanceIndex, &Pair.Value);
+			}
 		}
 
-		const bool bIsStorageOwner = IsOwnerStorageActor(ISMC);
-
-		if (bIsStorageOwner)
+		for (int32 i = RemovedIndices.Num() - 1; i >= 0; --i)
 		{
-			if (!bIncludeStorage)
+			const int32 RemovedIndex = RemovedIndices[i];
+			const int32 OldLastIndex = FromISMC->GetInstanceCount() - 1;
+
+			if (!FromISMC->RemoveInstance(RemovedIndex))
 			{
 				continue;
 			}
 
-			// Cannot apply impulses to storage unless we are allowed to convert it to dynamic.
-			if (!bConvertStorageToDynamic)
+			if (OldLastIndex != RemovedIndex)
 			{
-				continue;
+				if (FPhysXInstanceData* Moved = DataByIndex.FindRef(OldLastIndex))
+				{
+					Moved->InstanceIndex = RemovedIndex;
+					DataByIndex.Remove(OldLastIndex);
+					DataByIndex.Add(RemovedIndex, Moved);
+				}
 			}
 		}
+	}
+	else
+	{
+		FromISMC->RemoveInstances(RemovedIndices);
 
-		// Validate index range to avoid stale IDs returning nonsense.
-		const int32 NumInstances = ISMC->GetInstanceCount();
-		if (Data.InstanceIndex < 0 || Data.InstanceIndex >= NumInstances)
+		// RemoveAt compaction: each index shifts down by the number of removed slots below it.
+		for (TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
 		{
-			continue;
-		}
+			FPhysXInstanceData& OtherData = Pair.Value;
 
-		FVector InstanceLoc = FVector::ZeroVector;
-		if (!GetInstanceWorldLocation_Safe(Data, InstanceLoc))
-		{
-			continue;
-		}
+			if (OtherData.InstancedComponent.Get() != FromISMC || OtherData.InstanceIndex == INDEX_NONE)
+			{
+				continue;
+			}
 
-		const float DistSq = FVector::DistSquared(OriginWorld, InstanceLoc);
-		if (DistSq > RadiusSq)
-		{
-			continue;
+			OtherData.InstanceIndex -= Algo::LowerBound(RemovedIndices, OtherData.InstanceIndex);
 		}
+	}
 
-		FVector Dir = (InstanceLoc - OriginWorld);
-		const float Dist = Dir.Size();
-		if (Dist <= KINDA_SMALL_NUMBER)
-		{
-			continue;
-		}
+	RebuildSlotMappingForComponent(FromISMC);
+	RebuildSlotMappingForComponent(ToISMC);
 
-		float Falloff = 1.0f;
-		if (bLinearFalloff)
-		{
-			Falloff = 1.0f - (Dist / Radius);
-			Falloff = FMath::Clamp(Falloff, 0.0f, 1.0f);
-		}
+	FromISMC->MarkRenderStateDirty();
+	ToISMC->MarkRenderStateDirty();
 
-		const FVector ImpulseUU = Dir.GetSafeNormal() * (Strength * Falloff);
+	return NumMoved;
+}
 
-		FRadialImpulseTarget& T = Targets.AddDefaulted_GetRef();
-		T.ID         = ID;
-		T.PositionUU = InstanceLoc;
-		T.ImpulseUU  = ImpulseUU;
-	}
+bool UPhysXInstancedWorldSubsystem::RemoveInstanceByID(FPhysXInstanceID ID, bool bRemoveVisualInstance)
+{
+	return RemoveInstanceByID_Internal(ID, bRemoveVisualInstance, EPhysXInstanceRemoveReason::Explicit);
+}
 
-	if (Targets.Num() == 0)
+bool UPhysXInstancedWorldSubsystem::RemoveInstanceByID_Internal(
+	FPhysXInstanceID ID,
+	bool bRemoveVisualInstance,
+	EPhysXInstanceRemoveReason Reason)
+{
+	FPhysXInstanceData* Data = Instances.Find(ID);
+	if (!Data)
 	{
 		return false;
 	}
 
-#if !PHYSICS_INTERFACE_PHYSX
-	return false;
-#else
+	UInstancedStaticMeshComponent* ISMC = Data->InstancedComponent.Get();
+	int32 InstanceIndex = Data->InstanceIndex;
+	const bool bWasSimulating = Data->bSimulating;
 
-	bool bAppliedAny = false; // now means "queued at least one impulse task"
+	APhysXInstancedMeshActor* OwnerActor =
+		ISMC ? Cast<APhysXInstancedMeshActor>(ISMC->GetOwner()) : nullptr;
 
-	// 2) Queue per-instance impulse tasks (conversion/body creation handled inside tasks).
-	for (const FRadialImpulseTarget& T : Targets)
-	{
-		const bool bQueued = AddImpulseToInstanceAdvanced(
-			T.ID,
-			T.ImpulseUU,
-			bVelChange,
-			bIncludeStorage,
-			bConvertStorageToDynamic);
+	const bool bFirePre =
+		IsEventEnabled(OwnerActor, EPhysXInstanceEventFlags::PreRemove) &&
+		(OwnerActor->OnInstancePreRemove.IsBound() || HasInterfaceEvents(OwnerActor));
+
+	const bool bFirePost =
+		IsEventEnabled(OwnerActor, EPhysXInstanceEventFlags::PostRemove) &&
+		(OwnerActor->OnInstancePostRemove.IsBound() || HasInterfaceEvents(OwnerActor));
 
-		bAppliedAny |= bQueued;
+	FTransform SnapshotTM = FTransform::Identity;
+	if (bFirePre || bFirePost)
+	{
+		GetInstanceWorldTransform_Safe(*Data, SnapshotTM);
 	}
 
-#if ENABLE_DRAW_DEBUG
-	if (bAppliedAny && DebugMode != EPhysXInstancedQueryDebugMode::None)
+	if (bFirePre)
 	{
-		DrawSphereSafe(World, OriginWorld, Radius, FColor::Green, DebugDrawDuration, 1.5f);
+		OwnerActor->OnInstancePreRemove.Broadcast(ID, Reason, SnapshotTM);
 
-		if (DebugMode == EPhysXInstancedQueryDebugMode::Detailed)
+		if (HasInterfaceEvents(OwnerActor))
 		{
-			const int32 MaxArrows = 64;
-			const int32 NumToDraw = FMath::Min(Targets.Num(), MaxArrows);
+			IPhysXInstanceEvents::Execute_OnInstancePreRemove(OwnerActor, ID, Reason, SnapshotTM);
+		}
+	}
 
-			for (int32 i = 0; i < NumToDraw; ++i)
-			{
-				const FRadialImpulseTarget& D = Targets[i];
-				DrawArrowSafe(World, OriginWorld, D.PositionUU, FColor::Cyan, DebugDrawDuration, 1.5f);
-				DrawTextSafe(World, D.PositionUU + FVector(0, 0, 10.0f),
-					FString::Printf(TEXT("ID=%u"), D.ID.GetUniqueID()),
-					FColor::White, DebugDrawDuration);
-			}
+	bool bOwnerIsStorageActor = false;
+	if (OwnerActor)
+	{
+		bOwnerIsStorageActor = (OwnerActor->bIsStorageActor || OwnerActor->bStorageOnly);
+		OwnerActor->RegisteredInstanceIDs.Remove(ID);
+	}
 
-			if (Targets.Num() > MaxArrows)
-			{
-				DrawTextSafe(World,
-					OriginWorld + FVector(0, 0, 20.0f),
-					FString::Printf(TEXT("RadialImpulse: %d hits (showing %d)"), Targets.Num(), MaxArrows),
-					FColor::White,
-					DebugDrawDuration);
-			}
-		}
+	// -----------------------------
+	// PhysX cleanup first (if any)
+	// -----------------------------
+#if PHYSICS_INTERFACE_PHYSX
+	DestroyInstanceBody(ID, *Data);
+#endif
+
+	InvalidatePendingAddEntries(ID);
+
+	// Remove slot mapping even if indices were already corrupted.
+	RemoveSlotMapping(ID);
+
+	// Update counters before removing the record.
+	if (NumBodiesTotal > 0)
+	{
+		--NumBodiesTotal;
 	}
-	else if (!bAppliedAny && DebugMode != EPhysXInstancedQueryDebugMode::None)
+	if (bWasSimulating && NumBodiesSimulating > 0)
 	{
-		DrawSphereSafe(World, OriginWorld, Radius, FColor::Red, DebugDrawDuration, 1.5f);
+		--NumBodiesSimulating;
 	}
-#endif // ENABLE_DRAW_DEBUG
 
-	return bAppliedAny;
-#endif // PHYSICS_INTERFACE_PHYSX
-}
+	auto FirePost = [&](bool bSuccess)
+	{
+		if (!bFirePost)
+		{
+			return;
+		}
 
-bool UPhysXInstancedWorldSubsystem::AddForceToInstance(
-	FPhysXInstanceID ID,
-	FVector WorldForce,
-	bool bAccelChange)
-{
-	// Backward-compatible wrapper: behave like AddRadialImpulse defaults.
-	return AddForceToInstanceAdvanced(
-		ID,
-		WorldForce,
-		bAccelChange,
-		/*bIncludeStorage=*/true,
-		/*bConvertStorageToDynamic=*/true);
-}
+		OwnerActor->OnInstancePostRemove.Broadcast(ID, Reason, SnapshotTM);
 
-bool UPhysXInstancedWorldSubsystem::AddForceToInstanceAdvanced(
-	FPhysXInstanceID ID,
-	FVector WorldForce,
-	bool bAccelChange,
-	bool bIncludeStorage,
-	bool bConvertStorageToDynamic)
-{
-	if (!Instances.Contains(ID))
+		if (HasInterfaceEvents(OwnerActor))
+		{
+			IPhysXInstanceEvents::Execute_OnInstancePostRemove(OwnerActor, ID, Reason, SnapshotTM);
+		}
+	};
+
+	// If we do not need to remove the visual instance, we can drop the record now.
+	if (!bRemoveVisualInstance)
+	{
+		Instances.Remove(ID);
+		FirePost(/*bSuccess=*/true);
+		return true;
+	}
+
+	if (!ISMC || !ISMC->IsValidLowLevelFast() || InstanceIndex == INDEX_NONE)
 	{
+		Instances.Remove(ID);
+		FirePost(/*bSuccess=*/false);
 		return false;
 	}
 
-	FPhysXInstanceTask Task;
-	Task.Type = EPhysXInstanceTaskType::AddForce;
-	Task.ID = ID;
-	Task.Vector = WorldForce;
-	Task.bModeFlag = bAccelChange;
-	Task.bIncludeStorage = bIncludeStorage;
-	Task.bConvertStorageToDynamic = bConvertStorageToDynamic;
+	// -----------------------------
+	// Validate / resolve the slot
+	// -----------------------------
+	const int32 NumBefore = ISMC->GetInstanceCount();
+	if (InstanceIndex < 0 || InstanceIndex >= NumBefore ||
+		InstanceIDBySlot.FindRef(FPhysXInstanceSlotKey(ISMC, InstanceIndex)) != ID)
+	{
+		// Rebuild mapping and try to resolve ID -> current index.
+		RebuildSlotMappingForComponent(ISMC);
 
-	EnqueueInstanceTask(Task);
-	return true; // queued
-}
+		int32 ResolvedIndex = INDEX_NONE;
+		for (const TPair<FPhysXInstanceSlotKey, FPhysXInstanceID>& SlotPair : InstanceIDBySlot)
+		{
+			if (SlotPair.Value == ID && SlotPair.Key.Component.Get() == ISMC)
+			{
+				ResolvedIndex = SlotPair.Key.InstanceIndex;
+				break;
+			}
+		}
 
+		if (ResolvedIndex == INDEX_NONE || ResolvedIndex < 0 || ResolvedIndex >= ISMC->GetInstanceCount())
+		{
+			UE_LOG(LogTemp, Warning,
+				TEXT("[PhysXInstanced] RemoveInstanceByID: failed to resolve slot for ID=%u (ISMC=%s). Removing record only."),
+				ID.GetUniqueID(), *GetNameSafe(ISMC));
 
-bool UPhysXInstancedWorldSubsystem::PutInstanceToSleep(FPhysXInstanceID ID)
-{
-	return PutInstanceToSleepAdvanced(
-		ID,
-		/*bIncludeStorage=*/true,
-		/*bConvertStorageToDynamic=*/true);
-}
+			Instances.Remove(ID);
+			FirePost(/*bSuccess=*/false);
+			return false;
+		}
 
-bool UPhysXInstancedWorldSubsystem::WakeInstanceUp(FPhysXInstanceID ID)
-{
-	return WakeInstanceUpAdvanced(
-		ID,
-		/*bIncludeStorage=*/true,
-		/*bConvertStorageToDynamic=*/true);
-}
+		InstanceIndex = ResolvedIndex;
+	}
 
-bool UPhysXInstancedWorldSubsystem::PutInstanceToSleepAdvanced(
-	FPhysXInstanceID ID,
-	bool bIncludeStorage,
-	bool bConvertStorageToDynamic)
-{
-	if (!Instances.Contains(ID))
+	const int32 OldLastIndex = ISMC->GetInstanceCount() - 1;
+
+	// Drop the record BEFORE mutating indices of others.
+	Instances.Remove(ID);
+
+	const bool bRemoved = ISMC->RemoveInstance(InstanceIndex);
+	if (!bRemoved)
 	{
+		UE_LOG(LogTemp, Warning,
+			TEXT("[PhysXInstanced] RemoveInstanceByID: RemoveInstance failed for ISMC=%s, Index=%d"),
+			*GetNameSafe(ISMC), InstanceIndex);
+
+		RebuildSlotMappingForComponent(ISMC);
+		FirePost(/*bSuccess=*/false);
 		return false;
 	}
 
-	FPhysXInstanceTask Task;
-	Task.Type = EPhysXInstanceTaskType::PutToSleep;
-	Task.ID = ID;
-	Task.bIncludeStorage = bIncludeStorage;
-	Task.bConvertStorageToDynamic = bConvertStorageToDynamic;
+	// RemoveAt compaction shifts indices after the removed one by -1;
+	// swap removal (HISM, UE5 bSupportRemoveAtSwap) moves the last element into the removed slot.
+	FixInstanceIndicesAfterRemoval(ISMC, InstanceIndex, OldLastIndex);
+
+	RebuildSlotMappingForComponent(ISMC);
+	ISMC->MarkRenderStateDirty();
+	NotifyStorageInstancesChanged(ISMC, 1);
+
+	FirePost(/*bSuccess=*/true);
+
+	// Optional: auto-destroy empty storage actors to avoid accumulating dead containers.
+	if (bOwnerIsStorageActor && OwnerActor && OwnerActor->InstancedMesh)
+	{
+		if (OwnerActor->RegisteredInstanceIDs.Num() == 0 && OwnerActor->GetInstanceCount() == 0)
+		{
+			if (OwnerActor->PhysXActorID.IsValid())
+			{
+				UnregisterInstancedMeshActor(OwnerActor->PhysXActorID);
+			}
+			OwnerActor->Destroy();
+		}
+	}
 
-	EnqueueInstanceTask(Task);
 	return true;
 }
 
-bool UPhysXInstancedWorldSubsystem::WakeInstanceUpAdvanced(
+void UPhysXInstancedWorldSubsystem::EnqueueAddActorToScene(
 	FPhysXInstanceID ID,
-	bool bIncludeStorage,
-	bool bConvertStorageToDynamic)
+	UInstancedStaticMeshComponent* InstancedMesh,
+	int32 Priority)
 {
-	if (!Instances.Contains(ID))
+	if (!ID.IsValid() || !InstancedMesh)
 	{
-		return false;
+		return;
 	}
 
-	FPhysXInstanceTask Task;
-	Task.Type = EPhysXInstanceTaskType::WakeUp;
-	Task.ID = ID;
-	Task.bIncludeStorage = bIncludeStorage;
-	Task.bConvertStorageToDynamic = bConvertStorageToDynamic;
+	FPendingAddActorEntry Entry;
+	Entry.ID = ID;
+	Entry.InstancedComponent = InstancedMesh;
+	Entry.World = InstancedMesh->GetWorld(); // cache once per entry
+	Entry.Priority = Priority;
+	Entry.Sequence = NextPendingAddSequence++;
 
-	EnqueueInstanceTask(Task);
-	return true;
-}
+	FTransform InstanceTM;
+	const FPhysXInstanceData* Data = Instances.Find(ID);
+	Entry.Location = (Data && InstancedMesh->GetInstanceTransform(Data->InstanceIndex, InstanceTM, /*bWorldSpace=*/true))
+		? InstanceTM.GetLocation()
+		: InstancedMesh->GetComponentLocation();
 
+	Entry.DistSq          = GetDistSqToNearestRelevancePoint(Entry.Location);
+	Entry.RefreshedDistSq = Entry.DistSq;
+	Entry.RefreshPass     = PendingAddRefreshPass;
 
-// ============================================================================
-// Per-instance physics properties
-// ============================================================================
+	PendingAddActors.HeapPush(Entry, FPendingAddActorPred());
 
-bool UPhysXInstancedWorldSubsystem::SetInstanceGravityEnabled(FPhysXInstanceID ID, bool bEnable)
-{
-	FPhysXInstanceData* Data = Instances.Find(ID);
-	if (!Data)
+	// Bodies built around a collision mesh that is still cooking get their real shape later.
+	if (Data && Data->Body.bUsesProxyShape)
 	{
-		return false;
+		ProxyShapeInstances.AddUnique(ID);
 	}
+}
 
-#if !PHYSICS_INTERFACE_PHYSX
-	return false;
-#else
-	physx::PxRigidActor* Actor = Data->Body.GetPxActor();
-	physx::PxRigidDynamic* RigidDynamic =
-		Actor ? Actor->is<physx::PxRigidDynamic>() : nullptr;
-
-	if (!RigidDynamic)
+float UPhysXInstancedWorldSubsystem::GetDistSqToNearestRelevancePoint(const FVector& Location) const
+{
+	if (ActiveRelevancePoints.Num() == 0)
 	{
-		return false;
+		return 0.0f;
 	}
 
-	// DISABLE_GRAVITY disables gravity when true, so it is inverted relative to bEnable.
-	RigidDynamic->setActorFlag(physx::PxActorFlag::eDISABLE_GRAVITY, !bEnable);
-	return true;
-#endif
+	float BestDistSq = MAX_flt;
+	for (const FVector& Point : ActiveRelevancePoints)
+	{
+		BestDistSq = FMath::Min(BestDistSq, FVector::DistSquared(Point, Location));
+	}
+	return BestDistSq;
 }
 
-bool UPhysXInstancedWorldSubsystem::IsInstanceGravityEnabled(FPhysXInstanceID ID) const
+void UPhysXInstancedWorldSubsystem::RefreshPendingAddPriorities(UWorld* World)
 {
-#if !PHYSICS_INTERFACE_PHYSX
-	return false;
-#else
-	const FPhysXInstanceData* Data = Instances.Find(ID);
-	if (!Data)
+	ActiveRelevancePoints.Reset();
+
+	if (InsertionRelevancePoints.Num() > 0)
 	{
-		return false;
+		ActiveRelevancePoints.Append(InsertionRelevancePoints);
+	}
+	else
+	{
+		for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+		{
+			const APlayerController* PlayerController = It->Get();
+			if (PlayerController && PlayerController->IsLocalController())
+			{
+				FVector  ViewLocation;
+				FRotator ViewRotation;
+				PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+				ActiveRelevancePoints.Add(ViewLocation);
+			}
+		}
 	}
 
-	physx::PxRigidActor* Actor = Data->Body.GetPxActor();
-	physx::PxRigidDynamic* RigidDynamic =
-		Actor ? Actor->is<physx::PxRigidDynamic>() : nullptr;
-
-	if (!RigidDynamic)
+	// Without relevance points (e.g. dedicated server) the queue is ordered by priority, then FIFO.
+	if (ActiveRelevancePoints.Num() == 0 || PendingAddPriorityRefreshPerFrame <= 0)
 	{
-		return false;
+		return;
 	}
 
-	const physx::PxActorFlags Flags = RigidDynamic->getActorFlags();
-	return !Flags.isSet(physx::PxActorFlag::eDISABLE_GRAVITY);
-#endif
+	// Re-evaluate a slice per frame. Heap keys change only when a full pass completes,
+	// so the heap stays valid in between and the O(n) reorder is amortized over the pass.
+	// Pops and pushes between slices reorder the array under the cursor, so entries are
+	// stamped with the pass instead of trusting their position: none is refreshed twice,
+	// and the ones moved behind the cursor are caught up when the pass is published.
+	const int32 NumToRefresh = FMath::Min(PendingAddPriorityRefreshPerFrame, PendingAddActors.Num());
+
+	for (int32 Step = 0; Step < NumToRefresh; ++Step)
+	{
+		if (PendingAddRefreshCursor >= PendingAddActors.Num())
+		{
+			for (FPendingAddActorEntry& Entry : PendingAddActors)
+			{
+				if (Entry.RefreshPass != PendingAddRefreshPass)
+				{
+					Entry.RefreshedDistSq = GetDistSqToNearestRelevancePoint(Entry.Location);
+				}
+				Entry.DistSq = Entry.RefreshedDistSq;
+			}
+
+			PendingAddActors.Heapify(FPendingAddActorPred());
+			PendingAddRefreshCursor = 0;
+			++PendingAddRefreshPass;
+		}
+
+		FPendingAddActorEntry& Entry = PendingAddActors[PendingAddRefreshCursor++];
+		if (Entry.RefreshPass == PendingAddRefreshPass)
+		{
+			continue;
+		}
+
+		Entry.RefreshedDistSq = GetDistSqToNearestRelevancePoint(Entry.Location);
+		Entry.RefreshPass     = PendingAddRefreshPass;
+	}
 }
 
-bool UPhysXInstancedWorldSubsystem::SetInstanceLinearVelocity(
-	FPhysXInstanceID ID,
-	FVector NewVelocity,
-	bool bAutoWake)
+void UPhysXInstancedWorldSubsystem::ProcessPendingAddActors()
 {
-	FPhysXInstanceData* Data = Instances.Find(ID);
-	if (!Data)
+	const int32 NumPending = PendingAddActors.Num();
+	if (NumPending <= 0)
 	{
-		return false;
+		PendingAddRefreshCursor = 0;
+		return;
 	}
 
-#if !PHYSICS_INTERFACE_PHYSX
-	return false;
-#else
-	physx::PxRigidActor* Actor = Data->Body.GetPxActor();
-	physx::PxRigidDynamic* RigidDynamic =
-		Actor ? Actor->is<physx::PxRigidDynamic>() : nullptr;
+	UWorld* World = CachedWorld.Get();
+	if (!World)
+	{
+		World = GetWorld();
+		if (World)
+		{
+			CachedWorld = World;
+		}
+	}
+	if (!World)
+	{
+		return;
+	}
 
-	if (!RigidDynamic)
+	PxScene* Scene = GetPhysXSceneFromWorld(World);
+	if (!Scene)
 	{
-		return false;
+		return;
 	}
 
-	const physx::PxVec3 PxVel = U2PVector(NewVelocity);
-	RigidDynamic->setLinearVelocity(PxVel, bAutoWake);
-	return true;
-#endif
-}
+	RefreshPendingAddPriorities(World);
 
-bool UPhysXInstancedWorldSubsystem::GetInstanceLinearVelocity(
-	FPhysXInstanceID ID,
-	FVector& OutVelocity) const
-{
-	OutVelocity = FVector::ZeroVector;
+	int32 Budget = MaxAddActorsPerFrame;
+	Budget = (Budget <= 0) ? NumPending : FMath::Min(Budget, NumPending);
 
-#if !PHYSICS_INTERFACE_PHYSX
-	return false;
-#else
-	const FPhysXInstanceData* Data = Instances.Find(ID);
-	if (!Data)
+	// Actors are configured out of scene and inserted in one call after the loop.
+	PendingAddBatch.Reset();
+	PendingAddWakeUps.Reset();
+
+	// The budget goes to the most relevant bodies; far ones stay out of scene as visual-only instances.
+	FPendingAddActorEntry Entry;
+
+	for (int32 Popped = 0; Popped < Budget && PendingAddActors.Num() > 0; ++Popped)
 	{
-		return false;
+		PendingAddActors.HeapPop(Entry, FPendingAddActorPred(), /*bAllowShrinking=*/false);
+
+		if (!Entry.ID.IsValid())
+		{
+			continue;
+		}
+
+		UInstancedStaticMeshComponent* ISMC = Entry.InstancedComponent.Get();
+		if (!ISMC || !ISMC->IsValidLowLevelFast())
+		{
+			continue;
+		}
+
+		UWorld* EntryWorld = Entry.World.Get();
+		if (!EntryWorld || EntryWorld != World)
+		{
+			continue;
+		}
+
+		FPhysXInstanceData* Data = Instances.Find(Entry.ID);
+		if (!Data)
+		{
+			continue; // stale entry
+		}
+
+		// IMPORTANT(PXIS_DEFERRED_ADD):
+		// Body might have been destroyed/replaced after enqueue but before processing.
+		physx::PxRigidActor* PxActor = Data->Body.GetPxActor();
+		if (!PxActor)
+		{
+			continue;
+		}
+
+		// Already in some scene – nothing to do.
+		if (PxActor->getScene())
+		{
+			continue;
+		}
+
+		// Ensure userData is correct before the actor becomes visible to queries.
+		EnsureInstanceUserData(Entry.ID);
+
+		// Force-start simulation for instances that were registered as simulating.
+		// This fixes Manual/Grid bodies that may enter the scene sleeping and never wake.
+		if (Data->bSimulating)
+		{
+			if (physx::PxRigidDynamic* RD = PxActor->is<physx::PxRigidDynamic>())
+			{
+				RD->setActorFlag(physx::PxActorFlag::eDISABLE_SIMULATION, false);
+				RD->setRigidBodyFlag(physx::PxRigidBodyFlag::eKINEMATIC, false);
+
+				// wakeUp() is only valid once the actor is in a scene.
+				PendingAddWakeUps.Add(RD);
+			}
+		}
+
+		PendingAddBatch.Add(PxActor);
 	}
 
-	physx::PxRigidActor* Actor = Data->Body.GetPxActor();
-	physx::PxRigidDynamic* RigidDynamic =
-		Actor ? Actor->is<physx::PxRigidDynamic>() : nullptr;
+	AddActorsToSceneBatched(*Scene, PendingAddBatch);
 
-	if (!RigidDynamic)
+	for (physx::PxRigidDynamic* RD : PendingAddWakeUps)
 	{
-		return false;
+		RD->wakeUp();
 	}
 
-	const physx::PxVec3 PxVel = RigidDynamic->getLinearVelocity();
-	OutVelocity = P2UVector(PxVel);
-	return true;
-#endif
+	PendingAddBatch.Reset();
+	PendingAddWakeUps.Reset();
 }
 
-bool UPhysXInstancedWorldSubsystem::SetInstanceAngularVelocityInRadians(
-	FPhysXInstanceID ID,
-	FVector NewAngVelRad,
-	bool bAutoWake)
+
+void UPhysXInstancedWorldSubsystem::AddActorsToSceneBatched(PxScene& Scene, const TArray<PxRigidActor*>& Batch)
 {
-	FPhysXInstanceData* Data = Instances.Find(ID);
-	if (!Data)
+	if (Batch.Num() == 0)
 	{
-		return false;
+		return;
 	}
 
-#if !PHYSICS_INTERFACE_PHYSX
-	return false;
-#else
-	physx::PxRigidActor* Actor = Data->Body.GetPxActor();
-	physx::PxRigidDynamic* RigidDynamic =
-		Actor ? Actor->is<physx::PxRigidDynamic>() : nullptr;
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_SceneAddBatch);
+	INC_DWORD_STAT_BY(STAT_PhysXInstanced_SceneAddedActors, Batch.Num());
 
-	if (!RigidDynamic)
+	// Large batches: precompute the scene-query tree once and merge it instead of inserting actor by actor.
+	if (bUsePruningStructureForSceneAdds && GPhysXSDK && Batch.Num() >= PruningStructureMinBatchSize)
 	{
-		return false;
+		if (PxPruningStructure* Pruning = GPhysXSDK->createPruningStructure(Batch.GetData(), (PxU32)Batch.Num()))
+		{
+			Scene.addActors(*Pruning);
+			Pruning->release();
+			return;
+		}
 	}
 
-	const physx::PxVec3 PxOmega = U2PVector(NewAngVelRad);
-	RigidDynamic->setAngularVelocity(PxOmega, bAutoWake);
-	return true;
-#endif
+	// PxRigidActor derives from PxActor, so the array can be passed as is.
+	Scene.addActors(reinterpret_cast<PxActor* const*>(Batch.GetData()), (PxU32)Batch.Num());
 }
 
-bool UPhysXInstancedWorldSubsystem::GetInstanceAngularVelocityInRadians(
-	FPhysXInstanceID ID,
-	FVector& OutAngVelRad) const
+int32 UPhysXInstancedWorldSubsystem::GetMaxAddActorsPerFrame() const
 {
-	OutAngVelRad = FVector::ZeroVector;
+	return MaxAddActorsPerFrame;
+}
 
-#if !PHYSICS_INTERFACE_PHYSX
-	return false;
-#else
-	const FPhysXInstanceData* Data = Instances.Find(ID);
-	if (!Data)
-	{
-		return false;
-	}
+void UPhysXInstancedWorldSubsystem::SetMaxAddActorsPerFrame(int32 NewMax)
+{
+	MaxAddActorsPerFrame = FMath::Max(0, NewMax);
+}
 
-	physx::PxRigidActor* Actor = Data->Body.GetPxActor();
-	physx::PxRigidDynamic* RigidDynamic =
-		Actor ? Actor->is<physx::PxRigidDynamic>() : nullptr;
+void UPhysXInstancedWorldSubsystem::SetSceneInsertionRelevancePoints(const TArray<FVector>& Points)
+{
+	InsertionRelevancePoints = Points;
+}
 
-	if (!RigidDynamic)
+int32 UPhysXInstancedWorldSubsystem::WarmUpBodyPool(APhysXInstancedMeshActor* Actor, int32 Count, bool bSimulate, FVector InstanceScale)
+{
+#if PHYSICS_INTERFACE_PHYSX
+	if (!Actor || !Actor->InstancedMesh || Count <= 0 || !GInstancedDefaultMaterial)
 	{
-		return false;
+		return 0;
 	}
 
-	const physx::PxVec3 PxOmega = RigidDynamic->getAngularVelocity();
-	OutAngVelRad = P2UVector(PxOmega);
-	return true;
-#endif
-}
-
-// ============================================================================
-// Query helpers / actor registry
-// ============================================================================
+	UInstancedStaticMeshComponent* ISMC = Actor->InstancedMesh;
 
-bool UPhysXInstancedWorldSubsystem::IsInstanceValid(FPhysXInstanceID ID) const
-{
-	const FPhysXInstanceData* Data = Instances.Find(ID);
-	if (!Data)
+	// Shared shapes are keyed by quantized scale, so warm for the scale spawns will actually use.
+	FTransform RepresentativeTM = FTransform::Identity;
+	if (ISMC->GetInstanceCount() > 0)
 	{
-		return false;
+		ISMC->GetInstanceTransform(0, RepresentativeTM, /*bWorldSpace=*/false);
+		RepresentativeTM.SetLocation(FVector::ZeroVector);
+	}
+	if (!InstanceScale.IsZero())
+	{
+		RepresentativeTM.SetScale3D(InstanceScale);
 	}
 
-	UInstancedStaticMeshComponent* ISMC = Data->InstancedComponent.Get();
-	if (!ISMC || !ISMC->IsValidLowLevelFast())
+	// Same branch as CreateInstanceBody: archetype bodies are template clones and never come from the pool.
+	if (Actor->InstanceArchetype)
 	{
-		return false;
+		FindOrBakeArchetypeTemplate(*Actor->InstanceArchetype, ISMC, INDEX_NONE, &RepresentativeTM);
+		return 0;
 	}
 
-	if (Data->InstanceIndex == INDEX_NONE)
+	FPhysXInstancedShapeCache* Cache = GetShapeCacheForNewBodies();
+	if (!Cache || MaxPooledBodiesPerArchetype <= 0)
 	{
-		return false;
+		return 0;
 	}
 
-	const int32 NumInstances = ISMC->GetInstanceCount();
-	return (Data->InstanceIndex >= 0 && Data->InstanceIndex < NumInstances);
-}
+	const int32 NumPooledBefore = Cache->NumPooledActors();
 
-bool UPhysXInstancedWorldSubsystem::GetInstanceInfo(
-	FPhysXInstanceID ID,
-	UInstancedStaticMeshComponent*& OutComponent,
-	int32& OutInstanceIndex) const
-{
-	OutComponent     = nullptr;
-	OutInstanceIndex = INDEX_NONE;
+	// All bodies are built first: destroying one before the next is created would just reuse it.
+	TArray<FPhysXInstanceBody> WarmBodies;
+	WarmBodies.SetNum(FMath::Min(Count, MaxPooledBodiesPerArchetype));
 
-	const FPhysXInstanceData* Data = Instances.Find(ID);
-	if (!Data)
+	for (FPhysXInstanceBody& Body : WarmBodies)
 	{
-		return false;
+		// Built on InstancedMesh: its filter data matches every render chunk of the actor.
+		Body.CreateFromInstancedStaticMesh(
+			ISMC,
+			/*InstanceIndex=*/INDEX_NONE,
+			bSimulate,
+			GInstancedDefaultMaterial,
+			Actor->GetEffectiveShapeType(),
+			Actor->GetEffectiveCollisionMesh(),
+			Cache,
+			&RepresentativeTM);
 	}
 
-	UInstancedStaticMeshComponent* ISMC = Data->InstancedComponent.Get();
-	if (!ISMC || !ISMC->IsValidLowLevelFast() || Data->InstanceIndex == INDEX_NONE)
+	for (FPhysXInstanceBody& Body : WarmBodies)
 	{
-		return false;
+		Body.Destroy();
 	}
 
-	const int32 NumInstances = ISMC->GetInstanceCount();
-	if (Data->InstanceIndex < 0 || Data->InstanceIndex >= NumInstances)
-	{
-		return false;
-	}
-	
-	OutComponent     = ISMC;
-	OutInstanceIndex = Data->InstanceIndex;
-	return true;
+	return FMath::Max(0, Cache->NumPooledActors() - NumPooledBefore);
+#else
+	return 0;
+#endif
 }
 
-TArray<FPhysXInstanceID> UPhysXInstancedWorldSubsystem::GetAllInstanceIDs() const
+int32 UPhysXInstancedWorldSubsystem::GetNumPooledBodies() const
 {
-	TArray<FPhysXInstanceID> Result;
-	Result.Reserve(Instances.Num());
+#if PHYSICS_INTERFACE_PHYSX
+	return ShapeCache.NumPooledActors();
+#else
+	return 0;
+#endif
+}
 
-	for (const TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
+void UPhysXInstancedWorldSubsystem::EnqueueInstanceTask(const FPhysXInstanceTask& Task)
+{
+	if (!Task.ID.IsValid())
 	{
-		Result.Add(Pair.Key);
+		return;
 	}
 
-	return Result;
+	PendingInstanceTasks.Add(Task);
 }
 
-FPhysXInstanceID UPhysXInstancedWorldSubsystem::FindNearestInstance(
-	FVector WorldLocation,
-	UInstancedStaticMeshComponent* OptionalFilterComponent) const
+void UPhysXInstancedWorldSubsystem::ProcessInstanceTasks()
 {
-	// Backward-compatible wrapper: ignore nothing, do not include storage.
-	return FindNearestInstanceAdvanced(
-		WorldLocation,
-		OptionalFilterComponent,
-		FPhysXInstanceID(),
-		INDEX_NONE,
-		/*bIncludeStorage=*/false);
-}
+	if (PendingInstanceTasks.Num() == 0)
+	{
+		return;
+	}
 
-FPhysXInstanceID UPhysXInstancedWorldSubsystem::FindNearestInstanceAdvanced(
-	FVector WorldLocation,
-	UInstancedStaticMeshComponent* OptionalFilterComponent,
-	FPhysXInstanceID IgnoreInstanceID,
-	int32 IgnoreInstanceIndex,
-	bool bIncludeStorage) const
-{
-	FPhysXInstanceID BestID;
-	float BestDistSq = TNumericLimits<float>::Max();
+#if !PHYSICS_INTERFACE_PHYSX
+	// No PhysX: tasks cannot be executed.
+	PendingInstanceTasks.Reset();
+	return;
+#else
 
-	for (const TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
+	const int32 Budget = (MaxInstanceTasksPerFrame <= 0)
+		? TNumericLimits<int32>::Max()
+		: MaxInstanceTasksPerFrame;
+
+	// Prevent infinite growth if something is permanently broken.
+	static const int32 MaxAttempts = 600; // ~10s at 60 FPS
+
+	int32 Executed = 0;
+
+	TArray<FPhysXInstanceTask> Remaining;
+	Remaining.Reserve(PendingInstanceTasks.Num());
+
+	for (FPhysXInstanceTask& Task : PendingInstanceTasks)
 	{
-		const FPhysXInstanceID&   ID   = Pair.Key;
-		const FPhysXInstanceData& Data = Pair.Value;
+		const bool bCanAttempt = (Executed < Budget);
 
-		if (!ID.IsValid())
+		if (bCanAttempt)
 		{
-			continue;
-		}
+			if (TryExecuteInstanceTask(Task))
+			{
+				++Executed;
+				continue; // consumed (success or dropped)
+			}
 
-		// Ignore self by stable ID (recommended; indices are not stable after removals).
-		if (IgnoreInstanceID.IsValid() && ID == IgnoreInstanceID)
-		{
-			continue;
+			// Not ready yet -> keep for retry
+			++Task.Attempts;
+			if (Task.Attempts > MaxAttempts)
+			{
+				UE_LOG(LogTemp, Warning,
+					TEXT("[PhysXInstanced] Task dropped (too many retries). Type=%d ID=%u"),
+					(int32)Task.Type, Task.ID.GetUniqueID());
+				continue; // drop
+			}
 		}
 
-		UInstancedStaticMeshComponent* ISMC = Data.InstancedComponent.Get();
-		if (!ISMC || !ISMC->IsValidLowLevelFast())
-		{
-			continue;
-		}
+		Remaining.Add(Task);
+	}
+
+	PendingInstanceTasks = MoveTemp(Remaining);
+
+#endif // PHYSICS_INTERFACE_PHYSX
+}
+
+#if PHYSICS_INTERFACE_PHYSX
+bool UPhysXInstancedWorldSubsystem::TryExecuteInstanceTask(FPhysXInstanceTask& Task)
+{
+	FPhysXInstanceData* Data = Instances.Find(Task.ID);
+	if (!Data)
+	{
+		return true; // drop: unknown ID
+	}
 
-		if (OptionalFilterComponent && ISMC != OptionalFilterComponent)
+	UInstancedStaticMeshComponent* ISMC = Data->InstancedComponent.Get();
+	if (!ISMC || !ISMC->IsValidLowLevelFast())
+	{
+		return true; // drop: component is gone
+	}
+
+	// Storage handling (same semantics as your Advanced functions).
+	if (IsOwnerStorageActor(ISMC))
+	{
+		if (!Task.bIncludeStorage)
 		{
-			continue;
+			return true; // drop
 		}
 
-		// Ignore self by component-local index (only meaningful when the component is specified).
-		if (OptionalFilterComponent && IgnoreInstanceIndex != INDEX_NONE && Data.InstanceIndex == IgnoreInstanceIndex)
+		if (!Task.bConvertStorageToDynamic)
 		{
-			continue;
+			return true; // drop
 		}
 
-		if (Data.InstanceIndex == INDEX_NONE)
+		if (!ConvertStorageInstanceToDynamic(Task.ID, /*bCreateDynamicActorIfNeeded=*/true))
 		{
-			continue;
+			return false; // retry later
 		}
-		
-		// Validate InstanceIndex to avoid returning IDs bound to non-existent visual instances.
-		const int32 NumInstances = ISMC->GetInstanceCount();
-		if (Data.InstanceIndex < 0 || Data.InstanceIndex >= NumInstances)
+
+		// Refresh after conversion.
+		Data = Instances.Find(Task.ID);
+		if (!Data)
 		{
-			continue;
+			return true; // drop
 		}
-		
-		// Actor-level storage flags (dedicated storage actors).
-		bool bOwnerIsStorageActor = false;
-		if (AActor* Owner = ISMC->GetOwner())
+	}
+
+	// Ensure body exists for dynamic tasks.
+	if (!Data->Body.GetPxActor())
+	{
+		if (!SetInstancePhysicsEnabled(Task.ID, /*bEnable=*/true, /*bDestroyBodyIfDisabling=*/false))
 		{
-			if (const APhysXInstancedMeshActor* PhysXActor = Cast<APhysXInstancedMeshActor>(Owner))
-			{
-				bOwnerIsStorageActor = (PhysXActor->bIsStorageActor || PhysXActor->bStorageOnly);
-			}
+			return false; // retry later
 		}
+	}
 
-#if PHYSICS_INTERFACE_PHYSX
-		physx::PxRigidActor* RigidActor = Data.Body.GetPxActor();
+	physx::PxRigidActor* RA = Data->Body.GetPxActor();
+	physx::PxRigidDynamic* RD = RA ? RA->is<physx::PxRigidDynamic>() : nullptr;
+	if (!RD)
+	{
+		return false; // retry (body creation might still be pending)
+	}
+
+	// Critical: execute only when inserted into a scene.
+	// This solves all "pending add" issues for both impulses and forces.
+	if (!RD->getScene())
+	{
+		return false; // retry later
+	}
+
+	using FTaskHandler = bool (UPhysXInstancedWorldSubsystem::*)(FPhysXInstanceTask&, physx::PxRigidDynamic*);
+
+	static const FTaskHandler Handlers[] =
+	{
+		&UPhysXInstancedWorldSubsystem::HandleInstanceTask_AddImpulse,  // AddImpulse
+		&UPhysXInstancedWorldSubsystem::HandleInstanceTask_AddForce,    // AddForce
+		&UPhysXInstancedWorldSubsystem::HandleInstanceTask_PutToSleep,  // PutToSleep
+		&UPhysXInstancedWorldSubsystem::HandleInstanceTask_WakeUp       // WakeUp
+	};
+
+	static_assert(UE_ARRAY_COUNT(Handlers) == (int32)EPhysXInstanceTaskType::Count, "Instance task handler table mismatch.");
+
+	const int32 TypeIndex = (int32)Task.Type;
+	if (TypeIndex < 0 || TypeIndex >= (int32)EPhysXInstanceTaskType::Count)
+	{
+		return true;
+	}
+
+	FTaskHandler Handler = Handlers[TypeIndex];
+	if (!Handler)
+	{
+		return true;
+	}
+
+	return (this->*Handler)(Task, RD);
+
+}
+#endif // PHYSICS_INTERFACE_PHYSX
+
+bool UPhysXInstancedWorldSubsystem::RaycastPhysXInstanceID(
+const FVector& StartWorld,
+const FVector& EndWorld,
+FPhysXInstanceID& OutID,
+EPhysXInstancedQueryDebugMode DebugMode,
+float DebugDrawDuration) const
+{
+#if !PHYSICS_INTERFACE_PHYSX
+	OutID = FPhysXInstanceID();
+	return false;
 #else
-		void* RigidActor = nullptr;
-#endif
+	OutID = FPhysXInstanceID();
 
-		// If storage is excluded, require a real PhysX actor that is already in a scene.
-		if (!bIncludeStorage)
-		{
-			if (bOwnerIsStorageActor)
-			{
-				continue;
-			}
+	float DistUU = TNumericLimits<float>::Max();
+	FVector HitPos = FVector::ZeroVector;
+	FVector HitNormal = FVector::UpVector;
 
-#if PHYSICS_INTERFACE_PHYSX
-			if (!RigidActor)
-			{
-				continue;
-			}
-			if (!RigidActor->getScene())
-			{
-				// Body exists but is not inserted yet (pending add) -> not a valid "physics nearest".
-				continue;
-			}
-#endif
-		}
+	const bool bHit = RaycastPhysXInstanceID_Internal(StartWorld, EndWorld, OutID, DistUU, HitPos, HitNormal);
 
-		FVector InstanceLocation = FVector::ZeroVector;
-		bool bHasValidLocation = false;
+#if ENABLE_DRAW_DEBUG
+	if (IsDebugEnabled(DebugMode))
+	{
+		UWorld* World = GetWorld();
+		DrawLineSafe(World, StartWorld, EndWorld, bHit ? FColor::Green : FColor::Red, DebugDrawDuration);
 
-#if PHYSICS_INTERFACE_PHYSX
-		if (RigidActor)
-		{
-			const physx::PxTransform PxPose = RigidActor->getGlobalPose();
-			InstanceLocation = P2UVector(PxPose.p);
-			bHasValidLocation = true;
-		}
-		else
-#endif
+		if (bHit)
 		{
-			// Fallback path for storage/no-body instances.
-			const int32 Num = ISMC->GetInstanceCount();
-			if (Data.InstanceIndex < 0 || Data.InstanceIndex >= Num)
-			{
-				continue;
-			}
+			DrawPointSafe(World, HitPos, FColor::Green, DebugDrawDuration);
 
-			FTransform InstanceTM;
-			if (ISMC->GetInstanceTransform(Data.InstanceIndex, InstanceTM, /*bWorldSpace=*/true))
+			if (DebugMode == EPhysXInstancedQueryDebugMode::Detailed)
 			{
-				InstanceLocation = InstanceTM.GetLocation();
-				bHasValidLocation = true;
-			}
-		}
-
-		if (!bHasValidLocation)
-		{
-			continue;
-		}
+				DrawArrowSafe(World, HitPos, HitPos + HitNormal.GetSafeNormal() * 30.0f, FColor::Cyan, DebugDrawDuration);
 
-		const float DistSq = FVector::DistSquared(WorldLocation, InstanceLocation);
-		if (DistSq < BestDistSq)
-		{
-			BestDistSq = DistSq;
-			BestID = ID;
+				const FString Label = FString::Printf(TEXT("PhysX ID=%u Dist=%.1f"), OutID.GetUniqueID(), DistUU);
+				DrawTextSafe(World, HitPos + FVector(0, 0, 10.0f), Label, FColor::White, DebugDrawDuration);
+			}
 		}
 	}
+#endif
 
-	return BestID;
+	return bHit;
+#endif
 }
 
-
-FPhysXActorID UPhysXInstancedWorldSubsystem::RegisterInstancedMeshActor(APhysXInstancedMeshActor* Actor)
+bool UPhysXInstancedWorldSubsystem::RaycastInstanceID(
+	const FVector& StartWorld,
+	const FVector& EndWorld,
+	FPhysXInstanceID& OutID,
+	bool bIncludeStorage,
+	ECollisionChannel TraceChannel,
+	EPhysXInstancedQueryDebugMode DebugMode,
+	float DebugDrawDuration) const
 {
-	if (!Actor || !Actor->IsValidLowLevelFast())
-	{
-		return FPhysXActorID(); // invalid
-	}
+	OutID = FPhysXInstanceID();
 
-	// If already registered, return the existing ID.
-	for (const TPair<FPhysXActorID, FPhysXActorData>& Pair : Actors)
+	UWorld* World = GetWorld();
+	if (!World)
 	{
-		if (Pair.Value.Actor.Get() == Actor)
-		{
-			return Pair.Key;
-		}
+		return false;
 	}
 
-	const FPhysXActorID NewID(NextActorID++);
-
-	FPhysXActorData NewData;
-	NewData.Actor = Actor;
-
-	Actors.Add(NewID, NewData);
-	return NewID;
-}
-
-void UPhysXInstancedWorldSubsystem::UnregisterInstancedMeshActor(FPhysXActorID ActorID)
-{
-	Actors.Remove(ActorID);
-}
-
-bool UPhysXInstancedWorldSubsystem::IsActorValid(FPhysXActorID ActorID) const
-{
-	const FPhysXActorData* Data = Actors.Find(ActorID);
-	return Data && Data->Actor.IsValid();
-}
+	FPhysXInstanceID BestID;
+	float BestDistUU = TNumericLimits<float>::Max();
 
-APhysXInstancedMeshActor* UPhysXInstancedWorldSubsystem::GetActorByID(FPhysXActorID ActorID) const
-{
-	const FPhysXActorData* Data = Actors.Find(ActorID);
-	return Data ? Data->Actor.Get() : nullptr;
-}
+	bool bPhysXHit = false;
+	FPhysXInstanceID PhysXID;
+	float PhysXDistUU = TNumericLimits<float>::Max();
+	FVector PhysXHitPos = FVector::ZeroVector;
+	FVector PhysXHitNormal = FVector::UpVector;
 
-TArray<FPhysXActorID> UPhysXInstancedWorldSubsystem::GetAllActorIDs() const
-{
-	TArray<FPhysXActorID> Result;
-	Actors.GetKeys(Result);
-	return Result;
-}
+#if PHYSICS_INTERFACE_PHYSX
+	bPhysXHit = RaycastPhysXInstanceID_Internal(StartWorld, EndWorld, PhysXID, PhysXDistUU, PhysXHitPos, PhysXHitNormal);
+	if (bPhysXHit)
+	{
+		BestID = PhysXID;
+		BestDistUU = PhysXDistUU;
+	}
+#endif
 
-TArray<FPhysXInstanceID> UPhysXInstancedWorldSubsystem::GetInstanceIDsForActor(FPhysXActorID ActorID) const
-{
-	TArray<FPhysXInstanceID> OutIDs;
+	bool bTraceHit = false;
+	FHitResult Hit;
 
-	const FPhysXActorData* ActorData = Actors.Find(ActorID);
-	if (!ActorData)
+	if (bIncludeStorage)
 	{
-		return OutIDs;
+		FPhysXInstanceID StorageID;
+		if (SweepStorage_Internal(StartWorld, EndWorld, FCollisionShape::LineShape, FQuat::Identity, TraceChannel, StorageID, Hit))
+		{
+			bTraceHit = true;
+
+			if (!BestID.IsValid() || Hit.Distance < BestDistUU)
+			{
+				BestID = StorageID;
+				BestDistUU = Hit.Distance;
+			}
+		}
 	}
 
-	APhysXInstancedMeshActor* Actor = ActorData->Actor.Get();
-	if (!Actor)
+	const bool bHitAny = BestID.IsValid();
+	if (bHitAny)
 	{
-		return OutIDs;
+		OutID = BestID;
 	}
 
-	// Walk all instances and collect those whose ISM owner is this actor.
-	for (const TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
+#if ENABLE_DRAW_DEBUG
+	if (IsDebugEnabled(DebugMode))
 	{
-		const FPhysXInstanceData& Data = Pair.Value;
+		DrawLineSafe(World, StartWorld, EndWorld, bHitAny ? FColor::Green : FColor::Red, DebugDrawDuration);
 
-		UInstancedStaticMeshComponent* ISMC = Data.InstancedComponent.Get();
-		if (!ISMC)
+		if (DebugMode == EPhysXInstancedQueryDebugMode::Detailed)
 		{
-			continue;
-		}
+			if (bPhysXHit)
+			{
+				DrawPointSafe(World, PhysXHitPos, FColor::Cyan, DebugDrawDuration);
+				DrawArrowSafe(World, PhysXHitPos, PhysXHitPos + PhysXHitNormal.GetSafeNormal() * 30.0f, FColor::Cyan, DebugDrawDuration);
+				DrawTextSafe(World, PhysXHitPos + FVector(0, 0, 10.0f),
+					FString::Printf(TEXT("PhysX ID=%u Dist=%.1f"), PhysXID.GetUniqueID(), PhysXDistUU),
+					FColor::Cyan, DebugDrawDuration);
+			}
 
-		if (ISMC->GetOwner() == Actor)
+			if (bTraceHit)
+			{
+				DrawPointSafe(World, Hit.ImpactPoint, FColor::Yellow, DebugDrawDuration);
+				DrawArrowSafe(World, Hit.ImpactPoint, Hit.ImpactPoint + Hit.ImpactNormal.GetSafeNormal() * 30.0f, FColor::Yellow, DebugDrawDuration);
+				DrawTextSafe(World, Hit.ImpactPoint + FVector(0, 0, 10.0f),
+					FString::Printf(TEXT("Trace ID=%u Dist=%.1f"), OutID.GetUniqueID(), Hit.Distance),
+					FColor::Yellow, DebugDrawDuration);
+			}
+		}
+		else if (bHitAny)
 		{
-			OutIDs.Add(Pair.Key);
+			// Basic: mark only the chosen hit.
+			const FVector MarkPos =
+				(bPhysXHit && OutID == PhysXID) ? PhysXHitPos :
+				(bTraceHit ? Hit.ImpactPoint : (StartWorld + (EndWorld - StartWorld).GetSafeNormal() * BestDistUU));
+
+			DrawPointSafe(World, MarkPos, FColor::Green, DebugDrawDuration);
 		}
 	}
+#endif
 
-	return OutIDs;
+	return bHitAny;
 }
 
-FPhysXInstanceID UPhysXInstancedWorldSubsystem::GetInstanceIDForComponentAndIndex(
-	UInstancedStaticMeshComponent* InstancedMesh,
-	int32 InstanceIndex) const
-{
-	if (!InstancedMesh || InstanceIndex < 0)
-	{
-		return FPhysXInstanceID();
-	}
-
-	if (const FPhysXInstanceID* Found = InstanceIDBySlot.Find(FPhysXInstanceSlotKey(InstancedMesh, InstanceIndex)))
-	{
-		return *Found;
-	}
 
-	// Fallback (should be rare): rebuild and try again.
-	const_cast<UPhysXInstancedWorldSubsystem*>(this)->RebuildSlotMappingForComponent(InstancedMesh);
+bool UPhysXInstancedWorldSubsystem::SweepSphereInstanceID(
+	const FVector& StartWorld,
+	const FVector& EndWorld,
+	float Radius,
+	FPhysXInstanceID& OutID,
+	bool bIncludeStorage,
+	ECollisionChannel TraceChannel,
+	EPhysXInstancedQueryDebugMode DebugMode,
+	float DebugDrawDuration) const
+{
+	OutID = FPhysXInstanceID();
 
-	if (const FPhysXInstanceID* FoundAfter = InstanceIDBySlot.Find(FPhysXInstanceSlotKey(InstancedMesh, InstanceIndex)))
+	UWorld* World = GetWorld();
+	if (!World || Radius <= 0.0f)
 	{
-		return *FoundAfter;
+		return false;
 	}
 
-	return FPhysXInstanceID();
-}
-
-// ============================================================================
-// Stats / random helpers
-// ============================================================================
+	FPhysXInstanceID BestID;
+	float BestDistUU = TNumericLimits<float>::Max();
 
-int32 UPhysXInstancedWorldSubsystem::GetTotalInstanceCount() const
-{
-	return Instances.Num();
-}
+	// --- Storage sweep (BVH) ---
+	bool bTraceHit = false;
+	FHitResult TraceHit;
 
-int32 UPhysXInstancedWorldSubsystem::GetInstanceCountForComponent(
-	UInstancedStaticMeshComponent* Component) const
-{
-	if (!Component)
+	if (bIncludeStorage)
 	{
-		return 0;
+		FPhysXInstanceID StorageID;
+		if (SweepStorage_Internal(StartWorld, EndWorld, FCollisionShape::MakeSphere(Radius), FQuat::Identity, TraceChannel, StorageID, TraceHit))
+		{
+			bTraceHit  = true;
+			BestID     = StorageID;
+			BestDistUU = TraceHit.Distance;
+		}
 	}
 
-	int32 Count = 0;
+	// --- PhysX sweep ---
+	bool bPhysXHit = false;
+	bool bBestFromPhysX = false;
 
-	for (const TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
+	FPhysXInstanceID PhysXID;
+	float PhysXDistUU = TNumericLimits<float>::Max();
+	FVector PhysXHitPos = FVector::ZeroVector;
+	FVector PhysXHitNormal = FVector::UpVector;
+
+#if PHYSICS_INTERFACE_PHYSX
+	if (SweepSpherePhysXInstanceID_Internal(StartWorld, EndWorld, Radius, PhysXID, PhysXDistUU, PhysXHitPos, PhysXHitNormal))
 	{
-		const FPhysXInstanceData& Data = Pair.Value;
+		bPhysXHit = true;
 
-		if (Data.InstancedComponent.Get() == Component &&
-			Data.InstanceIndex != INDEX_NONE)
+		if (!BestID.IsValid() || PhysXDistUU < BestDistUU)
 		{
-			++Count;
+			BestID         = PhysXID;
+			BestDistUU     = PhysXDistUU;
+			bBestFromPhysX = true;
 		}
 	}
+#endif
 
-	return Count;
-}
-
-FPhysXInstanceID UPhysXInstancedWorldSubsystem::GetRandomInstanceID(bool bOnlySimulating) const
-{
-	TArray<FPhysXInstanceID> Candidates;
-	Candidates.Reserve(Instances.Num());
+	const bool bHitAny = BestID.IsValid();
+	if (bHitAny)
+	{
+		OutID = BestID;
+	}
 
-	for (const TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
+#if ENABLE_DRAW_DEBUG
+	if (IsDebugEnabled(DebugMode))
 	{
-		const FPhysXInstanceData& Data = Pair.Value;
+		const FColor LineColor = bHitAny ? FColor::Green : FColor::Red;
+
+		DrawSphereSafe(World, StartWorld, Radius, FColor::Silver, DebugDrawDuration, 1.0f);
+		DrawSphereSafe(World, EndWorld,   Radius, FColor::Silver, DebugDrawDuration, 1.0f);
+		DrawLineSafe(World, StartWorld, EndWorld, LineColor, DebugDrawDuration, 1.5f);
+
+		if (DebugMode == EPhysXInstancedQueryDebugMode::Detailed)
+		{
+			if (bTraceHit)
+			{
+				DrawPointSafe(World, TraceHit.ImpactPoint, FColor::Yellow, DebugDrawDuration);
+				DrawArrowSafe(World,
+					TraceHit.ImpactPoint,
+					TraceHit.ImpactPoint + TraceHit.ImpactNormal.GetSafeNormal() * 30.0f,
+					FColor::Yellow,
+					DebugDrawDuration);
+
+				DrawTextSafe(World,
+					TraceHit.ImpactPoint + FVector(0, 0, 10.0f),
+					FString::Printf(TEXT("Trace ID=%u Dist=%.1f"), BestID.IsValid() ? BestID.GetUniqueID() : 0u, TraceHit.Distance),
+					FColor::Yellow,
+					DebugDrawDuration);
+			}
 
-		if (Data.InstanceIndex == INDEX_NONE)
-		{
-			continue;
-		}
+			if (bPhysXHit)
+			{
+				DrawPointSafe(World, PhysXHitPos, FColor::Cyan, DebugDrawDuration);
+				DrawArrowSafe(World,
+					PhysXHitPos,
+					PhysXHitPos + PhysXHitNormal.GetSafeNormal() * 30.0f,
+					FColor::Cyan,
+					DebugDrawDuration);
 
-		UInstancedStaticMeshComponent* ISMC = Data.InstancedComponent.Get();
-		if (!ISMC || !ISMC->IsValidLowLevelFast())
-		{
-			continue;
+				DrawTextSafe(World,
+					PhysXHitPos + FVector(0, 0, 10.0f),
+					FString::Printf(TEXT("PhysX ID=%u Dist=%.1f"), PhysXID.GetUniqueID(), PhysXDistUU),
+					FColor::Cyan,
+					DebugDrawDuration);
+			}
 		}
-
-		if (bOnlySimulating && !IsInstancePhysicsEnabled(Pair.Key))
+		else if (bHitAny)
 		{
-			continue;
-		}
-
-		Candidates.Add(Pair.Key);
-	}
+			const FVector MarkPos = (bBestFromPhysX && bPhysXHit)
+				? PhysXHitPos
+				: (bTraceHit ? TraceHit.ImpactPoint : StartWorld);
 
-	if (Candidates.Num() == 0)
-	{
-		return FPhysXInstanceID();
+			DrawPointSafe(World, MarkPos, FColor::Green, DebugDrawDuration);
+		}
 	}
+#endif
 
-	const int32 RandomIndex = FMath::RandHelper(Candidates.Num());
-	return Candidates[RandomIndex];
+	return bHitAny;
 }
 
-FPhysXInstanceID UPhysXInstancedWorldSubsystem::GetRandomInstanceForComponent(
-	UInstancedStaticMeshComponent* Component,
-	bool bOnlySimulating) const
+bool UPhysXInstancedWorldSubsystem::OverlapSphereInstanceIDs(
+	const FVector& CenterWorld,
+	float Radius,
+	TArray<FPhysXInstanceID>& OutIDs,
+	bool bIncludeStorage,
+	ECollisionChannel TraceChannel,
+	EPhysXInstancedQueryDebugMode DebugMode,
+	float DebugDrawDuration) const
 {
-	if (!Component)
+	OutIDs.Reset();
+
+	UWorld* World = GetWorld();
+	if (!World || Radius <= 0.0f)
 	{
-		return FPhysXInstanceID();
+		return false;
 	}
 
-	TArray<FPhysXInstanceID> Candidates;
+	ForEachInstanceOverlappingSphere(CenterWorld, Radius,
+		[&OutIDs](FPhysXInstanceID ID) { OutIDs.Add(ID); return true; },
+		bIncludeStorage, TraceChannel);
 
-	for (const TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
+	const bool bAny = (OutIDs.Num() > 0);
+
+#if ENABLE_DRAW_DEBUG
+	if (IsDebugEnabled(DebugMode))
 	{
-		const FPhysXInstanceData& Data = Pair.Value;
+		DrawSphereSafe(World, CenterWorld, Radius, bAny ? FColor::Green : FColor::Red, DebugDrawDuration, 1.5f);
 
-		if (Data.InstanceIndex == INDEX_NONE)
+		if (DebugMode == EPhysXInstancedQueryDebugMode::Detailed && bAny)
 		{
-			continue;
-		}
+			const int32 MaxMarkers = 64;
+			const int32 NumToDraw = FMath::Min(OutIDs.Num(), MaxMarkers);
 
-		UInstancedStaticMeshComponent* ISMC = Data.InstancedComponent.Get();
-		if (ISMC != Component || !ISMC->IsValidLowLevelFast())
-		{
-			continue;
-		}
+			for (int32 i = 0; i < NumToDraw; ++i)
+			{
+				const FPhysXInstanceID ID = OutIDs[i];
+				FVector Pos = CenterWorld;
 
-		if (bOnlySimulating && !IsInstancePhysicsEnabled(Pair.Key))
-		{
-			continue;
-		}
+				if (const FPhysXInstanceData* Data = Instances.Find(ID))
+				{
+					if (UInstancedStaticMeshComponent* ISMC = Data->InstancedComponent.Get())
+					{
+#if PHYSICS_INTERFACE_PHYSX
+						if (physx::PxRigidActor* RA = Data->Body.GetPxActor())
+						{
+							const physx::PxTransform PxPose = RA->getGlobalPose();
+							Pos = P2UVector(PxPose.p);
+						}
+						else
+#endif
+						{
+							if (Data->InstanceIndex != INDEX_NONE)
+							{
+								FTransform TM;
+								if (ISMC->GetInstanceTransform(Data->InstanceIndex, TM, /*bWorldSpace=*/true))
+								{
+									Pos = TM.GetLocation();
+								}
+							}
+						}
+					}
+				}
 
-		Candidates.Add(Pair.Key);
-	}
+				DrawPointSafe(World, Pos, FColor::Cyan, DebugDrawDuration, 10.0f);
+				DrawTextSafe(World, Pos + FVector(0, 0, 10.0f), FString::Printf(TEXT("ID=%u"), ID.GetUniqueID()), FColor::White, DebugDrawDuration);
+			}
 
-	if (Candidates.Num() == 0)
-	{
-		return FPhysXInstanceID();
+			if (OutIDs.Num() > MaxMarkers)
+			{
+				DrawTextSafe(World,
+					CenterWorld + FVector(0, 0, 20.0f),
+					FString::Printf(TEXT("Overlap: %d hits (showing %d)"), OutIDs.Num(), MaxMarkers),
+					FColor::White,
+					DebugDrawDuration);
+			}
+		}
 	}
+#endif
 
-	const int32 RandomIndex = FMath::RandHelper(Candidates.Num());
-	return Candidates[RandomIndex];
+	return bAny;
 }
 
-void UPhysXInstancedWorldSubsystem::FixInstanceIndicesAfterRemoval(
-	UInstancedStaticMeshComponent* ISMC,
-	int32 RemovedIndex)
+bool UPhysXInstancedWorldSubsystem::OverlapBoxInstanceIDs(
+	const FVector& CenterWorld,
+	const FVector& HalfExtent,
+	TArray<FPhysXInstanceID>& OutIDs,
+	bool bIncludeStorage,
+	ECollisionChannel TraceChannel,
+	EPhysXInstancedQueryDebugMode DebugMode,
+	float DebugDrawDuration) const
 {
-	if (!ISMC || RemovedIndex < 0)
+	OutIDs.Reset();
+
+	UWorld* World = GetWorld();
+	if (!World || HalfExtent.GetMin() <= 0.0f)
 	{
-		return;
+		return false;
 	}
 
-	// UInstancedStaticMeshComponent::RemoveInstance() compacts the array (RemoveAt),
-	// so all indices after RemovedIndex shift by -1.
-	for (TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
+	ForEachInstanceOverlappingBox(CenterWorld, HalfExtent,
+		[&OutIDs](FPhysXInstanceID ID) { OutIDs.Add(ID); return true; },
+		bIncludeStorage, TraceChannel);
+
+	const bool bAny = (OutIDs.Num() > 0);
+
+#if ENABLE_DRAW_DEBUG
+	if (IsDebugEnabled(DebugMode))
 	{
-		FPhysXInstanceData& OtherData = Pair.Value;
+		DrawBoxSafe(World, CenterWorld, HalfExtent, bAny ? FColor::Green : FColor::Red, DebugDrawDuration, 1.5f);
 
-		if (OtherData.InstancedComponent.Get() != ISMC)
+		if (DebugMode == EPhysXInstancedQueryDebugMode::Detailed && bAny)
 		{
-			continue;
-		}
+			const int32 MaxMarkers = 64;
+			const int32 NumToDraw = FMath::Min(OutIDs.Num(), MaxMarkers);
 
-		if (OtherData.InstanceIndex != INDEX_NONE && OtherData.InstanceIndex > RemovedIndex)
-		{
-			OtherData.InstanceIndex -= 1;
-		}
-	}
-}
+			for (int32 i = 0; i < NumToDraw; ++i)
+			{
+				const FPhysXInstanceID ID = OutIDs[i];
 
-bool UPhysXInstancedWorldSubsystem::RemoveInstanceByID(FPhysXInstanceID ID, bool bRemoveVisualInstance)
-{
-	return RemoveInstanceByID_Internal(ID, bRemoveVisualInstance, EPhysXInstanceRemoveReason::Explicit);
-}
+				FVector Pos = CenterWorld;
+				SpatialHash.GetLocation(ID, Pos);
 
-bool UPhysXInstancedWorldSubsystem::RemoveInstanceByID_Internal(
-	FPhysXInstanceID ID,
-	bool bRemoveVisualInstance,
-	EPhysXInstanceRemoveReason Reason)
-{
-	FPhysXInstanceData* Data = Instances.Find(ID);
-	if (!Data)
-	{
-		return false;
-	}
+				DrawPointSafe(World, Pos, FColor::Cyan, DebugDrawDuration, 10.0f);
+				DrawTextSafe(World, Pos + FVector(0, 0, 10.0f), FString::Printf(TEXT("ID=%u"), ID.GetUniqueID()), FColor::White, DebugDrawDuration);
+			}
 
-	UInstancedStaticMeshComponent* ISMC = Data->InstancedComponent.Get();
-	int32 InstanceIndex = Data->InstanceIndex;
-	const bool bWasSimulating = Data->bSimulating;
+			if (OutIDs.Num() > MaxMarkers)
+			{
+				DrawTextSafe(World,
+					CenterWorld + FVector(0, 0, 20.0f),
+					FString::Printf(TEXT("Overlap: %d hits (showing %d)"), OutIDs.Num(), MaxMarkers),
+					FColor::White,
+					DebugDrawDuration);
+			}
+		}
+	}
+#endif
 
-	APhysXInstancedMeshActor* OwnerActor =
-		ISMC ? Cast<APhysXInstancedMeshActor>(ISMC->GetOwner()) : nullptr;
+	return bAny;
+}
 
-	const bool bFirePre =
-		IsEventEnabled(OwnerActor, EPhysXInstanceEventFlags::PreRemove) &&
-		(OwnerActor->OnInstancePreRemove.IsBound() || HasInterfaceEvents(OwnerActor));
+// ============================================================================
+// C++ visitor queries
+// ============================================================================
 
-	const bool bFirePost =
-		IsEventEnabled(OwnerActor, EPhysXInstanceEventFlags::PostRemove) &&
-		(OwnerActor->OnInstancePostRemove.IsBound() || HasInterfaceEvents(OwnerActor));
+uint16 UPhysXInstancedWorldSubsystem::BeginQueryVisit() const
+{
+	check(IsInGameThread());
 
-	FTransform SnapshotTM = FTransform::Identity;
-	if (bFirePre || bFirePost)
+	// Sized by live instances; slots past the last one are added on first visit.
+	if (QueryVisitStamps.Num() < Instances.Num())
 	{
-		GetInstanceWorldTransform_Safe(*Data, SnapshotTM);
+		QueryVisitStamps.SetNumZeroed(FMath::RoundUpToPowerOfTwo(Instances.Num()));
 	}
-
-	if (bFirePre)
+	else if (Instances.Num() == 0)
 	{
-		OwnerActor->OnInstancePreRemove.Broadcast(ID, Reason, SnapshotTM);
-
-		if (HasInterfaceEvents(OwnerActor))
-		{
-			IPhysXInstanceEvents::Execute_OnInstancePreRemove(OwnerActor, ID, Reason, SnapshotTM);
-		}
+		QueryVisitStamps.Empty();
 	}
 
-	bool bOwnerIsStorageActor = false;
-	if (OwnerActor)
+	// 0 means "never visited"; on wrap-around the stamps are cleared once.
+	if (++QueryVisitEpoch == 0)
 	{
-		bOwnerIsStorageActor = (OwnerActor->bIsStorageActor || OwnerActor->bStorageOnly);
-		OwnerActor->RegisteredInstanceIDs.Remove(ID);
+		FMemory::Memzero(QueryVisitStamps.GetData(), QueryVisitStamps.Num() * sizeof(uint16));
+		QueryVisitEpoch = 1;
 	}
 
-	// -----------------------------
-	// PhysX cleanup first (if any)
-	// -----------------------------
-#if PHYSICS_INTERFACE_PHYSX
-	ClearInstanceUserData(ID);
-	Data->Body.Destroy();
-#endif
-
-	InvalidatePendingAddEntries(ID);
-
-	// Remove slot mapping even if indices were already corrupted.
-	RemoveSlotMapping(ID);
+	return QueryVisitEpoch;
+}
 
-	// Update counters before removing the record.
-	if (NumBodiesTotal > 0)
-	{
-		--NumBodiesTotal;
-	}
-	if (bWasSimulating && NumBodiesSimulating > 0)
+int32 UPhysXInstancedWorldSubsystem::ForEachInstanceOverlappingSphere(
+	const FVector& CenterWorld,
+	float Radius,
+	FInstanceVisitor Visitor,
+	bool bIncludeStorage,
+	ECollisionChannel TraceChannel,
+	const FInstanceBodyFilter& BodyFilter) const
+{
+	UWorld* World = GetWorld();
+	if (!World || Radius <= 0.0f)
 	{
-		--NumBodiesSimulating;
+		return 0;
 	}
 
-	auto FirePost = [&](bool bSuccess)
-	{
-		if (!bFirePost)
-		{
-			return;
-		}
+	const uint16 Epoch = BeginQueryVisit();
 
-		OwnerActor->OnInstancePostRemove.Broadcast(ID, Reason, SnapshotTM);
+	int32 NumVisited = 0;
+	bool  bStopped   = false;
 
-		if (HasInterfaceEvents(OwnerActor))
+	auto Visit = [&](FPhysXInstanceID ID)
+	{
+		if (MarkQueryVisited(ID, Epoch))
 		{
-			IPhysXInstanceEvents::Execute_OnInstancePostRemove(OwnerActor, ID, Reason, SnapshotTM);
+			++NumVisited;
+			bStopped = !Visitor(ID);
 		}
+		return !bStopped;
 	};
 
-	// If we do not need to remove the visual instance, we can drop the record now.
-	if (!bRemoveVisualInstance)
+	auto VisitStorage = [&](FPhysXInstanceID ID)
 	{
-		Instances.Remove(ID);
-		FirePost(/*bSuccess=*/true);
-		return true;
-	}
+		return IsInstanceOwnedBy(ID, BodyFilter.Owner) ? Visit(ID) : true;
+	};
 
-	if (!ISMC || !ISMC->IsValidLowLevelFast() || InstanceIndex == INDEX_NONE)
+	// --- Storage overlaps via the storage BVH ---
+	if (bIncludeStorage && !BodyFilter.Archetype && !BodyFilter.bSimulatingOnly)
 	{
-		Instances.Remove(ID);
-		FirePost(/*bSuccess=*/false);
-		return false;
+		OverlapStorageSphere_Internal(CenterWorld, Radius, TraceChannel, VisitStorage);
 	}
 
-	// -----------------------------
-	// Validate / resolve the slot
-	// -----------------------------
-	const int32 NumBefore = ISMC->GetInstanceCount();
-	if (InstanceIndex < 0 || InstanceIndex >= NumBefore ||
-		InstanceIDBySlot.FindRef(FPhysXInstanceSlotKey(ISMC, InstanceIndex)) != ID)
+#if PHYSICS_INTERFACE_PHYSX
+	// --- Dynamic overlaps via PhysX ---
+	physx::PxScene* PxScenePtr = GetPhysXSceneFromWorld(World);
+	if (PxScenePtr && !bStopped)
 	{
-		// Rebuild mapping and try to resolve ID -> current index.
-		RebuildSlotMappingForComponent(ISMC);
-
-		int32 ResolvedIndex = INDEX_NONE;
-		for (const TPair<FPhysXInstanceSlotKey, FPhysXInstanceID>& SlotPair : InstanceIDBySlot)
-		{
-			if (SlotPair.Value == ID && SlotPair.Key.Component.Get() == ISMC)
-			{
-				ResolvedIndex = SlotPair.Key.InstanceIndex;
-				break;
-			}
-		}
-
-		if (ResolvedIndex == INDEX_NONE || ResolvedIndex < 0 || ResolvedIndex >= ISMC->GetInstanceCount())
-		{
-			UE_LOG(LogTemp, Warning,
-				TEXT("[PhysXInstanced] RemoveInstanceByID: failed to resolve slot for ID=%u (ISMC=%s). Removing record only."),
-				ID.GetUniqueID(), *GetNameSafe(ISMC));
-
-			Instances.Remove(ID);
-			FirePost(/*bSuccess=*/false);
-			return false;
-		}
-
-		InstanceIndex = ResolvedIndex;
+		OverlapPhysXScene_Internal(*PxScenePtr,
+			physx::PxSphereGeometry((physx::PxReal)U2PScalar(Radius)),
+			physx::PxTransform(U2PVector(CenterWorld)),
+			Visit,
+			BodyFilter);
 	}
+#endif
 
-	const int32 OldLastIndex = ISMC->GetInstanceCount() - 1;
-
-	// Drop the record BEFORE mutating indices of others.
-	Instances.Remove(ID);
+	return NumVisited;
+}
 
-	const bool bRemoved = ISMC->RemoveInstance(InstanceIndex);
-	if (!bRemoved)
+int32 UPhysXInstancedWorldSubsystem::ForEachInstanceOverlappingBox(
+	const FVector& CenterWorld,
+	const FVector& HalfExtent,
+	FInstanceVisitor Visitor,
+	bool bIncludeStorage,
+	ECollisionChannel TraceChannel,
+	const FInstanceBodyFilter& BodyFilter) const
+{
+	UWorld* World = GetWorld();
+	if (!World || HalfExtent.GetMin() <= 0.0f)
 	{
-		UE_LOG(LogTemp, Warning,
-			TEXT("[PhysXInstanced] RemoveInstanceByID: RemoveInstance failed for ISMC=%s, Index=%d"),
-			*GetNameSafe(ISMC), InstanceIndex);
-
-		RebuildSlotMappingForComponent(ISMC);
-		FirePost(/*bSuccess=*/false);
-		return false;
+		return 0;
 	}
 
-	// UE4 path: RemoveAt compaction -> indices after removed shift by -1.
-	// UE5 path: optional RemoveAtSwap -> last element moves into removed slot.
-	const bool bUsedRemoveSwap =
-#if ENGINE_MAJOR_VERSION >= 5
-		ISMC->bSupportRemoveAtSwap != 0;
-#else
-		false;
-#endif
+	const uint16 Epoch = BeginQueryVisit();
 
-	if (bUsedRemoveSwap && OldLastIndex != InstanceIndex)
+	int32 NumVisited = 0;
+	bool  bStopped   = false;
+
+	auto Visit = [&](FPhysXInstanceID ID)
 	{
-		// Only the old last index moved to InstanceIndex.
-		for (TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
+		if (MarkQueryVisited(ID, Epoch))
 		{
-			FPhysXInstanceData& Other = Pair.Value;
-			if (Other.InstancedComponent.Get() == ISMC && Other.InstanceIndex == OldLastIndex)
-			{
-				Other.InstanceIndex = InstanceIndex;
-				break;
-			}
+			++NumVisited;
+			bStopped = !Visitor(ID);
 		}
+		return !bStopped;
+	};
+
+	auto VisitStorage = [&](FPhysXInstanceID ID)
+	{
+		return IsInstanceOwnedBy(ID, BodyFilter.Owner) ? Visit(ID) : true;
+	};
+
+	// --- Storage overlaps via the storage BVH ---
+	if (bIncludeStorage && !BodyFilter.Archetype && !BodyFilter.bSimulatingOnly)
+	{
+		OverlapStorageBox_Internal(FBox(CenterWorld - HalfExtent, CenterWorld + HalfExtent), TraceChannel, VisitStorage);
 	}
-	else
+
+#if PHYSICS_INTERFACE_PHYSX
+	// --- Dynamic overlaps via PhysX ---
+	physx::PxScene* PxScenePtr = GetPhysXSceneFromWorld(World);
+	if (PxScenePtr && !bStopped)
 	{
-		// Shift by -1 for all indices after InstanceIndex.
-		FixInstanceIndicesAfterRemoval(ISMC, InstanceIndex);
+		OverlapPhysXScene_Internal(*PxScenePtr,
+			physx::PxBoxGeometry(U2PVector(HalfExtent)),
+			physx::PxTransform(U2PVector(CenterWorld)),
+			Visit,
+			BodyFilter);
 	}
+#endif
 
-	RebuildSlotMappingForComponent(ISMC);
-	ISMC->MarkRenderStateDirty();
+	return NumVisited;
+}
 
-	FirePost(/*bSuccess=*/true);
+int32 UPhysXInstancedWorldSubsystem::ForEachInstanceInRadius(
+	const FVector& Center,
+	float Radius,
+	FInstanceVisitor Visitor,
+	UInstancedStaticMeshComponent* OptionalFilterComponent,
+	bool bIncludeStorage) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_SpatialHashQuery);
 
-	// Optional: auto-destroy empty storage actors to avoid accumulating dead containers.
-	if (bOwnerIsStorageActor && OwnerActor && OwnerActor->InstancedMesh)
-	{
-		if (OwnerActor->RegisteredInstanceIDs.Num() == 0 && OwnerActor->InstancedMesh->GetInstanceCount() == 0)
+	// The hash holds one entry per ID, so no de-duplication is needed.
+	int32 NumVisited = 0;
+	SpatialHash.ForEachInSphere(Center, Radius,
+		[&](FPhysXInstanceID ID, const FVector& /*Location*/)
 		{
-			if (OwnerActor->PhysXActorID.IsValid())
+			const FPhysXInstanceData* Data = Instances.Find(ID);
+			if (!Data || !IsSpatialQueryCandidate(*Data, OptionalFilterComponent, bIncludeStorage))
 			{
-				UnregisterInstancedMeshActor(OwnerActor->PhysXActorID);
+				return true;
 			}
-			OwnerActor->Destroy();
-		}
-	}
 
-	return true;
+			++NumVisited;
+			return Visitor(ID);
+		});
+
+	return NumVisited;
 }
 
-void UPhysXInstancedWorldSubsystem::EnqueueAddActorToScene(
-	FPhysXInstanceID ID,
-	UInstancedStaticMeshComponent* InstancedMesh)
+int32 UPhysXInstancedWorldSubsystem::ForEachInstanceInBox(
+	const FBox& Box,
+	FInstanceVisitor Visitor,
+	UInstancedStaticMeshComponent* OptionalFilterComponent,
+	bool bIncludeStorage) const
 {
-	if (!ID.IsValid() || !InstancedMesh)
-	{
-		return;
-	}
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_SpatialHashQuery);
 
-	FPendingAddActorEntry Entry;
-	Entry.ID = ID;
-	Entry.InstancedComponent = InstancedMesh;
-	Entry.World = InstancedMesh->GetWorld(); // cache once per entry
-	
-	PendingAddActors.Add(Entry);
-}
+	int32 NumVisited = 0;
+	SpatialHash.ForEachInBox(Box,
+		[&](FPhysXInstanceID ID, const FVector& /*Location*/)
+		{
+			const FPhysXInstanceData* Data = Instances.Find(ID);
+			if (!Data || !IsSpatialQueryCandidate(*Data, OptionalFilterComponent, bIncludeStorage))
+			{
+				return true;
+			}
 
+			++NumVisited;
+			return Visitor(ID);
+		});
 
+	return NumVisited;
+}
 
-void UPhysXInstancedWorldSubsystem::ProcessPendingAddActors()
+int32 UPhysXInstancedWorldSubsystem::ForEachInstanceInConvexVolume(
+	const FConvexVolume& Volume,
+	const FBox& VolumeBounds,
+	FInstanceVisitor Visitor,
+	UInstancedStaticMeshComponent* OptionalFilterComponent,
+	bool bIncludeStorage,
+	float InstanceRadius) const
 {
-	const int32 NumPending = PendingAddActors.Num() - PendingAddActorsHead;
-	if (NumPending <= 0)
-	{
-		PendingAddActors.Reset();
-		PendingAddActorsHead = 0;
-		return;
-	}
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_SelectionQuery);
 
-	UWorld* World = CachedWorld.Get();
-	if (!World)
-	{
-		World = GetWorld();
-		if (World)
+	int32 NumVisited = 0;
+	SpatialHash.ForEachInConvexVolume(Volume, VolumeBounds, InstanceRadius,
+		[&](FPhysXInstanceID ID, const FVector& /*Location*/)
 		{
-			CachedWorld = World;
-		}
-	}
-	if (!World)
-	{
-		return;
-	}
+			const FPhysXInstanceData* Data = Instances.Find(ID);
+			if (!Data || !IsSpatialQueryCandidate(*Data, OptionalFilterComponent, bIncludeStorage))
+			{
+				return true;
+			}
 
-	int32 Budget = MaxAddActorsPerFrame;
-	Budget = (Budget <= 0) ? NumPending : FMath::Min(Budget, NumPending);
+			++NumVisited;
+			return Visitor(ID);
+		});
 
-	const int32 EndIndex = PendingAddActorsHead + Budget;
+	return NumVisited;
+}
 
-	for (int32 Index = PendingAddActorsHead; Index < EndIndex; ++Index)
-	{
-		FPendingAddActorEntry& Entry = PendingAddActors[Index];
+int32 UPhysXInstancedWorldSubsystem::ForEachInstanceInCone(
+	const FVector& Origin,
+	const FVector& Direction,
+	float HalfAngleDegrees,
+	float Length,
+	FInstanceVisitor Visitor,
+	UInstancedStaticMeshComponent* OptionalFilterComponent,
+	bool bIncludeStorage) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_SelectionQuery);
 
-		if (!Entry.ID.IsValid())
+	int32 NumVisited = 0;
+	SpatialHash.ForEachInCone(Origin, Direction, FMath::DegreesToRadians(HalfAngleDegrees), Length,
+		[&](FPhysXInstanceID ID, const FVector& /*Location*/)
 		{
-			continue;
-		}
+			const FPhysXInstanceData* Data = Instances.Find(ID);
+			if (!Data || !IsSpatialQueryCandidate(*Data, OptionalFilterComponent, bIncludeStorage))
+			{
+				return true;
+			}
 
-		UInstancedStaticMeshComponent* ISMC = Entry.InstancedComponent.Get();
-		if (!ISMC || !ISMC->IsValidLowLevelFast())
-		{
-			continue;
-		}
+			++NumVisited;
+			return Visitor(ID);
+		});
 
-		UWorld* EntryWorld = Entry.World.Get();
-		if (!EntryWorld || EntryWorld != World)
-		{
-			continue;
-		}
+	return NumVisited;
+}
 
-		FPhysXInstanceData* Data = Instances.Find(Entry.ID);
-		if (!Data)
+int32 UPhysXInstancedWorldSubsystem::ForEachInstance(FInstanceVisitor Visitor) const
+{
+	int32 NumVisited = 0;
+	for (const TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
+	{
+		++NumVisited;
+		if (!Visitor(Pair.Key))
 		{
-			Entry.ID = FPhysXInstanceID(); // stale entry
-			continue;
+			break;
 		}
+	}
 
-		// IMPORTANT(PXIS_DEFERRED_ADD):
-		// Body might have been destroyed/replaced after enqueue but before processing.
-		if (!Data->Body.GetPxActor())
+	return NumVisited;
+}
+
+int32 UPhysXInstancedWorldSubsystem::ForEachInstanceOfActor(FPhysXActorID ActorID, FInstanceVisitor Visitor) const
+{
+	const FPhysXActorData* ActorData = Actors.Find(ActorID);
+	APhysXInstancedMeshActor* Actor = ActorData ? ActorData->Actor.Get() : nullptr;
+	if (!Actor)
+	{
+		return 0;
+	}
+
+	// Walk all instances and visit those whose ISM owner is this actor.
+	int32 NumVisited = 0;
+	for (const TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
+	{
+		UInstancedStaticMeshComponent* ISMC = Pair.Value.InstancedComponent.Get();
+		if (!ISMC || ISMC->GetOwner() != Actor)
 		{
-			Entry.ID = FPhysXInstanceID(); // prevent repeated retries/budget waste
 			continue;
 		}
 
-		Data->Body.AddActorToScene(EntryWorld);
-		
-		// Ensure userData is still correct after deferred scene insertion.
-		EnsureInstanceUserData(Entry.ID);
-		// Force-start simulation for instances that were registered as simulating.
-		// This fixes Manual/Grid bodies that may enter the scene sleeping and never wake.
-		if (Data->bSimulating)
+		++NumVisited;
+		if (!Visitor(Pair.Key))
 		{
-			if (physx::PxRigidActor* PxActor = Data->Body.GetPxActor())
-			{
-				if (physx::PxRigidDynamic* RD = PxActor->is<physx::PxRigidDynamic>())
-				{
-					RD->setActorFlag(physx::PxActorFlag::eDISABLE_SIMULATION, false);
-					RD->setRigidBodyFlag(physx::PxRigidBodyFlag::eKINEMATIC, false);
-					RD->wakeUp();
-				}
-			}
+			break;
 		}
 	}
 
-	PendingAddActorsHead = EndIndex;
+	return NumVisited;
+}
 
-	if (PendingAddActorsHead >= PendingAddActors.Num())
-	{
-		PendingAddActors.Reset();
-		PendingAddActorsHead = 0;
-	}
-	else if (PendingAddActorsHead > 1024 && PendingAddActorsHead * 2 >= PendingAddActors.Num())
+int32 UPhysXInstancedWorldSubsystem::OverlapSphereInstanceIDs(
+	const FVector& CenterWorld,
+	float Radius,
+	TArrayView<FPhysXInstanceID> OutIDs,
+	bool bIncludeStorage,
+	ECollisionChannel TraceChannel) const
+{
+	int32 NumWritten = 0;
+	if (OutIDs.Num() == 0)
 	{
-		PendingAddActors.RemoveAt(0, PendingAddActorsHead, /*bAllowShrinking=*/false);
-		PendingAddActorsHead = 0;
+		return 0;
 	}
-}
 
+	ForEachInstanceOverlappingSphere(CenterWorld, Radius,
+		[&](FPhysXInstanceID ID)
+		{
+			OutIDs[NumWritten++] = ID;
+			return NumWritten < OutIDs.Num();
+		},
+		bIncludeStorage, TraceChannel);
 
-int32 UPhysXInstancedWorldSubsystem::GetMaxAddActorsPerFrame() const
-{
-	return MaxAddActorsPerFrame;
-}
-
-void UPhysXInstancedWorldSubsystem::SetMaxAddActorsPerFrame(int32 NewMax)
-{
-	MaxAddActorsPerFrame = FMath::Max(0, NewMax);
+	return NumWritten;
 }
 
-void UPhysXInstancedWorldSubsystem::EnqueueInstanceTask(const FPhysXInstanceTask& Task)
+int32 UPhysXInstancedWorldSubsystem::FindInstancesInRadius(
+	const FVector& Center,
+	float Radius,
+	TArrayView<FPhysXInstanceID> OutIDs,
+	UInstancedStaticMeshComponent* OptionalFilterComponent,
+	bool bIncludeStorage) const
 {
-	if (!Task.ID.IsValid())
+	int32 NumWritten = 0;
+	if (OutIDs.Num() == 0)
 	{
-		return;
+		return 0;
 	}
 
-	PendingInstanceTasks.Add(Task);
+	ForEachInstanceInRadius(Center, Radius,
+		[&](FPhysXInstanceID ID)
+		{
+			OutIDs[NumWritten++] = ID;
+			return NumWritten < OutIDs.Num();
+		},
+		OptionalFilterComponent, bIncludeStorage);
+
+	return NumWritten;
 }
 
-void UPhysXInstancedWorldSubsystem::ProcessInstanceTasks()
+int32 UPhysXInstancedWorldSubsystem::RaycastInstancesBatch(
+	TArrayView<const FPhysXInstanceRaycastRequest> Rays,
+	TArrayView<FPhysXInstanceQueryHit> OutHits,
+	bool bIncludeStorage,
+	ECollisionChannel TraceChannel) const
 {
-	if (PendingInstanceTasks.Num() == 0)
+	const int32 NumRays = FMath::Min(Rays.Num(), OutHits.Num());
+	if (NumRays == 0)
 	{
-		return;
+		return 0;
 	}
 
-#if !PHYSICS_INTERFACE_PHYSX
-	// No PhysX: tasks cannot be executed.
-	PendingInstanceTasks.Reset();
-	return;
-#else
-
-	const int32 Budget = (MaxInstanceTasksPerFrame <= 0)
-		? TNumericLimits<int32>::Max()
-		: MaxInstanceTasksPerFrame;
-
-	// Prevent infinite growth if something is permanently broken.
-	static const int32 MaxAttempts = 600; // ~10s at 60 FPS
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_BatchQuery);
+	INC_DWORD_STAT_BY(STAT_PhysXInstanced_BatchQueryCount, NumRays);
 
-	int32 Executed = 0;
+#if PHYSICS_INTERFACE_PHYSX
+	UWorld* World = GetWorld();
+	physx::PxScene* PxScenePtr = World ? GetPhysXSceneFromWorld(World) : nullptr;
+#endif
 
-	TArray<FPhysXInstanceTask> Remaining;
-	Remaining.Reserve(PendingInstanceTasks.Num());
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumRays, BatchQueryChunkSize);
 
-	for (FPhysXInstanceTask& Task : PendingInstanceTasks)
+	// Storage lookups only read the BVH and the instance map; nothing mutates them while we wait here.
+	auto TraceChunk = [&](int32 ChunkIndex)
 	{
-		const bool bCanAttempt = (Executed < Budget);
+		const int32 Begin = ChunkIndex * BatchQueryChunkSize;
+		const int32 End   = FMath::Min(Begin + BatchQueryChunkSize, NumRays);
 
-		if (bCanAttempt)
+#if PHYSICS_INTERFACE_PHYSX
+		if (PxScenePtr)
 		{
-			if (TryExecuteInstanceTask(Task))
+			PxScenePtr->lockRead();
+		}
+#endif
+
+		for (int32 RayIndex = Begin; RayIndex < End; ++RayIndex)
+		{
+			const FPhysXInstanceRaycastRequest& Ray = Rays[RayIndex];
+			FPhysXInstanceQueryHit& Out = OutHits[RayIndex];
+			Out = FPhysXInstanceQueryHit();
+
+#if PHYSICS_INTERFACE_PHYSX
+			if (PxScenePtr)
 			{
-				++Executed;
-				continue; // consumed (success or dropped)
+				RaycastPhysXScene_Internal(*PxScenePtr, Ray.Start, Ray.End, Out);
 			}
+#endif
 
-			// Not ready yet -> keep for retry
-			++Task.Attempts;
-			if (Task.Attempts > MaxAttempts)
+			if (bIncludeStorage)
 			{
-				UE_LOG(LogTemp, Warning,
-					TEXT("[PhysXInstanced] Task dropped (too many retries). Type=%d ID=%u"),
-					(int32)Task.Type, Task.ID.GetUniqueID());
-				continue; // drop
+				FPhysXInstanceID StorageID;
+				FHitResult       StorageHit;
+
+				if (SweepStorage_Internal(Ray.Start, Ray.End, FCollisionShape::LineShape, FQuat::Identity, TraceChannel, StorageID, StorageHit) &&
+					(!Out.IsHit() || StorageHit.Distance < Out.Distance))
+				{
+					Out.InstanceID = StorageID;
+					Out.Distance   = StorageHit.Distance;
+					Out.Location   = StorageHit.ImpactPoint;
+					Out.Normal     = StorageHit.ImpactNormal;
+					Out.bStorage   = true;
+				}
 			}
 		}
 
-		Remaining.Add(Task);
+#if PHYSICS_INTERFACE_PHYSX
+		if (PxScenePtr)
+		{
+			PxScenePtr->unlockRead();
+		}
+#endif
+	};
+
+	const bool bParallel = CVarPhysXInstancedUseParallelQueries.GetValueOnAnyThread() != 0 && NumChunks > 1;
+	ParallelFor(NumChunks, TraceChunk, /*bForceSingleThread=*/!bParallel);
+
+	int32 NumHits = 0;
+	for (int32 RayIndex = 0; RayIndex < NumRays; ++RayIndex)
+	{
+		NumHits += OutHits[RayIndex].IsHit() ? 1 : 0;
 	}
 
-	PendingInstanceTasks = MoveTemp(Remaining);
+	return NumHits;
+}
 
-#endif // PHYSICS_INTERFACE_PHYSX
+int32 UPhysXInstancedWorldSubsystem::RaycastInstanceIDsBatch(
+	const TArray<FPhysXInstanceRaycastRequest>& Rays,
+	TArray<FPhysXInstanceQueryHit>& OutHits,
+	bool bIncludeStorage,
+	ECollisionChannel TraceChannel) const
+{
+	OutHits.SetNum(Rays.Num());
+	return RaycastInstancesBatch(Rays, OutHits, bIncludeStorage, TraceChannel);
 }
 
 #if PHYSICS_INTERFACE_PHYSX
-bool UPhysXInstancedWorldSubsystem::TryExecuteInstanceTask(FPhysXInstanceTask& Task)
+/** PhysX geometry and orientation for a shape query. Capsules are rotated from PhysX X-up to UE Z-up. */
+static bool MakeShapeQueryGeometry(
+	const FPhysXInstanceShapeQuery& Query,
+	physx::PxGeometryHolder& OutGeometry,
+	physx::PxQuat& OutRotation)
 {
-	FPhysXInstanceData* Data = Instances.Find(Task.ID);
-	if (!Data)
-	{
-		return true; // drop: unknown ID
-	}
-
-	UInstancedStaticMeshComponent* ISMC = Data->InstancedComponent.Get();
-	if (!ISMC || !ISMC->IsValidLowLevelFast())
-	{
-		return true; // drop: component is gone
-	}
+	const FQuat Rotation = Query.Rotation.Quaternion();
 
-	// Storage handling (same semantics as your Advanced functions).
-	if (IsOwnerStorageActor(ISMC))
+	switch (Query.Shape)
 	{
-		if (!Task.bIncludeStorage)
-		{
-			return true; // drop
-		}
-
-		if (!Task.bConvertStorageToDynamic)
+	case EPhysXInstanceQueryShape::Box:
+		if (Query.HalfExtent.GetMin() <= 0.0f)
 		{
-			return true; // drop
+			return false;
 		}
+		OutGeometry.storeAny(physx::PxBoxGeometry(U2PVector(Query.HalfExtent)));
+		OutRotation = U2PQuat(Rotation);
+		return true;
 
-		if (!ConvertStorageInstanceToDynamic(Task.ID, /*bCreateDynamicActorIfNeeded=*/true))
+	case EPhysXInstanceQueryShape::Capsule:
+		if (Query.Radius <= 0.0f)
 		{
-			return false; // retry later
+			return false;
 		}
+		OutGeometry.storeAny(physx::PxCapsuleGeometry(
+			(physx::PxReal)U2PScalar(Query.Radius),
+			(physx::PxReal)U2PScalar(FMath::Max(Query.HalfHeight - Query.Radius, KINDA_SMALL_NUMBER))));
+		OutRotation = U2PQuat(Rotation * FQuat(FVector::RightVector, HALF_PI));
+		return true;
 
-		// Refresh after conversion.
-		Data = Instances.Find(Task.ID);
-		if (!Data)
+	case EPhysXInstanceQueryShape::Sphere:
+	default:
+		if (Query.Radius <= 0.0f)
 		{
-			return true; // drop
+			return false;
 		}
+		OutGeometry.storeAny(physx::PxSphereGeometry((physx::PxReal)U2PScalar(Query.Radius)));
+		OutRotation = physx::PxQuat(physx::PxIdentity);
+		return true;
 	}
+}
+#endif // PHYSICS_INTERFACE_PHYSX
 
-	// Ensure body exists for dynamic tasks.
-	if (!Data->Body.GetPxActor())
-	{
-		if (!SetInstancePhysicsEnabled(Task.ID, /*bEnable=*/true, /*bDestroyBodyIfDisabling=*/false))
-		{
-			return false; // retry later
-		}
-	}
+int32 UPhysXInstancedWorldSubsystem::OverlapInstancesBatch(
+	TArrayView<const FPhysXInstanceShapeQuery> Queries,
+	FPhysXInstanceOverlapBatchResult& OutResult,
+	bool bIncludeStorage,
+	ECollisionChannel TraceChannel) const
+{
+	const int32 NumQueries = Queries.Num();
 
-	physx::PxRigidActor* RA = Data->Body.GetPxActor();
-	physx::PxRigidDynamic* RD = RA ? RA->is<physx::PxRigidDynamic>() : nullptr;
-	if (!RD)
-	{
-		return false; // retry (body creation might still be pending)
-	}
+	OutResult.InstanceIDs.Reset();
+	OutResult.Offsets.SetNumZeroed(NumQueries);
+	OutResult.Counts.SetNumZeroed(NumQueries);
 
-	// Critical: execute only when inserted into a scene.
-	// This solves all "pending add" issues for both impulses and forces.
-	if (!RD->getScene())
+	if (NumQueries == 0)
 	{
-		return false; // retry later
+		return 0;
 	}
 
-	using FTaskHandler = bool (UPhysXInstancedWorldSubsystem::*)(FPhysXInstanceTask&, physx::PxRigidDynamic*);
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_BatchQuery);
+	INC_DWORD_STAT_BY(STAT_PhysXInstanced_BatchQueryCount, NumQueries);
 
-	static const FTaskHandler Handlers[] =
-	{
-		&UPhysXInstancedWorldSubsystem::HandleInstanceTask_AddImpulse,  // AddImpulse
-		&UPhysXInstancedWorldSubsystem::HandleInstanceTask_AddForce,    // AddForce
-		&UPhysXInstancedWorldSubsystem::HandleInstanceTask_PutToSleep,  // PutToSleep
-		&UPhysXInstancedWorldSubsystem::HandleInstanceTask_WakeUp       // WakeUp
-	};
+#if PHYSICS_INTERFACE_PHYSX
+	UWorld* World = GetWorld();
+	physx::PxScene* PxScenePtr = World ? GetPhysXSceneFromWorld(World) : nullptr;
+#endif
 
-	static_assert(UE_ARRAY_COUNT(Handlers) == (int32)EPhysXInstanceTaskType::Count, "Instance task handler table mismatch.");
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumQueries, BatchQueryChunkSize);
 
-	const int32 TypeIndex = (int32)Task.Type;
-	if (TypeIndex < 0 || TypeIndex >= (int32)EPhysXInstanceTaskType::Count)
-	{
-		return true;
-	}
+	// Each chunk writes its own ID list; the lists are stitched together in query order afterwards.
+	TArray<TArray<FPhysXInstanceID>> ChunkIDs;
+	ChunkIDs.SetNum(NumChunks);
 
-	FTaskHandler Handler = Handlers[TypeIndex];
-	if (!Handler)
+	auto OverlapChunk = [&](int32 ChunkIndex)
 	{
-		return true;
-	}
+		const int32 Begin = ChunkIndex * BatchQueryChunkSize;
+		const int32 End   = FMath::Min(Begin + BatchQueryChunkSize, NumQueries);
 
-	return (this->*Handler)(Task, RD);
+		TArray<FPhysXInstanceID>& IDs = ChunkIDs[ChunkIndex];
 
-}
-#endif // PHYSICS_INTERFACE_PHYSX
+		// Per-chunk: the subsystem visit stamps are game thread only.
+		TSet<FPhysXInstanceID> SeenIDs;
 
-bool UPhysXInstancedWorldSubsystem::RaycastPhysXInstanceID(
-const FVector& StartWorld,
-const FVector& EndWorld,
-FPhysXInstanceID& OutID,
-EPhysXInstancedQueryDebugMode DebugMode,
-float DebugDrawDuration) const
-{
-#if !PHYSICS_INTERFACE_PHYSX
-	OutID = FPhysXInstanceID();
-	return false;
-#else
-	OutID = FPhysXInstanceID();
+#if PHYSICS_INTERFACE_PHYSX
+		if (PxScenePtr)
+		{
+			PxScenePtr->lockRead();
+		}
+#endif
 
-	float DistUU = TNumericLimits<float>::Max();
-	FVector HitPos = FVector::ZeroVector;
-	FVector HitNormal = FVector::UpVector;
+		for (int32 QueryIndex = Begin; QueryIndex < End; ++QueryIndex)
+		{
+			const FPhysXInstanceShapeQuery& Query = Queries[QueryIndex];
+			const int32 First = IDs.Num();
 
-	const bool bHit = RaycastPhysXInstanceID_Internal(StartWorld, EndWorld, OutID, DistUU, HitPos, HitNormal);
+			// Dynamic and storage sets never intersect, so an ID can only repeat within one source.
+#if PHYSICS_INTERFACE_PHYSX
+			physx::PxGeometryHolder Geometry;
+			physx::PxQuat           Rotation;
 
-#if ENABLE_DRAW_DEBUG
-	if (IsDebugEnabled(DebugMode))
-	{
-		UWorld* World = GetWorld();
-		DrawLineSafe(World, StartWorld, EndWorld, bHit ? FColor::Green : FColor::Red, DebugDrawDuration);
+			if (PxScenePtr && MakeShapeQueryGeometry(Query, Geometry, Rotation))
+			{
+				SeenIDs.Reset();
 
-		if (bHit)
-		{
-			DrawPointSafe(World, HitPos, FColor::Green, DebugDrawDuration);
+				OverlapPhysXScene_Internal(*PxScenePtr, Geometry.any(), physx::PxTransform(U2PVector(Query.Start), Rotation),
+					[&IDs, &SeenIDs](FPhysXInstanceID ID)
+					{
+						// A multi-shape body reports one touch per shape.
+						bool bAlreadySeen = false;
+						SeenIDs.Add(ID, &bAlreadySeen);
+						if (!bAlreadySeen)
+						{
+							IDs.Add(ID);
+						}
+						return true;
+					});
+			}
+#endif
 
-			if (DebugMode == EPhysXInstancedQueryDebugMode::Detailed)
+			if (bIncludeStorage)
 			{
-				DrawArrowSafe(World, HitPos, HitPos + HitNormal.GetSafeNormal() * 30.0f, FColor::Cyan, DebugDrawDuration);
-
-				const FString Label = FString::Printf(TEXT("PhysX ID=%u Dist=%.1f"), OutID.GetUniqueID(), DistUU);
-				DrawTextSafe(World, HitPos + FVector(0, 0, 10.0f), Label, FColor::White, DebugDrawDuration);
+				OverlapStorageShape_Internal(Query, TraceChannel, [&IDs](FPhysXInstanceID ID) { IDs.Add(ID); return true; });
 			}
+
+			OutResult.Counts[QueryIndex] = IDs.Num() - First;
 		}
-	}
-#endif
 
-	return bHit;
+#if PHYSICS_INTERFACE_PHYSX
+		if (PxScenePtr)
+		{
+			PxScenePtr->unlockRead();
+		}
 #endif
+	};
+
+	const bool bParallel = CVarPhysXInstancedUseParallelQueries.GetValueOnAnyThread() != 0 && NumChunks > 1;
+	ParallelFor(NumChunks, OverlapChunk, /*bForceSingleThread=*/!bParallel);
+
+	int32 Total = 0;
+	for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+	{
+		OutResult.Offsets[QueryIndex] = Total;
+		Total += OutResult.Counts[QueryIndex];
+	}
+
+	OutResult.InstanceIDs.Reserve(Total);
+	for (const TArray<FPhysXInstanceID>& IDs : ChunkIDs)
+	{
+		OutResult.InstanceIDs.Append(IDs);
+	}
+
+	return Total;
 }
 
-bool UPhysXInstancedWorldSubsystem::RaycastInstanceID(
-	const FVector& StartWorld,
-	const FVector& EndWorld,
-	FPhysXInstanceID& OutID,
+int32 UPhysXInstancedWorldSubsystem::OverlapInstanceIDsBatch(
+	const TArray<FPhysXInstanceShapeQuery>& Queries,
+	FPhysXInstanceOverlapBatchResult& OutResult,
 	bool bIncludeStorage,
-	ECollisionChannel TraceChannel,
-	EPhysXInstancedQueryDebugMode DebugMode,
-	float DebugDrawDuration) const
+	ECollisionChannel TraceChannel) const
 {
-	OutID = FPhysXInstanceID();
+	return OverlapInstancesBatch(Queries, OutResult, bIncludeStorage, TraceChannel);
+}
 
-	UWorld* World = GetWorld();
-	if (!World)
+int32 UPhysXInstancedWorldSubsystem::SweepInstancesBatch(
+	TArrayView<const FPhysXInstanceShapeQuery> Queries,
+	TArrayView<FPhysXInstanceQueryHit> OutHits,
+	bool bIncludeStorage,
+	ECollisionChannel TraceChannel) const
+{
+	const int32 NumQueries = FMath::Min(Queries.Num(), OutHits.Num());
+	if (NumQueries == 0)
 	{
-		return false;
+		return 0;
 	}
 
-	FPhysXInstanceID BestID;
-	float BestDistUU = TNumericLimits<float>::Max();
-
-	bool bPhysXHit = false;
-	FPhysXInstanceID PhysXID;
-	float PhysXDistUU = TNumericLimits<float>::Max();
-	FVector PhysXHitPos = FVector::ZeroVector;
-	FVector PhysXHitNormal = FVector::UpVector;
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_BatchQuery);
+	INC_DWORD_STAT_BY(STAT_PhysXInstanced_BatchQueryCount, NumQueries);
 
 #if PHYSICS_INTERFACE_PHYSX
-	bPhysXHit = RaycastPhysXInstanceID_Internal(StartWorld, EndWorld, PhysXID, PhysXDistUU, PhysXHitPos, PhysXHitNormal);
-	if (bPhysXHit)
-	{
-		BestID = PhysXID;
-		BestDistUU = PhysXDistUU;
-	}
+	UWorld* World = GetWorld();
+	physx::PxScene* PxScenePtr = World ? GetPhysXSceneFromWorld(World) : nullptr;
 #endif
 
-	bool bTraceHit = false;
-	FHitResult Hit;
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumQueries, BatchQueryChunkSize);
 
-	if (bIncludeStorage)
+	auto SweepChunk = [&](int32 ChunkIndex)
 	{
-		FCollisionQueryParams Params(SCENE_QUERY_STAT(PhysXInstanced_RaycastInstanceID), true);
+		const int32 Begin = ChunkIndex * BatchQueryChunkSize;
+		const int32 End   = FMath::Min(Begin + BatchQueryChunkSize, NumQueries);
+
+#if PHYSICS_INTERFACE_PHYSX
+		if (PxScenePtr)
+		{
+			PxScenePtr->lockRead();
+		}
+#endif
 
-		if (World->LineTraceSingleByChannel(Hit, StartWorld, EndWorld, TraceChannel, Params))
+		for (int32 QueryIndex = Begin; QueryIndex < End; ++QueryIndex)
 		{
-			if (UInstancedStaticMeshComponent* ISMC = Cast<UInstancedStaticMeshComponent>(Hit.GetComponent()))
+			const FPhysXInstanceShapeQuery& Query = Queries[QueryIndex];
+			FPhysXInstanceQueryHit& Out = OutHits[QueryIndex];
+			Out = FPhysXInstanceQueryHit();
+
+#if PHYSICS_INTERFACE_PHYSX
+			physx::PxGeometryHolder Geometry;
+			physx::PxQuat           Rotation;
+
+			if (PxScenePtr && MakeShapeQueryGeometry(Query, Geometry, Rotation))
 			{
-				const int32 HitIndex = Hit.Item;
-				if (HitIndex != INDEX_NONE)
-				{
-					const FPhysXInstanceID ID = GetInstanceIDForComponentAndIndex(ISMC, HitIndex);
-					if (ID.IsValid())
-					{
-						bTraceHit = true;
+				SweepPhysXScene_Internal(*PxScenePtr, Geometry.any(), Rotation, Query.Start, Query.End, Out);
+			}
+#endif
 
-						if (!BestID.IsValid() || Hit.Distance < BestDistUU)
-						{
-							BestID = ID;
-							BestDistUU = Hit.Distance;
-						}
-					}
+			if (bIncludeStorage)
+			{
+				FPhysXInstanceID StorageID;
+				FHitResult       StorageHit;
+
+				if (SweepStorage_Internal(Query.Start, Query.End, Query.ToCollisionShape(), Query.Rotation.Quaternion(), TraceChannel, StorageID, StorageHit) &&
+					(!Out.IsHit() || StorageHit.Distance < Out.Distance))
+				{
+					Out.InstanceID = StorageID;
+					Out.Distance   = StorageHit.Distance;
+					Out.Location   = StorageHit.ImpactPoint;
+					Out.Normal     = StorageHit.ImpactNormal;
+					Out.bStorage   = true;
 				}
 			}
 		}
+
+#if PHYSICS_INTERFACE_PHYSX
+		if (PxScenePtr)
+		{
+			PxScenePtr->unlockRead();
+		}
+#endif
+	};
+
+	const bool bParallel = CVarPhysXInstancedUseParallelQueries.GetValueOnAnyThread() != 0 && NumChunks > 1;
+	ParallelFor(NumChunks, SweepChunk, /*bForceSingleThread=*/!bParallel);
+
+	int32 NumHits = 0;
+	for (int32 QueryIndex = 0; QueryIndex < NumQueries; ++QueryIndex)
+	{
+		NumHits += OutHits[QueryIndex].IsHit() ? 1 : 0;
 	}
 
-	const bool bHitAny = BestID.IsValid();
-	if (bHitAny)
+	return NumHits;
+}
+
+int32 UPhysXInstancedWorldSubsystem::SweepInstanceIDsBatch(
+	const TArray<FPhysXInstanceShapeQuery>& Queries,
+	TArray<FPhysXInstanceQueryHit>& OutHits,
+	bool bIncludeStorage,
+	ECollisionChannel TraceChannel) const
+{
+	OutHits.SetNum(Queries.Num());
+	return SweepInstancesBatch(Queries, OutHits, bIncludeStorage, TraceChannel);
+}
+
+// ============================================================================
+// Async queries
+// ============================================================================
+
+TFuture<FPhysXInstanceQueryHit> UPhysXInstancedWorldSubsystem::RaycastInstanceIDAsync(
+	const FVector& Start,
+	const FVector& End,
+	bool bIncludeStorage,
+	ECollisionChannel TraceChannel)
+{
+	FAsyncRaycastQuery Query;
+	Query.Input.Start     = Start;
+	Query.Input.End       = End;
+	Query.bIncludeStorage = bIncludeStorage;
+	Query.TraceChannel    = TraceChannel;
+
+	TFuture<FPhysXInstanceQueryHit> Future = Query.Promise.GetFuture();
 	{
-		OutID = BestID;
+		FScopeLock Lock(&AsyncQueryLock);
+		if (bAcceptAsyncQueries)
+		{
+			PendingAsyncRaycasts.Add(MoveTemp(Query));
+			return Future;
+		}
 	}
 
-#if ENABLE_DRAW_DEBUG
-	if (IsDebugEnabled(DebugMode))
-	{
-		DrawLineSafe(World, StartWorld, EndWorld, bHitAny ? FColor::Green : FColor::Red, DebugDrawDuration);
+	// Outside the lock: continuations may queue new requests.
+	Query.Promise.SetValue(FPhysXInstanceQueryHit());
+	return Future;
+}
 
-		if (DebugMode == EPhysXInstancedQueryDebugMode::Detailed)
-		{
-			if (bPhysXHit)
-			{
-				DrawPointSafe(World, PhysXHitPos, FColor::Cyan, DebugDrawDuration);
-				DrawArrowSafe(World, PhysXHitPos, PhysXHitPos + PhysXHitNormal.GetSafeNormal() * 30.0f, FColor::Cyan, DebugDrawDuration);
-				DrawTextSafe(World, PhysXHitPos + FVector(0, 0, 10.0f),
-					FString::Printf(TEXT("PhysX ID=%u Dist=%.1f"), PhysXID.GetUniqueID(), PhysXDistUU),
-					FColor::Cyan, DebugDrawDuration);
-			}
+TFuture<FPhysXInstanceQueryHit> UPhysXInstancedWorldSubsystem::SweepInstanceIDAsync(
+	const FPhysXInstanceShapeQuery& ShapeQuery,
+	bool bIncludeStorage,
+	ECollisionChannel TraceChannel)
+{
+	FAsyncSweepQuery Query;
+	Query.Input           = ShapeQuery;
+	Query.bIncludeStorage = bIncludeStorage;
+	Query.TraceChannel    = TraceChannel;
 
-			if (bTraceHit)
-			{
-				DrawPointSafe(World, Hit.ImpactPoint, FColor::Yellow, DebugDrawDuration);
-				DrawArrowSafe(World, Hit.ImpactPoint, Hit.ImpactPoint + Hit.ImpactNormal.GetSafeNormal() * 30.0f, FColor::Yellow, DebugDrawDuration);
-				DrawTextSafe(World, Hit.ImpactPoint + FVector(0, 0, 10.0f),
-					FString::Printf(TEXT("Trace ID=%u Dist=%.1f"), OutID.GetUniqueID(), Hit.Distance),
-					FColor::Yellow, DebugDrawDuration);
-			}
-		}
-		else if (bHitAny)
+	TFuture<FPhysXInstanceQueryHit> Future = Query.Promise.GetFuture();
+	{
+		FScopeLock Lock(&AsyncQueryLock);
+		if (bAcceptAsyncQueries)
 		{
-			// Basic: mark only the chosen hit.
-			const FVector MarkPos =
-				(bPhysXHit && OutID == PhysXID) ? PhysXHitPos :
-				(bTraceHit ? Hit.ImpactPoint : (StartWorld + (EndWorld - StartWorld).GetSafeNormal() * BestDistUU));
-
-			DrawPointSafe(World, MarkPos, FColor::Green, DebugDrawDuration);
+			PendingAsyncSweeps.Add(MoveTemp(Query));
+			return Future;
 		}
 	}
-#endif
 
-	return bHitAny;
+	Query.Promise.SetValue(FPhysXInstanceQueryHit());
+	return Future;
 }
 
-
-bool UPhysXInstancedWorldSubsystem::SweepSphereInstanceID(
-	const FVector& StartWorld,
-	const FVector& EndWorld,
-	float Radius,
-	FPhysXInstanceID& OutID,
+TFuture<TArray<FPhysXInstanceID>> UPhysXInstancedWorldSubsystem::OverlapInstanceIDsAsync(
+	const FPhysXInstanceShapeQuery& ShapeQuery,
 	bool bIncludeStorage,
-	ECollisionChannel TraceChannel,
-	EPhysXInstancedQueryDebugMode DebugMode,
-	float DebugDrawDuration) const
+	ECollisionChannel TraceChannel)
 {
-	OutID = FPhysXInstanceID();
+	FAsyncOverlapQuery Query;
+	Query.Input           = ShapeQuery;
+	Query.bIncludeStorage = bIncludeStorage;
+	Query.TraceChannel    = TraceChannel;
 
-	UWorld* World = GetWorld();
-	if (!World || Radius <= 0.0f)
+	TFuture<TArray<FPhysXInstanceID>> Future = Query.Promise.GetFuture();
 	{
-		return false;
+		FScopeLock Lock(&AsyncQueryLock);
+		if (bAcceptAsyncQueries)
+		{
+			PendingAsyncOverlaps.Add(MoveTemp(Query));
+			return Future;
+		}
 	}
 
-	FPhysXInstanceID BestID;
-	float BestDistUU = TNumericLimits<float>::Max();
+	Query.Promise.SetValue(TArray<FPhysXInstanceID>());
+	return Future;
+}
 
-	// --- Storage / UE sweep ---
-	bool bTraceHit = false;
-	FHitResult TraceHit;
+TFuture<TArray<FPhysXInstanceNearestHit>> UPhysXInstancedWorldSubsystem::FindKNearestInstancesAsync(
+	const FVector& WorldLocation,
+	int32 K,
+	FPhysXInstanceID IgnoreInstanceID,
+	bool bIncludeStorage,
+	float MaxDistance)
+{
+	FAsyncNearestQuery Query;
+	Query.Location         = WorldLocation;
+	Query.K                = K;
+	Query.IgnoreInstanceID = IgnoreInstanceID;
+	Query.bIncludeStorage  = bIncludeStorage;
+	Query.MaxDistance      = MaxDistance;
 
-	if (bIncludeStorage)
+	TFuture<TArray<FPhysXInstanceNearestHit>> Future = Query.Promise.GetFuture();
+	if (K > 0)
 	{
-		FCollisionQueryParams Params(SCENE_QUERY_STAT(PhysXInstanced_SweepSphereInstanceID), true);
-		const FCollisionShape Shape = FCollisionShape::MakeSphere(Radius);
-
-		if (World->SweepSingleByChannel(TraceHit, StartWorld, EndWorld, FQuat::Identity, TraceChannel, Shape, Params))
+		FScopeLock Lock(&AsyncQueryLock);
+		if (bAcceptAsyncQueries)
 		{
-			if (UInstancedStaticMeshComponent* ISMC = Cast<UInstancedStaticMeshComponent>(TraceHit.GetComponent()))
-			{
-				const int32 HitIndex = TraceHit.Item;
-				if (HitIndex != INDEX_NONE)
-				{
-					const FPhysXInstanceID ID = GetInstanceIDForComponentAndIndex(ISMC, HitIndex);
-					if (ID.IsValid())
-					{
-						bTraceHit  = true;
-						BestID     = ID;
-						BestDistUU = TraceHit.Distance;
-					}
-				}
-			}
+			PendingAsyncNearest.Add(MoveTemp(Query));
+			return Future;
 		}
 	}
 
-	// --- PhysX sweep ---
-	bool bPhysXHit = false;
-	bool bBestFromPhysX = false;
+	Query.Promise.SetValue(TArray<FPhysXInstanceNearestHit>());
+	return Future;
+}
 
-	FPhysXInstanceID PhysXID;
-	float PhysXDistUU = TNumericLimits<float>::Max();
-	FVector PhysXHitPos = FVector::ZeroVector;
-	FVector PhysXHitNormal = FVector::UpVector;
+int32 UPhysXInstancedWorldSubsystem::GetNumPendingAsyncQueries() const
+{
+	FScopeLock Lock(&AsyncQueryLock);
+	return PendingAsyncRaycasts.Num() + PendingAsyncSweeps.Num() + PendingAsyncOverlaps.Num() + PendingAsyncNearest.Num();
+}
 
-#if PHYSICS_INTERFACE_PHYSX
-	if (SweepSpherePhysXInstanceID_Internal(StartWorld, EndWorld, Radius, PhysXID, PhysXDistUU, PhysXHitPos, PhysXHitNormal))
+void UPhysXInstancedWorldSubsystem::ProcessAsyncQueries()
+{
+	TArray<FAsyncRaycastQuery> Raycasts;
+	TArray<FAsyncSweepQuery>   Sweeps;
+	TArray<FAsyncOverlapQuery> Overlaps;
+	TArray<FAsyncNearestQuery> Nearest;
 	{
-		bPhysXHit = true;
+		FScopeLock Lock(&AsyncQueryLock);
 
-		if (!BestID.IsValid() || PhysXDistUU < BestDistUU)
-		{
-			BestID         = PhysXID;
-			BestDistUU     = PhysXDistUU;
-			bBestFromPhysX = true;
-		}
+		int32 Budget = MaxAsyncQueriesPerFrame > 0 ? MaxAsyncQueriesPerFrame : MAX_int32;
+		TakeAsyncQueries(PendingAsyncRaycasts, Raycasts, Budget);
+		TakeAsyncQueries(PendingAsyncSweeps,   Sweeps,   Budget);
+		TakeAsyncQueries(PendingAsyncOverlaps, Overlaps, Budget);
+		TakeAsyncQueries(PendingAsyncNearest,  Nearest,  Budget);
 	}
-#endif
 
-	const bool bHitAny = BestID.IsValid();
-	if (bHitAny)
+	const int32 NumQueries = Raycasts.Num() + Sweeps.Num() + Overlaps.Num() + Nearest.Num();
+	if (NumQueries == 0)
 	{
-		OutID = BestID;
+		return;
 	}
 
-#if ENABLE_DRAW_DEBUG
-	if (IsDebugEnabled(DebugMode))
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_AsyncQueries);
+	INC_DWORD_STAT_BY(STAT_PhysXInstanced_AsyncQueryCount, NumQueries);
+
+	// Each group is one batched query; promises are fulfilled right after their batch, on the game thread.
+	ForEachAsyncQueryGroup(Raycasts, &GetTraceQueryGroupKey<FAsyncRaycastQuery>, [this](TArrayView<FAsyncRaycastQuery> Group)
 	{
-		const FColor LineColor = bHitAny ? FColor::Green : FColor::Red;
+		TArray<FPhysXInstanceRaycastRequest> Rays;
+		Rays.Reserve(Group.Num());
+		for (const FAsyncRaycastQuery& Query : Group)
+		{
+			Rays.Add(Query.Input);
+		}
 
-		DrawSphereSafe(World, StartWorld, Radius, FColor::Silver, DebugDrawDuration, 1.0f);
-		DrawSphereSafe(World, EndWorld,   Radius, FColor::Silver, DebugDrawDuration, 1.0f);
-		DrawLineSafe(World, StartWorld, EndWorld, LineColor, DebugDrawDuration, 1.5f);
+		TArray<FPhysXInstanceQueryHit> Hits;
+		Hits.SetNum(Group.Num());
+		RaycastInstancesBatch(Rays, Hits, Group[0].bIncludeStorage, Group[0].TraceChannel);
 
-		if (DebugMode == EPhysXInstancedQueryDebugMode::Detailed)
+		for (int32 Index = 0; Index < Group.Num(); ++Index)
 		{
-			if (bTraceHit)
-			{
-				DrawPointSafe(World, TraceHit.ImpactPoint, FColor::Yellow, DebugDrawDuration);
-				DrawArrowSafe(World,
-					TraceHit.ImpactPoint,
-					TraceHit.ImpactPoint + TraceHit.ImpactNormal.GetSafeNormal() * 30.0f,
-					FColor::Yellow,
-					DebugDrawDuration);
+			Group[Index].Promise.SetValue(Hits[Index]);
+		}
+	});
 
-				DrawTextSafe(World,
-					TraceHit.ImpactPoint + FVector(0, 0, 10.0f),
-					FString::Printf(TEXT("Trace ID=%u Dist=%.1f"), BestID.IsValid() ? BestID.GetUniqueID() : 0u, TraceHit.Distance),
-					FColor::Yellow,
-					DebugDrawDuration);
-			}
+	ForEachAsyncQueryGroup(Sweeps, &GetTraceQueryGroupKey<FAsyncSweepQuery>, [this](TArrayView<FAsyncSweepQuery> Group)
+	{
+		TArray<FPhysXInstanceShapeQuery> Shapes;
+		Shapes.Reserve(Group.Num());
+		for (const FAsyncSweepQuery& Query : Group)
+		{
+			Shapes.Add(Query.Input);
+		}
 
-			if (bPhysXHit)
-			{
-				DrawPointSafe(World, PhysXHitPos, FColor::Cyan, DebugDrawDuration);
-				DrawArrowSafe(World,
-					PhysXHitPos,
-					PhysXHitPos + PhysXHitNormal.GetSafeNormal() * 30.0f,
-					FColor::Cyan,
-					DebugDrawDuration);
+		TArray<FPhysXInstanceQueryHit> Hits;
+		Hits.SetNum(Group.Num());
+		SweepInstancesBatch(Shapes, Hits, Group[0].bIncludeStorage, Group[0].TraceChannel);
 
-				DrawTextSafe(World,
-					PhysXHitPos + FVector(0, 0, 10.0f),
-					FString::Printf(TEXT("PhysX ID=%u Dist=%.1f"), PhysXID.GetUniqueID(), PhysXDistUU),
-					FColor::Cyan,
-					DebugDrawDuration);
-			}
+		for (int32 Index = 0; Index < Group.Num(); ++Index)
+		{
+			Group[Index].Promise.SetValue(Hits[Index]);
 		}
-		else if (bHitAny)
+	});
+
+	ForEachAsyncQueryGroup(Overlaps, &GetTraceQueryGroupKey<FAsyncOverlapQuery>, [this](TArrayView<FAsyncOverlapQuery> Group)
+	{
+		TArray<FPhysXInstanceShapeQuery> Shapes;
+		Shapes.Reserve(Group.Num());
+		for (const FAsyncOverlapQuery& Query : Group)
 		{
-			const FVector MarkPos = (bBestFromPhysX && bPhysXHit)
-				? PhysXHitPos
-				: (bTraceHit ? TraceHit.ImpactPoint : StartWorld);
+			Shapes.Add(Query.Input);
+		}
 
-			DrawPointSafe(World, MarkPos, FColor::Green, DebugDrawDuration);
+		FPhysXInstanceOverlapBatchResult Result;
+		OverlapInstancesBatch(Shapes, Result, Group[0].bIncludeStorage, Group[0].TraceChannel);
+
+		for (int32 Index = 0; Index < Group.Num(); ++Index)
+		{
+			const TArrayView<const FPhysXInstanceID> IDs = Result.GetQueryResults(Index);
+			Group[Index].Promise.SetValue(TArray<FPhysXInstanceID>(IDs.GetData(), IDs.Num()));
 		}
-	}
-#endif
+	});
 
-	return bHitAny;
+	// K and MaxDistance are per batch, so they join the storage flag in the key.
+	auto GetNearestGroupKey = [](const FAsyncNearestQuery& Query)
+	{
+		uint32 MaxDistanceBits = 0;
+		if (Query.MaxDistance > 0.0f)
+		{
+			FMemory::Memcpy(&MaxDistanceBits, &Query.MaxDistance, sizeof(MaxDistanceBits));
+		}
+		return (uint64(MaxDistanceBits) << 32) | (uint64(uint32(Query.K)) << 1) | (Query.bIncludeStorage ? 1u : 0u);
+	};
+
+	ForEachAsyncQueryGroup(Nearest, GetNearestGroupKey, [this](TArrayView<FAsyncNearestQuery> Group)
+	{
+		TArray<FVector>          Locations;
+		TArray<FPhysXInstanceID> IgnoreIDs;
+		Locations.Reserve(Group.Num());
+		IgnoreIDs.Reserve(Group.Num());
+		for (const FAsyncNearestQuery& Query : Group)
+		{
+			Locations.Add(Query.Location);
+			IgnoreIDs.Add(Query.IgnoreInstanceID);
+		}
+
+		FPhysXInstanceNearestBatchResult Result;
+		FindKNearestInstancesBatch(Locations, Group[0].K, Result, nullptr, IgnoreIDs, Group[0].bIncludeStorage, Group[0].MaxDistance);
+
+		for (int32 Index = 0; Index < Group.Num(); ++Index)
+		{
+			const TArrayView<const FPhysXInstanceNearestHit> Hits = Result.GetQueryResults(Index);
+			Group[Index].Promise.SetValue(TArray<FPhysXInstanceNearestHit>(Hits.GetData(), Hits.Num()));
+		}
+	});
 }
 
-bool UPhysXInstancedWorldSubsystem::OverlapSphereInstanceIDs(
-	const FVector& CenterWorld,
-	float Radius,
-	TArray<FPhysXInstanceID>& OutIDs,
-	bool bIncludeStorage,
-	ECollisionChannel TraceChannel,
-	EPhysXInstancedQueryDebugMode DebugMode,
-	float DebugDrawDuration) const
+void UPhysXInstancedWorldSubsystem::CancelAsyncQueries()
 {
-	OutIDs.Reset();
+	TArray<FAsyncRaycastQuery> Raycasts;
+	TArray<FAsyncSweepQuery>   Sweeps;
+	TArray<FAsyncOverlapQuery> Overlaps;
+	TArray<FAsyncNearestQuery> Nearest;
+	{
+		FScopeLock Lock(&AsyncQueryLock);
 
-	UWorld* World = GetWorld();
-	if (!World || Radius <= 0.0f)
+		bAcceptAsyncQueries = false;
+		Raycasts = MoveTemp(PendingAsyncRaycasts);
+		Sweeps   = MoveTemp(PendingAsyncSweeps);
+		Overlaps = MoveTemp(PendingAsyncOverlaps);
+		Nearest  = MoveTemp(PendingAsyncNearest);
+	}
+
+	// A destroyed unfulfilled promise would leave its future waiting forever.
+	for (FAsyncRaycastQuery& Query : Raycasts)
 	{
-		return false;
+		Query.Promise.SetValue(FPhysXInstanceQueryHit());
+	}
+	for (FAsyncSweepQuery& Query : Sweeps)
+	{
+		Query.Promise.SetValue(FPhysXInstanceQueryHit());
+	}
+	for (FAsyncOverlapQuery& Query : Overlaps)
+	{
+		Query.Promise.SetValue(TArray<FPhysXInstanceID>());
 	}
+	for (FAsyncNearestQuery& Query : Nearest)
+	{
+		Query.Promise.SetValue(TArray<FPhysXInstanceNearestHit>());
+	}
+}
 
-	TSet<FPhysXInstanceID> Unique;
+// ============================================================================
+// Storage BVH queries
+// ============================================================================
 
-	// --- Storage overlaps via ISMC ---
-	if (bIncludeStorage)
+bool UPhysXInstancedWorldSubsystem::IsInstanceOwnedBy(FPhysXInstanceID ID, const AActor* Owner) const
+{
+	if (!Owner)
 	{
-		TSet<UInstancedStaticMeshComponent*> Components;
-		Components.Reserve(Instances.Num());
+		return true;
+	}
 
-		for (const TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
-		{
-			const FPhysXInstanceData& Data = Pair.Value;
-			UInstancedStaticMeshComponent* ISMC = Data.InstancedComponent.Get();
-			if (!ISMC || !ISMC->IsValidLowLevelFast() || Data.InstanceIndex == INDEX_NONE)
-			{
-				continue;
-			}
-			Components.Add(ISMC);
-		}
+	const FPhysXInstanceData* Data = Instances.Find(ID);
+	const UInstancedStaticMeshComponent* ISMC = Data ? Data->InstancedComponent.Get() : nullptr;
+	return ISMC && ISMC->GetOwner() == Owner;
+}
+
+void UPhysXInstancedWorldSubsystem::OverlapStorageSphere_Internal(
+	const FVector& CenterWorld,
+	float Radius,
+	ECollisionChannel TraceChannel,
+	FInstanceVisitor Visitor) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_StorageBVHQuery);
 
-		for (UInstancedStaticMeshComponent* ISMC : Components)
+	StorageBVH.ForEachOverlappingSphere(CenterWorld, Radius,
+		[&](FPhysXInstanceID ID, const FBox& /*Bounds*/)
 		{
-			if (!ISMC)
-			{
-				continue;
-			}
+			const FPhysXInstanceData* Data = Instances.Find(ID);
+			const UInstancedStaticMeshComponent* ISMC = Data ? Data->InstancedComponent.Get() : nullptr;
 
-			if (ISMC->GetCollisionEnabled() == ECollisionEnabled::NoCollision)
+			if (ISMC && DoesComponentRespondToChannel(ISMC, TraceChannel))
 			{
-				continue;
+				return Visitor(ID);
 			}
+			return true;
+		});
+}
 
-			if (ISMC->GetCollisionResponseToChannel(TraceChannel) == ECR_Ignore)
-			{
-				continue;
-			}
+void UPhysXInstancedWorldSubsystem::OverlapStorageBox_Internal(
+	const FBox& WorldBox,
+	ECollisionChannel TraceChannel,
+	FInstanceVisitor Visitor) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_StorageBVHQuery);
 
-			const TArray<int32> Indices =
-				ISMC->GetInstancesOverlappingSphere(CenterWorld, Radius, /*bSphereInWorldSpace=*/true);
+	StorageBVH.ForEachOverlappingBox(WorldBox,
+		[&](FPhysXInstanceID ID, const FBox& /*Bounds*/)
+		{
+			const FPhysXInstanceData* Data = Instances.Find(ID);
+			const UInstancedStaticMeshComponent* ISMC = Data ? Data->InstancedComponent.Get() : nullptr;
 
-			for (int32 InstanceIndex : Indices)
+			if (ISMC && DoesComponentRespondToChannel(ISMC, TraceChannel))
 			{
-				const FPhysXInstanceID ID = GetInstanceIDForComponentAndIndex(ISMC, InstanceIndex);
-				if (ID.IsValid())
-				{
-					Unique.Add(ID);
-				}
+				return Visitor(ID);
 			}
-		}
+			return true;
+		});
+}
+
+void UPhysXInstancedWorldSubsystem::OverlapStorageShape_Internal(
+	const FPhysXInstanceShapeQuery& Query,
+	ECollisionChannel TraceChannel,
+	FInstanceVisitor Visitor) const
+{
+	if (Query.Shape == EPhysXInstanceQueryShape::Sphere)
+	{
+		OverlapStorageSphere_Internal(Query.Start, Query.Radius, TraceChannel, MoveTemp(Visitor));
+		return;
 	}
 
 #if PHYSICS_INTERFACE_PHYSX
-	// --- Dynamic overlaps via PhysX ---
-	if (physx::PxScene* PxScenePtr = GetPhysXSceneFromWorld(World))
+	physx::PxGeometryHolder Geometry;
+	physx::PxQuat           Rotation;
+	if (!MakeShapeQueryGeometry(Query, Geometry, Rotation))
 	{
-		const physx::PxVec3 CenterPx = U2PVector(CenterWorld);
-		const physx::PxSphereGeometry Geom((physx::PxReal)U2PScalar(Radius));
-		const physx::PxTransform Pose(CenterPx);
+		return;
+	}
 
-		// IMPORTANT: Overlap returns *touches*. Default PxOverlapBuffer has 0 maxTouches.
-		physx::PxOverlapHit Hits[256];
-		physx::PxOverlapBuffer Buf(Hits, UE_ARRAY_COUNT(Hits));
+	const physx::PxTransform QueryPose(U2PVector(Query.Start), Rotation);
+#endif
 
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_StorageBVHQuery);
 
-		struct FFilter : physx::PxQueryFilterCallback
+	// The BVH culls by the query's world AABB; each leaf is then tested against the actual rotated box or capsule.
+	StorageBVH.ForEachOverlappingBox(Query.GetWorldBounds(Query.Start),
+		[&](FPhysXInstanceID ID, const FBox& Bounds)
 		{
-			const UPhysXInstancedWorldSubsystem* Subsystem = nullptr;
-
-			virtual physx::PxQueryHitType::Enum preFilter(
-				const physx::PxFilterData&,
-				const physx::PxShape*,
-				const physx::PxRigidActor* Actor,
-				physx::PxHitFlags&) override
+#if PHYSICS_INTERFACE_PHYSX
+			const physx::PxBoxGeometry LeafGeometry(U2PVector(Bounds.GetExtent()));
+			if (!physx::PxGeometryQuery::overlap(Geometry.any(), QueryPose, LeafGeometry, physx::PxTransform(U2PVector(Bounds.GetCenter()))))
 			{
-				const FPhysXInstanceID ID = Subsystem->GetInstanceIDFromPxActor(Actor);
-				return ID.IsValid() ? physx::PxQueryHitType::eTOUCH : physx::PxQueryHitType::eNONE;
+				return true;
 			}
+#endif
 
-			virtual physx::PxQueryHitType::Enum postFilter(
-				const physx::PxFilterData&,
-				const physx::PxQueryHit&) override
+			const FPhysXInstanceData* Data = Instances.Find(ID);
+			const UInstancedStaticMeshComponent* ISMC = Data ? Data->InstancedComponent.Get() : nullptr;
+
+			if (ISMC && DoesComponentRespondToChannel(ISMC, TraceChannel))
 			{
-				return physx::PxQueryHitType::eTOUCH;
+				return Visitor(ID);
 			}
-		} Filter;
+			return true;
+		});
+}
+
+bool UPhysXInstancedWorldSubsystem::SweepStorage_Internal(
+	const FVector& StartWorld,
+	const FVector& EndWorld,
+	const FCollisionShape& Shape,
+	const FQuat& ShapeRotation,
+	ECollisionChannel TraceChannel,
+	FPhysXInstanceID& OutID,
+	FHitResult& OutHit) const
+{
+	OutID  = FPhysXInstanceID();
+	OutHit = FHitResult();
 
-		Filter.Subsystem = this;
+	const FVector Delta  = EndWorld - StartWorld;
+	const float   Length = Delta.Size();
+	if (Length <= KINDA_SMALL_NUMBER)
+	{
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_PhysXInstanced_StorageBVHQuery);
+
+	const bool bLine = Shape.IsLine();
+
+	// Leaves are inflated by the world AABB of the (possibly rotated) shape.
+	FVector Extent = FVector::ZeroVector;
+	if (!bLine)
+	{
+		const FVector LocalExtent = Shape.GetExtent();
+		Extent = FBox(-LocalExtent, LocalExtent).TransformBy(FTransform(ShapeRotation)).GetExtent();
+	}
 
-		physx::PxQueryFilterData FD;
-		FD.flags = physx::PxQueryFlag::eDYNAMIC | physx::PxQueryFlag::ePREFILTER;
+	FHitResult BestHit;
+	float      BestTime = TNumericLimits<float>::Max();
+	UInstancedStaticMeshComponent* BestComponent = nullptr;
+	int32      BestIndex = INDEX_NONE;
 
-		if (PxScenePtr->overlap(Geom, Pose, Buf, FD, &Filter))
+	StorageBVH.RayCast(StartWorld, EndWorld, Extent,
+		[&](FPhysXInstanceID ID, float EntryFraction) -> float
 		{
-			for (physx::PxU32 i = 0; i < Buf.getNbTouches(); ++i)
+			const FPhysXInstanceData* Data = Instances.Find(ID);
+			UInstancedStaticMeshComponent* ISMC = Data ? Data->InstancedComponent.Get() : nullptr;
+
+			if (!ISMC || !ISMC->IsValidLowLevelFast() || !DoesComponentRespondToChannel(ISMC, TraceChannel))
 			{
-				const physx::PxOverlapHit& H = Buf.getTouch(i);
-				const FPhysXInstanceID ID = GetInstanceIDFromPxActor(H.actor);
-				if (ID.IsValid())
-				{
-					Unique.Add(ID);
-				}
+				return -1.0f;
 			}
-		}
-	}
-#endif
-
-	OutIDs = Unique.Array();
-	const bool bAny = (OutIDs.Num() > 0);
 
-#if ENABLE_DRAW_DEBUG
-	if (IsDebugEnabled(DebugMode))
-	{
-		DrawSphereSafe(World, CenterWorld, Radius, bAny ? FColor::Green : FColor::Red, DebugDrawDuration, 1.5f);
+			const int32 InstanceIndex = Data->InstanceIndex;
+			if (InstanceIndex < 0 || InstanceIndex >= ISMC->GetInstanceCount())
+			{
+				return -1.0f;
+			}
 
-		if (DebugMode == EPhysXInstancedQueryDebugMode::Detailed && bAny)
-		{
-			const int32 MaxMarkers = 64;
-			const int32 NumToDraw = FMath::Min(OutIDs.Num(), MaxMarkers);
+			FHitResult Hit;
 
-			for (int32 i = 0; i < NumToDraw; ++i)
+			const FBodyInstance* Body = ISMC->InstanceBodies.IsValidIndex(InstanceIndex) ? ISMC->InstanceBodies[InstanceIndex] : nullptr;
+			if (Body && Body->IsValidBodyInstance())
 			{
-				const FPhysXInstanceID ID = OutIDs[i];
-				FVector Pos = CenterWorld;
+				const bool bHit = bLine
+					? Body->LineTrace(Hit, StartWorld, EndWorld, /*bTraceComplex=*/false)
+					: Body->Sweep(Hit, StartWorld, EndWorld, ShapeRotation, Shape, /*bTraceComplex=*/false);
 
-				if (const FPhysXInstanceData* Data = Instances.Find(ID))
+				if (!bHit)
 				{
-					if (UInstancedStaticMeshComponent* ISMC = Data->InstancedComponent.Get())
-					{
-#if PHYSICS_INTERFACE_PHYSX
-						if (physx::PxRigidActor* RA = Data->Body.GetPxActor())
-						{
-							const physx::PxTransform PxPose = RA->getGlobalPose();
-							Pos = P2UVector(PxPose.p);
-						}
-						else
-#endif
-						{
-							if (Data->InstanceIndex != INDEX_NONE)
-							{
-								FTransform TM;
-								if (ISMC->GetInstanceTransform(Data->InstanceIndex, TM, /*bWorldSpace=*/true))
-								{
-									Pos = TM.GetLocation();
-								}
-							}
-						}
-					}
+					return -1.0f;
 				}
-
-				DrawPointSafe(World, Pos, FColor::Cyan, DebugDrawDuration, 10.0f);
-				DrawTextSafe(World, Pos + FVector(0, 0, 10.0f), FString::Printf(TEXT("ID=%u"), ID.GetUniqueID()), FColor::White, DebugDrawDuration);
+			}
+			else
+			{
+				// No collision body for this instance: the bounds are the best we have.
+				Hit.bBlockingHit = true;
+				Hit.Time         = EntryFraction;
+				Hit.Location     = StartWorld + Delta * EntryFraction;
+				Hit.ImpactPoint  = Hit.Location;
+				Hit.Normal       = -Delta / Length;
+				Hit.ImpactNormal = Hit.Normal;
 			}
 
-			if (OutIDs.Num() > MaxMarkers)
+			if (Hit.Time < BestTime)
 			{
-				DrawTextSafe(World,
-					CenterWorld + FVector(0, 0, 20.0f),
-					FString::Printf(TEXT("Overlap: %d hits (showing %d)"), OutIDs.Num(), MaxMarkers),
-					FColor::White,
-					DebugDrawDuration);
+				BestTime      = Hit.Time;
+				BestHit       = Hit;
+				BestComponent = ISMC;
+				BestIndex     = InstanceIndex;
 			}
-		}
+			return Hit.Time;
+		},
+		OutID);
+
+	if (!OutID.IsValid())
+	{
+		return false;
 	}
-#endif
 
-	return bAny;
+	OutHit            = BestHit;
+	OutHit.Distance   = Length * BestTime;
+	OutHit.TraceStart = StartWorld;
+	OutHit.TraceEnd   = EndWorld;
+	OutHit.Component  = BestComponent;
+	OutHit.Item       = BestIndex;
+	return true;
 }
 
 void UPhysXInstancedWorldSubsystem::AddSlotMapping(FPhysXInstanceID ID)
 {
-	const FPhysXInstanceData* Data = Instances.Find(ID);
+	FPhysXInstanceData* Data = Instances.Find(ID);
 	if (!Data || Data->InstanceIndex == INDEX_NONE)
 	{
 		return;
@@ -5430,11 +8749,34 @@ void UPhysXInstancedWorldSubsystem::AddSlotMapping(FPhysXInstanceID ID)
 		return;
 	}
 
+	// Lets the sleeping fast path of the physics step skip instances whose owner never uses the tier.
+	const APhysXInstancedMeshActor* OwnerActor = Cast<APhysXInstancedMeshActor>(ISMC->GetOwner());
+	Data->bOwnerUsesSleepingTier = OwnerActor && OwnerActor->bUseSleepingRenderTier &&
+		!OwnerActor->bIsStorageActor && !OwnerActor->bStorageOnly;
+	Data->bOwnerUsesShadowLOD = OwnerActor && OwnerActor->bUseShadowDistanceLOD &&
+		!OwnerActor->bIsStorageActor && !OwnerActor->bStorageOnly;
+
 	InstanceIDBySlot.Add(FPhysXInstanceSlotKey(ISMC, Data->InstanceIndex), ID);
+
+	// Every bind (spawn, registration, conversion) goes through here, so the spatial hash follows.
+	FVector Location;
+	if (GetInstanceWorldLocation_Safe(*Data, Location))
+	{
+		SpatialHash.Update(ID, Location);
+	}
+
+	FBox Bounds;
+	if (IsOwnerStorageActor(ISMC) && GetInstanceWorldBounds_Safe(*Data, Bounds))
+	{
+		StorageBVH.Insert(ID, Bounds);
+	}
 }
 
 void UPhysXInstancedWorldSubsystem::RemoveSlotMapping(FPhysXInstanceID ID)
 {
+	SpatialHash.Remove(ID);
+	StorageBVH.Remove(ID);
+
 	const FPhysXInstanceData* Data = Instances.Find(ID);
 
 	bool bRemovedExpected = false;
@@ -5469,6 +8811,12 @@ void UPhysXInstancedWorldSubsystem::RebuildSlotMappingForComponent(UInstancedSta
 		return;
 	}
 
+	if (SlotMappingBatchDepth > 0)
+	{
+		DeferredSlotMappingRebuilds.Add(ISMC);
+		return;
+	}
+
 	// Remove old entries for this component.
 	for (auto It = InstanceIDBySlot.CreateIterator(); It; ++It)
 	{
@@ -5496,6 +8844,81 @@ void UPhysXInstancedWorldSubsystem::RebuildSlotMappingForComponent(UInstancedSta
 	}
 }
 
+void UPhysXInstancedWorldSubsystem::FlushDeferredSlotMappingRebuilds()
+{
+	if (DeferredSlotMappingRebuilds.Num() == 0)
+	{
+		return;
+	}
+
+	const TSet<TWeakObjectPtr<UInstancedStaticMeshComponent>> Components = MoveTemp(DeferredSlotMappingRebuilds);
+	DeferredSlotMappingRebuilds.Reset();
+
+	for (auto It = InstanceIDBySlot.CreateIterator(); It; ++It)
+	{
+		if (Components.Contains(It.Key().Component))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	for (const TPair<FPhysXInstanceID, FPhysXInstanceData>& Pair : Instances)
+	{
+		const FPhysXInstanceData& Data = Pair.Value;
+		if (Data.InstanceIndex == INDEX_NONE || !Components.Contains(Data.InstancedComponent))
+		{
+			continue;
+		}
+
+		if (UInstancedStaticMeshComponent* ISMC = Data.InstancedComponent.Get())
+		{
+			InstanceIDBySlot.Add(FPhysXInstanceSlotKey(ISMC, Data.InstanceIndex), Pair.Key);
+		}
+	}
+}
+
+#if PHYSICS_INTERFACE_PHYSX
+
+void UPhysXInstancedWorldSubsystem::DestroyInstanceBody(FPhysXInstanceID ID, FPhysXInstanceData& Data)
+{
+	// User data must be detached while the body is still bound to the instance.
+	ClearInstanceUserData(ID);
+
+	// An async body still being built for this instance is dropped when it arrives.
+	Data.bBodyPending = false;
+
+	if (BodyDestroyBatchDepth > 0 && Data.Body.PxBody)
+	{
+		// The instance forgets the body now; the actor leaves the scene when the batch flushes.
+		DeferredBodyDestroys.Add(Data.Body);
+		Data.Body = FPhysXInstanceBody();
+		return;
+	}
+
+	Data.Body.Destroy();
+}
+
+void UPhysXInstancedWorldSubsystem::FlushDeferredBodyDestroys()
+{
+	if (DeferredBodyDestroys.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<FPhysXInstanceBody*> Bodies;
+	Bodies.Reserve(DeferredBodyDestroys.Num());
+
+	for (FPhysXInstanceBody& Body : DeferredBodyDestroys)
+	{
+		Bodies.Add(&Body);
+	}
+
+	FPhysXInstanceBody::DestroyBatch(Bodies);
+	DeferredBodyDestroys.Reset();
+}
+
+#endif // PHYSICS_INTERFACE_PHYSX
+
 void UPhysXInstancedWorldSubsystem::InvalidatePendingAddEntries(FPhysXInstanceID ID)
 {
 #if PHYSICS_INTERFACE_PHYSX
@@ -5504,7 +8927,7 @@ void UPhysXInstancedWorldSubsystem::InvalidatePendingAddEntries(FPhysXInstanceID
 		return;
 	}
 
-	for (int32 i = PendingAddActorsHead; i < PendingAddActors.Num(); ++i)
+	for (int32 i = 0; i < PendingAddActors.Num(); ++i)
 	{
 		if (PendingAddActors[i].ID == ID)
 		{
@@ -5521,6 +8944,57 @@ bool UPhysXInstancedWorldSubsystem::RemoveInstance(FPhysXInstanceID ID, bool bRe
 
 #if PHYSICS_INTERFACE_PHYSX
 
+/**
+ * Closest-hit prefilter: skips bodies whose instance userData was already cleared (removal in flight),
+ * so the query keeps looking past them instead of reporting a blocking hit without an ID.
+ */
+struct UPhysXInstancedWorldSubsystem::FPhysXInstanceBlockFilter : physx::PxQueryFilterCallback
+{
+	const UPhysXInstancedWorldSubsystem* Subsystem = nullptr;
+
+	explicit FPhysXInstanceBlockFilter(const UPhysXInstancedWorldSubsystem& InSubsystem)
+		: Subsystem(&InSubsystem)
+	{
+	}
+
+	virtual physx::PxQueryHitType::Enum preFilter(
+		const physx::PxFilterData&,
+		const physx::PxShape*,
+		const physx::PxRigidActor* Actor,
+		physx::PxHitFlags&) override
+	{
+		return Subsystem->GetInstanceIDFromPxActor(Actor).IsValid()
+			? physx::PxQueryHitType::eBLOCK
+			: physx::PxQueryHitType::eNONE;
+	}
+
+	virtual physx::PxQueryHitType::Enum postFilter(
+		const physx::PxFilterData&,
+		const physx::PxQueryHit&) override
+	{
+		return physx::PxQueryHitType::eBLOCK;
+	}
+};
+
+/**
+ * Scene query filter data that only lets instance shapes through.
+ * PhysX drops a shape when every word of (shape data & query data) is zero, so with only
+ * QueryFlag_Instance set the rejection happens inside the scene query, without a filter callback.
+ */
+static physx::PxQueryFilterData MakeInstanceQueryFilterData(bool bTouchesOnly)
+{
+	physx::PxQueryFilterData FD;
+	FD.data  = physx::PxFilterData(0, 0, 0, PhysXIS::QueryFlag_Instance);
+	FD.flags = physx::PxQueryFlag::eDYNAMIC;
+
+	if (bTouchesOnly)
+	{
+		FD.flags |= physx::PxQueryFlag::eNO_BLOCK;
+	}
+
+	return FD;
+}
+
 bool UPhysXInstancedWorldSubsystem::RaycastPhysXInstanceID_Internal(
 	const FVector& StartWorld,
 	const FVector& EndWorld,
@@ -5546,6 +9020,25 @@ bool UPhysXInstancedWorldSubsystem::RaycastPhysXInstanceID_Internal(
 		return false;
 	}
 
+	FPhysXInstanceQueryHit Hit;
+	if (!RaycastPhysXScene_Internal(*PxScenePtr, StartWorld, EndWorld, Hit))
+	{
+		return false;
+	}
+
+	OutID             = Hit.InstanceID;
+	OutDistanceUU     = Hit.Distance;
+	OutHitPosWorld    = Hit.Location;
+	OutHitNormalWorld = Hit.Normal;
+	return true;
+}
+
+bool UPhysXInstancedWorldSubsystem::RaycastPhysXScene_Internal(
+	physx::PxScene& Scene,
+	const FVector& StartWorld,
+	const FVector& EndWorld,
+	FPhysXInstanceQueryHit& OutHit) const
+{
 	const FVector DirU = (EndWorld - StartWorld);
 	const float DistU = DirU.Size();
 	if (DistU <= KINDA_SMALL_NUMBER)
@@ -5560,56 +9053,32 @@ bool UPhysXInstancedWorldSubsystem::RaycastPhysXInstanceID_Internal(
 	physx::PxRaycastBuffer Hit;
 	const physx::PxHitFlags HitFlags = physx::PxHitFlag::eDEFAULT;
 
-	struct FFilter : physx::PxQueryFilterCallback
-	{
-		const UPhysXInstancedWorldSubsystem* Subsystem = nullptr;
-
-		virtual physx::PxQueryHitType::Enum preFilter(
-			const physx::PxFilterData&,
-			const physx::PxShape*,
-			const physx::PxRigidActor* Actor,
-			physx::PxHitFlags&) override
-		{
-			const FPhysXInstanceID ID = Subsystem->GetInstanceIDFromPxActor(Actor);
-			return ID.IsValid() ? physx::PxQueryHitType::eBLOCK : physx::PxQueryHitType::eNONE;
-		}
-
-		virtual physx::PxQueryHitType::Enum postFilter(
-			const physx::PxFilterData&,
-			const physx::PxQueryHit&) override
-		{
-			return physx::PxQueryHitType::eBLOCK;
-		}
-	} Filter;
-
-	Filter.Subsystem = this;
+	// Non-instance shapes are rejected on their filter data; the callback only sees instance shapes.
+	physx::PxQueryFilterData FD = MakeInstanceQueryFilterData(/*bTouchesOnly=*/false);
+	FD.flags |= physx::PxQueryFlag::ePREFILTER;
 
-	physx::PxQueryFilterData FD;
-	FD.flags = physx::PxQueryFlag::eDYNAMIC | physx::PxQueryFlag::ePREFILTER;
+	FPhysXInstanceBlockFilter Filter(*this);
 
-	const bool bHit = PxScenePtr->raycast(OriginPx, DirPx, DistPx, Hit, HitFlags, FD, &Filter);
+	const bool bHit = Scene.raycast(OriginPx, DirPx, DistPx, Hit, HitFlags, FD, &Filter);
 	if (!bHit || !Hit.hasBlock)
 	{
 		return false;
 	}
 
-	OutID = GetInstanceIDFromPxActor(Hit.block.actor);
-	if (!OutID.IsValid())
+	const FPhysXInstanceID ID = GetInstanceIDFromPxActor(Hit.block.actor);
+	if (!ID.IsValid())
 	{
 		return false;
 	}
 
-	const FVector HitPosUU = P2UVector(Hit.block.position);
-	const FVector HitNormalUU = P2UVector(Hit.block.normal).GetSafeNormal();
-
-	OutHitPosWorld = HitPosUU;
-	OutHitNormalWorld = HitNormalUU;
-
-	OutDistanceUU = FVector::Dist(StartWorld, HitPosUU);
+	OutHit.InstanceID = ID;
+	OutHit.Location   = P2UVector(Hit.block.position);
+	OutHit.Normal     = P2UVector(Hit.block.normal).GetSafeNormal();
+	OutHit.Distance   = FVector::Dist(StartWorld, OutHit.Location);
+	OutHit.bStorage   = false;
 	return true;
 }
 
-
 bool UPhysXInstancedWorldSubsystem::SweepSpherePhysXInstanceID_Internal(
 	const FVector& StartWorld,
 	const FVector& EndWorld,
@@ -5636,6 +9105,31 @@ bool UPhysXInstancedWorldSubsystem::SweepSpherePhysXInstanceID_Internal(
 		return false;
 	}
 
+	const physx::PxSphereGeometry Geom((physx::PxReal)U2PScalar(Radius));
+
+	FPhysXInstanceQueryHit Hit;
+	if (!SweepPhysXScene_Internal(*PxScenePtr, Geom, physx::PxQuat(physx::PxIdentity), StartWorld, EndWorld, Hit))
+	{
+		return false;
+	}
+
+	OutID             = Hit.InstanceID;
+	OutHitPosWorld    = Hit.Location;
+	OutHitNormalWorld = Hit.Normal;
+
+	// Kept as distance to the contact point (not travel distance) for existing callers.
+	OutDistanceUU = FVector::Dist(StartWorld, Hit.Location);
+	return true;
+}
+
+bool UPhysXInstancedWorldSubsystem::SweepPhysXScene_Internal(
+	physx::PxScene& Scene,
+	const physx::PxGeometry& Geometry,
+	const physx::PxQuat& Rotation,
+	const FVector& StartWorld,
+	const FVector& EndWorld,
+	FPhysXInstanceQueryHit& OutHit) const
+{
 	const FVector DirU = (EndWorld - StartWorld);
 	const float DistU = DirU.Size();
 	if (DistU <= KINDA_SMALL_NUMBER)
@@ -5643,62 +9137,154 @@ bool UPhysXInstancedWorldSubsystem::SweepSpherePhysXInstanceID_Internal(
 		return false;
 	}
 
-	const physx::PxVec3 OriginPx = U2PVector(StartWorld);
-	const physx::PxVec3 DirPx    = U2PVector(DirU / DistU);
-	const physx::PxReal DistPx   = (physx::PxReal)U2PScalar(DistU);
+	const physx::PxVec3 DirPx  = U2PVector(DirU / DistU);
+	const physx::PxReal DistPx = (physx::PxReal)U2PScalar(DistU);
 
-	const physx::PxTransform Pose(OriginPx);
-	const physx::PxSphereGeometry Geom((physx::PxReal)U2PScalar(Radius));
+	const physx::PxTransform Pose(U2PVector(StartWorld), Rotation);
 
 	physx::PxSweepBuffer Hit;
 	const physx::PxHitFlags HitFlags = physx::PxHitFlag::eDEFAULT;
 
+	// Non-instance shapes are rejected on their filter data; the callback only sees instance shapes.
+	physx::PxQueryFilterData FD = MakeInstanceQueryFilterData(/*bTouchesOnly=*/false);
+	FD.flags |= physx::PxQueryFlag::ePREFILTER;
+
+	FPhysXInstanceBlockFilter Filter(*this);
+
+	const bool bHit = Scene.sweep(Geometry, Pose, DirPx, DistPx, Hit, HitFlags, FD, &Filter);
+	if (!bHit || !Hit.hasBlock)
+	{
+		return false;
+	}
+
+	const FPhysXInstanceID ID = GetInstanceIDFromPxActor(Hit.block.actor);
+	if (!ID.IsValid())
+	{
+		return false;
+	}
+
+	OutHit.InstanceID = ID;
+	OutHit.Location   = P2UVector(Hit.block.position);
+	OutHit.Normal     = P2UVector(Hit.block.normal).GetSafeNormal();
+	OutHit.Distance   = P2UScalar(Hit.block.distance);
+	OutHit.bStorage   = false;
+	return true;
+}
+
+void UPhysXInstancedWorldSubsystem::OverlapPhysXScene_Internal(
+	physx::PxScene& Scene,
+	const physx::PxGeometry& Geometry,
+	const physx::PxTransform& Pose,
+	FInstanceVisitor Visitor,
+	const FInstanceBodyFilter& BodyFilter) const
+{
+	// Archetype bodies carry the archetype in word0, so owners are resolved through the instance instead.
 	struct FFilter : physx::PxQueryFilterCallback
 	{
 		const UPhysXInstancedWorldSubsystem* Subsystem = nullptr;
+		const AActor* Owner           = nullptr;
+		physx::PxU32  ArchetypeWord   = 0;
+		bool          bSimulatingOnly = false;
 
 		virtual physx::PxQueryHitType::Enum preFilter(
 			const physx::PxFilterData&,
-			const physx::PxShape*,
+			const physx::PxShape* Shape,
 			const physx::PxRigidActor* Actor,
 			physx::PxHitFlags&) override
 		{
-			const FPhysXInstanceID ID = Subsystem->GetInstanceIDFromPxActor(Actor);
-			return ID.IsValid() ? physx::PxQueryHitType::eBLOCK : physx::PxQueryHitType::eNONE;
+			if (ArchetypeWord != 0 && Shape->getQueryFilterData().word0 != ArchetypeWord)
+			{
+				return physx::PxQueryHitType::eNONE;
+			}
+
+			if (Owner)
+			{
+				const FPhysXInstanceID ID = Subsystem->GetInstanceIDFromPxActor(Actor);
+				if (!ID.IsValid() || !Subsystem->IsInstanceOwnedBy(ID, Owner))
+				{
+					return physx::PxQueryHitType::eNONE;
+				}
+			}
+
+			if (bSimulatingOnly)
+			{
+				const physx::PxRigidBody* Body = Actor->is<physx::PxRigidBody>();
+				if (!Body || Body->getRigidBodyFlags().isSet(physx::PxRigidBodyFlag::eKINEMATIC))
+				{
+					return physx::PxQueryHitType::eNONE;
+				}
+			}
+
+			return physx::PxQueryHitType::eTOUCH;
 		}
 
 		virtual physx::PxQueryHitType::Enum postFilter(
 			const physx::PxFilterData&,
 			const physx::PxQueryHit&) override
 		{
-			return physx::PxQueryHitType::eBLOCK;
+			return physx::PxQueryHitType::eTOUCH;
 		}
 	} Filter;
 
-	Filter.Subsystem = this;
+	Filter.Subsystem       = this;
+	Filter.Owner           = BodyFilter.Owner;
+	Filter.ArchetypeWord   = BodyFilter.Archetype ? BodyFilter.Archetype->GetUniqueID() : 0;
+	Filter.bSimulatingOnly = BodyFilter.bSimulatingOnly;
 
-	physx::PxQueryFilterData FD;
-	FD.flags = physx::PxQueryFlag::eDYNAMIC | physx::PxQueryFlag::ePREFILTER;
+	// Overlaps only need touches; the callback only runs when something has to be narrowed further.
+	physx::PxQueryFilterData FD = MakeInstanceQueryFilterData(/*bTouchesOnly=*/true);
+	physx::PxQueryFilterCallback* FilterCallback = nullptr;
 
-	const bool bHit = PxScenePtr->sweep(Geom, Pose, DirPx, DistPx, Hit, HitFlags, FD, &Filter);
-	if (!bHit || !Hit.hasBlock)
+	if (!BodyFilter.IsEmpty())
 	{
-		return false;
+		FD.flags |= physx::PxQueryFlag::ePREFILTER;
+		FilterCallback = &Filter;
 	}
 
-	OutID = GetInstanceIDFromPxActor(Hit.block.actor);
-	if (!OutID.IsValid())
+	// Touches are streamed in fixed batches, so any number of them is visited without growing a buffer or re-running the overlap.
+	struct FTouchStream : physx::PxHitCallback<physx::PxOverlapHit>
 	{
-		return false;
-	}
+		static constexpr physx::PxU32 BatchSize = 256;
+
+		const UPhysXInstancedWorldSubsystem* Subsystem = nullptr;
+		FInstanceVisitor* Visitor = nullptr;
+		bool bStopped = false;
+		physx::PxOverlapHit Batch[BatchSize];
+
+		FTouchStream()
+			: physx::PxHitCallback<physx::PxOverlapHit>(Batch, BatchSize)
+		{
+		}
+
+		bool Forward(const physx::PxOverlapHit* Buffer, physx::PxU32 NumHits)
+		{
+			for (physx::PxU32 i = 0; i < NumHits; ++i)
+			{
+				const FPhysXInstanceID ID = Subsystem->GetInstanceIDFromPxActor(Buffer[i].actor);
+				if (ID.IsValid() && !(*Visitor)(ID))
+				{
+					bStopped = true;
+					return false;
+				}
+			}
+			return true;
+		}
+
+		virtual physx::PxAgain processTouches(const physx::PxOverlapHit* Buffer, physx::PxU32 NumHits) override
+		{
+			return Forward(Buffer, NumHits);
+		}
+	} Stream;
 
-	const FVector HitPosUU = P2UVector(Hit.block.position);
-	const FVector HitNormalUU = P2UVector(Hit.block.normal).GetSafeNormal();
+	Stream.Subsystem = this;
+	Stream.Visitor   = &Visitor;
 
-	OutHitPosWorld = HitPosUU;
-	OutHitNormalWorld = HitNormalUU;
+	Scene.overlap(Geometry, Pose, Stream, FD, FilterCallback);
 
-	OutDistanceUU = FVector::Dist(StartWorld, HitPosUU);
-	return true;
+	// Continuing from processTouches resets nbTouches, so whatever is left was never handed to the visitor.
+	if (!Stream.bStopped && Stream.nbTouches > 0)
+	{
+		Stream.Forward(Stream.touches, Stream.nbTouches);
+	}
 }
 #endif // PHYSICS_INTERFACE_PHYSX
@@ -0,0 +1,79 @@
+﻿/**
+* Copyright (C) 2025 | Created by NordVader Inc.
+* All rights reserved!
+* My Discord Server: https://discord.gg/B8prpf3vzD
+*/
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Subsystems/PhysXInstancedWorldSubsystem.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeExit.h"
+
+// -----------------------------------------------------------------------------
+// Async queries
+// -----------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FPhysXInstancedAsyncQueryFallbackTickTest,
+	"PhysXInstanced.AsyncQueries.ResolvedWithoutProcessPipeline",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FPhysXInstancedAsyncQueryFallbackTickTest::RunTest(const FString& Parameters)
+{
+	IConsoleVariable* PipelineCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("physxinstanced.Process.Pipeline"));
+	if (!TestNotNull(TEXT("Process pipeline console variable"), PipelineCVar))
+	{
+		return false;
+	}
+
+	// Fallback mode: Tick runs the fixed phase sequence instead of the process pipeline.
+	const int32 PreviousPipeline = PipelineCVar->GetInt();
+	PipelineCVar->Set(0, ECVF_SetByCode);
+
+	ON_SCOPE_EXIT
+	{
+		PipelineCVar->Set(PreviousPipeline, ECVF_SetByCode);
+	};
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, /*bInformEngineOfWorld=*/false);
+	if (!TestNotNull(TEXT("Test world"), World))
+	{
+		return false;
+	}
+
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(/*bInformEngineOfWorld=*/false);
+	};
+
+	UPhysXInstancedWorldSubsystem* Subsystem = World->GetSubsystem<UPhysXInstancedWorldSubsystem>();
+	if (!TestNotNull(TEXT("Instanced subsystem"), Subsystem))
+	{
+		return false;
+	}
+
+	TFuture<FPhysXInstanceQueryHit> Future = Subsystem->RaycastInstanceIDAsync(
+		FVector(0.0f, 0.0f, 1000.0f), FVector(0.0f, 0.0f, -1000.0f));
+
+	TestFalse(TEXT("Query waits for the next tick"), Future.IsReady());
+	TestEqual(TEXT("Pending queries before tick"), Subsystem->GetNumPendingAsyncQueries(), 1);
+
+	Subsystem->Tick(1.0f / 60.0f);
+
+	TestEqual(TEXT("Pending queries after tick"), Subsystem->GetNumPendingAsyncQueries(), 0);
+
+	if (TestTrue(TEXT("Query resolved by the fallback tick"), Future.IsReady()))
+	{
+		// Nothing is registered in this world, so the ray cannot hit an instance.
+		TestFalse(TEXT("Empty world has no hit"), Future.Get().IsHit());
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
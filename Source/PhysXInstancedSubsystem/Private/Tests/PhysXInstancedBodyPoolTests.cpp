@@ -0,0 +1,91 @@
+﻿/**
+* Copyright (C) 2025 | Created by NordVader Inc.
+* All rights reserved!
+* My Discord Server: https://discord.gg/B8prpf3vzD
+*/
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Actors/PhysXInstancedMeshActor.h"
+#include "Components/PhysXInstancedStaticMeshComponent.h"
+#include "Subsystems/PhysXInstancedWorldSubsystem.h"
+
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Misc/ScopeExit.h"
+
+// -----------------------------------------------------------------------------
+// Body pool
+// -----------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FPhysXInstancedWarmUpBodyPoolTest,
+	"PhysXInstanced.BodyPool.WarmedBodiesAreReusedByRegistration",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FPhysXInstancedWarmUpBodyPoolTest::RunTest(const FString& Parameters)
+{
+#if PHYSICS_INTERFACE_PHYSX
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!TestNotNull(TEXT("Engine cube mesh"), Cube))
+	{
+		return false;
+	}
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, /*bInformEngineOfWorld=*/false);
+	if (!TestNotNull(TEXT("Test world"), World))
+	{
+		return false;
+	}
+
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(/*bInformEngineOfWorld=*/false);
+	};
+
+	UPhysXInstancedWorldSubsystem* Subsystem = World->GetSubsystem<UPhysXInstancedWorldSubsystem>();
+	if (!TestNotNull(TEXT("Instanced subsystem"), Subsystem))
+	{
+		return false;
+	}
+
+	// Not begun play: the actor does not register its instances, the test does.
+	APhysXInstancedMeshActor* Actor = World->SpawnActor<APhysXInstancedMeshActor>();
+	if (!TestNotNull(TEXT("Instanced mesh actor"), Actor) || !TestNotNull(TEXT("Instanced mesh"), Actor->InstancedMesh))
+	{
+		return false;
+	}
+
+	Actor->InstanceShapeType = EPhysXInstanceShapeType::Box;
+	Actor->InstancedMesh->SetStaticMesh(Cube);
+
+	// A non-unit scale: the warmed key must follow the instances, not unit scale.
+	const FVector InstanceScale(2.0f, 2.0f, 2.0f);
+	const int32 InstanceIndex = Actor->InstancedMesh->AddInstance(
+		FTransform(FQuat::Identity, FVector(0.0f, 0.0f, 500.0f), InstanceScale));
+
+	const int32 NumWarmed = Subsystem->WarmUpBodyPool(Actor, /*Count=*/4, /*bSimulate=*/true);
+	if (NumWarmed == 0)
+	{
+		AddWarning(TEXT("Shape sharing or body pooling is disabled by config; nothing to verify."));
+		return true;
+	}
+
+	TestEqual(TEXT("Warmed bodies"), NumWarmed, 4);
+
+	const int32 NumPooledBefore = Subsystem->GetNumPooledBodies();
+
+	const FPhysXInstanceID ID = Subsystem->RegisterInstance(Actor->InstancedMesh, InstanceIndex, /*bSimulate=*/true);
+	TestTrue(TEXT("Instance registered"), ID.IsValid());
+
+	TestEqual(TEXT("Registration took a warmed body"), Subsystem->GetNumPooledBodies(), NumPooledBefore - 1);
+
+	Subsystem->UnregisterInstance(ID);
+#endif // PHYSICS_INTERFACE_PHYSX
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
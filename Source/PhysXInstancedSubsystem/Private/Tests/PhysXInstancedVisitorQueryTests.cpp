@@ -0,0 +1,202 @@
+﻿/**
+* Copyright (C) 2025 | Created by NordVader Inc.
+* All rights reserved!
+* My Discord Server: https://discord.gg/B8prpf3vzD
+*/
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Actors/PhysXInstancedMeshActor.h"
+#include "Components/PhysXInstancedStaticMeshComponent.h"
+#include "Subsystems/PhysXInstancedWorldSubsystem.h"
+
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Misc/ScopeExit.h"
+
+// -----------------------------------------------------------------------------
+// Visitor queries
+// -----------------------------------------------------------------------------
+
+namespace PhysXInstancedVisitorQueryTests
+{
+	/** Forwards to the wrapped allocator and counts new allocations made by one thread. */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInner)
+			: Inner(InInner)
+			, CountedThreadId(FPlatformTLS::GetCurrentThreadId())
+		{
+		}
+
+		int32 GetNumAllocations() const { return NumAllocations.GetValue(); }
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->Malloc(Count, Alignment);
+		}
+
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->TryMalloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			if (Count > 0)
+			{
+				CountAllocation();
+			}
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			if (Count > 0)
+			{
+				CountAllocation();
+			}
+			return Inner->TryRealloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+		virtual const TCHAR* GetDescriptiveName() override { return TEXT("PhysXInstancedCountingMalloc"); }
+
+	private:
+		void CountAllocation()
+		{
+			// Render and worker threads keep allocating while the test runs; only the querying thread matters.
+			if (FPlatformTLS::GetCurrentThreadId() == CountedThreadId)
+			{
+				NumAllocations.Increment();
+			}
+		}
+
+		FMalloc* Inner = nullptr;
+		uint32 CountedThreadId = 0;
+		FThreadSafeCounter NumAllocations;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FPhysXInstancedVisitorQueryNoAllocationTest,
+	"PhysXInstanced.VisitorQueries.NoAllocationOnceWarmedUp",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FPhysXInstancedVisitorQueryNoAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace PhysXInstancedVisitorQueryTests;
+
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!TestNotNull(TEXT("Engine cube mesh"), Cube))
+	{
+		return false;
+	}
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, /*bInformEngineOfWorld=*/false);
+	if (!TestNotNull(TEXT("Test world"), World))
+	{
+		return false;
+	}
+
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(/*bInformEngineOfWorld=*/false);
+	};
+
+	UPhysXInstancedWorldSubsystem* Subsystem = World->GetSubsystem<UPhysXInstancedWorldSubsystem>();
+	if (!TestNotNull(TEXT("Instanced subsystem"), Subsystem))
+	{
+		return false;
+	}
+
+	// Not begun play: the actor does not register its instances, the test does.
+	APhysXInstancedMeshActor* Actor = World->SpawnActor<APhysXInstancedMeshActor>();
+	if (!TestNotNull(TEXT("Instanced mesh actor"), Actor) || !TestNotNull(TEXT("Instanced mesh"), Actor->InstancedMesh))
+	{
+		return false;
+	}
+
+	Actor->InstancedMesh->SetStaticMesh(Cube);
+
+	TArray<FPhysXInstanceID> IDs;
+	for (int32 X = 0; X < 4; ++X)
+	{
+		for (int32 Y = 0; Y < 4; ++Y)
+		{
+			const int32 InstanceIndex = Actor->InstancedMesh->AddInstance(
+				FTransform(FVector(X * 150.0f, Y * 150.0f, 500.0f)));
+
+			const FPhysXInstanceID ID = Subsystem->RegisterInstance(Actor->InstancedMesh, InstanceIndex, /*bSimulate=*/true);
+			if (ID.IsValid())
+			{
+				IDs.Add(ID);
+			}
+		}
+	}
+
+	ON_SCOPE_EXIT
+	{
+		for (const FPhysXInstanceID& ID : IDs)
+		{
+			Subsystem->UnregisterInstance(ID);
+		}
+	};
+
+	TestEqual(TEXT("Registered instances"), IDs.Num(), 16);
+
+	// Lets deferred body insertion reach the PhysX scene before anything is measured.
+	Subsystem->Tick(1.0f / 60.0f);
+
+	const FVector Center(225.0f, 225.0f, 500.0f);
+	const float   Radius = 1000.0f;
+
+	auto VisitAll = [](FPhysXInstanceID) { return true; };
+
+	// Warm-up: sizes the visit stamps and any lazily built query state.
+	const int32 NumOverlappingWarmUp = Subsystem->ForEachInstanceOverlappingSphere(Center, Radius, VisitAll);
+	const int32 NumInRadiusWarmUp    = Subsystem->ForEachInstanceInRadius(Center, Radius, VisitAll);
+
+	TestTrue(TEXT("Radius query sees the instances"), NumInRadiusWarmUp > 0);
+
+	FMalloc* const PreviousMalloc = GMalloc;
+	FCountingMalloc CountingMalloc(PreviousMalloc);
+
+	int32 NumOverlapping = 0;
+	int32 NumInRadius    = 0;
+	{
+		GMalloc = &CountingMalloc;
+		ON_SCOPE_EXIT
+		{
+			GMalloc = PreviousMalloc;
+		};
+
+		NumOverlapping = Subsystem->ForEachInstanceOverlappingSphere(Center, Radius, VisitAll);
+		NumInRadius    = Subsystem->ForEachInstanceInRadius(Center, Radius, VisitAll);
+	}
+
+	TestEqual(TEXT("Overlap results match the warm-up"), NumOverlapping, NumOverlappingWarmUp);
+	TestEqual(TEXT("Radius results match the warm-up"), NumInRadius, NumInRadiusWarmUp);
+	TestEqual(TEXT("Allocations during warmed-up visitor queries"), CountingMalloc.GetNumAllocations(), 0);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,37 @@
+﻿/**
+* Copyright (C) 2025 | Created by NordVader Inc.
+* All rights reserved!
+* My Discord Server: https://discord.gg/B8prpf3vzD
+*/
+
+#include "Types/PhysXInstanceArchetype.h"
+
+UPhysXInstanceArchetype::UPhysXInstanceArchetype()
+{
+	CollisionProfile.Name = UCollisionProfile::PhysicsActor_ProfileName;
+}
+
+bool UPhysXInstanceArchetype::GetCollisionResponses(ECollisionChannel& OutObjectType, FCollisionResponseContainer& OutResponses) const
+{
+	FCollisionResponseTemplate Template;
+	if (!UCollisionProfile::Get()->GetProfileTemplate(CollisionProfile.Name, Template))
+	{
+		return false;
+	}
+
+	OutObjectType = Template.ObjectType;
+	OutResponses  = Template.ResponseToChannels;
+	return true;
+}
+
+#if WITH_EDITOR
+
+void UPhysXInstanceArchetype::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Running worlds rebake on the next body creation.
+	++BakeRevision;
+}
+
+#endif
@@ -6,5 +6,30 @@
 
 #include "Types/PhysXInstancedTypes.h"
 
-// No additional implementation is required here.
 // FPhysXInstanceBody is fully implemented in PhysXInstancedBody.cpp.
+
+// -----------------------------------------------------------------------------
+// FPhysXInstanceShapeQuery
+// -----------------------------------------------------------------------------
+
+FCollisionShape FPhysXInstanceShapeQuery::ToCollisionShape() const
+{
+	switch (Shape)
+	{
+	case EPhysXInstanceQueryShape::Box:
+		return FCollisionShape::MakeBox(HalfExtent);
+
+	case EPhysXInstanceQueryShape::Capsule:
+		return FCollisionShape::MakeCapsule(Radius, FMath::Max(HalfHeight, Radius));
+
+	case EPhysXInstanceQueryShape::Sphere:
+	default:
+		return FCollisionShape::MakeSphere(Radius);
+	}
+}
+
+FBox FPhysXInstanceShapeQuery::GetWorldBounds(const FVector& Center) const
+{
+	const FVector Extent = ToCollisionShape().GetExtent();
+	return FBox(-Extent, Extent).TransformBy(FTransform(Rotation, Center));
+}
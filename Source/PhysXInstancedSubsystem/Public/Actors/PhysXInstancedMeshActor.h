@@ -61,10 +61,16 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(
 	bool, bDestroyBodyIfDisabling,
 	bool, bSuccess);
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(
+	FPhysXInstanceBodiesReadySig,
+	const TArray<FPhysXInstanceID>&, InstanceIDs);
+
 class USceneComponent;
 class UStaticMesh;
 class UMaterialInterface;
 class UPhysXInstancedStaticMeshComponent;
+class UPhysXInstancedHierarchicalStaticMeshComponent;
+class UInstancedStaticMeshComponent;
 class UPhysXInstancedWorldSubsystem;
 class APhysXInstancedMeshActor;
 
@@ -78,6 +84,29 @@ enum class EPhysXInstanceSpawnMode : uint8
 	Grid2D UMETA(DisplayName = "Grid (Rows x Columns x Layers)")
 };
 
+/**
+ * One entry of an actor's material variant table.
+ * Empty slots fall back to the mesh material of that slot.
+ */
+USTRUCT(BlueprintType)
+struct FPhysXInstanceMaterialVariant
+{
+	GENERATED_BODY()
+
+	/** Materials per slot this variant stands for (used to match spawn/convert requests). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Material Variant")
+	TArray<UMaterialInterface*> Materials;
+};
+
+/** How dynamic instances are split across render components. */
+UENUM(BlueprintType)
+enum class EPhysXInstanceChunkMode : uint8
+{
+	None                     UMETA(DisplayName = "None (single component)"),
+	SpatialCell              UMETA(DisplayName = "Spatial Cell (XY grid)"),
+	MaxInstancesPerComponent UMETA(DisplayName = "Max Instances Per Component")
+};
+
 /**
  * Actor that owns a PhysX-driven instanced static mesh.
  *
@@ -127,6 +156,10 @@ public:
 	UPROPERTY(BlueprintAssignable, Category="PhysX Instance|Events")
 	FPhysXInstancePostPhysicsEventSig OnInstancePostPhysics;
 
+	/** Fired when bodies created by an async BuildAndRegisterInstances() batch are ready. */
+	UPROPERTY(BlueprintAssignable, Category="PhysX Instance|Events")
+	FPhysXInstanceBodiesReadySig OnInstanceBodiesReady;
+
 	// === Components ==========================================================
 
 	/** Scene root to move/rotate the whole group of instances. */
@@ -137,6 +170,31 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Rendering")
 	UPhysXInstancedStaticMeshComponent* InstancedMesh;
 
+	/**
+	 * Render-only component holding instances whose bodies are asleep (created on demand).
+	 * Only used when bUseSleepingRenderTier is enabled; SpatialCell chunking uses per-cell sleeping chunks instead.
+	 */
+	UPROPERTY(Transient, VisibleAnywhere, BlueprintReadOnly, Category = "Rendering")
+	UPhysXInstancedStaticMeshComponent* SleepingInstancedMesh = nullptr;
+
+	/**
+	 * Render-only component that never casts shadows, holding awake instances beyond
+	 * ShadowCastDistance (created on demand). Only used when bUseShadowDistanceLOD is enabled.
+	 */
+	UPROPERTY(Transient, VisibleAnywhere, BlueprintReadOnly, Category = "Rendering")
+	UPhysXInstancedStaticMeshComponent* NoShadowInstancedMesh = nullptr;
+
+	/** Render-only chunk components created on demand when ChunkMode is not None (sleeping chunks included). */
+	UPROPERTY(Transient, VisibleAnywhere, BlueprintReadOnly, Category = "Rendering")
+	TArray<UPhysXInstancedStaticMeshComponent*> ChunkComponents;
+
+	/**
+	 * Hierarchical component holding storage instances (created on demand).
+	 * Only used when bUseHierarchicalStorage is enabled.
+	 */
+	UPROPERTY(Transient, VisibleAnywhere, BlueprintReadOnly, Category = "Rendering")
+	UPhysXInstancedHierarchicalStaticMeshComponent* StorageHierarchicalMesh = nullptr;
+
 	// ========================================================================
 	//   Phys X Instance
 	// ========================================================================
@@ -159,6 +217,110 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Phys X Instance|Rendering", meta = (EditCondition = "bOverrideInstanceMaterials"))
 	TArray<UMaterialInterface*> InstanceOverrideMaterials;
 
+	// --- Material variants ---------------------------------------------------
+
+	/**
+	 * If true, requests whose materials match an entry of MaterialVariants share this actor.
+	 * The variant index is written into PerInstanceCustomData and the actor's (shared) material
+	 * is expected to select its look from it, so all variants render in one draw.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Phys X Instance|Rendering")
+	bool bUseMaterialVariants = false;
+
+	/** Material sets collapsed into this actor; the array index is the variant written to custom data. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Phys X Instance|Rendering",
+		meta = (EditCondition = "bUseMaterialVariants"))
+	TArray<FPhysXInstanceMaterialVariant> MaterialVariants;
+
+	/** PerInstanceCustomData slot that receives the variant index. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Phys X Instance|Rendering",
+		meta = (ClampMin = "0", ClampMax = "3", EditCondition = "bUseMaterialVariants"))
+	int32 MaterialVariantCustomDataIndex = 0;
+
+	// --- Render tiers --------------------------------------------------------
+
+	/**
+	 * If true, instances whose bodies stay asleep are moved into SleepingInstancedMesh,
+	 * so per-frame transform uploads only touch the component with moving instances.
+	 * In SpatialCell chunk mode each cell gets its own sleeping chunk, so resting instances keep per-cell culling;
+	 * MaxInstancesPerComponent chunks are not spatial and share SleepingInstancedMesh.
+	 * Bodies and instance IDs are kept; only the rendering component changes.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Phys X Instance|Rendering")
+	bool bUseSleepingRenderTier = false;
+
+	/** Seconds a body must stay asleep before its instance moves to the sleeping tier. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Phys X Instance|Rendering",
+		meta = (ClampMin = "0.0", EditCondition = "bUseSleepingRenderTier"))
+	float SleepingTierEnterDelay = 2.0f;
+
+	/** Seconds a woken body must stay awake before its instance moves back to the active tier. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Phys X Instance|Rendering",
+		meta = (ClampMin = "0.0", EditCondition = "bUseSleepingRenderTier"))
+	float SleepingTierExitDelay = 0.1f;
+
+	// --- Shadow distance LOD -------------------------------------------------
+
+	/**
+	 * If true, awake instances further than ShadowCastDistance from the viewer are moved
+	 * to a non-casting component, so far moving debris does not invalidate cached shadows.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Phys X Instance|Rendering")
+	bool bUseShadowDistanceLOD = false;
+
+	/** Viewer distance (world units) beyond which awake instances stop casting shadows. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Phys X Instance|Rendering",
+		meta = (ClampMin = "0.0", EditCondition = "bUseShadowDistanceLOD"))
+	float ShadowCastDistance = 4000.0f;
+
+	/** Extra distance an instance must travel past ShadowCastDistance before it stops casting. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Phys X Instance|Rendering",
+		meta = (ClampMin = "0.0", EditCondition = "bUseShadowDistanceLOD"))
+	float ShadowDistanceHysteresis = 500.0f;
+
+	// --- Spatial chunks ------------------------------------------------------
+
+	/**
+	 * Splits dynamic instances across several components so each chunk gets its own
+	 * bounds (per-chunk culling) and only chunks with moving instances are re-uploaded.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Phys X Instance|Rendering")
+	EPhysXInstanceChunkMode ChunkMode = EPhysXInstanceChunkMode::None;
+
+	/** Size (world units) of one XY chunk cell in SpatialCell mode. */
+	UPROPERTY(EditAnywhere, Category = "Phys X Instance|Rendering",
+		meta = (ClampMin = "100.0", EditCondition = "ChunkMode==EPhysXInstanceChunkMode::SpatialCell"))
+	float ChunkCellSize = 5000.0f;
+
+	/** Distance an instance may travel past its cell border before it is moved to the next chunk. */
+	UPROPERTY(EditAnywhere, Category = "Phys X Instance|Rendering",
+		meta = (ClampMin = "0.0", EditCondition = "ChunkMode==EPhysXInstanceChunkMode::SpatialCell"))
+	float ChunkCellHysteresis = 250.0f;
+
+	/** Instance cap per component in MaxInstancesPerComponent mode. */
+	UPROPERTY(EditAnywhere, Category = "Phys X Instance|Rendering",
+		meta = (ClampMin = "1", EditCondition = "ChunkMode==EPhysXInstanceChunkMode::MaxInstancesPerComponent"))
+	int32 MaxInstancesPerChunk = 4096;
+
+	/** Collect all render components of this actor (primary, chunks, sleeping and no-shadow tiers). */
+	void GetRenderComponents(TArray<UPhysXInstancedStaticMeshComponent*>& OutComponents) const;
+
+	/** Pick (and create on demand) the component a new awake instance at WorldLocation is added to. */
+	UPhysXInstancedStaticMeshComponent* GetRenderComponentForLocation(const FVector& WorldLocation);
+
+	/**
+	 * Resolve the component an existing instance should render in.
+	 * Keeps CurrentComponent unless the sleep state, shadow distance or chunk cell asks for a move.
+	 */
+	UPhysXInstancedStaticMeshComponent* ResolveRenderComponent(
+		const UInstancedStaticMeshComponent* CurrentComponent,
+		bool bSleeping,
+		const FVector& WorldLocation,
+		bool bBeyondShadowDistance = false);
+
+	/** True if WorldLocation is further than ChunkCellHysteresis outside the cell of ChunkComponent. */
+	bool HasLeftChunkCell(const UPhysXInstancedStaticMeshComponent* ChunkComponent, const FVector& WorldLocation) const;
+
 	// --- Instance generation -------------------------------------------------
 
 	/** If true, instances are registered in the subsystem automatically on BeginPlay. */
@@ -223,6 +385,13 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Phys X Instance")
 	bool bSimulateInstances;
 
+	/**
+	 * If true, BuildAndRegisterInstances() returns right away and bodies are created
+	 * on background tasks over the next frames (see OnInstanceBodiesReady).
+	 */
+	UPROPERTY(EditAnywhere, Category = "Phys X Instance")
+	bool bCreateBodiesAsync;
+
 	/** If true, gravity is enabled for PhysX bodies created for this actor. */
 	UPROPERTY(EditAnywhere, Category = "Phys X Instance")
 	bool bInstancesUseGravity;
@@ -311,6 +480,13 @@ public:
 	UPROPERTY(VisibleAnywhere, Category = "Phys X Instance|Storage")
 	bool bIsStorageActor = false;
 
+	/**
+	 * If true, storage instances live in a hierarchical instanced component
+	 * (per-cluster culling and LOD) whose cluster tree is rebuilt in deferred batches.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Phys X Instance|Storage")
+	bool bUseHierarchicalStorage = false;
+
 	/** Collision profile for storage-only instances (static ISM, no PhysX bodies). */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Phys X Instance",
 		meta = (DisplayName = "Storage Collision Profile", ProfileName = "BlockAllDynamic"))
@@ -336,6 +512,20 @@ public:
 			EditConditionHides))
 	UStaticMesh* OverrideCollisionMesh;
 
+	/**
+	 * Optional shared archetype. When set, instance bodies are cloned from its baked template:
+	 * shape, collision profile, material, mass, damping, gravity and CCD come from the asset,
+	 * and the shape, gravity and mass settings above are ignored.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Phys X Instance")
+	class UPhysXInstanceArchetype* InstanceArchetype = nullptr;
+
+	/** Shape type of instance bodies (archetype first, then InstanceShapeType). */
+	EPhysXInstanceShapeType GetEffectiveShapeType() const;
+
+	/** Collision mesh override of instance bodies (archetype first, then OverrideCollisionMesh). */
+	UStaticMesh* GetEffectiveCollisionMesh() const;
+
 	// --- Runtime behaviour ---------------------------------------------------
 
 	/**
@@ -444,6 +634,35 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Phys X Instance|Runtime")
 	int32 GetInstanceCount() const;
 
+	/** Component that receives storage instances (hierarchical storage mesh or InstancedMesh). */
+	UInstancedStaticMeshComponent* GetStorageComponent();
+
+	// === Material variants ===================================================
+
+	/** True if the variant table is enabled and not empty. */
+	bool UsesMaterialVariants() const { return bUseMaterialVariants && MaterialVariants.Num() > 0; }
+
+	/** Per-slot materials of this actor (overrides resolved against the mesh materials). */
+	void GetResolvedMaterials(TArray<UMaterialInterface*>& OutMaterials) const;
+
+	/** Per-slot materials of a variant; returns false if Variant is out of range. */
+	bool GetResolvedVariantMaterials(int32 Variant, TArray<UMaterialInterface*>& OutMaterials) const;
+
+	/** Variant whose resolved materials equal Materials, or INDEX_NONE. */
+	int32 FindMaterialVariant(const TArray<UMaterialInterface*>& Materials) const;
+
+	/** Variant stored in the custom data of an instance, or INDEX_NONE if variants are not used. */
+	int32 GetInstanceMaterialVariant(const UInstancedStaticMeshComponent* Component, int32 InstanceIndex) const;
+
+	/** Materials an instance renders with: its variant when variants are used, the actor materials otherwise. */
+	void GetInstanceResolvedMaterials(
+		const UInstancedStaticMeshComponent* Component,
+		int32 InstanceIndex,
+		TArray<UMaterialInterface*>& OutMaterials) const;
+
+	/** Write Variant into the custom data of an instance. Returns false if the slot is not available. */
+	bool SetInstanceMaterialVariant(UInstancedStaticMeshComponent* Component, int32 InstanceIndex, int32 Variant) const;
+
 	/**
 	 * Get the PhysX instance ID corresponding to an InstancedMesh instance index.
 	 * Returns an invalid ID (UniqueID == 0) if the index is out of range or not registered.
@@ -536,6 +755,36 @@ protected:
 	/** Generate InstanceRelativeTransforms for Grid mode. */
 	void GenerateGridTransforms();
 
+	/** Return SleepingInstancedMesh, creating and registering it on first use. */
+	UPhysXInstancedStaticMeshComponent* GetOrCreateSleepingInstancedMesh();
+
+	/** Return NoShadowInstancedMesh, creating and registering it on first use. */
+	UPhysXInstancedStaticMeshComponent* GetOrCreateNoShadowInstancedMesh();
+
+	/** Create a render-only instanced component that mirrors InstancedMesh settings. */
+	UPhysXInstancedStaticMeshComponent* CreateRenderTierComponent(FName ComponentName);
+
+	/** Copy mesh, materials, shadow and collision settings from InstancedMesh onto a tier component. */
+	void SyncRenderTierComponent(UInstancedStaticMeshComponent* TierComponent) const;
+
+	/** Return StorageHierarchicalMesh, creating and registering it on first use. */
+	UPhysXInstancedHierarchicalStaticMeshComponent* GetOrCreateStorageHierarchicalMesh();
+
+	/** XY cell that contains WorldLocation in SpatialCell mode. */
+	FIntVector GetChunkCellForLocation(const FVector& WorldLocation) const;
+
+	/** Find or create the chunk component for a spatial cell. */
+	UPhysXInstancedStaticMeshComponent* GetOrCreateChunkForCell(const FIntVector& Cell);
+
+	/** Spatial-cell lookup for ChunkComponents (rebuilt implicitly as chunks are created). */
+	TMap<FIntVector, UPhysXInstancedStaticMeshComponent*> ChunkComponentsByCell;
+
+	/** Find or create the sleeping-tier chunk for a spatial cell (kept in ChunkComponents as well). */
+	UPhysXInstancedStaticMeshComponent* GetOrCreateSleepingChunkForCell(const FIntVector& Cell);
+
+	/** Spatial-cell lookup for sleeping-tier chunks. */
+	TMap<FIntVector, UPhysXInstancedStaticMeshComponent*> SleepingChunkComponentsByCell;
+
 	// === Runtime state =======================================================
 
 	/** Cached pointer to the PhysX instanced subsystem for this world. */
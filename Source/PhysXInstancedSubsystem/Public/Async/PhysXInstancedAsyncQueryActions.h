@@ -0,0 +1,154 @@
+﻿/**
+* Copyright (C) 2025 | Created by NordVader Inc.
+* All rights reserved!
+* My Discord Server: https://discord.gg/B8prpf3vzD
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+
+#include "Types/PhysXInstancedTypes.h"
+
+#include "PhysXInstancedAsyncQueryActions.generated.h"
+
+class UPhysXInstancedWorldSubsystem;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPhysXInstanceAsyncHitDelegate, const FPhysXInstanceQueryHit&, Hit);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPhysXInstanceAsyncIDsDelegate, const TArray<FPhysXInstanceID>&, InstanceIDs);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPhysXInstanceAsyncNearestDelegate, const TArray<FPhysXInstanceNearestHit>&, Hits);
+
+/**
+ * Latent Blueprint nodes over the subsystem async queries.
+ * The request is queued on activation; Completed fires on the game thread once the AsyncQueries phase ran it,
+ * or right away with an empty result when the world has no subsystem.
+ */
+UCLASS(Abstract)
+class PHYSXINSTANCEDSUBSYSTEM_API UPhysXInstanceAsyncQueryAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+protected:
+	/** Subsystem of the world the node was called from, or null once that world is gone. */
+	UPhysXInstancedWorldSubsystem* GetQuerySubsystem() const;
+
+	/** Resolves the world and keeps the action alive until it calls SetReadyToDestroy. */
+	void InitQueryAction(UObject* WorldContextObject);
+
+	TWeakObjectPtr<UWorld> QueryWorld;
+
+	bool              bQueryStorage = true;
+	ECollisionChannel QueryChannel  = ECC_Visibility;
+};
+
+UCLASS()
+class PHYSXINSTANCEDSUBSYSTEM_API UPhysXInstanceAsyncRaycastAction : public UPhysXInstanceAsyncQueryAction
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintAssignable)
+	FPhysXInstanceAsyncHitDelegate Completed;
+
+	/** Closest instance hit along Start -> End, resolved in the next AsyncQueries phase. */
+	UFUNCTION(BlueprintCallable, Category = "Phys X Instance|Query|Async",
+		meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject", AdvancedDisplay = "bIncludeStorage,TraceChannel"))
+	static UPhysXInstanceAsyncRaycastAction* RaycastInstanceIDAsync(
+		UObject* WorldContextObject,
+		FVector Start,
+		FVector End,
+		bool bIncludeStorage = true,
+		ECollisionChannel TraceChannel = ECC_Visibility);
+
+	virtual void Activate() override;
+
+private:
+	void HandleCompleted(const FPhysXInstanceQueryHit& Hit);
+
+	FPhysXInstanceRaycastRequest Ray;
+};
+
+UCLASS()
+class PHYSXINSTANCEDSUBSYSTEM_API UPhysXInstanceAsyncSweepAction : public UPhysXInstanceAsyncQueryAction
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintAssignable)
+	FPhysXInstanceAsyncHitDelegate Completed;
+
+	/** Closest instance hit by sweeping Query from Query.Start to Query.End, resolved in the next AsyncQueries phase. */
+	UFUNCTION(BlueprintCallable, Category = "Phys X Instance|Query|Async",
+		meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject", AdvancedDisplay = "bIncludeStorage,TraceChannel"))
+	static UPhysXInstanceAsyncSweepAction* SweepInstanceIDAsync(
+		UObject* WorldContextObject,
+		const FPhysXInstanceShapeQuery& Query,
+		bool bIncludeStorage = true,
+		ECollisionChannel TraceChannel = ECC_Visibility);
+
+	virtual void Activate() override;
+
+private:
+	void HandleCompleted(const FPhysXInstanceQueryHit& Hit);
+
+	FPhysXInstanceShapeQuery ShapeQuery;
+};
+
+UCLASS()
+class PHYSXINSTANCEDSUBSYSTEM_API UPhysXInstanceAsyncOverlapAction : public UPhysXInstanceAsyncQueryAction
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintAssignable)
+	FPhysXInstanceAsyncIDsDelegate Completed;
+
+	/** Instances overlapping Query placed at Query.Start, resolved in the next AsyncQueries phase. */
+	UFUNCTION(BlueprintCallable, Category = "Phys X Instance|Query|Async",
+		meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject", AdvancedDisplay = "bIncludeStorage,TraceChannel"))
+	static UPhysXInstanceAsyncOverlapAction* OverlapInstanceIDsAsync(
+		UObject* WorldContextObject,
+		const FPhysXInstanceShapeQuery& Query,
+		bool bIncludeStorage = true,
+		ECollisionChannel TraceChannel = ECC_Visibility);
+
+	virtual void Activate() override;
+
+private:
+	void HandleCompleted(const TArray<FPhysXInstanceID>& InstanceIDs);
+
+	FPhysXInstanceShapeQuery ShapeQuery;
+};
+
+UCLASS()
+class PHYSXINSTANCEDSUBSYSTEM_API UPhysXInstanceAsyncNearestAction : public UPhysXInstanceAsyncQueryAction
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintAssignable)
+	FPhysXInstanceAsyncNearestDelegate Completed;
+
+	/** The K instances closest to WorldLocation, sorted by distance. MaxDistance <= 0 means unbounded. */
+	UFUNCTION(BlueprintCallable, Category = "Phys X Instance|Query|Async",
+		meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject", AdvancedDisplay = "IgnoreInstanceID,bIncludeStorage,MaxDistance"))
+	static UPhysXInstanceAsyncNearestAction* FindKNearestInstancesAsync(
+		UObject* WorldContextObject,
+		FVector WorldLocation,
+		int32 K,
+		FPhysXInstanceID IgnoreInstanceID,
+		bool bIncludeStorage = true,
+		float MaxDistance = 0.0f);
+
+	virtual void Activate() override;
+
+private:
+	void HandleCompleted(const TArray<FPhysXInstanceNearestHit>& Hits);
+
+	FVector          QueryLocation = FVector::ZeroVector;
+	int32            QueryK        = 1;
+	FPhysXInstanceID QueryIgnoreID;
+	float            QueryMaxDistance = 0.0f;
+};
@@ -0,0 +1,89 @@
+﻿/**
+* Copyright (C) 2025 | Created by NordVader Inc.
+* All rights reserved!
+* My Discord Server: https://discord.gg/B8prpf3vzD
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "PhysXInstancedHierarchicalStaticMeshComponent.generated.h"
+
+class APhysXInstancedMeshActor;
+
+/**
+ * Hierarchical instanced mesh component used by storage actors.
+ *
+ * Responsibilities:
+ *  - Keeps static storage instances in a cluster tree (per-cluster culling and LOD).
+ *  - Defers cluster-tree rebuilds so a batch of conversions costs a single rebuild.
+ *  - Controls whether per-instance updates trigger navigation updates.
+ *
+ * Automatic tree rebuilds are disabled; the world subsystem flushes pending changes
+ * once enough of them accumulated or the oldest one waited long enough.
+ */
+UCLASS(ClassGroup = (PhysX), BlueprintType, Blueprintable, meta = (BlueprintSpawnableComponent))
+class PHYSXINSTANCEDSUBSYSTEM_API UPhysXInstancedHierarchicalStaticMeshComponent : public UHierarchicalInstancedStaticMeshComponent
+{
+	GENERATED_BODY()
+
+public:
+	UPhysXInstancedHierarchicalStaticMeshComponent(const FObjectInitializer& ObjectInitializer);
+
+	// --- Ownership -----------------------------------------------------------
+
+	/** Owning PhysX instanced actor (optional). */
+	UPROPERTY(BlueprintReadOnly, Category = "Phys X Instance")
+	APhysXInstancedMeshActor* OwningPhysXActor;
+
+	// --- Navigation ----------------------------------------------------------
+
+	/**
+	 * If true, per-instance changes call PartialNavigationUpdate()
+	 * to update navigation data for the affected instance.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Phys X Instance|Navigation")
+	bool bInstancesAffectNavigation;
+
+	/** Set whether per-instance updates should trigger navigation updates. */
+	UFUNCTION(BlueprintCallable, Category = "Phys X Instance|Navigation")
+	void SetInstancesAffectNavigation(bool bNewValue);
+
+	/** Get whether per-instance updates trigger navigation updates. */
+	bool GetInstancesAffectNavigation() const { return bInstancesAffectNavigation; }
+
+	// --- Deferred cluster tree ----------------------------------------------
+
+	/** Record NumChanges added/removed instances; the tree is rebuilt later by FlushTreeRebuild(). */
+	void NotifyInstancesChanged(int32 NumChanges, double CurrentTime);
+
+	/** True if instances changed since the last flush. */
+	bool HasPendingTreeRebuild() const { return PendingTreeChanges > 0; }
+
+	/** Number of instance changes since the last flush. */
+	int32 GetPendingTreeChanges() const { return PendingTreeChanges; }
+
+	/** Time (world seconds) of the oldest change since the last flush. */
+	double GetFirstPendingChangeTime() const { return FirstPendingChangeTime; }
+
+	/** Rebuild the cluster tree if it is outdated and clear the pending counters. */
+	void FlushTreeRebuild(bool bAsync);
+
+protected:
+	// --- Registration --------------------------------------------------------
+
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+
+	// --- Navigation ----------------------------------------------------------
+
+	virtual void PartialNavigationUpdate(int32 InstanceIndex) override;
+
+private:
+	/** Instance changes accumulated since the last flush. */
+	int32 PendingTreeChanges = 0;
+
+	/** World time of the first accumulated change. */
+	double FirstPendingChangeTime = 0.0;
+};
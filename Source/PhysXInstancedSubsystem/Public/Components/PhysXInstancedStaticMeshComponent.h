@@ -34,6 +34,17 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Phys X Instance")
 	APhysXInstancedMeshActor* OwningPhysXActor;
 
+	// --- Spatial chunk ------------------------------------------------------
+
+	/** True if this component is a spatial chunk of its owning actor. */
+	bool bIsSpatialChunk = false;
+
+	/** XY cell covered by this chunk (valid only when bIsSpatialChunk is true). */
+	FIntVector ChunkCell = FIntVector::ZeroValue;
+
+	/** True for the owner's sleeping-tier components (the shared one or a per-cell sleeping chunk). */
+	bool bIsSleepingTier = false;
+
 	// --- Navigation ----------------------------------------------------------
 
 	/**
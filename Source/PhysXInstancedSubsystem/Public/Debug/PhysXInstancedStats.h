@@ -57,6 +57,96 @@ DECLARE_CYCLE_STAT_EXTERN(TEXT("Async Step - ApplyResults"), STAT_PhysXInstanced
 /** Batched registration: ParallelFor over CreateBody jobs. */
 DECLARE_CYCLE_STAT_EXTERN(TEXT("Register - ParallelFor"), STAT_PhysXInstanced_RegisterParallel, STATGROUP_PhysXInstanced, );
 
+// --- Scene insertion -------------------------------------------------------
+
+/** Scene insertion: one batched addActors call for the frame's budgeted bodies. */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Scene Insert - AddActors"), STAT_PhysXInstanced_SceneAddBatch, STATGROUP_PhysXInstanced, );
+
+/** Scene insertion: number of bodies inserted this frame. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Scene Inserted Bodies"), STAT_PhysXInstanced_SceneAddedActors, STATGROUP_PhysXInstanced, );
+
+/** Scene removal: one batched removeActors call per scene for mass removals and teardown. */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Scene Remove - RemoveActors"), STAT_PhysXInstanced_SceneRemoveBatch, STATGROUP_PhysXInstanced, );
+
+/** Scene removal: number of bodies removed through batched calls this frame. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Scene Removed Bodies"), STAT_PhysXInstanced_SceneRemovedActors, STATGROUP_PhysXInstanced, );
+
+// --- Async body creation ---------------------------------------------------
+
+/** Async registration: game-thread finalization of bodies created on background tasks. */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Async Create - Finalize"), STAT_PhysXInstanced_AsyncCreateFinalize, STATGROUP_PhysXInstanced, );
+
+/** Async registration: instances still waiting for their body. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Async Create Backlog"), STAT_PhysXInstanced_AsyncCreateBacklog, STATGROUP_PhysXInstanced, );
+
+// --- Runtime collision cooking ---------------------------------------------
+
+/** Runtime cooking: rebuilding proxy bodies with their cooked shape. */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Cooked Shapes - Swap"), STAT_PhysXInstanced_CookedShapeSwap, STATGROUP_PhysXInstanced, );
+
+/** Runtime cooking: collision meshes requested or cooking. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Cooked Shapes Pending"), STAT_PhysXInstanced_CookedShapesPending, STATGROUP_PhysXInstanced, );
+
+// --- Spatial hash ----------------------------------------------------------
+
+/** Spatial hash: nearest / radius / box queries answered from the instance grid. */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spatial Hash - Query"), STAT_PhysXInstanced_SpatialHashQuery, STATGROUP_PhysXInstanced, );
+
+/** Spatial hash: frustum / cone / screen-rect selection. */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spatial Hash - Selection"), STAT_PhysXInstanced_SelectionQuery, STATGROUP_PhysXInstanced, );
+
+/** Spatial hash: occupied grid cells. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Spatial Hash Cells"), STAT_PhysXInstanced_SpatialHashCells, STATGROUP_PhysXInstanced, );
+
+// --- Batched queries -------------------------------------------------------
+
+/** Batched queries: whole batch, including the parallel wait. */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Batched Queries"), STAT_PhysXInstanced_BatchQuery, STATGROUP_PhysXInstanced, );
+
+/** Batched queries: queries issued this frame. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Batched Query Count"), STAT_PhysXInstanced_BatchQueryCount, STATGROUP_PhysXInstanced, );
+
+/** Async queries: AsyncQueries phase, grouping and promise fulfillment included. */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Async Queries"), STAT_PhysXInstanced_AsyncQueries, STATGROUP_PhysXInstanced, );
+
+/** Async queries: requests completed this frame. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Async Query Count"), STAT_PhysXInstanced_AsyncQueryCount, STATGROUP_PhysXInstanced, );
+
+// --- Render tiers ----------------------------------------------------------
+
+/** Render tiers: moving instances between active and sleeping components. */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Render Tiers - Migrate"), STAT_PhysXInstanced_RenderTierMigrate, STATGROUP_PhysXInstanced, );
+
+/** Render tiers: number of instances moved between components this frame. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Render Tier Migrations"), STAT_PhysXInstanced_RenderTierMigrations, STATGROUP_PhysXInstanced, );
+
+/** Render tiers: number of queued migrations still waiting for budget. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Render Tier Pending"), STAT_PhysXInstanced_RenderTierPending, STATGROUP_PhysXInstanced, );
+
+/** Storage: flushing deferred cluster-tree rebuilds of hierarchical storage components. */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Storage Trees - Rebuild"), STAT_PhysXInstanced_StorageTreeRebuild, STATGROUP_PhysXInstanced, );
+
+/** Storage: number of cluster-tree rebuilds started this frame. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Storage Tree Rebuilds"), STAT_PhysXInstanced_StorageTreeRebuilds, STATGROUP_PhysXInstanced, );
+
+/** Storage: number of hierarchical storage components waiting for a rebuild. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Storage Tree Pending"), STAT_PhysXInstanced_StorageTreePending, STATGROUP_PhysXInstanced, );
+
+/** Storage: overlap, ray and sweep queries answered by the storage BVH. */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Storage BVH - Query"), STAT_PhysXInstanced_StorageBVHQuery, STATGROUP_PhysXInstanced, );
+
+/** Storage: full rebuilds of the storage BVH. */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Storage BVH - Rebuild"), STAT_PhysXInstanced_StorageBVHRebuild, STATGROUP_PhysXInstanced, );
+
+/** Storage: instances tracked by the storage BVH. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Storage BVH Leaves"), STAT_PhysXInstanced_StorageBVHLeaves, STATGROUP_PhysXInstanced, );
+
+/** Shapes: number of distinct PxShapes shared between instance bodies. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Shared Shapes"), STAT_PhysXInstanced_SharedShapes, STATGROUP_PhysXInstanced, );
+
+/** Shapes: number of out-of-scene bodies parked for reuse. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pooled Bodies"), STAT_PhysXInstanced_PooledBodies, STATGROUP_PhysXInstanced, );
+
 // --- Counters --------------------------------------------------------------
 
 /** Async step: number of jobs (simulated bodies) processed this frame. */
@@ -27,4 +27,14 @@
 static FORCEINLINE float U2PScalar(float ValueUU)
 {	return U2PVector(FVector(ValueUU, 0.f, 0.f)).x;	}
 
+namespace PhysXIS
+{
+	/**
+	 * Set in query filter word3 of every instance shape.
+	 * The engine uses the low 7 bits (EPDF_* flags) and the top 11 bits (channel and mask filter) of word3.
+	 * Query filter word0 holds the owning actor's UniqueID, or the archetype's for shapes shared through an archetype.
+	 */
+	static constexpr uint32 QueryFlag_Instance = 1u << 16;
+}
+
 #endif // PHYSICS_INTERFACE_PHYSX
\ No newline at end of file
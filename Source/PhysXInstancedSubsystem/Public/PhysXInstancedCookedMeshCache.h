@@ -0,0 +1,136 @@
+﻿/**
+* Copyright (C) 2025 | Created by NordVader Inc.
+* All rights reserved!
+* My Discord Server: https://discord.gg/B8prpf3vzD
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "HAL/CriticalSection.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+#if PHYSICS_INTERFACE_PHYSX
+
+#include "PhysXIncludes.h"
+
+class UBodySetup;
+
+// ============================================================================
+// Cooked collision cache
+// ============================================================================
+
+/** Kind of cooked PhysX mesh an instance shape needs. */
+enum class EPhysXCookedMeshKind : uint8
+{
+	Convex,
+	TriangleMesh
+};
+
+/**
+ * Runtime cooking of convex / triangle meshes for body setups that have no cooked data
+ * (e.g. a runtime-generated OverrideCollisionMesh).
+ *
+ * Bodies ask for a mesh with FindOrRequest*(); on a miss the body spawns with a proxy box and the mesh
+ * is cooked on a worker thread. Cooked bytes are stored on disk keyed by a hash of the source geometry,
+ * so later sessions only deserialize them. Tick() (game thread) starts cooks and creates finished meshes.
+ *
+ * Runtime cooking needs the PhysXCooking module, which is usually editor-only. Without it, only meshes
+ * already in the disk cache are loaded and everything else keeps the box.
+ *
+ * Process-wide: cooked meshes do not depend on a world. Requests are game thread only; state queries are thread-safe.
+ */
+class PHYSXINSTANCEDSUBSYSTEM_API FPhysXInstancedCookedMeshCache
+{
+public:
+	static FPhysXInstancedCookedMeshCache& Get();
+
+	~FPhysXInstancedCookedMeshCache();
+
+	/**
+	 * Cooked convex mesh for BodySetup, or nullptr. Game thread only.
+	 * bOutPending is true when a cook was requested or is running, so a proxy shape should be used for now.
+	 */
+	physx::PxConvexMesh* FindOrRequestConvex(UBodySetup* BodySetup, bool& bOutPending);
+
+	/** Triangle-mesh counterpart of FindOrRequestConvex(). */
+	physx::PxTriangleMesh* FindOrRequestTriangleMesh(UBodySetup* BodySetup, bool& bOutPending);
+
+	/** True while a mesh for BodySetup is requested or cooking. */
+	bool IsPending(const UBodySetup* BodySetup, EPhysXCookedMeshKind Kind) const;
+
+	/** True once a mesh for BodySetup was created and can be looked up. */
+	bool IsReady(const UBodySetup* BodySetup, EPhysXCookedMeshKind Kind) const;
+
+	/** Game thread: starts requested cooks and creates meshes from finished ones. Returns meshes that became ready. */
+	int32 Tick();
+
+	/** Waits for running cooks and releases every cached mesh. */
+	void Reset();
+
+	/** When disabled, lookups never request cooks (missing data falls back to a box as before). */
+	void SetEnabled(bool bInEnabled) { bEnabled = bInEnabled; }
+
+	/** Reads and writes cooked bytes under Saved/PhysXInstanced/CookedCollision. */
+	void SetDiskCacheEnabled(bool bInEnabled) { bDiskCacheEnabled = bInEnabled; }
+
+	/** Number of meshes requested or cooking. */
+	int32 NumPending() const;
+
+private:
+	enum class EState : uint8
+	{
+		Requested,
+		Cooking,
+		Ready,
+		Failed
+	};
+
+	/** Output of one cook task; the task owns nothing else. */
+	struct FCookResult
+	{
+		TArray<uint8> CookedData;
+		bool          bLoadedFromDisk = false;
+	};
+
+	struct FEntry
+	{
+		/** Dereferenced on the game thread only; tasks get the gathered source geometry instead. */
+		TWeakObjectPtr<UBodySetup> BodySetup;
+		EPhysXCookedMeshKind       Kind  = EPhysXCookedMeshKind::Convex;
+		EState                     State = EState::Requested;
+
+		/** PxConvexMesh or PxTriangleMesh once ready; the cache owns one reference. */
+		physx::PxBase* Mesh = nullptr;
+
+		/** Disk cache file for this geometry. */
+		FString CachePath;
+
+		/** Filled by the cook task, consumed on the game thread once Task is ready. */
+		TSharedPtr<FCookResult, ESPMode::ThreadSafe> Result;
+		TFuture<void> Task;
+	};
+
+	using FEntryKey = TPair<const UBodySetup*, EPhysXCookedMeshKind>;
+
+	physx::PxBase* FindOrRequest(UBodySetup* BodySetup, EPhysXCookedMeshKind Kind, bool& bOutPending);
+
+	void StartCook_Locked(FEntry& Entry);
+	void FinishCook_Locked(FEntry& Entry);
+
+	/** Loads the PhysXCooking module once; null when this build ships without it. Game thread only. */
+	class IPhysXCooking* GetCooker();
+
+	class IPhysXCooking* Cooker = nullptr;
+	bool bCookerResolved = false;
+
+	TMap<FEntryKey, TUniquePtr<FEntry>> Entries;
+
+	bool bEnabled          = true;
+	bool bDiskCacheEnabled = true;
+
+	mutable FCriticalSection Lock;
+};
+
+#endif // PHYSICS_INTERFACE_PHYSX
@@ -0,0 +1,170 @@
+﻿/**
+* Copyright (C) 2025 | Created by NordVader Inc.
+* All rights reserved!
+* My Discord Server: https://discord.gg/B8prpf3vzD
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/Function.h"
+#include "Types/PhysXInstancedTypes.h"
+
+#if PHYSICS_INTERFACE_PHYSX
+
+#include "PhysXIncludes.h"
+
+class UBodySetup;
+class UStaticMesh;
+
+// ============================================================================
+// Shared shape cache
+// ============================================================================
+
+/**
+ * Identity of a shareable instance shape.
+ * Two bodies can share a PxShape only if geometry, local pose, material and filter data all match,
+ * so the key covers the collision mesh, the shape type, the snapped scale and the resolved filter words.
+ */
+struct FPhysXShapeCacheKey
+{
+	/** Render mesh whose bounds drive fitted primitives. */
+	const UStaticMesh* StaticMesh = nullptr;
+
+	/** Body setup the geometry was built from (collision mesh). */
+	const UBodySetup* BodySetup = nullptr;
+
+	/** Effective shape type (after fallbacks are decided by the caller). */
+	EPhysXInstanceShapeType ShapeType = EPhysXInstanceShapeType::Box;
+
+	/** Scale used to build the geometry, already snapped to the cache quantum. */
+	FVector Scale = FVector::OneVector;
+
+	/** Extra local offset applied to the shape (capsule collision offset), identity otherwise. */
+	FTransform LocalOffset = FTransform::Identity;
+
+	/** Material assigned to the shape. */
+	const physx::PxMaterial* Material = nullptr;
+
+	/**
+	 * Query and simulation filter words (collision profile, CCD and notify flags).
+	 * Shapes bake filter data, so actors with different profiles cannot share; per-component
+	 * and per-body words are zeroed by the body builder so chunks of one actor still do.
+	 */
+	uint32 QueryWords[4] = { 0, 0, 0, 0 };
+	uint32 SimWords[4]   = { 0, 0, 0, 0 };
+
+	bool operator==(const FPhysXShapeCacheKey& Other) const;
+
+	friend uint32 GetTypeHash(const FPhysXShapeCacheKey& Key);
+};
+
+/**
+ * Ref-counted cache of non-exclusive PxShapes shared between instance bodies.
+ *
+ * Every Acquire() must be paired with a Release() once the body that attached the shape is gone.
+ * The cache keeps one PhysX reference per entry and drops it when the last body releases the shape.
+ *
+ * Each entry also pools out-of-scene rigid dynamics that already have the shape attached.
+ * A pooled actor keeps its shape reference while parked, so a shape stays alive as long as its pool is not empty.
+ *
+ * Thread-safe: bodies may be created from ParallelFor workers.
+ */
+class PHYSXINSTANCEDSUBSYSTEM_API FPhysXInstancedShapeCache
+{
+public:
+	FPhysXInstancedShapeCache() = default;
+	~FPhysXInstancedShapeCache();
+
+	FPhysXInstancedShapeCache(const FPhysXInstancedShapeCache&) = delete;
+	FPhysXInstancedShapeCache& operator=(const FPhysXInstancedShapeCache&) = delete;
+
+	/**
+	 * Return a shared shape for Key and add a reference to it.
+	 * On a miss CreateShape is called (under the cache lock) and must return a non-exclusive shape or nullptr.
+	 */
+	physx::PxShape* Acquire(const FPhysXShapeCacheKey& Key, TFunctionRef<physx::PxShape*()> CreateShape);
+
+	/** Drop one reference taken by Acquire(). Releases the PxShape when the last reference goes. */
+	void Release(physx::PxShape* Shape);
+
+	/** Release every pooled actor and cached shape regardless of outstanding references (world teardown). */
+	void Reset();
+
+	/** Number of distinct shapes currently cached. */
+	int32 Num() const;
+
+	/** Number of rigid dynamics parked in all pools. */
+	int32 NumPooledActors() const;
+
+	/** Max actors parked per shape. 0 disables pooling; lowering it trims existing pools. */
+	void SetMaxPooledActorsPerShape(int32 InMaxPooled);
+
+	/**
+	 * Pop a pooled actor with Shape attached, or nullptr if the pool is empty.
+	 * Consumes the reference taken by Acquire(): the pooled actor already holds one.
+	 */
+	physx::PxRigidDynamic* TakePooledActor(physx::PxShape* Shape);
+
+	/**
+	 * Park an actor (already removed from its scene) in the pool of Shape, keeping its shape reference.
+	 * Returns false if the pool is full or pooling is disabled; the caller then releases actor and shape as usual.
+	 */
+	bool RecycleActor(physx::PxRigidDynamic& Actor, physx::PxShape* Shape);
+
+	/** Scale step used to snap instance scales before keying. <= 0 disables snapping. */
+	void SetScaleQuantum(float InQuantum) { ScaleQuantum = InQuantum; }
+
+	/** Snap a scale to the cache quantum. Never returns a zero component. */
+	FVector QuantizeScale(const FVector& Scale) const { return QuantizeScale(Scale, ScaleQuantum); }
+
+	/** Snap a scale to Quantum without touching any cache. <= 0 disables snapping. */
+	static FVector QuantizeScale(const FVector& Scale, float Quantum);
+
+	/**
+	 * Apply mass, mass-space inertia and center-of-mass pose for a body whose only shape is Shape.
+	 * Values are computed once per (shape, density, mass scale) and reused by every later body.
+	 * Returns false if Shape is not owned by this cache or has no mass (triangle meshes);
+	 * the caller then falls back to PxRigidBodyExt::updateMassAndInertia.
+	 */
+	bool ApplyMassProperties(physx::PxRigidDynamic& Body, physx::PxShape* Shape, float Density, float MassScale);
+
+private:
+	struct FMassProperties
+	{
+		float Density   = 0.f;
+		float MassScale = 1.f;
+
+		physx::PxReal      Mass = 0.f;
+		physx::PxVec3      InertiaDiagonal = physx::PxVec3(0.f);
+		physx::PxTransform CMassLocalPose  = physx::PxTransform(physx::PxIdentity);
+	};
+
+	struct FEntry
+	{
+		physx::PxShape* Shape    = nullptr;
+		int32           RefCount = 0;
+
+		/** Mass properties per (density, mass scale); usually a single entry. */
+		TArray<FMassProperties, TInlineAllocator<1>> MassProperties;
+
+		/** Out-of-scene actors with Shape attached, each holding one reference. */
+		TArray<physx::PxRigidDynamic*> PooledActors;
+	};
+
+	/** Releases pooled actors beyond MaxPooled and drops their references. Lock must be held. */
+	void TrimPool_Locked(FEntry& Entry, int32 MaxPooled);
+
+	TMap<FPhysXShapeCacheKey, FEntry>          Entries;
+	TMap<physx::PxShape*, FPhysXShapeCacheKey> KeyByShape;
+
+	float ScaleQuantum = 0.01f;
+
+	int32 MaxPooledActorsPerShape = 0;
+	int32 NumPooled = 0;
+
+	mutable FCriticalSection Lock;
+};
+
+#endif // PHYSICS_INTERFACE_PHYSX
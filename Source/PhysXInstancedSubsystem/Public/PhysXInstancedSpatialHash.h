@@ -0,0 +1,151 @@
+﻿/**
+* Copyright (C) 2025 | Created by NordVader Inc.
+* All rights reserved!
+* My Discord Server: https://discord.gg/B8prpf3vzD
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ConvexVolume.h"
+#include "Templates/Function.h"
+#include "Types/PhysXInstancedTypes.h"
+
+// ============================================================================
+// Instance spatial hash
+// ============================================================================
+
+/**
+ * Uniform grid over instance positions, keyed by FPhysXInstanceID.
+ *
+ * Cells are cubes of CellSize and only occupied cells are stored, so memory follows the instance count.
+ * Each cell keeps the ID and position side by side: queries test candidates without touching instance records.
+ * Update() is O(1) and only moves the entry between cells when it crosses a cell border.
+ *
+ * Positions are whatever the owner last reported; the hash never reads bodies or components itself.
+ * Updates are game thread only; const queries may run on workers while no update is in flight.
+ */
+class PHYSXINSTANCEDSUBSYSTEM_API FPhysXInstancedSpatialHash
+{
+public:
+	/** One result of FindKNearest. */
+	struct FNeighbor
+	{
+		FPhysXInstanceID ID;
+		float            DistSq = 0.f;
+	};
+
+	/** Insert ID at Location, or move it there if it is already tracked. */
+	void Update(FPhysXInstanceID ID, const FVector& Location);
+
+	/** Stop tracking ID. Returns false if it was not tracked. */
+	bool Remove(FPhysXInstanceID ID);
+
+	/** Last reported position of ID. */
+	bool GetLocation(FPhysXInstanceID ID, FVector& OutLocation) const;
+
+	bool Contains(FPhysXInstanceID ID) const { return Entries.Contains(ID); }
+
+	/** Drop every entry and cell. */
+	void Reset();
+
+	/** Number of tracked instances. */
+	int32 Num() const { return Entries.Num(); }
+
+	/** Number of occupied cells. */
+	int32 NumCells() const { return Cells.Num(); }
+
+	/** Edge length of a cell. Changing it re-buckets every tracked entry. */
+	void SetCellSize(float InCellSize);
+	float GetCellSize() const { return CellSize; }
+
+	/**
+	 * Call Visitor for every entry within Radius of Center. Returns the number of entries visited.
+	 * The visitor returns false to stop the query early.
+	 */
+	int32 ForEachInSphere(const FVector& Center, float Radius, TFunctionRef<bool(FPhysXInstanceID, const FVector&)> Visitor) const;
+
+	/** Same as ForEachInSphere for entries inside Box. */
+	int32 ForEachInBox(const FBox& Box, TFunctionRef<bool(FPhysXInstanceID, const FVector&)> Visitor) const;
+
+	/**
+	 * Entries inside a convex volume (planes facing outward, as FConvexVolume expects), grown by ItemRadius.
+	 * Bounds must enclose the volume; it limits the cells considered.
+	 * Whole cells are culled or accepted against the planes first, so only cells straddling a plane test their entries.
+	 */
+	int32 ForEachInConvexVolume(
+		const FConvexVolume& Volume,
+		const FBox& Bounds,
+		float ItemRadius,
+		TFunctionRef<bool(FPhysXInstanceID, const FVector&)> Visitor) const;
+
+	/**
+	 * Entries inside a cone with apex Origin, unit axis Direction, half angle HalfAngleRadians and length Length.
+	 * Cells are culled by their bounding sphere before the per-entry angle test.
+	 */
+	int32 ForEachInCone(
+		const FVector& Origin,
+		const FVector& Direction,
+		float HalfAngleRadians,
+		float Length,
+		TFunctionRef<bool(FPhysXInstanceID, const FVector&)> Visitor) const;
+
+	/**
+	 * Closest entry to Location accepted by Filter, searching outward ring by ring.
+	 * MaxDistance <= 0 means unbounded. Returns an invalid ID if nothing passes.
+	 */
+	FPhysXInstanceID FindNearest(
+		const FVector& Location,
+		float MaxDistance,
+		TFunctionRef<bool(FPhysXInstanceID, const FVector&)> Filter,
+		float* OutDistSq = nullptr) const;
+
+	/**
+	 * Up to OutNeighbors.Num() closest entries accepted by Filter, sorted by distance.
+	 * Filter only runs for entries that would enter the current result. Returns the number written.
+	 * Read-only: safe to run from several workers while the owner is not updating the hash.
+	 */
+	int32 FindKNearest(
+		const FVector& Location,
+		float MaxDistance,
+		TFunctionRef<bool(FPhysXInstanceID, const FVector&)> Filter,
+		TArrayView<FNeighbor> OutNeighbors) const;
+
+private:
+	struct FCellItem
+	{
+		FPhysXInstanceID ID;
+		FVector          Location = FVector::ZeroVector;
+	};
+
+	struct FEntry
+	{
+		FIntVector Cell = FIntVector::ZeroValue;
+		int32      SlotInCell = INDEX_NONE;
+	};
+
+	FIntVector GetCell(const FVector& Location) const;
+
+	void AddToCell(FPhysXInstanceID ID, const FVector& Location, FEntry& Entry);
+	void RemoveFromCell(const FEntry& Entry);
+
+	/** Call Visitor for every item of every occupied cell in [MinCell, MaxCell]. Returns false if stopped. */
+	bool ForEachCellInRange(const FIntVector& MinCell, const FIntVector& MaxCell, TFunctionRef<bool(const FCellItem&)> Visitor) const;
+
+	/** Same walk, one call per occupied cell. */
+	bool ForEachOccupiedCellInRange(
+		const FIntVector& MinCell,
+		const FIntVector& MaxCell,
+		TFunctionRef<bool(const FIntVector&, const TArray<FCellItem>&)> Visitor) const;
+
+	TMap<FIntVector, TArray<FCellItem>> Cells;
+	TMap<FPhysXInstanceID, FEntry>      Entries;
+
+	/** Bounds of every cell ever occupied since the last reset; caps the nearest-ring expansion. */
+	FIntVector OccupiedMin = FIntVector::ZeroValue;
+	FIntVector OccupiedMax = FIntVector::ZeroValue;
+	bool       bHasOccupiedBounds = false;
+
+	float CellSize = 1000.f;
+	float InvCellSize = 1.f / 1000.f;
+};
@@ -0,0 +1,103 @@
+﻿/**
+* Copyright (C) 2025 | Created by NordVader Inc.
+* All rights reserved!
+* My Discord Server: https://discord.gg/B8prpf3vzD
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+#include "Types/PhysXInstancedTypes.h"
+
+// ============================================================================
+// Storage BVH
+// ============================================================================
+
+/**
+ * Dynamic AABB tree over static (storage) instances, one leaf per instance.
+ *
+ * Insert() and Remove() are incremental (best-sibling insertion by surface area, refit up to the root).
+ * Incremental edits slowly degrade the tree, so the owner calls Rebuild() once NeedsRebuild() says so;
+ * the rebuild is a top-down midpoint split over leaf centers.
+ *
+ * Leaves hold world AABBs only. Queries report candidates and leave exact tests to the caller.
+ * Game thread only.
+ */
+class PHYSXINSTANCEDSUBSYSTEM_API FPhysXInstancedStorageBVH
+{
+public:
+	/** Add ID with world bounds Box, or replace its bounds if it is already in the tree. */
+	void Insert(FPhysXInstanceID ID, const FBox& Box);
+
+	/** Remove ID. Returns false if it was not in the tree. */
+	bool Remove(FPhysXInstanceID ID);
+
+	bool Contains(FPhysXInstanceID ID) const { return LeafByID.Contains(ID); }
+
+	/** Drop every node. */
+	void Reset();
+
+	/** Number of leaves. */
+	int32 Num() const { return LeafByID.Num(); }
+
+	/** True once incremental edits since the last rebuild reach MinChanges and a quarter of the leaves. */
+	bool NeedsRebuild(int32 MinChanges) const;
+
+	/** Rebuild the whole tree top-down from the current leaves. */
+	void Rebuild();
+
+	/**
+	 * Call Visitor for every leaf whose box overlaps the sphere. Returns the number of leaves visited.
+	 * The visitor returns false to stop the query early.
+	 */
+	int32 ForEachOverlappingSphere(const FVector& Center, float Radius, TFunctionRef<bool(FPhysXInstanceID, const FBox&)> Visitor) const;
+
+	/** Same as ForEachOverlappingSphere for leaves overlapping Box. */
+	int32 ForEachOverlappingBox(const FBox& Box, TFunctionRef<bool(FPhysXInstanceID, const FBox&)> Visitor) const;
+
+	/**
+	 * Closest hit along Start -> End, with leaf boxes inflated by Extent (zero for rays, shape half-size for sweeps).
+	 * HitTest gets each leaf whose box is entered before the current best hit, together with the entry fraction,
+	 * and returns the exact hit fraction in [0, 1] or a negative value to reject the leaf.
+	 * Returns the fraction of the best hit and sets OutID, or returns -1 if nothing was hit.
+	 */
+	float RayCast(
+		const FVector& Start,
+		const FVector& End,
+		const FVector& Extent,
+		TFunctionRef<float(FPhysXInstanceID, float /*EntryFraction*/)> HitTest,
+		FPhysXInstanceID& OutID) const;
+
+private:
+	struct FNode
+	{
+		FBox  Bounds = FBox(ForceInit);
+		int32 Parent = INDEX_NONE;
+		int32 Left   = INDEX_NONE;
+		int32 Right  = INDEX_NONE;
+
+		/** Valid on leaves only. */
+		FPhysXInstanceID ID;
+
+		bool IsLeaf() const { return Left == INDEX_NONE; }
+	};
+
+	int32 AllocateNode();
+	void FreeNode(int32 NodeIndex);
+
+	void InsertLeaf(int32 Leaf);
+	void RemoveLeaf(int32 Leaf);
+
+	/** Recompute bounds from NodeIndex up to the root. */
+	void RefitFrom(int32 NodeIndex);
+
+	TArray<FNode> Nodes;
+	TArray<int32> FreeNodes;
+	TMap<FPhysXInstanceID, int32> LeafByID;
+
+	int32 Root = INDEX_NONE;
+
+	/** Inserts and removes since the last rebuild. */
+	int32 NumChangesSinceRebuild = 0;
+};
@@ -19,6 +19,7 @@ enum class EPhysXISProcessCategory : uint8
 	DeferredInstanceOps,
 	PhysicsStep,
 	Lifetime,
+	Rendering,
 	Other
 };
 
@@ -8,11 +8,15 @@
 
 #include "CoreMinimal.h"
 #include "Engine/EngineTypes.h"
+#include "Async/Future.h"
+#include "HAL/CriticalSection.h"
 #include "Subsystems/WorldSubsystem.h"
 #include "Templates/UniquePtr.h"
 
 #include "Types/PhysXInstancedTypes.h"
 #include "Processes/PhysXInstancedProcessPipeline.h"
+#include "PhysXInstancedSpatialHash.h"
+#include "PhysXInstancedStorageBVH.h"
 
 #include "Actors/PhysXInstancedMeshActor.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
@@ -21,6 +25,7 @@
 	#include "PhysXPublic.h"
 	#include "PhysXIncludes.h"
 	#include "PxRigidBodyExt.h"
+	#include "PhysXInstancedShapeCache.h"
 #endif
 
 
@@ -28,6 +33,7 @@
 
 class UInstancedStaticMeshComponent;
 class UPhysXInstancedStaticMeshComponent;
+class UPhysXInstancedHierarchicalStaticMeshComponent;
 class APhysXInstancedMeshActor;
 
 #if PHYSICS_INTERFACE_PHYSX
@@ -41,6 +47,8 @@ namespace physx
 namespace PhysXIS
 {
 #if PHYSICS_INTERFACE_PHYSX
+	class FAsyncBodyCreationProcess;
+	class FCookedShapesProcess;
 	class FAddActorsProcess;
 	class FInstanceTasksProcess;
 
@@ -48,12 +56,19 @@ namespace PhysXIS
 	class FPhysicsStepStopActionsProcess;
 	class FPhysicsStepTransformSyncProcess;
 	class FPhysicsStepFinalizeProcess;
+
+	class FRenderTiersProcess;
 #endif
 
 	class FPhysicsStepProcess;
+	class FAsyncQueriesProcess;
+	class FStorageTreesProcess;
 	class FLifetimeProcess;
 }
 
+/** Fired once every body of an async registration batch exists; failed instances are not listed. */
+DECLARE_DELEGATE_OneParam(FPhysXInstanceBodiesCreatedDelegate, const TArray<FPhysXInstanceID>&);
+
 /**
  * World-level subsystem that owns all PhysX-backed instanced bodies.
  *
@@ -111,6 +126,7 @@ public:
 	 * @param InstancedMesh  Owning instanced static mesh component.
 	 * @param InstanceIndex  Index inside the ISM (0..NumInstances-1).
 	 * @param bSimulate      If true, a PhysX body is created and starts simulating.
+	 * @param InsertionPriority  Higher values enter the PhysX scene earlier (see SetSceneInsertionRelevancePoints).
 	 *
 	 * @return Stable handle used to control the instance later.
 	 *         Returns an invalid ID (UniqueID == 0) on failure.
@@ -118,7 +134,8 @@ public:
 	FPhysXInstanceID RegisterInstance(
 		UInstancedStaticMeshComponent* InstancedMesh,
 		int32 InstanceIndex,
-		bool bSimulate);
+		bool bSimulate,
+		int32 InsertionPriority = 0);
 
 	/**
 	 * Register many ISM instances in one pass.
@@ -130,6 +147,26 @@ public:
 		bool bSimulate,
 		TArray<FPhysXInstanceID>& OutInstanceIDs);
 
+	/**
+	 * Register many ISM instances without blocking the calling frame.
+	 * IDs are returned immediately in the "pending body" state; bodies are created on background
+	 * tasks across frames and finalized (mass, user data, scene enqueue) within a per-frame budget.
+	 */
+	void RegisterInstancesBatchAsync(
+		UInstancedStaticMeshComponent* InstancedMesh,
+		const TArray<int32>& InstanceIndices,
+		bool bSimulate,
+		TArray<FPhysXInstanceID>& OutInstanceIDs,
+		FPhysXInstanceBodiesCreatedDelegate OnCompleted = FPhysXInstanceBodiesCreatedDelegate());
+
+	/** True while an asynchronously registered instance is still waiting for its PhysX body. */
+	UFUNCTION(BlueprintPure, Category = "Phys X Instance|Registration")
+	bool IsInstanceBodyPending(FPhysXInstanceID ID) const;
+
+	/** Number of asynchronously registered instances that do not have their body yet. */
+	UFUNCTION(BlueprintPure, Category = "Phys X Instance|Registration")
+	int32 GetNumPendingAsyncBodies() const;
+
 	/** Removes an instance record; if a PhysX body exists, it is destroyed as well. */
 	void UnregisterInstance(FPhysXInstanceID ID);
 
@@ -176,9 +213,21 @@ private:
 		bool bCreateStorageActorIfNeeded,
 		EPhysXInstanceConvertReason Reason);
 
+	/** bDeferStorageIndexFixup leaves the indices of other storage instances to the caller (see the batch below). */
 	bool ConvertStorageInstanceToDynamic_Internal(
 		FPhysXInstanceID ID,
 		bool bCreateDynamicActorIfNeeded,
+		EPhysXInstanceConvertReason Reason,
+		bool bDeferStorageIndexFixup = false);
+
+	/**
+	 * ConvertStorageInstanceToDynamic_Internal for many IDs. IDs are grouped by storage component and converted
+	 * from the highest instance index down, so pending IDs never move; indices and slot mappings are fixed up
+	 * once per component. Returns the number converted.
+	 */
+	int32 ConvertStorageInstancesToDynamic_Internal(
+		TArrayView<const FPhysXInstanceID> IDs,
+		bool bCreateDynamicActorIfNeeded,
 		EPhysXInstanceConvertReason Reason);
 public:
 	// ---------------------------------------------------------------------
@@ -199,6 +248,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Phys X Instance|Physics")
 	bool IsInstancePhysicsEnabled(FPhysXInstanceID ID) const;
 
+	// ---------------------------------------------------------------------
+	// Material variants
+	// ---------------------------------------------------------------------
+
+	/** Selects a material variant of the owning actor for an instance (writes its custom data). */
+	UFUNCTION(BlueprintCallable, Category = "Phys X Instance|Rendering")
+	bool SetInstanceMaterialVariant(FPhysXInstanceID ID, int32 Variant);
+
+	/** Returns the material variant of an instance, or INDEX_NONE if its actor has no variant table. */
+	UFUNCTION(BlueprintPure, Category = "Phys X Instance|Rendering")
+	int32 GetInstanceMaterialVariant(FPhysXInstanceID ID) const;
+
 	// ---------------------------------------------------------------------
 	// Forces / impulses
 	// ---------------------------------------------------------------------
@@ -260,7 +321,9 @@ public:
 
 	/**
 	 * Applies a radial impulse around OriginWorld to all instances within Radius.
-	 * Storage instances can be accepted and optionally converted to dynamic first.
+	 * Bodies already in the scene are found with one PhysX overlap and pushed immediately.
+	 * Storage instances can be accepted and optionally converted to dynamic first (as one batch);
+	 * they and bodies still waiting for scene insertion get the impulse through the instance task queue.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Phys X Instance|Forces",
 		meta = (AdvancedDisplay = "bIncludeStorage,bConvertStorageToDynamic,bLinearFalloff,DebugMode,DebugDrawDuration"))
@@ -342,6 +405,109 @@ public:
 		int32 IgnoreInstanceIndex,
 		bool bIncludeStorage) const;
 
+	/**
+	 * The K instances closest to WorldLocation, sorted by distance, with the same filters as FindNearestInstanceAdvanced.
+	 * OutHits is cleared first. MaxDistance <= 0 means unbounded. Returns the number found.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Phys X Instance|Query",
+		meta = (AdvancedDisplay = "OptionalFilterComponent,IgnoreInstanceID,bIncludeStorage,MaxDistance"))
+	int32 FindKNearestInstances(
+		FVector WorldLocation,
+		int32 K,
+		TArray<FPhysXInstanceNearestHit>& OutHits,
+		UInstancedStaticMeshComponent* OptionalFilterComponent,
+		FPhysXInstanceID IgnoreInstanceID,
+		bool bIncludeStorage,
+		float MaxDistance) const;
+
+	/** C++ form of FindKNearestInstances: K is OutHits.Num(); returns the number of slots written. */
+	int32 FindKNearestInstances(
+		const FVector& WorldLocation,
+		TArrayView<FPhysXInstanceNearestHit> OutHits,
+		UInstancedStaticMeshComponent* OptionalFilterComponent,
+		FPhysXInstanceID IgnoreInstanceID,
+		bool bIncludeStorage,
+		float MaxDistance = 0.0f) const;
+
+	/**
+	 * FindKNearestInstances for many query points, run in parallel over the points.
+	 * IgnoreInstanceIDs is either empty or holds one ID per point (e.g. the querying agent itself).
+	 * Returns the total number of neighbors found.
+	 */
+	int32 FindKNearestInstancesBatch(
+		TArrayView<const FVector> Locations,
+		int32 K,
+		FPhysXInstanceNearestBatchResult& OutResult,
+		UInstancedStaticMeshComponent* OptionalFilterComponent,
+		TArrayView<const FPhysXInstanceID> IgnoreInstanceIDs,
+		bool bIncludeStorage,
+		float MaxDistance = 0.0f) const;
+
+	/** Blueprint wrapper of FindKNearestInstancesBatch. */
+	UFUNCTION(BlueprintCallable, Category = "Phys X Instance|Query",
+		meta = (AdvancedDisplay = "OptionalFilterComponent,IgnoreInstanceIDs,bIncludeStorage,MaxDistance"))
+	int32 FindKNearestInstanceIDsBatch(
+		const TArray<FVector>& Locations,
+		int32 K,
+		FPhysXInstanceNearestBatchResult& OutResult,
+		UInstancedStaticMeshComponent* OptionalFilterComponent,
+		const TArray<FPhysXInstanceID>& IgnoreInstanceIDs,
+		bool bIncludeStorage,
+		float MaxDistance) const;
+
+	/**
+	 * Collects instances within Radius of Center into OutIDs (cleared first) and returns their count.
+	 * Answered from the instance spatial hash: moving bodies are seen at their last synced position.
+	 * If bIncludeStorage is false, storage instances and bodies not yet in a scene are skipped.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Phys X Instance|Query",
+		meta = (AdvancedDisplay = "OptionalFilterComponent,bIncludeStorage"))
+	int32 FindInstancesInRadius(
+		FVector Center,
+		float Radius,
+		TArray<FPhysXInstanceID>& OutIDs,
+		UInstancedStaticMeshComponent* OptionalFilterComponent = nullptr,
+		bool bIncludeStorage = true) const;
+
+	/** Same as FindInstancesInRadius for instances inside an axis-aligned world box. */
+	UFUNCTION(BlueprintCallable, Category = "Phys X Instance|Query",
+		meta = (AdvancedDisplay = "OptionalFilterComponent,bIncludeStorage"))
+	int32 FindInstancesInBox(
+		FBox Box,
+		TArray<FPhysXInstanceID>& OutIDs,
+		UInstancedStaticMeshComponent* OptionalFilterComponent = nullptr,
+		bool bIncludeStorage = true) const;
+
+	/**
+	 * Selection: instances whose position is inside a cone (e.g. an AI vision cone).
+	 * Answered from the instance spatial hash; OutIDs is cleared first. Returns the number selected.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Phys X Instance|Query",
+		meta = (AdvancedDisplay = "OptionalFilterComponent,bIncludeStorage"))
+	int32 SelectInstancesInCone(
+		FVector Origin,
+		FVector Direction,
+		float HalfAngleDegrees,
+		float Length,
+		TArray<FPhysXInstanceID>& OutIDs,
+		UInstancedStaticMeshComponent* OptionalFilterComponent = nullptr,
+		bool bIncludeStorage = true) const;
+
+	/**
+	 * Selection: instances whose position projects inside the screen rectangle spanned by ScreenA and ScreenB
+	 * (viewport pixels, any two opposite corners), up to MaxDistance from the camera. Marquee selection.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Phys X Instance|Query",
+		meta = (AdvancedDisplay = "MaxDistance,OptionalFilterComponent,bIncludeStorage"))
+	int32 SelectInstancesInScreenRect(
+		APlayerController* PlayerController,
+		FVector2D ScreenA,
+		FVector2D ScreenB,
+		TArray<FPhysXInstanceID>& OutIDs,
+		float MaxDistance = 100000.0f,
+		UInstancedStaticMeshComponent* OptionalFilterComponent = nullptr,
+		bool bIncludeStorage = true) const;
+
 	/** Looks up an instance ID by its component and index. */
 	UFUNCTION(BlueprintCallable, Category = "Phys X Instance|Query")
 	FPhysXInstanceID GetInstanceIDForComponentAndIndex(
@@ -391,6 +557,221 @@ public:
 		EPhysXInstancedQueryDebugMode DebugMode = EPhysXInstancedQueryDebugMode::None,
 		float DebugDrawDuration = 0.0f) const;
 
+	/**
+	 * Batched RaycastInstanceID: closest instance hit per segment, written to OutHits[i] for Rays[i].
+	 * Rays run in parallel chunks, each under a PhysX scene read lock; storage is tested in the same pass.
+	 * Only the first Min(Rays.Num(), OutHits.Num()) rays are traced. Returns the number of rays that hit.
+	 */
+	int32 RaycastInstancesBatch(
+		TArrayView<const FPhysXInstanceRaycastRequest> Rays,
+		TArrayView<FPhysXInstanceQueryHit> OutHits,
+		bool bIncludeStorage = true,
+		ECollisionChannel TraceChannel = ECC_Visibility) const;
+
+	/** Blueprint wrapper of RaycastInstancesBatch; OutHits is resized to match Rays. */
+	UFUNCTION(BlueprintCallable, Category = "Phys X Instance|Query",
+		meta = (AdvancedDisplay = "bIncludeStorage,TraceChannel"))
+	int32 RaycastInstanceIDsBatch(
+		const TArray<FPhysXInstanceRaycastRequest>& Rays,
+		TArray<FPhysXInstanceQueryHit>& OutHits,
+		bool bIncludeStorage = true,
+		ECollisionChannel TraceChannel = ECC_Visibility) const;
+
+	/**
+	 * Batched overlaps of sphere, box and capsule shapes placed at Query.Start.
+	 * Results are written flat into OutResult (see FPhysXInstanceOverlapBatchResult); returns the total number of IDs.
+	 * Storage is matched against instance bounds with an exact shape test, PhysX bodies against their collision shapes.
+	 */
+	int32 OverlapInstancesBatch(
+		TArrayView<const FPhysXInstanceShapeQuery> Queries,
+		FPhysXInstanceOverlapBatchResult& OutResult,
+		bool bIncludeStorage = true,
+		ECollisionChannel TraceChannel = ECC_Visibility) const;
+
+	/** Blueprint wrapper of OverlapInstancesBatch. */
+	UFUNCTION(BlueprintCallable, Category = "Phys X Instance|Query",
+		meta = (AdvancedDisplay = "bIncludeStorage,TraceChannel"))
+	int32 OverlapInstanceIDsBatch(
+		const TArray<FPhysXInstanceShapeQuery>& Queries,
+		FPhysXInstanceOverlapBatchResult& OutResult,
+		bool bIncludeStorage = true,
+		ECollisionChannel TraceChannel = ECC_Visibility) const;
+
+	/**
+	 * Batched sweeps of sphere, box and capsule shapes from Query.Start to Query.End.
+	 * Same contract as RaycastInstancesBatch: closest hit per query into OutHits, returns the number of hits.
+	 */
+	int32 SweepInstancesBatch(
+		TArrayView<const FPhysXInstanceShapeQuery> Queries,
+		TArrayView<FPhysXInstanceQueryHit> OutHits,
+		bool bIncludeStorage = true,
+		ECollisionChannel TraceChannel = ECC_Visibility) const;
+
+	/** Blueprint wrapper of SweepInstancesBatch; OutHits is resized to match Queries. */
+	UFUNCTION(BlueprintCallable, Category = "Phys X Instance|Query",
+		meta = (AdvancedDisplay = "bIncludeStorage,TraceChannel"))
+	int32 SweepInstanceIDsBatch(
+		const TArray<FPhysXInstanceShapeQuery>& Queries,
+		TArray<FPhysXInstanceQueryHit>& OutHits,
+		bool bIncludeStorage = true,
+		ECollisionChannel TraceChannel = ECC_Visibility) const;
+
+	/** Box counterpart of OverlapSphereInstanceIDs (axis-aligned, world space). */
+	UFUNCTION(BlueprintCallable, Category = "Phys X Instance|Query",
+		meta = (AdvancedDisplay = "bIncludeStorage,TraceChannel,DebugMode,DebugDrawDuration"))
+	bool OverlapBoxInstanceIDs(
+		const FVector& CenterWorld,
+		const FVector& HalfExtent,
+		TArray<FPhysXInstanceID>& OutIDs,
+		bool bIncludeStorage = true,
+		ECollisionChannel TraceChannel = ECC_Visibility,
+		EPhysXInstancedQueryDebugMode DebugMode = EPhysXInstancedQueryDebugMode::None,
+		float DebugDrawDuration = 0.0f) const;
+
+	// ---------------------------------------------------------------------
+	// C++ visitor queries
+	// ---------------------------------------------------------------------
+
+	/** Callback of the visitor queries. Return false to stop the query. */
+	using FInstanceVisitor = TFunctionRef<bool(FPhysXInstanceID)>;
+
+	/**
+	 * Optional narrowing of the visitor overlaps. PhysX bodies are tested on their owner, shape filter data and
+	 * rigid body flags; an empty filter runs the callback-free PhysX path. Set Owner or Archetype, not both.
+	 */
+	struct FInstanceBodyFilter
+	{
+		/** Only instances owned by this actor, resolved through the instance ID of each touched body. */
+		const AActor* Owner = nullptr;
+
+		/** Only bodies built from this archetype. Storage instances never match. */
+		const UPhysXInstanceArchetype* Archetype = nullptr;
+
+		/** Only simulating (non-kinematic) bodies. Storage instances never match. */
+		bool bSimulatingOnly = false;
+
+		bool IsEmpty() const { return !Owner && !Archetype && !bSimulatingOnly; }
+	};
+
+	/**
+	 * Visitor forms of the queries above. They do not allocate once warmed up:
+	 * results go straight to Visitor, and duplicates (multi-shape bodies) are dropped with per-ID visit stamps.
+	 * Game thread only; do not start another visitor query from inside Visitor.
+	 * Return the number of IDs passed to Visitor.
+	 */
+	int32 ForEachInstanceOverlappingSphere(
+		const FVector& CenterWorld,
+		float Radius,
+		FInstanceVisitor Visitor,
+		bool bIncludeStorage = true,
+		ECollisionChannel TraceChannel = ECC_Visibility,
+		const FInstanceBodyFilter& BodyFilter = FInstanceBodyFilter()) const;
+
+	int32 ForEachInstanceOverlappingBox(
+		const FVector& CenterWorld,
+		const FVector& HalfExtent,
+		FInstanceVisitor Visitor,
+		bool bIncludeStorage = true,
+		ECollisionChannel TraceChannel = ECC_Visibility,
+		const FInstanceBodyFilter& BodyFilter = FInstanceBodyFilter()) const;
+
+	/** Spatial-hash queries (see FindInstancesInRadius / FindInstancesInBox). */
+	int32 ForEachInstanceInRadius(
+		const FVector& Center,
+		float Radius,
+		FInstanceVisitor Visitor,
+		UInstancedStaticMeshComponent* OptionalFilterComponent = nullptr,
+		bool bIncludeStorage = true) const;
+
+	int32 ForEachInstanceInBox(
+		const FBox& Box,
+		FInstanceVisitor Visitor,
+		UInstancedStaticMeshComponent* OptionalFilterComponent = nullptr,
+		bool bIncludeStorage = true) const;
+
+	/**
+	 * Instances whose position (grown by InstanceRadius) lies inside Volume; planes face outward as in FConvexVolume.
+	 * VolumeBounds must enclose the volume. Build frustum volumes with GetViewFrustumBounds().
+	 */
+	int32 ForEachInstanceInConvexVolume(
+		const FConvexVolume& Volume,
+		const FBox& VolumeBounds,
+		FInstanceVisitor Visitor,
+		UInstancedStaticMeshComponent* OptionalFilterComponent = nullptr,
+		bool bIncludeStorage = true,
+		float InstanceRadius = 0.0f) const;
+
+	/** Instances inside a cone (apex Origin, half angle in degrees, Length from the apex). */
+	int32 ForEachInstanceInCone(
+		const FVector& Origin,
+		const FVector& Direction,
+		float HalfAngleDegrees,
+		float Length,
+		FInstanceVisitor Visitor,
+		UInstancedStaticMeshComponent* OptionalFilterComponent = nullptr,
+		bool bIncludeStorage = true) const;
+
+	/** Every registered instance, or every instance of one actor. */
+	int32 ForEachInstance(FInstanceVisitor Visitor) const;
+	int32 ForEachInstanceOfActor(FPhysXActorID ActorID, FInstanceVisitor Visitor) const;
+
+	/**
+	 * Fixed-capacity forms: write up to OutIDs.Num() IDs and return how many were written.
+	 * Pair with a TArray<FPhysXInstanceID, TInlineAllocator<N>> or a stack array.
+	 */
+	int32 OverlapSphereInstanceIDs(
+		const FVector& CenterWorld,
+		float Radius,
+		TArrayView<FPhysXInstanceID> OutIDs,
+		bool bIncludeStorage = true,
+		ECollisionChannel TraceChannel = ECC_Visibility) const;
+
+	int32 FindInstancesInRadius(
+		const FVector& Center,
+		float Radius,
+		TArrayView<FPhysXInstanceID> OutIDs,
+		UInstancedStaticMeshComponent* OptionalFilterComponent = nullptr,
+		bool bIncludeStorage = true) const;
+
+	// ---------------------------------------------------------------------
+	// Async queries
+	// ---------------------------------------------------------------------
+
+	/**
+	 * Queued queries, callable from any thread. Requests run together in the AsyncQueries phase of the next
+	 * subsystem tick through the batched queries (parallel chunks under PhysX scene read locks).
+	 * Futures are fulfilled on the game thread during that phase, so Then/Next continuations run there as well.
+	 * Requests still pending when the subsystem shuts down complete with an empty result.
+	 */
+	TFuture<FPhysXInstanceQueryHit> RaycastInstanceIDAsync(
+		const FVector& Start,
+		const FVector& End,
+		bool bIncludeStorage = true,
+		ECollisionChannel TraceChannel = ECC_Visibility);
+
+	/** Queued SweepInstancesBatch for one shape; same contract as RaycastInstanceIDAsync. */
+	TFuture<FPhysXInstanceQueryHit> SweepInstanceIDAsync(
+		const FPhysXInstanceShapeQuery& Query,
+		bool bIncludeStorage = true,
+		ECollisionChannel TraceChannel = ECC_Visibility);
+
+	/** Queued OverlapInstancesBatch for one shape; same contract as RaycastInstanceIDAsync. */
+	TFuture<TArray<FPhysXInstanceID>> OverlapInstanceIDsAsync(
+		const FPhysXInstanceShapeQuery& Query,
+		bool bIncludeStorage = true,
+		ECollisionChannel TraceChannel = ECC_Visibility);
+
+	/** Queued FindKNearestInstances without a component filter; same contract as RaycastInstanceIDAsync. */
+	TFuture<TArray<FPhysXInstanceNearestHit>> FindKNearestInstancesAsync(
+		const FVector& WorldLocation,
+		int32 K,
+		FPhysXInstanceID IgnoreInstanceID = FPhysXInstanceID(),
+		bool bIncludeStorage = true,
+		float MaxDistance = 0.0f);
+
+	/** Async queries waiting for the next AsyncQueries phase. Thread safe. */
+	int32 GetNumPendingAsyncQueries() const;
+
 	// ---------------------------------------------------------------------
 	// Actor-level registration & query
 	// ---------------------------------------------------------------------
@@ -456,6 +837,29 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Phys X Instance|Performance")
 	void SetMaxAddActorsPerFrame(int32 NewMax);
 
+	/**
+	 * Points that pending scene insertion is prioritized around: bodies nearest to any point go first.
+	 * An empty array falls back to the local players' view locations.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Phys X Instance|Performance")
+	void SetSceneInsertionRelevancePoints(const TArray<FVector>& Points);
+
+	/**
+	 * Pre-builds out-of-scene bodies with the same shape key registration uses for this actor
+	 * (effective shape type, collision mesh and filter data), so later spawns reuse them instead of allocating.
+	 * Requires shared shapes and a non-zero pool size. Archetype actors clone a baked template rather than
+	 * pooling bodies, so for them the template is baked instead and nothing is pooled.
+	 *
+	 * @param InstanceScale  Per-instance scale to warm for; zero uses the actor's first instance (unit if none).
+	 * @return Number of bodies added to the pool.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Phys X Instance|Performance")
+	int32 WarmUpBodyPool(APhysXInstancedMeshActor* Actor, int32 Count, bool bSimulate = true, FVector InstanceScale = FVector::ZeroVector);
+
+	/** Number of removed or warmed bodies currently parked out of scene for reuse. */
+	UFUNCTION(BlueprintPure, Category = "Phys X Instance|Performance")
+	int32 GetNumPooledBodies() const;
+
 	// ---------------------------------------------------------------------
 	// Lifetime (TTL)
 	// ---------------------------------------------------------------------
@@ -501,7 +905,7 @@ private:
 		const APhysXInstancedMeshActor* OwnerActor,
 		UInstancedStaticMeshComponent* ISMC,
 		UStaticMesh* CollisionMeshUsed,
-		physx::PxRigidDynamic* RD) const
+		physx::PxRigidDynamic* RD)
 	{
 		if (!ISMC || !RD)
 		{
@@ -519,14 +923,23 @@ private:
 		// Convert to kg/m^3 for PhysX: 1 g/cm^3 = 1000 kg/m^3.
 		UPhysicalMaterial* PhysMat = MassMesh->GetBodySetup()->PhysMaterial;
 		const float Density_g_per_cm3 = PhysMat ? PhysMat->Density : 1.0f;
-		float Density_kg_per_m3 = FMath::Max(Density_g_per_cm3 * 1000.0f, 0.001f);
+		const float Density_kg_per_m3 = FMath::Max(Density_g_per_cm3 * 1000.0f, 0.001f);
 
 		// Optional: respect UE mass scale on the component (dimensionless).
 		const float MassScale = FMath::Max(ISMC->BodyInstance.MassScale, KINDA_SMALL_NUMBER);
-		Density_kg_per_m3 *= MassScale;
 
-		// Recompute mass & inertia from shapes using density derived from the mesh.
-		physx::PxRigidBodyExt::updateMassAndInertia(*RD, (physx::PxReal)Density_kg_per_m3);
+		// Shared shapes: mass, inertia and CoM come from the per-archetype cache.
+		physx::PxShape* Shape = nullptr;
+		const bool bSharedShape =
+			RD->getNbShapes() == 1 &&
+			RD->getShapes(&Shape, 1) == 1 &&
+			!Shape->isExclusive();
+
+		if (!bSharedShape || !ShapeCache.ApplyMassProperties(*RD, Shape, Density_kg_per_m3, MassScale))
+		{
+			// Recompute mass & inertia from shapes using density derived from the mesh.
+			physx::PxRigidBodyExt::updateMassAndInertia(*RD, (physx::PxReal)(Density_kg_per_m3 * MassScale));
+		}
 
 		// If you want damping etc. to follow UE component defaults:
 		RD->setLinearDamping((physx::PxReal)FMath::Max(0.0f, ISMC->BodyInstance.LinearDamping));
@@ -639,6 +1052,53 @@ private:
 	UPROPERTY(EditAnywhere, Config, Category = "Phys X Instance|Performance", meta = (ClampMin = "0"))
 	int32 MaxAddActorsPerFrame = 64;
 
+	/** If true, large scene-insertion batches are added through a precomputed PxPruningStructure. */
+	UPROPERTY(EditAnywhere, Config, Category = "Phys X Instance|Performance")
+	bool bUsePruningStructureForSceneAdds = false;
+
+	/** Minimum batch size for which a pruning structure is built. */
+	UPROPERTY(EditAnywhere, Config, Category = "Phys X Instance|Performance", meta = (ClampMin = "1"))
+	int32 PruningStructureMinBatchSize = 512;
+
+	/** Pending scene-add entries whose distance to the relevance points is re-evaluated per frame. */
+	UPROPERTY(EditAnywhere, Config, Category = "Phys X Instance|Performance", meta = (ClampMin = "0"))
+	int32 PendingAddPriorityRefreshPerFrame = 256;
+
+	/** User-provided insertion relevance points; empty means local player view locations. */
+	TArray<FVector> InsertionRelevancePoints;
+
+	// ---------------------------------------------------------------------
+	// Internal: async body creation budget
+	// ---------------------------------------------------------------------
+
+	/** Bodies created by one background task of an async registration batch. */
+	UPROPERTY(EditAnywhere, Config, Category = "Phys X Instance|Performance", meta = (ClampMin = "1"))
+	int32 AsyncBodyCreateChunkSize = 256;
+
+	/** Max async-created bodies finalized on the game thread per frame. 0 means "no limit". */
+	UPROPERTY(EditAnywhere, Config, Category = "Phys X Instance|Performance", meta = (ClampMin = "0"))
+	int32 MaxAsyncBodyFinalizePerFrame = 512;
+
+	/** Components read by in-flight body creation tasks; referenced so GC cannot free them mid-task. */
+	UPROPERTY(Transient)
+	TArray<UInstancedStaticMeshComponent*> AsyncBodyCreateComponents;
+
+	// ---------------------------------------------------------------------
+	// Internal: runtime collision cooking
+	// ---------------------------------------------------------------------
+
+	/** Convex / triangle collision without cooked data is cooked in the background; a box stands in meanwhile. */
+	UPROPERTY(EditAnywhere, Config, Category = "Phys X Instance|Performance")
+	bool bCookMissingCollisionAtRuntime = true;
+
+	/** Keep runtime-cooked collision under Saved/ so later sessions skip cooking. */
+	UPROPERTY(EditAnywhere, Config, Category = "Phys X Instance|Performance")
+	bool bCacheCookedCollisionOnDisk = true;
+
+	/** Max proxy bodies rebuilt with their cooked shape per frame. 0 means "no limit". */
+	UPROPERTY(EditAnywhere, Config, Category = "Phys X Instance|Performance", meta = (ClampMin = "0"))
+	int32 MaxCookedShapeSwapsPerFrame = 128;
+
 	// ---------------------------------------------------------------------
 	// Internal: deferred instance tasks (forces/impulses/sleep/wake)
 	// ---------------------------------------------------------------------
@@ -690,6 +1150,56 @@ private:
 	bool HandleInstanceTask_WakeUp(FPhysXInstanceTask& Task, physx::PxRigidDynamic* RD);
 #endif
 
+	// ---------------------------------------------------------------------
+	// Internal: async queries
+	// ---------------------------------------------------------------------
+
+	/** Max queued async queries executed per frame. 0 means "no limit". */
+	UPROPERTY(EditAnywhere, Config, Category = "Phys X Instance|Performance", meta = (ClampMin = "0"))
+	int32 MaxAsyncQueriesPerFrame = 1024;
+
+	/** One queued raycast, sweep or overlap: its input, batch settings and the promise to fulfill. */
+	template <typename InputType, typename ResultType>
+	struct TAsyncQuery
+	{
+		InputType            Input;
+		bool                 bIncludeStorage = true;
+		ECollisionChannel    TraceChannel    = ECC_Visibility;
+		TPromise<ResultType> Promise;
+	};
+
+	using FAsyncRaycastQuery = TAsyncQuery<FPhysXInstanceRaycastRequest, FPhysXInstanceQueryHit>;
+	using FAsyncSweepQuery   = TAsyncQuery<FPhysXInstanceShapeQuery, FPhysXInstanceQueryHit>;
+	using FAsyncOverlapQuery = TAsyncQuery<FPhysXInstanceShapeQuery, TArray<FPhysXInstanceID>>;
+
+	struct FAsyncNearestQuery
+	{
+		FVector          Location = FVector::ZeroVector;
+		int32            K        = 1;
+		FPhysXInstanceID IgnoreInstanceID;
+		bool             bIncludeStorage = true;
+		float            MaxDistance     = 0.0f;
+
+		TPromise<TArray<FPhysXInstanceNearestHit>> Promise;
+	};
+
+	/** Guards the pending async queues and bAcceptAsyncQueries. */
+	mutable FCriticalSection AsyncQueryLock;
+
+	TArray<FAsyncRaycastQuery> PendingAsyncRaycasts;
+	TArray<FAsyncSweepQuery>   PendingAsyncSweeps;
+	TArray<FAsyncOverlapQuery> PendingAsyncOverlaps;
+	TArray<FAsyncNearestQuery> PendingAsyncNearest;
+
+	/** False outside Initialize/Deinitialize; requests made then complete immediately with an empty result. */
+	bool bAcceptAsyncQueries = false;
+
+	/** Runs queued queries grouped by their batch settings and fulfills their promises (game thread, budgeted). */
+	void ProcessAsyncQueries();
+
+	/** Stops accepting requests and completes every pending one with an empty result. */
+	void CancelAsyncQueries();
+
 	// ---------------------------------------------------------------------
 	// Internal: lifetime (TTL)
 	// ---------------------------------------------------------------------
@@ -826,7 +1336,273 @@ private:
 	void RemoveSlotMapping(FPhysXInstanceID ID);
 	void RebuildSlotMappingForComponent(UInstancedStaticMeshComponent* ISMC);
 
-	void FixInstanceIndicesAfterRemoval(UInstancedStaticMeshComponent* ISMC, int32 RemovedIndex);
+	/** Open FScopedSlotMappingBatch scopes; while > 0, RebuildSlotMappingForComponent only records the component. */
+	int32 SlotMappingBatchDepth = 0;
+
+	/** Components whose slot mapping is rebuilt when the outermost batch scope closes. */
+	TSet<TWeakObjectPtr<UInstancedStaticMeshComponent>> DeferredSlotMappingRebuilds;
+
+	/** Rebuilds the slot mapping of every deferred component in one pass over the instance map. */
+	void FlushDeferredSlotMappingRebuilds();
+
+	/**
+	 * Collects slot mapping rebuilds for mass conversions; the outermost scope flushes them.
+	 * Slot lookups on the recorded components are stale until then. Instance data and IDs are not.
+	 */
+	struct FScopedSlotMappingBatch
+	{
+		explicit FScopedSlotMappingBatch(UPhysXInstancedWorldSubsystem& InOwner)
+			: Owner(InOwner)
+		{
+			++Owner.SlotMappingBatchDepth;
+		}
+
+		~FScopedSlotMappingBatch()
+		{
+			if (--Owner.SlotMappingBatchDepth == 0)
+			{
+				Owner.FlushDeferredSlotMappingRebuilds();
+			}
+		}
+
+		UPhysXInstancedWorldSubsystem& Owner;
+	};
+
+	/**
+	 * Fix indices of IDs on ISMC after RemoveInstance(RemovedIndex).
+	 * OldLastIndex is the last valid index before the removal (used by swap-removing components).
+	 */
+	void FixInstanceIndicesAfterRemoval(UInstancedStaticMeshComponent* ISMC, int32 RemovedIndex, int32 OldLastIndex = INDEX_NONE);
+
+	/** One RemoveInstance() of a batch: the removed index and the last valid index before it. */
+	struct FInstanceRemoval
+	{
+		int32 RemovedIndex = INDEX_NONE;
+		int32 OldLastIndex = INDEX_NONE;
+	};
+
+	/** FixInstanceIndicesAfterRemoval for several removals on ISMC, in the order they happened, in one pass. */
+	void FixInstanceIndicesAfterRemovals(UInstancedStaticMeshComponent* ISMC, TArrayView<const FInstanceRemoval> Removals);
+
+	// ---------------------------------------------------------------------
+	// Internal: instance spatial hash
+	// ---------------------------------------------------------------------
+
+	/** Edge length (uu) of a spatial hash cell. Roughly the typical query radius works best. */
+	UPROPERTY(EditAnywhere, Config, Category = "Phys X Instance|Performance", meta = (ClampMin = "50.0"))
+	float SpatialHashCellSize = 1000.0f;
+
+	/**
+	 * Last known position of every bound instance.
+	 * Follows the slot mapping for static instances (spawn, conversion, removal)
+	 * and is refreshed by the transform sync for moving bodies.
+	 */
+	FPhysXInstancedSpatialHash SpatialHash;
+
+	/**
+	 * Visit stamps indexed by the element slot of an instance in Instances.
+	 * Removed slots are reused, so the array follows the peak live instance count rather than the ID counter.
+	 * Each visitor query takes a new epoch, so nothing has to be cleared between queries.
+	 */
+	mutable TArray<uint16> QueryVisitStamps;
+	mutable uint16 QueryVisitEpoch = 0;
+
+	/** Start a de-duplicated visitor query; returns its epoch. */
+	uint16 BeginQueryVisit() const;
+
+	/** True the first time ID is seen during the query Epoch. Unknown IDs are never visited. */
+	FORCEINLINE bool MarkQueryVisited(FPhysXInstanceID ID, uint16 Epoch) const
+	{
+		const FSetElementId Slot = Instances.FindId(ID);
+		if (!Slot.IsValidId())
+		{
+			return false;
+		}
+
+		const int32 Index = Slot.AsInteger();
+		if (Index >= QueryVisitStamps.Num())
+		{
+			QueryVisitStamps.SetNumZeroed(FMath::RoundUpToPowerOfTwo(Index + 1));
+		}
+		else if (QueryVisitStamps[Index] == Epoch)
+		{
+			return false;
+		}
+
+		QueryVisitStamps[Index] = Epoch;
+		return true;
+	}
+
+	/** Shared filter of the spatial queries (component, storage and scene membership checks). */
+	bool IsSpatialQueryCandidate(
+		const FPhysXInstanceData& Data,
+		UInstancedStaticMeshComponent* OptionalFilterComponent,
+		bool bIncludeStorage) const;
+
+	// ---------------------------------------------------------------------
+	// Internal: storage BVH
+	// ---------------------------------------------------------------------
+
+	/** Incremental storage BVH edits before a full rebuild (never less than a quarter of the tree). 0 disables rebuilds. */
+	UPROPERTY(EditAnywhere, Config, Category = "Phys X Instance|Performance", meta = (ClampMin = "0"))
+	int32 StorageBVHRebuildMinChanges = 1024;
+
+	/**
+	 * World bounds of every storage instance. Kept in sync by the slot mapping (storage spawn, conversion, removal),
+	 * rebuilt from the StorageTrees process; storage overlap, ray and sweep queries read it instead of the components.
+	 */
+	FPhysXInstancedStorageBVH StorageBVH;
+
+	/** True if Owner is null or owns the component of instance ID (storage or body). */
+	bool IsInstanceOwnedBy(FPhysXInstanceID ID, const AActor* Owner) const;
+
+	/** Visit storage instances inside a sphere / box that respond to TraceChannel (Visitor returns false to stop). Safe to call from workers. */
+	void OverlapStorageSphere_Internal(const FVector& CenterWorld, float Radius, ECollisionChannel TraceChannel, FInstanceVisitor Visitor) const;
+	void OverlapStorageBox_Internal(const FBox& WorldBox, ECollisionChannel TraceChannel, FInstanceVisitor Visitor) const;
+
+	/** Visit storage instances whose bounds overlap the query shape itself, not just its world AABB. Safe to call from workers. */
+	void OverlapStorageShape_Internal(const FPhysXInstanceShapeQuery& Query, ECollisionChannel TraceChannel, FInstanceVisitor Visitor) const;
+
+	/**
+	 * First storage instance hit by a line (Shape.IsLine()) or a sweep of Shape.
+	 * Leaves are tested against the instance collision body when it exists, otherwise against their bounds.
+	 */
+	bool SweepStorage_Internal(
+		const FVector& StartWorld,
+		const FVector& EndWorld,
+		const FCollisionShape& Shape,
+		const FQuat& ShapeRotation,
+		ECollisionChannel TraceChannel,
+		FPhysXInstanceID& OutID,
+		FHitResult& OutHit) const;
+
+	// ---------------------------------------------------------------------
+	// Internal: hierarchical storage (deferred cluster-tree rebuilds)
+	// ---------------------------------------------------------------------
+
+	/** If true, storage actors created by the subsystem keep their instances in a hierarchical component. */
+	UPROPERTY(EditAnywhere, Config, Category = "Phys X Instance|Performance")
+	bool bUseHierarchicalStorageActors = false;
+
+	/** Pending instance changes that trigger a cluster-tree rebuild of a storage component. */
+	UPROPERTY(EditAnywhere, Config, Category = "Phys X Instance|Performance", meta = (ClampMin = "1"))
+	int32 StorageTreeRebuildBatchSize = 256;
+
+	/** Max seconds a storage change waits for its batch before the tree is rebuilt anyway. */
+	UPROPERTY(EditAnywhere, Config, Category = "Phys X Instance|Performance", meta = (ClampMin = "0.0"))
+	float StorageTreeRebuildMaxDelay = 0.5f;
+
+	/** Rebuild storage cluster trees on a worker thread. */
+	UPROPERTY(EditAnywhere, Config, Category = "Phys X Instance|Performance")
+	bool bAsyncStorageTreeRebuilds = true;
+
+	/** Hierarchical storage components with instance changes not yet reflected in their tree. */
+	TArray<TWeakObjectPtr<UPhysXInstancedHierarchicalStaticMeshComponent>> PendingStorageTreeRebuilds;
+
+	/** Record NumChanges added/removed instances on a storage component (no-op for non-hierarchical components). */
+	void NotifyStorageInstancesChanged(UInstancedStaticMeshComponent* ISMC, int32 NumChanges);
+
+	/** Rebuild the storage BVH when due, then flush cluster-tree rebuilds whose batch is full or whose oldest change waited long enough. */
+	void ProcessStorageTreeRebuilds();
+
+	// ---------------------------------------------------------------------
+	// Internal: render tiers (active / sleeping components)
+	// ---------------------------------------------------------------------
+
+	/** Max number of instances moved between render-tier components per frame. 0 means "no limit". */
+	UPROPERTY(EditAnywhere, Config, Category = "Phys X Instance|Performance", meta = (ClampMin = "0"))
+	int32 MaxRenderTierMigrationsPerFrame = 512;
+
+	/** FIFO of instances whose sleep state settled into the other render tier. */
+	TArray<FPhysXInstanceID> PendingRenderTierMigrations;
+
+	/** Accumulates sleep/tier mismatch time and queues a migration once the owner's delay is reached. */
+	void UpdateRenderTierHysteresis(
+		FPhysXInstanceID ID,
+		FPhysXInstanceData& Data,
+		bool bSleeping,
+		float TimerDelta,
+		const APhysXInstancedMeshActor* OwnerActor);
+
+	/** True if at least one registered actor uses the sleeping render tier; refreshed once per step. */
+	bool bAnySleepingRenderTierActor = false;
+
+	/**
+	 * Once per step: picks up render tier flags toggled on actors at runtime, re-stamps the cached owner flags
+	 * of their instances and moves instances out of a tier the actor just turned off.
+	 */
+	void RefreshActorRenderTierSettings();
+
+	/** Viewer location used for shadow distance LOD this frame (valid only if bShadowLODViewValid). */
+	FVector ShadowLODViewLocation = FVector::ZeroVector;
+
+	/** True if a viewer exists and at least one registered actor uses shadow distance LOD. */
+	bool bShadowLODViewValid = false;
+
+	/** Caches the first local viewer location once per step (skipped when no actor uses shadow LOD). */
+	void UpdateShadowLODView();
+
+	/** Flips bBeyondShadowDistance with hysteresis and queues a migration when it changes. */
+	void UpdateShadowDistanceLOD(
+		FPhysXInstanceID ID,
+		FPhysXInstanceData& Data,
+		const FVector& WorldLocation,
+		const APhysXInstancedMeshActor* OwnerActor);
+
+	/** Max number of sleeping instances re-checked against the shadow distance per step. 0 means "no limit". */
+	UPROPERTY(EditAnywhere, Config, Category = "Phys X Instance|Performance", meta = (ClampMin = "0"))
+	int32 MaxSleepingShadowLODChecksPerFrame = 256;
+
+	/** Sleeping instances whose owner uses shadow distance LOD; gathered during the physics step. */
+	TArray<FPhysXInstanceID> SleepingShadowLODCandidates;
+
+	/** Round-robin position in SleepingShadowLODCandidates, carried across steps. */
+	int32 SleepingShadowLODCursor = 0;
+
+	/** Runs UpdateShadowDistanceLOD for a budgeted slice of the sleeping candidates. */
+	void UpdateSleepingShadowDistanceLOD();
+
+	/** Queues an instance for a render component re-resolve (tier switch, shadow LOD or chunk crossing); deduplicated. */
+	void QueueRenderComponentMigration(FPhysXInstanceID ID, FPhysXInstanceData& Data);
+
+	/** Moves queued instances to the render component their owner resolves for them (budgeted, batched per component pair). */
+	void ProcessRenderTierMigrations();
+
+	/**
+	 * Moves instances from one component to another while keeping bodies and IDs.
+	 * Returns the number of instances moved.
+	 */
+	int32 MigrateInstancesToComponent_Internal(
+		UInstancedStaticMeshComponent* FromISMC,
+		UInstancedStaticMeshComponent* ToISMC,
+		const TArray<FPhysXInstanceID>& IDs);
+
+	// ---------------------------------------------------------------------
+	// Internal: shared collision shapes
+	// ---------------------------------------------------------------------
+
+	/** If true, bodies with the same mesh, shape type, scale and collision profile share one PxShape. */
+	UPROPERTY(EditAnywhere, Config, Category = "Phys X Instance|Performance")
+	bool bShareInstanceShapes = true;
+
+	/** Scale step used to match instances to a shared shape. 0 means exact scale matches only. */
+	UPROPERTY(EditAnywhere, Config, Category = "Phys X Instance|Performance", meta = (ClampMin = "0.0"))
+	float SharedShapeScaleQuantum = 0.01f;
+
+	/** Removed bodies kept out of scene per shared shape for reuse by later spawns. 0 disables pooling. */
+	UPROPERTY(EditAnywhere, Config, Category = "Phys X Instance|Performance", meta = (ClampMin = "0"))
+	int32 MaxPooledBodiesPerArchetype = 256;
+
+#if PHYSICS_INTERFACE_PHYSX
+	/** Ref-counted shapes shared between instance bodies. Outlives every body created with it. */
+	FPhysXInstancedShapeCache ShapeCache;
+
+	/** Cache to pass to new bodies, or null when sharing is disabled. Game thread only. */
+	FPhysXInstancedShapeCache* GetShapeCacheForNewBodies();
+
+	/** Post-GC hook that prunes fitted-primitive cache entries of destroyed meshes. */
+	FDelegateHandle PostGarbageCollectHandle;
+#endif
 
 	// ---------------------------------------------------------------------
 	// Internal: removal
@@ -849,6 +1625,9 @@ private:
 	void ClearInstanceUserData(FPhysXInstanceID ID);
 	FPhysXInstanceID GetInstanceIDFromPxActor(const physx::PxRigidActor* Actor) const;
 
+	/** Closest-hit query filter that skips bodies without instance userData. */
+	struct FPhysXInstanceBlockFilter;
+
 	// -----------------------------------------------------------------
 	// PhysX: pending scene adds
 	// -----------------------------------------------------------------
@@ -860,17 +1639,223 @@ private:
 
 		/** Cached world pointer captured at enqueue time. */
 		TWeakObjectPtr<UWorld> World;
+
+		/** Explicit priority; higher values are inserted first. */
+		int32 Priority = 0;
+
+		/** Enqueue order, keeps FIFO behaviour between otherwise equal entries. */
+		uint32 Sequence = 0;
+
+		/** Instance location captured at enqueue time. */
+		FVector Location = FVector::ZeroVector;
+
+		/** Squared distance to the nearest relevance point, as ordered in the heap. */
+		float DistSq = 0.0f;
+
+		/** Latest re-evaluated distance; published into DistSq when a refresh pass completes. */
+		float RefreshedDistSq = 0.0f;
+
+		/** Refresh pass RefreshedDistSq belongs to; heap pops move entries across the cursor. */
+		uint32 RefreshPass = 0;
 	};
 
+	/** Heap order: higher priority first, then nearest, then oldest. */
+	struct FPendingAddActorPred
+	{
+		FORCEINLINE bool operator()(const FPendingAddActorEntry& A, const FPendingAddActorEntry& B) const
+		{
+			if (A.Priority != B.Priority)
+			{
+				return A.Priority > B.Priority;
+			}
+			if (A.DistSq != B.DistSq)
+			{
+				return A.DistSq < B.DistSq;
+			}
+			return A.Sequence < B.Sequence;
+		}
+	};
+
+	/** Binary heap of bodies waiting for scene insertion (FPendingAddActorPred). */
 	TArray<FPendingAddActorEntry> PendingAddActors;
-	int32 PendingAddActorsHead = 0;
+	uint32 NextPendingAddSequence  = 0;
+	int32  PendingAddRefreshCursor = 0;
+	uint32 PendingAddRefreshPass   = 0;
 
-	void EnqueueAddActorToScene(FPhysXInstanceID ID, UInstancedStaticMeshComponent* InstancedMesh);
+	/** Relevance points gathered for the current frame. */
+	TArray<FVector> ActiveRelevancePoints;
+
+	/** Per-frame scratch: actors configured for insertion, and simulating ones to wake once inserted. */
+	TArray<physx::PxRigidActor*>   PendingAddBatch;
+	TArray<physx::PxRigidDynamic*> PendingAddWakeUps;
+
+	void EnqueueAddActorToScene(FPhysXInstanceID ID, UInstancedStaticMeshComponent* InstancedMesh, int32 Priority = 0);
 	void ProcessPendingAddActors();
 
+	/** Gathers this frame's relevance points and re-evaluates a slice of the pending entries. */
+	void RefreshPendingAddPriorities(UWorld* World);
+	float GetDistSqToNearestRelevancePoint(const FVector& Location) const;
+
+	/** Inserts out-of-scene actors with one addActors call (optionally through a pruning structure). */
+	void AddActorsToSceneBatched(physx::PxScene& Scene, const TArray<physx::PxRigidActor*>& Batch);
+
 	/** Marks pending scene-add entries as invalid when an instance is removed or rebuilt. */
 	void InvalidatePendingAddEntries(FPhysXInstanceID ID);
 
+	// -----------------------------------------------------------------
+	// PhysX: batched body removal
+	// -----------------------------------------------------------------
+
+	/** Open FScopedBodyDestroyBatch scopes; while > 0, destroyed bodies are deferred. */
+	int32 BodyDestroyBatchDepth = 0;
+
+	/** Bodies already detached from their instances, waiting for one removeActors call. */
+	TArray<FPhysXInstanceBody> DeferredBodyDestroys;
+
+	/** Clears the instance user data and destroys its body (deferred inside a batch scope). */
+	void DestroyInstanceBody(FPhysXInstanceID ID, FPhysXInstanceData& Data);
+
+	/** Destroys all deferred bodies with FPhysXInstanceBody::DestroyBatch. */
+	void FlushDeferredBodyDestroys();
+
+	/** Collects body destruction for mass removals; the outermost scope flushes the batch. */
+	struct FScopedBodyDestroyBatch
+	{
+		explicit FScopedBodyDestroyBatch(UPhysXInstancedWorldSubsystem& InOwner)
+			: Owner(InOwner)
+		{
+			++Owner.BodyDestroyBatchDepth;
+		}
+
+		~FScopedBodyDestroyBatch()
+		{
+			if (--Owner.BodyDestroyBatchDepth == 0)
+			{
+				Owner.FlushDeferredBodyDestroys();
+			}
+		}
+
+		UPhysXInstancedWorldSubsystem& Owner;
+	};
+
+	// -----------------------------------------------------------------
+	// PhysX: async body creation
+	// -----------------------------------------------------------------
+
+	struct FAsyncBodyCreateJob
+	{
+		FPhysXInstanceID   ID;
+		int32              InstanceIndex = INDEX_NONE;
+
+		/** Instance transform captured at registration; workers never read the component's instance data. */
+		FTransform         InstanceLocalTM;
+
+		FPhysXInstanceBody Body;
+		bool               bSuccess = false;
+	};
+
+	struct FAsyncBodyCreateBatch
+	{
+		/** Read on the game thread only (finalize); workers see CreateParams. */
+		UInstancedStaticMeshComponent* InstancedMesh = nullptr;
+		UStaticMesh*                   OverrideMesh  = nullptr;
+
+		/** Component, owner and collision snapshot taken at registration; the only input workers read. */
+		FPhysXInstanceBodyCreateParams CreateParams;
+		FPhysXInstancedShapeCache*     ShapeCache    = nullptr;
+
+		TArray<FAsyncBodyCreateJob> Jobs;
+
+		/** [0, NumCreated) finished on workers, [NumCreated, NumDispatched) in flight, [0, NumFinalized) done. */
+		int32 NumDispatched = 0;
+		int32 NumCreated    = 0;
+		int32 NumFinalized  = 0;
+
+		TFuture<void> InFlight;
+
+		TArray<FPhysXInstanceID>            CreatedIDs;
+		FPhysXInstanceBodiesCreatedDelegate OnCompleted;
+	};
+
+	/** FIFO of async registrations; heap-allocated so in-flight tasks keep a stable address. */
+	TArray<TUniquePtr<FAsyncBodyCreateBatch>> AsyncBodyCreateBatches;
+
+	/** Instances in the "pending body" state across all batches. */
+	int32 NumPendingAsyncBodies = 0;
+
+	void ProcessAsyncBodyCreation();
+	void DispatchAsyncBodyChunk(FAsyncBodyCreateBatch& Batch);
+	void FinalizeAsyncBody(FAsyncBodyCreateBatch& Batch, FAsyncBodyCreateJob& Job);
+
+	/** Waits for in-flight tasks and destroys every body that was not finalized (teardown only). */
+	void CancelAsyncBodyCreation();
+
+	// -----------------------------------------------------------------
+	// PhysX: runtime-cooked collision
+	// -----------------------------------------------------------------
+
+	/** Instances whose body uses a proxy box until their collision mesh is cooked. */
+	TArray<FPhysXInstanceID> ProxyShapeInstances;
+
+	/** Ticks the cooked mesh cache and rebuilds proxy bodies whose mesh became ready. */
+	void ProcessCookedShapeSwaps();
+
+	/** Replaces the proxy body with one using the cooked shape, keeping pose, velocity and scene membership. */
+	bool SwapProxyShapeBody(FPhysXInstanceID ID, FPhysXInstanceData& Data);
+
+	// -----------------------------------------------------------------
+	// PhysX: instance archetypes
+	// -----------------------------------------------------------------
+
+	struct FArchetypeTemplateKey
+	{
+		const UPhysXInstanceArchetype* Archetype  = nullptr;
+		const UStaticMesh*             StaticMesh = nullptr;
+		FVector                        Scale      = FVector::OneVector;
+		FTransform                     ShapeOffset;
+		uint32                         Revision   = 0;
+
+		bool operator==(const FArchetypeTemplateKey& Other) const
+		{
+			return Archetype == Other.Archetype &&
+				StaticMesh == Other.StaticMesh &&
+				Scale == Other.Scale &&
+				Revision == Other.Revision &&
+				ShapeOffset.Equals(Other.ShapeOffset, 0.f);
+		}
+
+		friend uint32 GetTypeHash(const FArchetypeTemplateKey& Key)
+		{
+			uint32 Hash = HashCombine(::GetTypeHash(Key.Archetype), ::GetTypeHash(Key.StaticMesh));
+			Hash = HashCombine(Hash, ::GetTypeHash(Key.Scale));
+			return HashCombine(Hash, ::GetTypeHash(Key.Revision));
+		}
+	};
+
+	/** Out-of-scene template bodies, one per archetype, render mesh and geometry scale. */
+	TMap<FArchetypeTemplateKey, physx::PxRigidDynamic*> ArchetypeTemplates;
+
+	/**
+	 * Template body for the archetype at this instance's geometry scale, baked on first use.
+	 * Null while it cannot be baked (collision still cooking). Game thread only.
+	 */
+	physx::PxRigidDynamic* FindOrBakeArchetypeTemplate(
+		const UPhysXInstanceArchetype& Archetype,
+		UInstancedStaticMeshComponent* ISMC,
+		int32 InstanceIndex,
+		const FTransform* InstanceLocalTransform = nullptr);
+
+	/**
+	 * Creates the body of an instance from the owner's settings: a clone of the archetype template,
+	 * or a body derived from the mesh with the owner's physics overrides applied.
+	 */
+	bool CreateInstanceBody(FPhysXInstanceBody& OutBody, UInstancedStaticMeshComponent* ISMC, int32 InstanceIndex, bool bSimulate);
+
+	/** Releases templates of Archetype baked at an older revision; live clones keep their own shape references. */
+	void ReleaseStaleArchetypeTemplates(const UPhysXInstanceArchetype& Archetype);
+
+	void ReleaseArchetypeTemplates();
+
 	// -----------------------------------------------------------------
 	// PhysX: internal queries
 	// -----------------------------------------------------------------
@@ -883,6 +1868,13 @@ private:
 		FVector& OutHitPosWorld,
 		FVector& OutHitNormalWorld) const;
 
+	/** Instance-only raycast against Scene. Off the game thread the caller must hold a scene read lock. */
+	bool RaycastPhysXScene_Internal(
+		physx::PxScene& Scene,
+		const FVector& StartWorld,
+		const FVector& EndWorld,
+		FPhysXInstanceQueryHit& OutHit) const;
+
 	bool SweepSpherePhysXInstanceID_Internal(
 		const FVector& StartWorld,
 		const FVector& EndWorld,
@@ -892,6 +1884,28 @@ private:
 		FVector& OutHitPosWorld,
 		FVector& OutHitNormalWorld) const;
 
+	/**
+	 * Visit every instance body overlapping Geometry at Pose in Scene (dynamic actors only).
+	 * A body with several shapes is visited once per touching shape; Visitor returns false to stop.
+	 * Touches are streamed through a fixed stack batch, so there is no cap and no heap allocation.
+	 * Off the game thread the caller must hold a scene read lock.
+	 */
+	void OverlapPhysXScene_Internal(
+		physx::PxScene& Scene,
+		const physx::PxGeometry& Geometry,
+		const physx::PxTransform& Pose,
+		FInstanceVisitor Visitor,
+		const FInstanceBodyFilter& BodyFilter = FInstanceBodyFilter()) const;
+
+	/** Closest instance body hit by sweeping Geometry (rotated by Rotation) from Start to End. Same locking rule. */
+	bool SweepPhysXScene_Internal(
+		physx::PxScene& Scene,
+		const physx::PxGeometry& Geometry,
+		const physx::PxQuat& Rotation,
+		const FVector& StartWorld,
+		const FVector& EndWorld,
+		FPhysXInstanceQueryHit& OutHit) const;
+
 #else
 
 	/** No-op stub for non-PhysX builds; keeps shared codepaths clean. */
@@ -904,9 +1918,13 @@ private:
 	// ---------------------------------------------------------------------
 
 	friend class PhysXIS::FPhysicsStepProcess;
+	friend class PhysXIS::FAsyncQueriesProcess;
+	friend class PhysXIS::FStorageTreesProcess;
 	friend class PhysXIS::FLifetimeProcess;
 
 #if PHYSICS_INTERFACE_PHYSX
+	friend class PhysXIS::FAsyncBodyCreationProcess;
+	friend class PhysXIS::FCookedShapesProcess;
 	friend class PhysXIS::FAddActorsProcess;
 	friend class PhysXIS::FInstanceTasksProcess;
 
@@ -914,5 +1932,7 @@ private:
 	friend class PhysXIS::FPhysicsStepStopActionsProcess;
 	friend class PhysXIS::FPhysicsStepTransformSyncProcess;
 	friend class PhysXIS::FPhysicsStepFinalizeProcess;
+
+	friend class PhysXIS::FRenderTiersProcess;
 #endif
 };
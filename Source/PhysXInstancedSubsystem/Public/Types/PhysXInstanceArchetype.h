@@ -0,0 +1,94 @@
+﻿/**
+* Copyright (C) 2025 | Created by NordVader Inc.
+* All rights reserved!
+* My Discord Server: https://discord.gg/B8prpf3vzD
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Engine/CollisionProfile.h"       // FCollisionProfileName
+
+#include "Types/PhysXInstancedTypes.h"     // EPhysXInstanceShapeType
+
+#include "PhysXInstanceArchetype.generated.h"
+
+class UStaticMesh;
+class UPhysicalMaterial;
+
+/**
+ * Shared description of a PhysX instance body: shape, collision filtering, material, mass and flags.
+ *
+ * The subsystem bakes an archetype once per (mesh, scale) into an out-of-scene template body;
+ * new instance bodies are clones of that template instead of being derived from the mesh,
+ * the component BodyInstance and the owner actor every time.
+ * One archetype can be shared by any number of actors and spawn requests.
+ */
+UCLASS(BlueprintType)
+class PHYSXINSTANCEDSUBSYSTEM_API UPhysXInstanceArchetype : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	// --- Collision shape -----------------------------------------------------
+
+	/** Collision shape type baked into the template. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Collision")
+	EPhysXInstanceShapeType ShapeType = EPhysXInstanceShapeType::Box;
+
+	/** Mesh used for collision; null uses the render mesh of the instance that bakes the template. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Collision")
+	UStaticMesh* CollisionMesh = nullptr;
+
+	/** Collision profile baked into the shape filter data (object type and responses). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Collision")
+	FCollisionProfileName CollisionProfile;
+
+	/** Generate contact notifications for bodies of this archetype. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Collision")
+	bool bNotifyRigidBodyCollision = false;
+
+	// --- Physics -------------------------------------------------------------
+
+	/** Friction, restitution and density source; null uses the subsystem default material and 1 g/cm^3. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Physics")
+	UPhysicalMaterial* PhysicalMaterial = nullptr;
+
+	/** Use MassInKg instead of the mass derived from the shape volume and density. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Physics")
+	bool bOverrideMass = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Physics", meta = (EditCondition = "bOverrideMass", ClampMin = "0.001"))
+	float MassInKg = 10.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Physics", meta = (ClampMin = "0.0"))
+	float LinearDamping = 0.01f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Physics", meta = (ClampMin = "0.0"))
+	float AngularDamping = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Physics")
+	bool bEnableGravity = true;
+
+	/** Enable swept CCD for bodies of this archetype (ignored for triangle meshes). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Physics")
+	bool bUseCCD = false;
+
+	UPhysXInstanceArchetype();
+
+	/** Object type and channel responses of CollisionProfile. Returns false if the profile does not exist. */
+	bool GetCollisionResponses(ECollisionChannel& OutObjectType, FCollisionResponseContainer& OutResponses) const;
+
+	/** Bumped on every edit; baked templates of an older revision are not reused. */
+	uint32 GetBakeRevision() const { return BakeRevision; }
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+	/** Runtime only: templates live in memory, so the revision is never saved. */
+	UPROPERTY(Transient)
+	uint32 BakeRevision = 0;
+};
@@ -8,6 +8,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/InstancedStaticMeshComponent.h"
+#include "CollisionShape.h"
 
 #include "PhysXInstancedTypes.generated.h"
 
@@ -17,10 +18,17 @@ namespace physx
 	class PxRigidDynamic;
 	class PxScene;
 	class PxMaterial;
+	class PxShape;
+	class PxConvexMesh;
+	class PxTriangleMesh;
 }
 
+class FPhysXInstancedShapeCache;
+class UPhysXInstanceArchetype;
+
 class UWorld;
 class UStaticMesh;
+class UBodySetup;
 class UMaterialInterface;
 class UInstancedStaticMeshComponent;
 class APhysXInstancedMeshActor;
@@ -170,6 +178,15 @@ enum class EPhysXInstanceConvertDirection : uint8
 	ToDynamic,
 };
 
+/** Shape of a batched overlap or sweep query. */
+UENUM(BlueprintType)
+enum class EPhysXInstanceQueryShape : uint8
+{
+	Sphere,
+	Box,
+	Capsule,
+};
+
 /**
  * Configuration for automatic "stop" handling of instances.
  * This can be owned by an actor and read by the subsystem for each instance.
@@ -413,6 +430,13 @@ struct FPhysXSpawnInstanceRequest
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn", meta = (EditCondition = "bUseOverrideMaterials"))
 	TArray<UMaterialInterface*> OverrideMaterials;
 
+	/**
+	 * Explicit material variant on the owning actor (see APhysXInstancedMeshActor::MaterialVariants).
+	 * INDEX_NONE resolves the variant from the requested materials.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn")
+	int32 MaterialVariantIndex = INDEX_NONE;
+
 	/**
 	 * Explicit actor used when ActorMode == UseExplicitActor.
 	 * The actor is expected to already have mesh/materials configured.
@@ -420,6 +444,13 @@ struct FPhysXSpawnInstanceRequest
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn")
 	TWeakObjectPtr<APhysXInstancedMeshActor> ExplicitActor;
 
+	/**
+	 * Optional instance archetype (body template) for the new instance.
+	 * In FindOrCreateByMeshAndMats mode this also participates in actor matching. Ignored for UseExplicitActor.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn")
+	UPhysXInstanceArchetype* Archetype = nullptr;
+
 	/**
 	 * Desired world-space transform for the new instance.
 	 * Internally converted to actor-space relative transform for ISM insertion.
@@ -441,6 +472,13 @@ struct FPhysXSpawnInstanceRequest
 	/** Optional initial angular velocity (radians/s) in world space. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn")
 	FVector InitialAngularVelocityRad = FVector::ZeroVector;
+
+	/**
+	 * Scene insertion priority of the new body. Higher values enter the PhysX scene first;
+	 * equal priorities go nearest-first to the insertion relevance points.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn")
+	int32 InsertionPriority = 0;
 	
 	// --- Lifetime override ---------------------------------------------------
 
@@ -487,10 +525,262 @@ struct FPhysXSpawnInstanceResult
 	FTransform FinalWorldTransform = FTransform::Identity;
 };
 
+// ============================================================================
+//  Batched queries (Blueprint-facing)
+// ============================================================================
+
+/** One segment of a batched raycast. */
+USTRUCT(BlueprintType)
+struct FPhysXInstanceRaycastRequest
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query")
+	FVector Start = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query")
+	FVector End = FVector::ZeroVector;
+};
+
+/** Closest instance hit of one batched query. InstanceID is invalid when nothing was hit. */
+USTRUCT(BlueprintType)
+struct FPhysXInstanceQueryHit
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Query")
+	FPhysXInstanceID InstanceID;
+
+	/** Distance from the query start to the hit. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Query")
+	float Distance = 0.0f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Query")
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Query")
+	FVector Normal = FVector::UpVector;
+
+	/** True if the hit came from a storage instance rather than a PhysX body. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Query")
+	bool bStorage = false;
+
+	bool IsHit() const { return InstanceID.IsValid(); }
+};
+
+/**
+ * One shape of a batched overlap or sweep.
+ * Overlaps place the shape at Start; sweeps move it from Start to End.
+ */
+USTRUCT(BlueprintType)
+struct FPhysXInstanceShapeQuery
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query")
+	EPhysXInstanceQueryShape Shape = EPhysXInstanceQueryShape::Sphere;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query")
+	FVector Start = FVector::ZeroVector;
+
+	/** Sweep end; ignored by overlaps. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query")
+	FVector End = FVector::ZeroVector;
+
+	/** Shape orientation (boxes and capsules). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query")
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	/** Sphere and capsule radius. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query", meta = (ClampMin = "0.0"))
+	float Radius = 50.0f;
+
+	/** Box half size. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query")
+	FVector HalfExtent = FVector(50.0f);
+
+	/** Capsule half height, caps included (same convention as UCapsuleComponent). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query", meta = (ClampMin = "0.0"))
+	float HalfHeight = 100.0f;
+
+	FCollisionShape ToCollisionShape() const;
+
+	/** World AABB of the shape placed at Center. */
+	FBox GetWorldBounds(const FVector& Center) const;
+};
+
+/**
+ * Flat results of a batched overlap.
+ * The IDs found by query i are InstanceIDs[Offsets[i]] .. InstanceIDs[Offsets[i] + Counts[i] - 1].
+ */
+USTRUCT(BlueprintType)
+struct FPhysXInstanceOverlapBatchResult
+{
+	GENERATED_BODY()
+
+	/** IDs of every query, back to back in query order. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Query")
+	TArray<FPhysXInstanceID> InstanceIDs;
+
+	/** First entry of each query in InstanceIDs. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Query")
+	TArray<int32> Offsets;
+
+	/** Number of entries of each query. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Query")
+	TArray<int32> Counts;
+
+	/** IDs found by one query. */
+	TArrayView<const FPhysXInstanceID> GetQueryResults(int32 QueryIndex) const
+	{
+		return TArrayView<const FPhysXInstanceID>(InstanceIDs.GetData() + Offsets[QueryIndex], Counts[QueryIndex]);
+	}
+};
+
+/** One result of a K-nearest query. */
+USTRUCT(BlueprintType)
+struct FPhysXInstanceNearestHit
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Query")
+	FPhysXInstanceID InstanceID;
+
+	/** Distance (uu) from the query point to the instance position. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Query")
+	float Distance = 0.0f;
+};
+
+/**
+ * Results of a batched K-nearest query.
+ * Query i owns Hits[i * MaxPerQuery] .. Hits[i * MaxPerQuery + Counts[i] - 1], sorted by distance.
+ */
+USTRUCT(BlueprintType)
+struct FPhysXInstanceNearestBatchResult
+{
+	GENERATED_BODY()
+
+	/** MaxPerQuery slots per query, back to back in query order. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Query")
+	TArray<FPhysXInstanceNearestHit> Hits;
+
+	/** Number of valid slots of each query. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Query")
+	TArray<int32> Counts;
+
+	/** K of the query. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Query")
+	int32 MaxPerQuery = 0;
+
+	/** Neighbors found by one query. */
+	TArrayView<const FPhysXInstanceNearestHit> GetQueryResults(int32 QueryIndex) const
+	{
+		return TArrayView<const FPhysXInstanceNearestHit>(Hits.GetData() + QueryIndex * MaxPerQuery, Counts[QueryIndex]);
+	}
+};
+
 // ============================================================================
 //  Internal runtime data (subsystem-owned, not exposed to reflection)
 // ============================================================================
 
+#if PHYSICS_INTERFACE_PHYSX
+/** Unit-scale fit data for Box/Sphere/Capsule shapes of one mesh. Scale is applied arithmetically per instance. */
+struct FPhysXInstancePrimitiveFit
+{
+	/** Body setup GUIDs the fit was built from; a mismatch means collision was rebuilt or reimported. */
+	FGuid MeshBodySetupGuid;
+	FGuid CollisionBodySetupGuid;
+
+	bool bHasMesh = false;
+
+	/** Static mesh bounds. */
+	FVector BoundsOrigin       = FVector::ZeroVector;
+	FVector BoundsExtent       = FVector::ZeroVector;
+	float   BoundsSphereRadius = 0.f;
+
+	/** Major bounds axis at unit scale (0=X, 1=Y, 2=Z); re-picked only for non-uniform scale. */
+	int32 BoundsMajorAxis = 2;
+
+	/** First simple sphere of the collision body setup. */
+	bool    bHasSphere   = false;
+	FVector SphereCenter = FVector::ZeroVector;
+	float   SphereRadius = 0.f;
+
+	/** First simple capsule of the render mesh body setup. */
+	bool    bHasSphyl     = false;
+	FVector SphylCenter   = FVector::ZeroVector;
+	FQuat   SphylRotation = FQuat::Identity;
+	float   SphylRadius   = 0.f;
+	float   SphylLength   = 0.f;
+};
+
+/**
+ * Everything body creation reads from a component, its owner and its collision assets, resolved on the game thread.
+ * Worker threads build bodies from it without touching a UObject: the mesh and body setup pointers
+ * are only identities for the shape cache and the runtime cook, never dereferenced off the game thread.
+ */
+struct FPhysXInstanceBodyCreateParams
+{
+	/** Component world transform; instances are posed relative to it. */
+	FTransform ComponentTransform;
+
+	// --- Geometry source ---------------------------------------------------
+
+	/** Shape type after fallbacks (missing or still cooking meshes become a box). */
+	EPhysXInstanceShapeType ShapeType = EPhysXInstanceShapeType::Box;
+
+	/** Bounds and simple elements for fitted primitives (unset for mesh shapes). */
+	FPhysXInstancePrimitiveFit Fit;
+
+	physx::PxConvexMesh*   ConvexMesh = nullptr;
+	physx::PxTriangleMesh* TriMesh    = nullptr;
+
+	const UStaticMesh* StaticMesh         = nullptr;
+	const UBodySetup*  CollisionBodySetup = nullptr;
+
+	/** Set while the collision mesh cooks at runtime; the body then carries a proxy box. */
+	const UBodySetup* ProxyCookBodySetup = nullptr;
+
+	/** Per-actor local offset applied to capsule shapes. */
+	FTransform ShapeOffset;
+
+	// --- Collision filtering -----------------------------------------------
+
+	TEnumAsByte<ECollisionChannel> ObjectType = ECC_WorldDynamic;
+	FMaskFilter                    MaskFilter = 0;
+	FCollisionResponseContainer    Responses;
+
+	int32  ActorID     = 0;
+	uint32 ComponentID = 0;
+
+	bool bCCDFilter                = false;
+	bool bNotifyRigidBodyCollision = false;
+	bool bContactModification      = false;
+	bool bPhysicsStatic            = false;
+
+	// --- Rigid body --------------------------------------------------------
+
+	/** False for triangle meshes even if simulation was requested. */
+	bool bSimulate       = false;
+	bool bCCDFlag        = false;
+	bool bSkipMassUpdate = false;
+	bool bEnableGravity  = true;
+
+	float LinearDamping  = 0.f;
+	float AngularDamping = 0.f;
+	float Mass           = 10.f;
+
+	uint8 PositionSolverIterationCount = 8;
+	uint8 VelocitySolverIterationCount = 1;
+
+	/** Cooked meshes follow the component scale only; fitted primitives also follow the instance scale. */
+	bool UsesMeshScale() const
+	{
+		return ShapeType == EPhysXInstanceShapeType::Convex || ShapeType == EPhysXInstanceShapeType::TriangleMeshStatic;
+	}
+};
+#endif // PHYSICS_INTERFACE_PHYSX
+
 /**
  * Thin wrapper over a PhysX rigid body for a single ISM instance.
  * This is intentionally not a USTRUCT (no reflection needed).
@@ -500,6 +790,18 @@ struct FPhysXInstanceBody
 #if PHYSICS_INTERFACE_PHYSX
 	/** Underlying PhysX rigid dynamic body. */
 	physx::PxRigidDynamic* PxBody = nullptr;
+
+	/** Shape borrowed from OwningShapeCache (null for exclusive shapes). */
+	physx::PxShape* SharedShape = nullptr;
+
+	/** Cache the shared shape reference is returned to on Destroy(). */
+	FPhysXInstancedShapeCache* OwningShapeCache = nullptr;
+
+	/** Shape is a box standing in for a convex / triangle mesh that is still being cooked. */
+	bool bUsesProxyShape = false;
+
+	/** Body setup whose runtime cook the proxy shape waits for. */
+	const UBodySetup* ProxyCookBodySetup = nullptr;
 #else
 	/** Dummy pointer for non-PhysX builds. */
 	void* PxBody = nullptr;
@@ -517,6 +819,9 @@ struct FPhysXInstanceBody
 	 * @param DefaultMaterial        PhysX material used when no per-shape material is available.
 	 * @param ShapeType              Collision shape type to build for this instance.
 	 * @param OverrideCollisionMesh  Optional mesh used for convex/triangle collision generation.
+	 * @param ShapeCache             Optional cache of shared shapes; null creates an exclusive shape.
+	 * @param InstanceLocalTransform Optional snapshot of the instance transform (component space);
+	 *                               when set, the component's per-instance data is not read.
 	 */
 	bool CreateFromInstancedStaticMesh(
 		UInstancedStaticMeshComponent* InstancedMesh,
@@ -524,11 +829,83 @@ struct FPhysXInstanceBody
 		bool bSimulate,
 		physx::PxMaterial* DefaultMaterial,
 		EPhysXInstanceShapeType ShapeType,
-		UStaticMesh* OverrideCollisionMesh);
+		UStaticMesh* OverrideCollisionMesh,
+		FPhysXInstancedShapeCache* ShapeCache = nullptr,
+		const FTransform* InstanceLocalTransform = nullptr);
+
+#if PHYSICS_INTERFACE_PHYSX
+	/**
+	 * Snapshot what CreateFromParams() needs from the component, its owner and the collision assets.
+	 * Game thread only: reads the component, the owner actor and the body setups, and may request a runtime cook.
+	 */
+	static bool ResolveCreateParams(
+		UInstancedStaticMeshComponent* InstancedMesh,
+		bool bSimulate,
+		EPhysXInstanceShapeType ShapeType,
+		UStaticMesh* OverrideCollisionMesh,
+		FPhysXInstanceBodyCreateParams& OutParams);
+
+	/**
+	 * Create the body from a ResolveCreateParams() snapshot. Touches no UObject, so it is safe on worker threads.
+	 *
+	 * @param InstanceIndex          Instance index, only used as the body index of exclusive shapes.
+	 * @param InstanceLocalTransform Instance transform in component space.
+	 */
+	bool CreateFromParams(
+		const FPhysXInstanceBodyCreateParams& Params,
+		int32 InstanceIndex,
+		const FTransform& InstanceLocalTransform,
+		physx::PxMaterial* DefaultMaterial,
+		FPhysXInstancedShapeCache* ShapeCache = nullptr);
+#endif
+
+	/**
+	 * Bake an out-of-scene template body for an archetype, taking geometry from one instance of InstancedMesh.
+	 * The template owns a shared shape carrying the archetype's filter data and material; clones attach it.
+	 * Returns null if the shape cannot be built yet (e.g. its collision mesh is still cooking).
+	 * The caller owns the template and releases it with PxRigidDynamic::release().
+	 */
+	static physx::PxRigidDynamic* BakeArchetypeTemplate(
+		const UPhysXInstanceArchetype& Archetype,
+		UInstancedStaticMeshComponent* InstancedMesh,
+		int32 InstanceIndex,
+		physx::PxMaterial* DefaultMaterial,
+		const FTransform* InstanceLocalTransform = nullptr);
+
+	/** Create the body as a clone of a BakeArchetypeTemplate() template, posed at the instance transform. */
+	bool CreateFromArchetypeTemplate(
+		const physx::PxRigidDynamic& Template,
+		UInstancedStaticMeshComponent* InstancedMesh,
+		int32 InstanceIndex,
+		bool bSimulate,
+		const FTransform* InstanceLocalTransform = nullptr);
+
+	/** Clone a template at a precomputed instance world transform. Touches no UObject, so it is safe on worker threads. */
+	bool CreateFromArchetypeTemplate(
+		const physx::PxRigidDynamic& Template,
+		const FTransform& InstanceWorldTransform,
+		bool bSimulate);
 
 	/** Destroy the underlying PhysX body and release associated resources. */
 	void Destroy();
 
+	/**
+	 * Destroy many bodies at once: one removeActors call per scene, then a tight release loop.
+	 *
+	 * @param Bodies            Bodies to destroy; entries without a PhysX body are skipped.
+	 * @param bWakeOnLostTouch  Wake bodies that were touching the removed ones (off for world teardown).
+	 */
+	static void DestroyBatch(const TArray<FPhysXInstanceBody*>& Bodies, bool bWakeOnLostTouch = true);
+
+#if PHYSICS_INTERFACE_PHYSX
+	/**
+	 * Drop fitted-primitive cache entries whose mesh or body setup has been destroyed. Game thread only.
+	 *
+	 * @param bReleaseAll  Empty the cache instead (no world uses it anymore).
+	 */
+	static void PrunePrimitiveFits(bool bReleaseAll = false);
+#endif
+
 	/** Add the created rigid body to the PhysX scene associated with the given world. */
 	void AddActorToScene(UWorld* World);
 
@@ -569,6 +946,9 @@ struct FPhysXInstanceData
 	/** Accumulated continuous fall time (seconds) while velocity Z is negative. */
 	float FallTime = 0.0f;
 
+	/** True while an asynchronously registered instance waits for its PhysX body. */
+	bool bBodyPending = false;
+
 	FPhysXInstanceData() = default;
 	
 	// --- Lifetime (TTL) ------------------------------------------------------
@@ -587,6 +967,26 @@ struct FPhysXInstanceData
 	 * Incremented each time lifetime state changes.
 	 */
 	uint32 LifetimeSerial = 0;
+
+	// --- Render tiers --------------------------------------------------------
+
+	/** True while the instance is rendered by the owner's sleeping-tier component. */
+	bool bInSleepingRenderTier = false;
+
+	/** Owner opted into the sleeping render tier; stamped on bind and again whenever the owner toggles the flag. */
+	bool bOwnerUsesSleepingTier = false;
+
+	/** True while a render-tier migration for this instance is queued in the subsystem. */
+	bool bRenderTierMigrationQueued = false;
+
+	/** Time (seconds) the body sleep state has disagreed with the current render tier. */
+	float RenderTierMismatchTime = 0.0f;
+
+	/** True while the instance is beyond its owner's shadow distance (with hysteresis). */
+	bool bBeyondShadowDistance = false;
+
+	/** Owner opted into shadow distance LOD; stamped on bind and again whenever the owner toggles the flag. */
+	bool bOwnerUsesShadowLOD = false;
 };
 
 /** Runtime info about a PhysXInstancedMeshActor stored by the subsystem. */
@@ -595,6 +995,12 @@ struct FPhysXActorData
 	/** Weak pointer to the actor so it does not prevent GC. */
 	TWeakObjectPtr<APhysXInstancedMeshActor> Actor;
 
+	/** bUseSleepingRenderTier as last stamped into the actor's instances; a mismatch triggers a re-stamp. */
+	bool bStampedSleepingRenderTier = false;
+
+	/** Same for bUseShadowDistanceLOD. */
+	bool bStampedShadowDistanceLOD = false;
+
 	FPhysXActorData() = default;
 };
 